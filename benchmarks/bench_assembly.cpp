@@ -0,0 +1,116 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// Benchmark includes
+#include "bench_base.h"
+#include "bench_models.h"
+
+// MAST includes
+#include "base/nonlinear_implicit_assembly.h"
+#include "elasticity/structural_nonlinear_assembly.h"
+#include "heat_conduction/heat_conduction_nonlinear_assembly.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+#include "libmesh/sparse_matrix.h"
+
+
+namespace BENCH {
+    
+    /*!
+     *   times the global residual and Jacobian assembly for \p model using
+     *   the element operations \p elem_ops. The throughput is reported
+     *   for the global number of elements.
+     */
+    template <typename ModelType>
+    void assembly(BENCH::State& state,
+                  ModelType& model,
+                  MAST::AssemblyElemOperations& elem_ops) {
+        
+        MAST::NonlinearImplicitAssembly assembly;
+        
+        assembly.set_discipline_and_system(model.discipline, model.sys_init);
+        elem_ops.set_discipline_and_system(model.discipline, model.sys_init);
+        assembly.set_elem_operation_object(elem_ops);
+        
+        MAST::NonlinearSystem& sys = model.system;
+        
+        *sys.solution = 0.;
+        sys.solution->close();
+        
+        state.measure("residual/" + model.mesh_label(),
+                      model.mesh.n_active_elem(),
+                      [&] {
+                          assembly.residual_and_jacobian(*sys.solution, sys.rhs, nullptr, sys);
+                      });
+        
+        state.measure("residual_and_jacobian/" + model.mesh_label(),
+                      model.mesh.n_active_elem(),
+                      [&] {
+                          assembly.residual_and_jacobian(*sys.solution, sys.rhs, sys.matrix, sys);
+                      });
+        
+        assembly.clear_elem_operation_object();
+        elem_ops.clear_discipline_and_system();
+        assembly.clear_discipline_and_system();
+    }
+}
+
+
+
+MAST_BENCHMARK(structural_assembly_2d) {
+    
+    const unsigned int n_divs[] = {16, 32, 64, 128};
+    
+    for (unsigned int i=0; i<4; i++) {
+        
+        BENCH::StructuralModel model(state.comm(), 2, n_divs[i]);
+        MAST::StructuralNonlinearAssemblyElemOperations elem_ops;
+        BENCH::assembly(state, model, elem_ops);
+    }
+}
+
+
+
+MAST_BENCHMARK(structural_assembly_3d) {
+    
+    const unsigned int n_divs[] = {4, 8, 16};
+    
+    for (unsigned int i=0; i<3; i++) {
+        
+        BENCH::StructuralModel model(state.comm(), 3, n_divs[i]);
+        MAST::StructuralNonlinearAssemblyElemOperations elem_ops;
+        BENCH::assembly(state, model, elem_ops);
+    }
+}
+
+
+
+MAST_BENCHMARK(heat_conduction_assembly) {
+    
+    const unsigned int n_divs[] = {16, 32, 64, 128};
+    
+    for (unsigned int i=0; i<4; i++) {
+        
+        BENCH::ConductionModel model(state.comm(), n_divs[i]);
+        MAST::HeatConductionNonlinearAssemblyElemOperations elem_ops;
+        BENCH::assembly(state, model, elem_ops);
+    }
+}
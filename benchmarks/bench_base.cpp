@@ -0,0 +1,96 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <iomanip>
+
+// Benchmark includes
+#include "bench_base.h"
+
+
+std::atomic<unsigned long long> BENCH::n_allocations(0);
+std::atomic<unsigned long long> BENCH::n_allocated_bytes(0);
+
+
+std::map<std::string, BENCH::Function>&
+BENCH::registry() {
+    
+    // constructed on first use, since the registrars in other translation
+    // units may be initialized before this one.
+    static std::map<std::string, BENCH::Function> benchmarks;
+    return benchmarks;
+}
+
+
+
+void
+BENCH::write_json(std::ostream& o,
+                  const libMesh::Parallel::Communicator& comm,
+                  const double min_time,
+                  const std::vector<BENCH::Result>& results) {
+    
+    o << std::setprecision(9)
+    << "{\n"
+    << "  \"context\": {\n"
+    << "    \"n_processors\": " << comm.size() << ",\n"
+    << "    \"min_time_s\": "   << min_time << "\n"
+    << "  },\n"
+    << "  \"benchmarks\": [";
+    
+    for (unsigned int i=0; i<results.size(); i++) {
+        
+        const BENCH::Result& r = results[i];
+        
+        const double
+        n  = (double)r.n_iterations * (double)r.n_elems;
+        
+        // benchmark names are identifiers and do not need escaping
+        o << (i? ",": "") << "\n"
+        << "    {\n"
+        << "      \"name\": \""                 << r.name << "\",\n"
+        << "      \"elements\": "               << r.n_elems << ",\n"
+        << "      \"iterations\": "             << r.n_iterations << ",\n"
+        << "      \"real_time_s\": "            << r.seconds << ",\n"
+        << "      \"time_per_iteration_s\": "   << r.seconds / r.n_iterations << ",\n"
+        << "      \"elements_per_second\": "    << n / r.seconds << ",\n"
+        << "      \"allocations_per_element\": "<< r.n_allocations / n << ",\n"
+        << "      \"bytes_per_element\": "      << r.n_allocated_bytes / n << "\n"
+        << "    }";
+    }
+    
+    o << "\n  ]\n}\n";
+}
+
+
+
+void
+BENCH::print_result(std::ostream& o,
+                    const BENCH::Result& r) {
+    
+    const double
+    n  = (double)r.n_iterations * (double)r.n_elems;
+    
+    o
+    << std::setw(60) << std::left << r.name << std::right
+    << std::setw(12) << r.n_iterations
+    << std::setw(16) << std::setprecision(4) << std::scientific << n / r.seconds << " elem/s"
+    << std::setw(12) << std::setprecision(2) << std::fixed << r.n_allocations / n << " alloc/elem"
+    << std::defaultfloat << std::endl;
+}
@@ -0,0 +1,195 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __bench__bench_base__
+#define __bench__bench_base__
+
+// C++ includes
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/parallel.h"
+
+
+namespace BENCH {
+    
+    /*!
+     *   number of calls to the global operator new, and the bytes requested
+     *   by these calls. These are updated by the replacement operators
+     *   defined in bench_main.cpp.
+     */
+    extern std::atomic<unsigned long long> n_allocations;
+    extern std::atomic<unsigned long long> n_allocated_bytes;
+    
+    
+    /*!
+     *   timing of one measured operation
+     */
+    struct Result {
+        
+        std::string         name;
+        unsigned long long  n_elems;
+        unsigned long long  n_iterations;
+        double              seconds;
+        unsigned long long  n_allocations;
+        unsigned long long  n_allocated_bytes;
+    };
+    
+    
+    /*!
+     *   Provided to each benchmark function to time its operations.
+     */
+    class State {
+        
+    public:
+        
+        State(const libMesh::Parallel::Communicator& comm,
+              const std::string& name,
+              const double min_time):
+        _comm     (comm),
+        _name     (name),
+        _min_time (min_time)
+        { }
+        
+        const libMesh::Parallel::Communicator& comm() const { return _comm; }
+        
+        /*!
+         *   calls \p f repeatedly until the accumulated time exceeds the
+         *   minimum time, and records the result as \p <name>/<label>.
+         *   Each call processes \p n_elems elements, which is used to
+         *   report the throughput and the allocations per element. A first
+         *   untimed call initializes any lazily allocated buffers. If \p f
+         *   is collective, all ranks must call this together.
+         */
+        template <typename F>
+        void measure(const std::string& label,
+                     const unsigned long long n_elems,
+                     F f) {
+            
+            f();
+            
+            unsigned long long
+            n_calls   = 1,
+            n_total   = 0,
+            n_alloc0  = n_allocations,
+            n_bytes0  = n_allocated_bytes;
+            
+            double
+            t_total   = 0.;
+            
+            // the number of calls is doubled until the minimum time is
+            // reached on all ranks, so that all ranks make the same calls.
+            while (t_total < _min_time) {
+                
+                std::chrono::steady_clock::time_point
+                t0 = std::chrono::steady_clock::now();
+                
+                for (unsigned long long i=0; i<n_calls; i++)
+                    f();
+                
+                t_total += std::chrono::duration<double>
+                (std::chrono::steady_clock::now() - t0).count();
+                _comm.max(t_total);
+                
+                n_total += n_calls;
+                n_calls *= 2;
+            }
+            
+            Result r;
+            r.name              = _name + "/" + label;
+            r.n_elems           = n_elems;
+            r.n_iterations      = n_total;
+            r.seconds           = t_total;
+            r.n_allocations     = n_allocations - n_alloc0;
+            r.n_allocated_bytes = n_allocated_bytes - n_bytes0;
+            _results.push_back(r);
+        }
+        
+        const std::vector<BENCH::Result>& results() const { return _results; }
+        
+    protected:
+        
+        const libMesh::Parallel::Communicator& _comm;
+        
+        const std::string _name;
+        
+        const double _min_time;
+        
+        std::vector<BENCH::Result> _results;
+    };
+    
+    
+    typedef void (*Function)(BENCH::State&);
+    
+    
+    /*!
+     *   @returns the map of benchmark names to functions. The map is
+     *   ordered so that the benchmarks run in a reproducible order.
+     */
+    std::map<std::string, BENCH::Function>& registry();
+    
+    
+    /*!
+     *   adds a benchmark function to the registry at static initialization
+     */
+    struct Registrar {
+        
+        Registrar(const char* nm, BENCH::Function f) {
+            BENCH::registry()[nm] = f;
+        }
+    };
+    
+    
+    /*!
+     *   writes the results in JSON format.
+     */
+    void write_json(std::ostream& o,
+                    const libMesh::Parallel::Communicator& comm,
+                    const double min_time,
+                    const std::vector<BENCH::Result>& results);
+    
+    
+    /*!
+     *   writes a one-line summary of \p r
+     */
+    void print_result(std::ostream& o,
+                      const BENCH::Result& r);
+}
+
+
+/*!
+ *   defines a benchmark function with the signature
+ *   \p void nm(BENCH::State& state) and adds it to the registry.
+ */
+#define MAST_BENCHMARK(nm)                                          \
+    static void nm(BENCH::State& state);                            \
+    static BENCH::Registrar nm##_registrar(#nm, nm);                \
+    static void nm(BENCH::State& state)
+
+
+#endif // __bench__bench_base__
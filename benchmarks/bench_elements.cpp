@@ -0,0 +1,187 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// Benchmark includes
+#include "bench_base.h"
+#include "bench_models.h"
+
+// MAST includes
+#include "mesh/geom_elem.h"
+#include "elasticity/structural_element_base.h"
+#include "elasticity/stress_output_base.h"
+#include "heat_conduction/heat_conduction_elem_base.h"
+#include "fluid/conservative_fluid_element_base.h"
+
+// libMesh includes
+#include "libmesh/elem.h"
+
+
+namespace BENCH {
+    
+    /*!
+     *   times the internal residual and Jacobian, and the stress
+     *   evaluation of the first local element of a structural model of
+     *   dimension \p dim.
+     */
+    void structural_element(BENCH::State& state,
+                            const unsigned int dim,
+                            const unsigned int n_divs) {
+        
+        BENCH::StructuralModel model(state.comm(), dim, n_divs);
+        
+        MAST::GeomElem geom;
+        geom.init(model.first_local_elem(), model.sys_init);
+        
+        std::unique_ptr<MAST::StructuralElementBase>
+        elem(MAST::build_structural_element(model.sys_init, geom, *model.section));
+        
+        const unsigned int
+        n    = geom.get_reference_elem().n_nodes() * model.sys_init.n_vars();
+        
+        const std::string
+        nm   = geom.get_reference_elem().type() == libMesh::EDGE2? "edge2":
+        (geom.get_reference_elem().type() == libMesh::QUAD4? "quad4": "hex8");
+        
+        RealVectorX
+        sol  = BENCH::random_vector(n, 1.e-4),
+        zero = RealVectorX::Zero(n),
+        f    = RealVectorX::Zero(n);
+        
+        RealMatrixX
+        jac  = RealMatrixX::Zero(n, n);
+        
+        elem->set_solution(sol);
+        elem->set_solution(zero, true);
+        
+        state.measure("internal_residual/" + nm, 1, [&] {
+            f.setZero();
+            elem->internal_residual(false, f, jac);
+        });
+        
+        state.measure("internal_residual_and_jacobian/" + nm, 1, [&] {
+            f.setZero();
+            jac.setZero();
+            elem->internal_residual(true, f, jac);
+        });
+        
+        MAST::StressStrainOutputBase output;
+        output.set_discipline_and_system(model.discipline, model.sys_init);
+        output.set_participating_elements_to_all();
+        
+        // the stored quadrature point data are deleted after each
+        // evaluation, and are included in the allocation count
+        state.measure("calculate_stress/" + nm, 1, [&] {
+            elem->calculate_stress(false, nullptr, output);
+            output.clear();
+        });
+        
+        output.clear_discipline_and_system();
+    }
+}
+
+
+
+MAST_BENCHMARK(structural_element_1d) {
+    
+    BENCH::structural_element(state, 1, 16);
+}
+
+
+
+MAST_BENCHMARK(structural_element_2d) {
+    
+    BENCH::structural_element(state, 2, 8);
+}
+
+
+
+MAST_BENCHMARK(structural_element_3d) {
+    
+    BENCH::structural_element(state, 3, 4);
+}
+
+
+
+MAST_BENCHMARK(heat_conduction_element) {
+    
+    BENCH::ConductionModel model(state.comm(), 8);
+    
+    MAST::GeomElem geom;
+    geom.init(model.first_local_elem(), model.sys_init);
+    
+    MAST::HeatConductionElementBase elem(model.sys_init, geom, *model.section);
+    
+    const unsigned int
+    n    = geom.get_reference_elem().n_nodes();
+    
+    RealVectorX
+    sol  = RealVectorX::Constant(n, 300.) + BENCH::random_vector(n, 10.),
+    f    = RealVectorX::Zero(n);
+    
+    RealMatrixX
+    jac  = RealMatrixX::Zero(n, n);
+    
+    elem.set_solution(sol);
+    
+    state.measure("internal_residual_and_jacobian/quad4", 1, [&] {
+        f.setZero();
+        jac.setZero();
+        elem.internal_residual(true, f, jac);
+    });
+}
+
+
+
+MAST_BENCHMARK(conservative_fluid_element) {
+    
+    BENCH::FluidModel model(state.comm(), 8);
+    
+    MAST::GeomElem geom;
+    geom.init(model.first_local_elem(), model.sys_init);
+    
+    MAST::ConservativeFluidElementBase elem(model.sys_init, geom, model.flight_cond);
+    
+    const unsigned int
+    n_nodes = geom.get_reference_elem().n_nodes(),
+    n       = 4 * n_nodes;
+    
+    // a small perturbation of the free-stream solution exercises the
+    // stabilization and shock-capturing terms
+    RealVectorX
+    sol  = model.elem_free_stream_solution(n_nodes),
+    f    = RealVectorX::Zero(n);
+    sol  = sol.cwiseProduct(RealVectorX::Ones(n) + BENCH::random_vector(n, 1.e-3));
+    
+    RealMatrixX
+    jac  = RealMatrixX::Zero(n, n);
+    
+    elem.set_solution(sol);
+    
+    state.measure("internal_residual/quad4", 1, [&] {
+        f.setZero();
+        elem.internal_residual(false, f, jac);
+    });
+    
+    state.measure("internal_residual_and_jacobian/quad4", 1, [&] {
+        f.setZero();
+        jac.setZero();
+        elem.internal_residual(true, f, jac);
+    });
+}
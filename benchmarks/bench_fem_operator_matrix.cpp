@@ -0,0 +1,108 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// Benchmark includes
+#include "bench_base.h"
+#include "bench_models.h"
+
+// MAST includes
+#include "numerics/fem_operator_matrix.h"
+#include "numerics/fixed_size_kernels.h"
+
+
+namespace BENCH {
+    
+    /*!
+     *   initializes the membrane strain operator of a QUAD4 element with
+     *   reproducible shape function derivatives.
+     */
+    void init_membrane_strain_operator(MAST::FEMOperatorMatrix& B) {
+        
+        const RealVectorX
+        dNdx = BENCH::random_vector(4, 1.),
+        dNdy = BENCH::random_vector(4, 1.).reverse();
+        
+        B.reinit(3, 2, 4);
+        B.set_shape_function(0, 0, dNdx);
+        B.set_shape_function(1, 1, dNdy);
+        B.set_shape_function(2, 0, dNdy);
+        B.set_shape_function(2, 1, dNdx);
+    }
+}
+
+
+
+// Each operation is the quadrature point contribution to the stiffness
+// matrix of a QUAD4 membrane, [B]^T [D] [B], using the operator products
+// of FEMOperatorMatrix and the compile-time sized strain kernel.
+MAST_BENCHMARK(fem_operator_matrix) {
+    
+    MAST::FEMOperatorMatrix B;
+    BENCH::init_membrane_strain_operator(B);
+    
+    // plane-stress constitutive matrix with nu = 0.3
+    RealMatrixX
+    D    = RealMatrixX::Identity(3, 3),
+    DB   = RealMatrixX::Zero(3, 8),
+    BtDB = RealMatrixX::Zero(8, 8),
+    jac  = RealMatrixX::Zero(8, 8);
+    
+    D(0, 1) = D(1, 0) = 0.3;
+    D(2, 2) = 0.35;
+    
+    RealVectorX
+    u    = BENCH::random_vector(8, 1.e-3),
+    eps  = RealVectorX::Zero(3),
+    f    = RealVectorX::Zero(8);
+    
+    state.measure("vector_mult/quad4_membrane", 1, [&] {
+        B.vector_mult(eps, u);
+    });
+    
+    state.measure("vector_mult_transpose/quad4_membrane", 1, [&] {
+        B.vector_mult_transpose(f, eps);
+    });
+    
+    state.measure("left_right_multiply/quad4_membrane", 1, [&] {
+        B.left_multiply(DB, D);
+        B.right_multiply_transpose(BtDB, DB);
+        jac += BtDB;
+    });
+    
+    std::unique_ptr<MAST::StrainOperatorKernelBase>
+    kernel(MAST::build_strain_operator_kernel(3, 8));
+    
+    state.measure("strain_kernel_add_Bt_D_B/quad4_membrane", 1, [&] {
+        kernel->add_Bt_D_B(1., B, D, B, jac);
+    });
+    
+    // fluid elements interpolate all variables with the same shape
+    // functions
+    MAST::FEMOperatorMatrix N;
+    N.reinit(4, BENCH::random_vector(4, 1.));
+    
+    RealVectorX
+    sol  = BENCH::random_vector(16, 1.),
+    val  = RealVectorX::Zero(4);
+    
+    state.measure("vector_mult/quad4_fluid_interpolation", 1, [&] {
+        N.vector_mult(val, sol);
+    });
+}
@@ -0,0 +1,56 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// Benchmark includes
+#include "bench_base.h"
+#include "bench_models.h"
+
+// MAST includes
+#include "level_set/filter_base.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+
+
+// The filter computes the neighbors of each design variable within the
+// filter radius when it is constructed, which is timed here for a radius
+// spanning a few elements.
+MAST_BENCHMARK(filter_setup) {
+    
+    const unsigned int n_divs[] = {16, 32, 64, 128};
+    
+    for (unsigned int i=0; i<4; i++) {
+        
+        BENCH::ConductionModel model(state.comm(), n_divs[i]);
+        
+        std::set<unsigned int> dv_dof_ids;
+        for (unsigned int j=0; j<model.system.get_dof_map().n_dofs(); j++)
+            dv_dof_ids.insert(j);
+        
+        const Real
+        radius = 2.5 / n_divs[i];
+        
+        state.measure("construct/" + model.mesh_label(),
+                      model.mesh.n_active_elem(),
+                      [&] {
+                          MAST::FilterBase filter(model.system, radius, dv_dof_ids);
+                      });
+    }
+}
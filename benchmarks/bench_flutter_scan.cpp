@@ -0,0 +1,156 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <random>
+
+// Benchmark includes
+#include "bench_base.h"
+
+// MAST includes
+#include "numerics/lapack_zggev_interface.h"
+#include "numerics/generalized_eigen_tracker.h"
+
+
+namespace BENCH {
+    
+    /*!
+     *   reduced-order modal model with synthetic aerodynamic matrices,
+     *   \f$ A_{aero}(k) = A_0 + i k A_1 \f$, of the same size and
+     *   structure as the matrices assembled at each sample of the UG and
+     *   PK flutter scans. This isolates the eigenvalue solutions of the
+     *   scans from the assembly of the generalized aerodynamic forces,
+     *   which is timed by the assembly benchmarks.
+     */
+    struct ModalModel {
+        
+        ModalModel(unsigned int n):
+        K  (ComplexMatrixX::Zero(n, n)),
+        M  (ComplexMatrixX::Identity(n, n)),
+        A0 (ComplexMatrixX::Zero(n, n)),
+        A1 (ComplexMatrixX::Zero(n, n)) {
+            
+            std::mt19937 gen(1);
+            std::uniform_real_distribution<Real> dist(-1., 1.);
+            
+            for (unsigned int i=0; i<n; i++) {
+                
+                // well separated structural frequencies
+                K(i, i) = std::pow(2. * (i+1), 2);
+                
+                for (unsigned int j=0; j<n; j++) {
+                    A0(i, j) = 0.1 * dist(gen);
+                    A1(i, j) = 0.1 * dist(gen);
+                }
+            }
+        }
+        
+        /*!
+         *   UG pencil at reduced frequency \p k and dynamic pressure \p q
+         */
+        void ug_pencil(Real k, Real q, ComplexMatrixX& A, ComplexMatrixX& B) const {
+            
+            A = K + q * (A0 + Complex(0., k) * A1);
+            B = M;
+        }
+        
+        /*!
+         *   first-order PK pencil at reduced frequency \p k and dynamic
+         *   pressure \p q
+         */
+        void pk_pencil(Real k, Real q, ComplexMatrixX& A, ComplexMatrixX& B) const {
+            
+            const unsigned int n = (unsigned int)K.rows();
+            
+            A = ComplexMatrixX::Zero(2*n, 2*n);
+            B = ComplexMatrixX::Identity(2*n, 2*n);
+            
+            A.topRightCorner(n, n)    = ComplexMatrixX::Identity(n, n);
+            A.bottomLeftCorner(n, n)  = -(K - q * A0);
+            A.bottomRightCorner(n, n) = q * k * A1;
+            B.bottomRightCorner(n, n) = M;
+        }
+        
+        ComplexMatrixX K, M, A0, A1;
+    };
+}
+
+
+
+MAST_BENCHMARK(flutter_scan) {
+    
+    const unsigned int
+    n_modes[]  = {8, 16, 32},
+    n_samples  = 50;
+    
+    const Real
+    q          = 1.,
+    k_max      = 1.;
+    
+    for (unsigned int i=0; i<3; i++) {
+        
+        BENCH::ModalModel model(n_modes[i]);
+        
+        const std::string
+        nm = std::to_string(n_modes[i]) + "_modes";
+        
+        ComplexMatrixX
+        A,
+        B;
+        
+        // each sample of the scan uses the full QZ solution
+        state.measure("ug_qz/" + nm, n_samples, [&] {
+            for (unsigned int j=0; j<n_samples; j++) {
+                model.ug_pencil(k_max * (j+1) / n_samples, q, A, B);
+                MAST::LAPACK_ZGGEV ges;
+                ges.compute(A, B, true);
+            }
+        });
+        
+        // the roots are tracked from the previous sample, and the QZ
+        // solution is used only if tracking fails
+        state.measure("ug_tracked/" + nm, n_samples, [&] {
+            
+            MAST::GeneralizedEigenTracker tracker;
+            ComplexVectorX eig;
+            ComplexMatrixX VR, VL;
+            
+            for (unsigned int j=0; j<n_samples; j++) {
+                
+                model.ug_pencil(k_max * (j+1) / n_samples, q, A, B);
+                
+                if (j == 0 || !tracker.track(A, B, eig, VR, &VL))
+                    tracker.compute(A, B, true);
+                
+                eig = tracker.alphas().cwiseQuotient(tracker.betas());
+                VR  = tracker.right_eigenvectors();
+                VL  = tracker.left_eigenvectors();
+            }
+        });
+        
+        state.measure("pk_qz/" + nm, n_samples, [&] {
+            for (unsigned int j=0; j<n_samples; j++) {
+                model.pk_pencil(k_max * (j+1) / n_samples, q, A, B);
+                MAST::LAPACK_ZGGEV ges;
+                ges.compute(A, B, true);
+            }
+        });
+    }
+}
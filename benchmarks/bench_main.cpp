@@ -0,0 +1,154 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <cstdlib>
+#include <new>
+#include <fstream>
+#include <iostream>
+
+// MAST includes
+#include "utility/assembly_profiler.h"
+
+// Benchmark includes
+#include "bench_base.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+
+
+// The global allocation operators are replaced to count the allocations
+// made in the benchmarked operations. Allocations made directly with
+// malloc, for example by PETSc, are not counted.
+void* operator new(std::size_t n) {
+    
+    BENCH::n_allocations++;
+    BENCH::n_allocated_bytes += n;
+    
+    if (void* p = std::malloc(n? n: 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+
+void* operator new[](std::size_t n) {
+    
+    return ::operator new(n);
+}
+
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    
+    BENCH::n_allocations++;
+    BENCH::n_allocated_bytes += n;
+    
+    return std::malloc(n? n: 1);
+}
+
+
+void* operator new[](std::size_t n, const std::nothrow_t& t) noexcept {
+    
+    return ::operator new(n, t);
+}
+
+
+void operator delete(void* p) noexcept                          { std::free(p); }
+void operator delete[](void* p) noexcept                        { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept             { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept           { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept   { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+
+// provides the allocation counts to the assembly profiler
+void allocation_counter(std::uint64_t& n_allocations,
+                        std::uint64_t& n_bytes) {
+    
+    n_allocations = BENCH::n_allocations;
+    n_bytes       = BENCH::n_allocated_bytes;
+}
+
+
+
+int main(int argc, const char** argv) {
+    
+    libMesh::LibMeshInit init(argc, argv);
+    
+    const std::string
+    filter   = libMesh::command_line_value("--filter", std::string("")),
+    json     = libMesh::command_line_value("--json", std::string("")),
+    profile  = libMesh::command_line_value("--profile", std::string(""));
+    
+    const double
+    min_time = libMesh::command_line_value("--min_time", 0.5);
+    
+    std::map<std::string, BENCH::Function>::const_iterator
+    it       = BENCH::registry().begin(),
+    end      = BENCH::registry().end();
+    
+    if (libMesh::on_command_line("--list")) {
+        
+        for ( ; it != end; it++)
+            libMesh::out << it->first << std::endl;
+        return 0;
+    }
+    
+    // the assembly phases are profiled if requested. Note that this adds
+    // the profiling overhead to the benchmark timings.
+    if (!profile.empty()) {
+        
+        MAST::AssemblyProfiler::set_allocation_counter(allocation_counter);
+        MAST::AssemblyProfiler::enable(true);
+    }
+    
+    std::vector<BENCH::Result>
+    results;
+    
+    for ( ; it != end; it++) {
+        
+        if (it->first.find(filter) == std::string::npos)
+            continue;
+        
+        BENCH::State state(init.comm(), it->first, min_time);
+        it->second(state);
+        
+        for (unsigned int i=0; i<state.results().size(); i++)
+            BENCH::print_result(libMesh::out, state.results()[i]);
+        
+        results.insert(results.end(),
+                       state.results().begin(),
+                       state.results().end());
+    }
+    
+    // the timings are the maximum over all ranks, so the first rank
+    // writes the output
+    if (!json.empty() && init.comm().rank() == 0) {
+        
+        std::ofstream o(json.c_str());
+        BENCH::write_json(o, init.comm(), min_time, results);
+    }
+    else if (json.empty())
+        BENCH::write_json(libMesh::out, init.comm(), min_time, results);
+    
+    if (!profile.empty())
+        MAST::AssemblyProfiler::write(init.comm(), profile);
+    
+    return 0;
+}
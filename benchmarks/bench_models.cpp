@@ -0,0 +1,261 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <random>
+#include <sstream>
+
+// Benchmark includes
+#include "bench_models.h"
+
+// MAST includes
+#include "property_cards/solid_1d_section_element_property_card.h"
+#include "property_cards/solid_2d_section_element_property_card.h"
+#include "property_cards/isotropic_element_property_card_3D.h"
+
+// libMesh includes
+#include "libmesh/mesh_generation.h"
+#include "libmesh/elem.h"
+
+
+BENCH::ModelBase::ModelBase(const libMesh::Parallel::Communicator& comm,
+                            const unsigned int d,
+                            const unsigned int n):
+dim              (d),
+n_divs           (n),
+mesh             (comm),
+equation_systems (mesh),
+system           (equation_systems.add_system<MAST::NonlinearSystem>("bench")),
+fetype           (libMesh::FIRST, libMesh::LAGRANGE) {
+    
+    switch (dim) {
+        case 1:
+            libMesh::MeshTools::Generation::build_line(mesh, n, 0., 1., libMesh::EDGE2);
+            break;
+            
+        case 2:
+            libMesh::MeshTools::Generation::build_square(mesh, n, n, 0., 1., 0., 1., libMesh::QUAD4);
+            break;
+            
+        case 3:
+            libMesh::MeshTools::Generation::build_cube(mesh, n, n, n, 0., 1., 0., 1., 0., 1., libMesh::HEX8);
+            break;
+            
+        default:
+            libmesh_error();
+    }
+}
+
+
+
+const libMesh::Elem&
+BENCH::ModelBase::first_local_elem() const {
+    
+    libmesh_assert(mesh.active_local_elements_begin() != mesh.active_local_elements_end());
+    
+    return **mesh.active_local_elements_begin();
+}
+
+
+
+std::string
+BENCH::ModelBase::mesh_label() const {
+    
+    std::ostringstream oss;
+    
+    switch (dim) {
+        case 1: oss << "edge2_" << n_divs;                                   break;
+        case 2: oss << "quad4_" << n_divs << "x" << n_divs;                  break;
+        case 3: oss << "hex8_"  << n_divs << "x" << n_divs << "x" << n_divs; break;
+        default: libmesh_error();
+    }
+    
+    return oss.str();
+}
+
+
+
+BENCH::MaterialModel::MaterialModel(const libMesh::Parallel::Communicator& comm,
+                                    const unsigned int d,
+                                    const unsigned int n):
+BENCH::ModelBase(comm, d, n),
+E          ("E",      72.e9),
+nu         ("nu",     0.33),
+rho        ("rho",    2700.),
+alpha      ("alpha",  2.5e-5),
+k          ("k",      237.),
+cp         ("cp",     908.),
+h          ("h",      0.002),
+off        ("off",    0.),
+kappa      ("kappa",  5./6.),
+zero       ("zero",   0.),
+E_f        ("E",               E),
+nu_f       ("nu",              nu),
+rho_f      ("rho",             rho),
+alpha_f    ("alpha_expansion", alpha),
+k_f        ("k_th",            k),
+cp_f       ("cp",              cp),
+h_f        ("h",               h),
+off_f      ("off",             off),
+kappa_f    ("kappa",           kappa),
+hy_f       ("hy",              h),
+hz_f       ("hz",              h),
+hy_off_f   ("hy_off",          zero),
+hz_off_f   ("hz_off",          zero),
+kappa_yy_f ("Kappayy",         kappa),
+kappa_zz_f ("Kappazz",         kappa) {
+    
+    material.add(E_f);
+    material.add(nu_f);
+    material.add(rho_f);
+    material.add(alpha_f);
+    material.add(k_f);
+    material.add(cp_f);
+    
+    switch (dim) {
+            
+        case 1: {
+            
+            MAST::Solid1DSectionElementPropertyCard*
+            p = new MAST::Solid1DSectionElementPropertyCard;
+            section.reset(p);
+            
+            p->add(hy_f);
+            p->add(hz_f);
+            p->add(hy_off_f);
+            p->add(hz_off_f);
+            p->add(kappa_yy_f);
+            p->add(kappa_zz_f);
+            p->y_vector()    = RealVectorX::Zero(3);
+            p->y_vector()(1) = 1.;
+            p->set_material(material);
+            p->init();
+        }
+            break;
+            
+        case 2: {
+            
+            MAST::Solid2DSectionElementPropertyCard*
+            p = new MAST::Solid2DSectionElementPropertyCard;
+            section.reset(p);
+            
+            p->add(h_f);
+            p->add(off_f);
+            p->add(kappa_f);
+            p->set_material(material);
+        }
+            break;
+            
+        case 3: {
+            
+            MAST::IsotropicElementPropertyCard3D*
+            p = new MAST::IsotropicElementPropertyCard3D;
+            section.reset(p);
+            
+            p->set_material(material);
+        }
+            break;
+            
+        default:
+            libmesh_error();
+    }
+}
+
+
+
+BENCH::StructuralModel::StructuralModel(const libMesh::Parallel::Communicator& comm,
+                                        const unsigned int d,
+                                        const unsigned int n):
+BENCH::MaterialModel(comm, d, n),
+sys_init   (system, system.name(), fetype),
+discipline (equation_systems) {
+    
+    discipline.set_property_for_subdomain(0, *section);
+    equation_systems.init();
+}
+
+
+
+BENCH::ConductionModel::ConductionModel(const libMesh::Parallel::Communicator& comm,
+                                        const unsigned int n):
+BENCH::MaterialModel(comm, 2, n),
+sys_init   (system, system.name(), fetype),
+discipline (equation_systems) {
+    
+    discipline.set_property_for_subdomain(0, *section);
+    equation_systems.init();
+}
+
+
+
+BENCH::FluidModel::FluidModel(const libMesh::Parallel::Communicator& comm,
+                              const unsigned int n):
+BENCH::ModelBase(comm, 2, n),
+sys_init   (system, system.name(), fetype, 2),
+discipline (equation_systems) {
+    
+    flight_cond.flow_unit_vector(0)  = 1.;
+    flight_cond.mach                 = 0.5;
+    flight_cond.gas_property.cp      = 1003.;
+    flight_cond.gas_property.cv      = 716.;
+    flight_cond.gas_property.T       = 300.;
+    flight_cond.gas_property.rho     = 1.05;
+    flight_cond.init();
+    
+    discipline.set_flight_condition(flight_cond);
+    equation_systems.init();
+}
+
+
+
+RealVectorX
+BENCH::FluidModel::elem_free_stream_solution(unsigned int n_nodes) const {
+    
+    RealVectorX
+    s   = RealVectorX::Zero(4),
+    sol = RealVectorX::Zero(4*n_nodes);
+    
+    s(0) = flight_cond.rho();
+    s(1) = flight_cond.rho_u1();
+    s(2) = flight_cond.rho_u2();
+    s(3) = flight_cond.rho_e();
+    
+    // the element dofs are ordered by variable
+    for (unsigned int i=0; i<4; i++)
+        sol.segment(i*n_nodes, n_nodes).setConstant(s(i));
+    
+    return sol;
+}
+
+
+
+RealVectorX
+BENCH::random_vector(unsigned int n, Real scale) {
+    
+    // fixed seed for reproducible benchmarks
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<Real> dist(-scale, scale);
+    
+    RealVectorX v = RealVectorX::Zero(n);
+    for (unsigned int i=0; i<n; i++)
+        v(i) = dist(gen);
+    
+    return v;
+}
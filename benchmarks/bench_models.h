@@ -0,0 +1,176 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __bench__bench_models__
+#define __bench__bench_models__
+
+// C++ includes
+#include <memory>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/nonlinear_system.h"
+#include "base/physics_discipline_base.h"
+#include "base/parameter.h"
+#include "base/constant_field_function.h"
+#include "property_cards/isotropic_material_property_card.h"
+#include "property_cards/element_property_card_base.h"
+#include "elasticity/structural_system_initialization.h"
+#include "heat_conduction/heat_conduction_system_initialization.h"
+#include "fluid/conservative_fluid_system_initialization.h"
+#include "fluid/conservative_fluid_discipline.h"
+#include "fluid/flight_condition.h"
+
+// libMesh includes
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/fe_type.h"
+
+
+namespace BENCH {
+    
+    /*!
+     *   Mesh and equation system on a generated line, square or cube mesh
+     *   with \p n_divs elements along each edge. The line and square are
+     *   meshed with EDGE2 and QUAD4 elements, and the cube with HEX8.
+     */
+    class ModelBase {
+        
+    public:
+        
+        ModelBase(const libMesh::Parallel::Communicator& comm,
+                  const unsigned int dim,
+                  const unsigned int n_divs);
+        
+        virtual ~ModelBase() { }
+        
+        /*!
+         *   @returns the first element owned by this rank
+         */
+        const libMesh::Elem& first_local_elem() const;
+        
+        /*!
+         *   @returns the label of the mesh used in benchmark names, for
+         *   example \p quad4_32x32
+         */
+        std::string mesh_label() const;
+        
+        const unsigned int           dim;
+        const unsigned int           n_divs;
+        libMesh::ReplicatedMesh      mesh;
+        libMesh::EquationSystems     equation_systems;
+        MAST::NonlinearSystem&       system;
+        libMesh::FEType              fetype;
+    };
+    
+    
+    /*!
+     *   isotropic material and the section property card for the
+     *   dimension of the mesh
+     */
+    class MaterialModel:
+    public BENCH::ModelBase {
+        
+    public:
+        
+        MaterialModel(const libMesh::Parallel::Communicator& comm,
+                      const unsigned int dim,
+                      const unsigned int n_divs);
+        
+        virtual ~MaterialModel() { }
+        
+        MAST::Parameter
+        E, nu, rho, alpha, k, cp, h, off, kappa, zero;
+        
+        MAST::ConstantFieldFunction
+        E_f, nu_f, rho_f, alpha_f, k_f, cp_f,
+        h_f, off_f, kappa_f, hy_f, hz_f, hy_off_f, hz_off_f, kappa_yy_f, kappa_zz_f;
+        
+        MAST::IsotropicMaterialPropertyCard              material;
+        std::unique_ptr<MAST::ElementPropertyCardBase>   section;
+    };
+    
+    
+    /*!
+     *   structural model on a mesh of dimension \p dim
+     */
+    class StructuralModel:
+    public BENCH::MaterialModel {
+        
+    public:
+        
+        StructuralModel(const libMesh::Parallel::Communicator& comm,
+                        const unsigned int dim,
+                        const unsigned int n_divs);
+        
+        MAST::StructuralSystemInitialization   sys_init;
+        MAST::PhysicsDisciplineBase            discipline;
+    };
+    
+    
+    /*!
+     *   heat conduction model on a two-dimensional mesh
+     */
+    class ConductionModel:
+    public BENCH::MaterialModel {
+        
+    public:
+        
+        ConductionModel(const libMesh::Parallel::Communicator& comm,
+                        const unsigned int n_divs);
+        
+        MAST::HeatConductionSystemInitialization   sys_init;
+        MAST::PhysicsDisciplineBase                discipline;
+    };
+    
+    
+    /*!
+     *   inviscid conservative fluid model on a two-dimensional mesh,
+     *   initialized to the free-stream solution
+     */
+    class FluidModel:
+    public BENCH::ModelBase {
+        
+    public:
+        
+        FluidModel(const libMesh::Parallel::Communicator& comm,
+                   const unsigned int n_divs);
+        
+        /*!
+         *   @returns the free-stream solution for the dofs of an element
+         *   with \p n_nodes nodes
+         */
+        RealVectorX elem_free_stream_solution(unsigned int n_nodes) const;
+        
+        MAST::FlightCondition                       flight_cond;
+        MAST::ConservativeFluidSystemInitialization sys_init;
+        MAST::ConservativeFluidDiscipline           discipline;
+    };
+    
+    
+    /*!
+     *   @returns a vector of size \p n with reproducible uniform random
+     *   entries in [-\p scale, \p scale]
+     */
+    RealVectorX random_vector(unsigned int n, Real scale);
+}
+
+
+#endif // __bench__bench_models__
@@ -38,6 +38,7 @@
 #include "fluid/conservative_fluid_transient_assembly.h"
 #include "fluid/flight_condition.h"
 #include "fluid/integrated_force_output.h"
+#include "utility/async_output_writer.h"
 #include "solver/first_order_newmark_transient_solver.h"
 #include "solver/stabilized_first_order_transient_sensitivity_solver.h"
 
@@ -997,10 +998,13 @@ public:
     void compute_flow() {
         
         bool
-        output     = _input("if_output", "if write output to a file", true);
+        output     = _input("if_output", "if write output to a file", true),
+        hdf5_output = _input("if_hdf5_output", "if write solution and velocity at each time-step to an HDF5 file in the background", false);
         std::string
         output_name = _input("output_file_root", "prefix of output file names", "output"),
         transient_output_name = output_name + "_transient.exo";
+        unsigned int
+        exodus_interval = _input("exodus_output_interval", "number of time-steps between Exodus output, with 0 to disable Exodus output", 1);
         
         
         // create the nonlinear assembly object
@@ -1032,6 +1036,14 @@ public:
         
         // file to write the solution for visualization
         libMesh::ExodusII_IO transient_output(*_mesh);
+        
+        // the time history is staged and written from a background thread
+        // while the next time-step is being solved
+        std::unique_ptr<MAST::AsyncOutputWriter> hdf5_writer;
+        if (output && hdf5_output)
+            hdf5_writer.reset(new MAST::AsyncOutputWriter(_sys->comm(),
+                                                          output_name + "_transient.h5"));
+        
         std::ofstream force_output;
         force_output.open("force.txt");
         force_output
@@ -1057,6 +1069,35 @@ public:
         // the default parameter adds some numerical damping to improve
         // convergence towards steady state solution.
         solver.beta       = _input("beta", "Newmark solver beta parameter ",  0.7);
+        
+        // pseudo-transient continuation uses local time-steps defined by
+        // the CFL number, which is adapted based on the reduction in
+        // the solution rate. In this case the global dt is not changed.
+        bool
+        if_ptc            = _input("if_pseudo_transient", "use local time-stepping to march to steady-state", false);
+        if (if_ptc) {
+            
+            elem_ops.set_pseudo_transient_continuation
+            (true,
+             _input("cfl", "initial CFL number for pseudo-transient continuation", 1.),
+             _input("max_cfl", "maximum CFL number for pseudo-transient continuation", 1.e5),
+             _input("min_cfl", "minimum CFL number for pseudo-transient continuation", 1.e-3));
+            solver.dt     = 1.;
+            solver.beta   = 1.;
+        }
+        
+        // Jacobian-free Newton-Krylov uses finite-difference products
+        // for the Jacobian, and an assembled Jacobian with frozen
+        // coefficients as preconditioner, updated every few iterations
+        bool
+        if_jfnk           = _input("if_jfnk", "use Jacobian-free Newton-Krylov for the nonlinear solves", false);
+        if (if_jfnk) {
+            
+            unsigned int
+            pc_lag        = _input("jfnk_pc_lag", "number of Newton iterations between preconditioner updates", 3);
+            elem_ops.set_frozen_coefficient_jacobian(true);
+            _sys->set_jacobian_free_newton_krylov(true, pc_lag);
+        }
 
         // print the fluid values:
         libMesh::out
@@ -1078,7 +1119,12 @@ public:
         // loop over time steps
         while (t_step < n_steps) {
             
-            if (iter_count_dt == n_iters_change_dt) {
+            if (if_ptc) {
+                
+                // nothing to be done here, since the CFL number is updated
+                // after each time-step.
+            }
+            else if (iter_count_dt == n_iters_change_dt) {
                 
                 libMesh::out
                 << "Changing dt:  old dt = " << solver.dt
@@ -1100,19 +1146,34 @@ public:
             << "Time step: "    << t_step
             << " :  t = "       << tval
             << " :  dt = "      << solver.dt
-            << " :  xdot-L2 = " << solver.velocity().l2_norm()
+            << " :  xdot-L2 = " << solver.velocity().l2_norm();
+            if (if_ptc)
+                libMesh::out
+                << " :  CFL = "     << elem_ops.cfl();
+            libMesh::out
             << std::endl;
             
             // write the time-step
             if (output) {
                 
-                transient_output.write_timestep(transient_output_name,
-                                                *_eq_sys,
-                                                t_step+1,
-                                                _sys->time);
+                if (exodus_interval && t_step % exodus_interval == 0)
+                    transient_output.write_timestep(transient_output_name,
+                                                    *_eq_sys,
+                                                    t_step/exodus_interval+1,
+                                                    _sys->time);
                 std::ostringstream oss;
                 oss << output_name << "_sol_t_" << t_step;
                 _sys->write_out_vector(*_sys->solution, "data", oss.str(), true);
+                
+                if (hdf5_writer) {
+                    
+                    oss.str("");
+                    oss << "t_" << t_step;
+                    hdf5_writer->write(oss.str(),
+                                       _sys->time,
+                                       {"solution", "velocity"},
+                                       {&solver.solution(), &solver.velocity()});
+                }
             }
             
             // calculate the output quantity
@@ -1127,8 +1188,32 @@ public:
             //adjoint_output.write_timestep("adjoint.exo", *_eq_sys, t_step+1, _sys->time);
             //_sys->solution->swap(_sys->get_adjoint_solution(0));
             
-            // solve for the time-step
-            solver.solve(assembly);
+            // solve for the time-step. With pseudo-transient continuation
+            // a rejected step is repeated from the solution of the
+            // previous time-step with a reduced CFL number.
+            bool if_accepted = false;
+            while (!if_accepted) {
+                
+                solver.solve(assembly);
+                if_accepted = true;
+                
+                if (if_ptc) {
+                    
+                    _sys->update();
+                    std::unique_ptr<libMesh::NumericVector<Real>>
+                    vel(solver.velocity().zero_clone());
+                    solver.update_velocity(*vel, solver.solution());
+                    
+                    if_accepted = elem_ops.update_cfl(vel->l2_norm(),
+                                                      _sys->nonlinear_solver->converged);
+                    
+                    if (!if_accepted) {
+                        
+                        *_sys->solution = solver.solution(1);
+                        _sys->update();
+                    }
+                }
+            }
             solver.advance_time_step();
             
             // update time value
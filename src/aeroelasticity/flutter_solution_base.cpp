@@ -45,3 +45,21 @@ MAST::FlutterSolutionBase::swap_root(MAST::FlutterSolutionBase& sol,
 }
 
 
+
+
+
+Real
+MAST::FlutterSolutionBase::damping_slope(const MAST::FlutterSolutionBase& sol,
+                                         unsigned int root_num) const {
+    
+    libmesh_assert(root_num < _roots.size());
+    libmesh_assert(root_num < sol._roots.size());
+    
+    const Real
+    dref = _ref_val - sol._ref_val;
+    
+    if (dref == 0.)
+        return 0.;
+    
+    return (_roots[root_num]->g - sol._roots[root_num]->g)/dref;
+}
@@ -100,6 +100,15 @@ namespace MAST {
          */
         void swap_root(MAST::FlutterSolutionBase& sol,
                        unsigned int root_num);
+
+        
+        /*!
+         *    @returns the rate of change of damping of root \p root_num
+         *    with respect to the reference value of this solution, estimated
+         *    as a finite difference with the same root in \p sol.
+         */
+        Real damping_slope(const MAST::FlutterSolutionBase& sol,
+                           unsigned int root_num) const;
                 
         
         /*!
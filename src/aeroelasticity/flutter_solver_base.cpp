@@ -17,6 +17,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <algorithm>
+
+
 // MAST includes
 #include "aeroelasticity/flutter_solver_base.h"
 #include "aeroelasticity/flutter_solution_base.h"
@@ -34,7 +38,10 @@ MAST::FlutterSolverBase::FlutterSolverBase():
 _assembly(nullptr),
 _basis_vectors(nullptr),
 _output(nullptr),
-_steady_solver(nullptr) {
+_steady_solver(nullptr),
+_if_track_eigenpairs(false),
+_if_adaptive_scan(false),
+_adaptive_scan_levels(3) {
     
 }
 
@@ -106,3 +113,169 @@ initialize(std::vector<libMesh::NumericVector<Real> *>& basis) {
 
 
 
+
+
+
+void
+MAST::FlutterSolverBase::
+_adaptive_scan(const std::vector<Real>& vals,
+               const std::map<Real, MAST::FlutterSolutionBase*>& sols) {
+    
+    libmesh_assert_greater(vals.size(), 1);
+    
+    const unsigned int
+    n      = (unsigned int)vals.size()-1,
+    stride = 1u << _adaptive_scan_levels;
+    
+    // indices of the evaluated points in the uniform grid, sorted by the
+    // value of the sweep parameter so that they follow the order of sols
+    std::map<Real, unsigned int> pts;
+    
+    // indices of the new points, which are evaluated in the order of the
+    // scan
+    std::vector<unsigned int> new_pts;
+    
+    for (unsigned int i=0; i<n; i+=stride)
+        new_pts.push_back(i);
+    new_pts.push_back(n);
+    
+    std::vector<bool> refine;
+    
+    while (new_pts.size()) {
+        
+        for (unsigned int i=0; i<new_pts.size(); i++) {
+            
+            pts[vals[new_pts[i]]] = new_pts[i];
+            _analyze_scan_point(vals[new_pts[i]]);
+        }
+        
+        libmesh_assert_equal_to(sols.size(), pts.size());
+        
+        _adaptive_scan_intervals(sols, refine);
+        
+        // the marked intervals are bisected on the uniform grid
+        new_pts.clear();
+        
+        std::map<Real, unsigned int>::const_iterator
+        it  = pts.begin(),
+        nxt = pts.begin();
+        
+        for (unsigned int j=0; j<refine.size(); j++) {
+            
+            nxt++;
+            
+            const unsigned int
+            i0 = std::min(it->second, nxt->second),
+            i1 = std::max(it->second, nxt->second);
+            
+            if (refine[j] && i1 - i0 > 1)
+                new_pts.push_back((i0+i1)/2);
+            
+            it = nxt;
+        }
+        
+        std::sort(new_pts.begin(), new_pts.end());
+    }
+}
+
+
+
+void
+MAST::FlutterSolverBase::
+_adaptive_scan_intervals(const std::map<Real, MAST::FlutterSolutionBase*>& sols,
+                         std::vector<bool>& refine) const {
+    
+    refine.clear();
+    
+    if (sols.size() < 2)
+        return;
+    
+    // same limits as those used for identification of crossover points
+    const Real
+    max_allowable_g = 0.75,
+    mode_tol        = 0.9;
+    
+    const unsigned int
+    nvals = sols.begin()->second->n_roots();
+    
+    std::vector<MAST::FlutterSolutionBase*> s;
+    s.reserve(sols.size());
+    
+    std::map<Real, MAST::FlutterSolutionBase*>::const_iterator
+    it  = sols.begin(),
+    end = sols.end();
+    for ( ; it != end; it++)
+        s.push_back(it->second);
+    
+    const unsigned int n_int = (unsigned int)s.size()-1;
+    
+    refine.resize(n_int, false);
+    
+    for (unsigned int j=0; j<n_int; j++) {
+        
+        const MAST::FlutterSolutionBase
+        &a = *s[j],
+        &b = *s[j+1];
+        
+        for (unsigned int i=0; i<nvals && !refine[j]; i++) {
+            
+            const MAST::FlutterRootBase
+            &r_a = a.get_root(i),
+            &r_b = b.get_root(i);
+            
+            if (r_a.if_nonphysical_root ||
+                r_b.if_nonphysical_root ||
+                fabs(r_a.g) > max_allowable_g ||
+                fabs(r_b.g) > max_allowable_g)
+                continue;
+            
+            // a root crosses the zero damping axis in this interval
+            if ((r_a.g <= 0.) != (r_b.g <= 0.)) {
+                refine[j] = true;
+                continue;
+            }
+            
+            // a change in modal participation suggests that the roots
+            // have crossed and may be sorted incorrectly
+            const Real
+            mp_norm = r_a.modal_participation.norm() * r_b.modal_participation.norm();
+            
+            if (mp_norm > 0. &&
+                r_a.modal_participation.dot(r_b.modal_participation) <
+                mode_tol * mp_norm) {
+                refine[j] = true;
+                continue;
+            }
+            
+            // the damping slopes at the two ends, obtained from the
+            // neighboring intervals, are extrapolated into the interval
+            // to identify a possible pair of sign changes within the
+            // interval.
+            const Real
+            dref = b.ref_val() - a.ref_val();
+            
+            if (j > 0) {
+                
+                const Real g = r_a.g + a.damping_slope(*s[j-1], i) * dref;
+                if ((g <= 0.) != (r_a.g <= 0.))
+                    refine[j] = true;
+            }
+            
+            if (j+1 < n_int) {
+                
+                const Real g = r_b.g - s[j+2]->damping_slope(b, i) * dref;
+                if ((g <= 0.) != (r_b.g <= 0.))
+                    refine[j] = true;
+            }
+        }
+    }
+}
+
+
+
+void
+MAST::FlutterSolverBase::_analyze_scan_point(const Real val) {
+    
+    // should be implemented by solvers that use the adaptive scan
+    libmesh_error();
+}
@@ -24,6 +24,8 @@
 #include <string>
 #include <fstream>
 #include <iomanip>
+#include <map>
+#include <vector>
 
 
 // MAST includes
@@ -130,6 +132,38 @@ namespace MAST {
         }
         
         
+        /*!
+         *   If \p f is true, eigensolutions at successive reference values
+         *   are computed by tracking each root from the previous solution
+         *   with a Rayleigh-quotient inverse iteration on the reduced-order
+         *   pencil. This preserves the identity of each mode across the
+         *   sweep. The full eigensolution is computed only for the first
+         *   solution, or if tracking fails. This is false by default.
+         */
+        void set_eigen_tracking(bool f) {
+            _if_track_eigenpairs = f;
+        }
+        
+        
+        /*!
+         *   If \p f is true, the uniform grid of the scan is treated as the
+         *   finest grid of an adaptive scan. The scan starts from every
+         *   \f$ 2^{levels} \f$-th point of the uniform grid, and an interval
+         *   is bisected on the uniform grid if a root changes damping sign
+         *   in the interval, or if a damping sign change or a mode crossing
+         *   is suspected from the damping slopes and modal participation of
+         *   the bounding solutions. Crossings detected by the coarse grid
+         *   are therefore bracketed by the same interval as the uniform
+         *   scan, while intervals with no change in damping sign are not
+         *   evaluated at the finer levels.
+         */
+        void set_adaptive_scan(bool f,
+                               const unsigned int levels = 3) {
+            _if_adaptive_scan     = f;
+            _adaptive_scan_levels = levels;
+        }
+        
+        
         /*!
          *   Prints the sorted roots to the \p output
          */
@@ -145,6 +179,35 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   performs the adaptive scan on the uniform grid \p vals, given
+         *   in the order of the scan. Each point is evaluated with
+         *   \p _analyze_scan_point(), which is expected to add its solution
+         *   to \p sols.
+         */
+        void
+        _adaptive_scan(const std::vector<Real>& vals,
+                       const std::map<Real, MAST::FlutterSolutionBase*>& sols);
+        
+        
+        /*!
+         *   identifies the intervals between consecutive solutions in
+         *   \p sols that should be refined by the adaptive scan. On return,
+         *   \p refine has one entry per interval.
+         */
+        void
+        _adaptive_scan_intervals(const std::map<Real, MAST::FlutterSolutionBase*>& sols,
+                                 std::vector<bool>& refine) const;
+        
+        
+        /*!
+         *   computes the solution of the scan at the sweep parameter
+         *   \p val and stores it in the solver. This is used by
+         *   \p _adaptive_scan() and must be implemented by solvers that
+         *   support the adaptive scan.
+         */
+        virtual void _analyze_scan_point(const Real val);
+        
         
         /*!
          *   structural assembly that provides the assembly of the system
@@ -170,6 +233,26 @@ namespace MAST {
          */
         MAST::FlutterSolverBase::SteadySolver* _steady_solver;
         
+        
+        /*!
+         *    flag to enable tracking of eigenpairs between successive
+         *    eigensolutions
+         */
+        bool                                            _if_track_eigenpairs;
+        
+        
+        /*!
+         *    flag to enable the adaptive refinement of the scan
+         */
+        bool                                            _if_adaptive_scan;
+        
+        
+        /*!
+         *    number of bisection levels between the starting grid of the
+         *    adaptive scan and the uniform grid
+         */
+        unsigned int                                    _adaptive_scan_levels;
+        
     };
 }
 
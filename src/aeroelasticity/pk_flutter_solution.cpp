@@ -33,7 +33,7 @@ MAST::PKFlutterSolution::init (const MAST::PKFlutterSolver& solver,
                                const Real v_ref,
                                const Real bref,
                                const RealMatrixX& kmat,
-                               const LAPACK_ZGGEV& eig_sol) {
+                               const MAST::LAPACK_ZGGEV_Base& eig_sol) {
     
     // make sure that it hasn't already been initialized
     libmesh_assert(!_roots.size());
@@ -33,7 +33,7 @@ namespace MAST {
     
     // Forward declerations
     class PKFlutterSolver;
-    class LAPACK_ZGGEV;
+    class LAPACK_ZGGEV_Base;
     
     
     class PKFlutterSolution:
@@ -55,7 +55,7 @@ namespace MAST {
                            const Real v_ref,
                            const Real bref,
                            const RealMatrixX& kmat,
-                           const MAST::LAPACK_ZGGEV& eig_sol);
+                           const MAST::LAPACK_ZGGEV_Base& eig_sol);
 
         /*!
          *    sort this root with respect to the given solution from a previous
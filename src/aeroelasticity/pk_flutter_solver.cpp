@@ -25,6 +25,7 @@
 #include "aeroelasticity/pk_flutter_root_crossover.h"
 #include "elasticity/fsi_generalized_aero_force_assembly.h"
 #include "numerics/lapack_zggev_interface.h"
+#include "numerics/generalized_eigen_tracker.h"
 #include "base/parameter.h"
 
 
@@ -156,6 +157,27 @@ MAST::PKFlutterSolver::scan_for_roots() {
         }
         k_red_vals[_n_k_red_divs] = _kr_range.first; // to get around finite-precision arithmetic
         
+        if (_if_adaptive_scan) {
+            
+            // the velocity grid is refined on the union of the points of
+            // all reduced frequencies, so that each velocity in the scan
+            // is analyzed at every reduced frequency.
+            Real current_v_ref = _V_range.first,
+            delta_v_ref = (_V_range.second-_V_range.first)/_n_V_divs;
+            
+            std::vector<Real> v_ref_vals(_n_V_divs+1);
+            for (unsigned int i=0; i<_n_V_divs+1; i++) {
+                v_ref_vals[i] = current_v_ref;
+                current_v_ref += delta_v_ref;
+            }
+            v_ref_vals[_n_V_divs] = _V_range.second; // to get around finite-precision arithmetic
+            
+            _scan_k_red_vals = k_red_vals;
+            _adaptive_scan(v_ref_vals, _flutter_solutions);
+            _identify_crossover_points();
+            return;
+        }
+        
         //
         //  outer loop is on reduced frequency
         //
@@ -209,6 +231,32 @@ MAST::PKFlutterSolver::scan_for_roots() {
 
 
 
+void
+MAST::PKFlutterSolver::_analyze_scan_point(const Real v_ref) {
+    
+    // the solution at the next lower velocity is used for sorting
+    std::map<Real, MAST::FlutterSolutionBase*>::const_iterator
+    it = _flutter_solutions.lower_bound(v_ref);
+    
+    const MAST::FlutterSolutionBase*
+    prev_sol = it != _flutter_solutions.begin()? (--it)->second: nullptr;
+    
+    for (unsigned int j=0; j<_scan_k_red_vals.size(); j++) {
+        
+        std::unique_ptr<MAST::FlutterSolutionBase> sol =
+        _analyze(_scan_k_red_vals[j],
+                 v_ref,
+                 prev_sol);
+        
+        if (_output)
+            sol->print(*_output);
+        
+        _insert_new_solution(_scan_k_red_vals[j], sol.release());
+    }
+}
+
+
+
 void
 MAST::PKFlutterSolver::print_sorted_roots()
 {
@@ -850,16 +898,51 @@ MAST::PKFlutterSolver::_analyze(const Real k_red,
     << "   V_ref = " << std::setw(10) << v_ref << std::endl;
     
     _initialize_matrices(k_red, v_ref, L, R, stiff);
-    LAPACK_ZGGEV ges;
-    ges.compute(L, R);
-    ges.scale_eigenvectors_to_identity_innerproduct();
+    
+    MAST::GeneralizedEigenTracker tracker;
+    bool if_tracked = false;
+    
+    if (prev_sol && _if_track_eigenpairs) {
+        
+        // the roots only store the structural part of the right
+        // eigenvectors, X. The state-space vector is {X, pX}.
+        const unsigned int
+        n     = prev_sol->n_roots(),
+        n_dof = n/2;
+        
+        ComplexVectorX
+        eig0  = ComplexVectorX::Zero(n);
+        ComplexMatrixX
+        VR0   = ComplexMatrixX::Zero(n, n);
+        
+        for (unsigned int i=0; i<n; i++) {
+            
+            const MAST::FlutterRootBase& r = prev_sol->get_root(i);
+            eig0(i)                    = r.root;
+            VR0.col(i).topRows(n_dof)    = r.eig_vec_right;
+            VR0.col(i).bottomRows(n_dof) = r.root * r.eig_vec_right;
+        }
+        
+        if_tracked = tracker.track(L, R, eig0, VR0);
+        
+        if (!if_tracked)
+            libMesh::out
+            << "Eigenpair tracking failed, computing full eigensolution"
+            << std::endl;
+    }
+    
+    if (!if_tracked)
+        tracker.compute(L, R);
+    tracker.scale_eigenvectors_to_identity_innerproduct();
     
     MAST::PKFlutterSolution* root = new MAST::PKFlutterSolution;
     root->init(*this,
                k_red, v_ref,
                (*_bref_param)(),
-               stiff, ges);
-    if (prev_sol)
+               stiff, tracker);
+    
+    // tracked roots are already in the order of the previous solution
+    if (prev_sol && !if_tracked)
         root->sort(*prev_sol);
     
     libMesh::out
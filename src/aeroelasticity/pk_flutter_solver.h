@@ -142,6 +142,13 @@ namespace MAST {
                                   MAST::FlutterSolutionBase* sol);
         
         
+        /*!
+         *   analyzes the velocity \p v_ref at all reduced frequencies of
+         *   the scan for the adaptive scan
+         */
+        virtual void _analyze_scan_point(const Real v_ref);
+        
+        
         virtual std::pair<bool, MAST::FlutterSolutionBase*>
         _bisection_search(const std::pair<MAST::FlutterSolutionBase*,
                           MAST::FlutterSolutionBase*>& ref_sol_range,
@@ -244,6 +251,12 @@ namespace MAST {
          */
         unsigned int                                    _n_k_red_divs;
         
+        /*!
+         *    reduced frequencies analyzed at each velocity of the adaptive
+         *    scan
+         */
+        std::vector<Real>                               _scan_k_red_vals;
+        
         /*!
          *   map of velocity sorted flutter solutions
          */
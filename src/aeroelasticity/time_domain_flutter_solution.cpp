@@ -25,6 +25,7 @@
 #include "aeroelasticity/time_domain_flutter_solution.h"
 #include "aeroelasticity/time_domain_flutter_root.h"
 #include "numerics/lapack_dggev_interface.h"
+#include "numerics/lapack_zggev_base.h"
 
 
 MAST::TimeDomainFlutterSolution::TimeDomainFlutterSolution():
@@ -81,6 +82,45 @@ MAST::TimeDomainFlutterSolution::init (const MAST::TimeDomainFlutterSolver& solv
 
 
 
+void
+MAST::TimeDomainFlutterSolution::init (const MAST::TimeDomainFlutterSolver& solver,
+                                       const Real v_ref,
+                                       const MAST::LAPACK_ZGGEV_Base& eig_sol) {
+    
+    // make sure that it hasn't already been initialized
+    libmesh_assert(!_roots.size());
+    
+    _ref_val           = v_ref;
+    
+    // the pencil is real, so only the real part is retained
+    _Amat              = eig_sol.A().real();
+    _Bmat              = eig_sol.B().real();
+    const ComplexMatrixX
+    &VR                = eig_sol.right_eigenvectors(),
+    &VL                = eig_sol.left_eigenvectors();
+    const ComplexVectorX
+    &num               = eig_sol.alphas(),
+    &den               = eig_sol.betas();
+    
+    unsigned int nvals = (int)_Bmat.rows();
+    
+    _roots.resize(nvals);
+    for (unsigned int i=0; i<nvals; i++) {
+        
+        MAST::TimeDomainFlutterRoot* root = new MAST::TimeDomainFlutterRoot;
+        root->init(v_ref,
+                   num(i),
+                   den(i),
+                   _Bmat,
+                   VR.col(i),
+                   VL.col(i));
+        
+        _roots[i] = root;
+    }
+}
+
+
+
 unsigned int
 MAST::TimeDomainFlutterSolution::
 n_unstable_roots_in_upper_complex_half (Real tol) const {
@@ -33,6 +33,7 @@ namespace MAST {
     // Forward declerations
     class TimeDomainFlutterSolver;
     class LAPACK_DGGEV;
+    class LAPACK_ZGGEV_Base;
 
     
     class TimeDomainFlutterSolution:
@@ -54,6 +55,14 @@ namespace MAST {
                    const Real v_ref,
                    const MAST::LAPACK_DGGEV& eig_sol);
         
+        /*!
+         *   initializes the root from an eigensolution of the real
+         *   pencil computed in complex arithmetic
+         */
+        void init (const MAST::TimeDomainFlutterSolver& solver,
+                   const Real v_ref,
+                   const MAST::LAPACK_ZGGEV_Base& eig_sol);
+        
         /*!
          *   number of unstable roots in this solution. Only roots with damping
          *   greater than \p tol will be considered unstable.
@@ -27,6 +27,7 @@
 #include "base/physics_discipline_base.h"
 #include "base/boundary_condition_base.h"
 #include "numerics/lapack_dggev_interface.h"
+#include "numerics/generalized_eigen_tracker.h"
 #include "base/parameter.h"
 #include "base/nonlinear_system.h"
 
@@ -652,14 +653,54 @@ MAST::TimeDomainFlutterSolver::_analyze(const Real v_ref,
     // initialize the matrices for the structure.
     _initialize_matrices(v_ref, A, B);
     
-    MAST::LAPACK_DGGEV ges;
-    ges.compute(A, B);
-    ges.scale_eigenvectors_to_identity_innerproduct();
-    
     MAST::TimeDomainFlutterSolution* root = new MAST::TimeDomainFlutterSolution;
-    root->init(*this, v_ref, ges);
-    if (prev_sol)
-        root->sort(*prev_sol);
+    bool if_tracked = false;
+    
+    if (prev_sol && _if_track_eigenpairs) {
+        
+        const unsigned int
+        n     = prev_sol->n_roots();
+        
+        ComplexVectorX
+        eig0  = ComplexVectorX::Zero(n);
+        ComplexMatrixX
+        VR0   = ComplexMatrixX::Zero(n, n),
+        VL0   = ComplexMatrixX::Zero(n, n);
+        
+        for (unsigned int i=0; i<n; i++) {
+            
+            const MAST::FlutterRootBase& r = prev_sol->get_root(i);
+            eig0(i)     = r.root;
+            VR0.col(i)  = r.eig_vec_right;
+            VL0.col(i)  = r.eig_vec_left;
+        }
+        
+        MAST::GeneralizedEigenTracker tracker;
+        if_tracked = tracker.track(A.cast<Complex>(), B.cast<Complex>(),
+                                   eig0, VR0, &VL0);
+        
+        if (if_tracked) {
+            
+            tracker.scale_eigenvectors_to_identity_innerproduct();
+            root->init(*this, v_ref, tracker);
+        }
+        else
+            libMesh::out
+            << "Eigenpair tracking failed, computing full eigensolution"
+            << std::endl;
+    }
+    
+    if (!if_tracked) {
+        
+        MAST::LAPACK_DGGEV ges;
+        ges.compute(A, B);
+        ges.scale_eigenvectors_to_identity_innerproduct();
+        
+        root->init(*this, v_ref, ges);
+        
+        if (prev_sol)
+            root->sort(*prev_sol);
+    }
     
     libMesh::out
     << "Finished Eigensolution" << std::endl
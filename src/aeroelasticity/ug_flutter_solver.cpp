@@ -28,6 +28,7 @@
 #include "base/physics_discipline_base.h"
 #include "base/boundary_condition_base.h"
 #include "numerics/lapack_zggev_interface.h"
+#include "numerics/generalized_eigen_tracker.h"
 #include "base/parameter.h"
 #include "base/nonlinear_system.h"
 
@@ -275,6 +276,13 @@ MAST::UGFlutterSolver::scan_for_roots() {
         }
         k_vals[_n_kr_divs] = _kr_range.first; // to get around finite-precision arithmetic
         
+        if (_if_adaptive_scan) {
+            
+            _adaptive_scan(k_vals, _flutter_solutions);
+            _identify_crossover_points();
+            return;
+        }
+        
         MAST::FlutterSolutionBase* prev_sol = nullptr;
         for (unsigned int i=0; i< _n_kr_divs+1; i++) {
             
@@ -302,6 +310,30 @@ MAST::UGFlutterSolver::scan_for_roots() {
 
 
 
+void
+MAST::UGFlutterSolver::_analyze_scan_point(const Real kr) {
+    
+    // the scan marches from higher to lower kr, so the solution at the
+    // next higher kr is used for sorting.
+    std::map<Real, MAST::FlutterSolutionBase*>::const_iterator
+    it = _flutter_solutions.upper_bound(kr);
+    
+    std::unique_ptr<MAST::FlutterSolutionBase> sol =
+    _analyze(kr, it != _flutter_solutions.end()? it->second: nullptr);
+    
+    if (_output)
+        sol->print(*_output);
+    
+    bool if_success =
+    _flutter_solutions.insert(std::pair<Real, MAST::FlutterSolutionBase*>
+                              (kr, sol.release())).second;
+    
+    libmesh_assert(if_success);
+}
+
+
+
+
 
 void
 MAST::UGFlutterSolver::print_sorted_roots()
@@ -498,13 +530,45 @@ MAST::UGFlutterSolver::_analyze(const Real kr_ref,
     // initialize the matrices for the structure.
     _initialize_matrices(kr_ref, A, B);
     
-    MAST::LAPACK_ZGGEV ges;
-    ges.compute(A, B);
-    ges.scale_eigenvectors_to_identity_innerproduct();
+    MAST::GeneralizedEigenTracker tracker;
+    bool if_tracked = false;
+    
+    if (prev_sol && _if_track_eigenpairs) {
+        
+        const unsigned int
+        n     = prev_sol->n_roots();
+        
+        ComplexVectorX
+        eig0  = ComplexVectorX::Zero(n);
+        ComplexMatrixX
+        VR0   = ComplexMatrixX::Zero(n, n),
+        VL0   = ComplexMatrixX::Zero(n, n);
+        
+        for (unsigned int i=0; i<n; i++) {
+            
+            const MAST::FlutterRootBase& r = prev_sol->get_root(i);
+            eig0(i)     = r.root;
+            VR0.col(i)  = r.eig_vec_right;
+            VL0.col(i)  = r.eig_vec_left;
+        }
+        
+        if_tracked = tracker.track(A, B, eig0, VR0, &VL0);
+        
+        if (!if_tracked)
+            libMesh::out
+            << "Eigenpair tracking failed, computing full eigensolution"
+            << std::endl;
+    }
+    
+    if (!if_tracked)
+        tracker.compute(A, B);
+    tracker.scale_eigenvectors_to_identity_innerproduct();
     
     MAST::UGFlutterSolution* root = new MAST::UGFlutterSolution;
-    root->init(*this, kr_ref, (*_bref_param)(), ges);
-    if (prev_sol)
+    root->init(*this, kr_ref, (*_bref_param)(), tracker);
+    
+    // tracked roots are already in the order of the previous solution
+    if (prev_sol && !if_tracked)
         root->sort(*prev_sol);
     
     libMesh::out
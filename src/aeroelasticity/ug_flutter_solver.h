@@ -166,6 +166,12 @@ namespace MAST {
                  const MAST::FlutterSolutionBase* prev_sol=nullptr);
         
         
+        /*!
+         *   analyzes the reduced frequency \p kr for the adaptive scan
+         */
+        virtual void _analyze_scan_point(const Real kr);
+        
+        
         
         /*!
          *    bisection method search
@@ -29,6 +29,7 @@
 #include "mesh/fe_base.h"
 #include "mesh/geom_elem.h"
 #include "numerics/utility.h"
+#include "utility/assembly_profiler.h"
 
 
 // libMesh includes
@@ -179,6 +180,7 @@ clear_discipline_and_system() {
     _discipline       = nullptr;
     _system           = nullptr;
     _param_dependence = nullptr;
+    _localized_vectors.clear();
 }
 
 
@@ -211,6 +213,8 @@ MAST::AssemblyBase::
 build_localized_vector(const libMesh::System& sys,
                        const libMesh::NumericVector<Real>& global) const {
     
+    MAST::AssemblyProfiler::Scope profile(MAST::AssemblyProfiler::LOCALIZATION);
+    
     libMesh::NumericVector<Real>* local =
     libMesh::NumericVector<Real>::build(sys.comm()).release();
     
@@ -224,11 +228,42 @@ build_localized_vector(const libMesh::System& sys,
                 libMesh::GHOSTED);
     global.localize(*local, send_list);
     
+    MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::LOCALIZED_VECTORS);
+    MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::LOCALIZED_ENTRIES,
+                                  sys.n_local_dofs() + send_list.size());
+    
     return std::unique_ptr<libMesh::NumericVector<Real> >(local);
 }
 
 
 
+const libMesh::NumericVector<Real>&
+MAST::AssemblyBase::localized_vector(const libMesh::System& sys,
+                                     const libMesh::NumericVector<Real>& global,
+                                     const std::string& role) {
+    
+    return _localized_vectors.localize(sys, global, role);
+}
+
+
+
+void
+MAST::AssemblyBase::release_localized_vector(const libMesh::System& sys,
+                                             const std::string& role) {
+    
+    _localized_vectors.release(sys, role);
+}
+
+
+
+void
+MAST::AssemblyBase::clear_localized_vectors() {
+    
+    _localized_vectors.clear();
+}
+
+
+
 
 void
 MAST::AssemblyBase::attach_solution_function(MAST::MeshFieldFunction& f){
@@ -259,6 +294,9 @@ MAST::AssemblyBase::calculate_output(const libMesh::NumericVector<Real>& X,
     libmesh_assert(_system);
     
     MAST::NonlinearSystem& nonlin_sys = _system->system();
+    MAST::AssemblyProfiler::Scope
+    profile("AssemblyBase::calculate_output");
+    
     output.set_assembly(*this);
     
     output.zero_for_analysis();
@@ -273,11 +311,8 @@ MAST::AssemblyBase::calculate_output(const libMesh::NumericVector<Real>& X,
     const libMesh::NumericVector<Real>*
     sol_vec = nullptr;
     
-    std::unique_ptr<libMesh::NumericVector<Real> > localized_solution;
-    if (if_localize_sol) {
-        localized_solution.reset(build_localized_vector(nonlin_sys, X).release());
-        sol_vec = localized_solution.get();
-    }
+    if (if_localize_sol)
+        sol_vec = &localized_vector(nonlin_sys, X, "solution");
     else
         sol_vec = &X;
     
@@ -302,9 +337,16 @@ MAST::AssemblyBase::calculate_output(const libMesh::NumericVector<Real>& X,
         //if (_sol_function)
         //    physics_elem->attach_active_solution_function(*_sol_function);
         
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         MAST::GeomElem geom_elem;
-        output.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
+        
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            output.set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+        }
         
         if (!output.if_evaluate_for_element(geom_elem)) continue;
         
@@ -317,9 +359,18 @@ MAST::AssemblyBase::calculate_output(const libMesh::NumericVector<Real>& X,
         for (unsigned int i=0; i<dof_indices.size(); i++)
             sol(i) = (*sol_vec)(dof_indices[i]);
         
-        output.init(geom_elem);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            output.init(geom_elem);
+        }
+        
         output.set_elem_solution(sol);
-        output.evaluate();
+        
+        {
+            MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+            output.evaluate();
+        }
+        
         output.clear_elem();
 
         //physics_elem->detach_active_solution_function();
@@ -342,32 +393,57 @@ calculate_output_derivative(const libMesh::NumericVector<Real>& X,
                             MAST::OutputAssemblyElemOperations& output,
                             libMesh::NumericVector<Real>& dq_dX) {
     
+    std::vector<MAST::OutputAssemblyElemOperations*>
+    outputs(1, &output);
+    
+    std::vector<libMesh::NumericVector<Real>*>
+    dq_dX_vecs(1, &dq_dX);
+    
+    this->calculate_output_derivatives(X, if_localize_sol, outputs, dq_dX_vecs);
+}
+
+
+
+void
+MAST::AssemblyBase::
+calculate_output_derivatives(const libMesh::NumericVector<Real>& X,
+                             bool if_localize_sol,
+                             const std::vector<MAST::OutputAssemblyElemOperations*>& outputs,
+                             const std::vector<libMesh::NumericVector<Real>*>& dq_dX) {
+    
     libmesh_assert(_discipline);
     libmesh_assert(_system);
+    libmesh_assert_equal_to(outputs.size(), dq_dX.size());
+    
+    if (outputs.empty())
+        return;
 
-    output.zero_for_sensitivity();
+    MAST::AssemblyProfiler::Scope
+    profile("AssemblyBase::calculate_output_derivative");
     
     MAST::NonlinearSystem& nonlin_sys = _system->system();
-    output.set_assembly(*this);
     
-    dq_dX.zero();
+    for (unsigned int i=0; i<outputs.size(); i++) {
+        
+        outputs[i]->zero_for_sensitivity();
+        outputs[i]->set_assembly(*this);
+        dq_dX[i]->zero();
+    }
     
     // iterate over each element, initialize it and get the relevant
     // analysis quantities
     RealVectorX vec, sol;
     
-    std::vector<libMesh::dof_id_type> dof_indices;
+    // the constraint of the element vector can modify the dof indices,
+    // so these are copied for each output
+    std::vector<libMesh::dof_id_type> dof_indices, output_dof_indices;
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
     
     const libMesh::NumericVector<Real>*
     sol_vec = nullptr;
     
-    std::unique_ptr<libMesh::NumericVector<Real> > localized_solution;
-    
-    if (if_localize_sol) {
-        localized_solution.reset(build_localized_vector(nonlin_sys, X).release());
-        sol_vec = localized_solution.get();
-    }
+    if (if_localize_sol)
+        sol_vec = &localized_vector(nonlin_sys, X, "solution");
     else
         sol_vec = &X;
     
@@ -389,44 +465,88 @@ calculate_output_derivative(const libMesh::NumericVector<Real>& X,
         if (diagonal_elem_subdomain_id.count(elem->subdomain_id()))
             continue;
         
-        MAST::GeomElem geom_elem;
-        output.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
-
-        if (!output.if_evaluate_for_element(geom_elem)) continue;
-
-        dof_map.dof_indices (elem, dof_indices);
-        
-        // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
-        vec.setZero(ndofs);
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
         
-        for (unsigned int i=0; i<dof_indices.size(); i++)
-            sol(i) = (*sol_vec)(dof_indices[i]);
+        MAST::GeomElem geom_elem;
         
-        //        if (_sol_function)
-        //            physics_elem->attach_active_solution_function(*_sol_function);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            outputs[0]->set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+        }
 
-        output.init(geom_elem);
-        output.set_elem_solution(sol);
-        output.output_derivative_for_elem(vec);
-        output.clear_elem();
-        
-        DenseRealVector v;
-        MAST::copy(v, vec);
-        dof_map.constrain_element_vector(v, dof_indices);
-        dq_dX.add_vector(v, dof_indices);
+        // the element solution is read only if at least one output
+        // is evaluated on this element
         dof_indices.clear();
+        
+        for (unsigned int i=0; i<outputs.size(); i++) {
+            
+            MAST::OutputAssemblyElemOperations& output = *outputs[i];
+            
+            if (!output.if_evaluate_for_element(geom_elem)) continue;
+
+            if (dof_indices.empty()) {
+                
+                dof_map.dof_indices (elem, dof_indices);
+                
+                // get the solution
+                sol.setZero(dof_indices.size());
+                
+                for (unsigned int j=0; j<dof_indices.size(); j++)
+                    sol(j) = (*sol_vec)(dof_indices[j]);
+            }
+            
+            vec.setZero(dof_indices.size());
+            
+            //        if (_sol_function)
+            //            physics_elem->attach_active_solution_function(*_sol_function);
+            
+            {
+                MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+                output.init(geom_elem);
+            }
+            
+            output.set_elem_solution(sol);
+            
+            {
+                MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+                output.output_derivative_for_elem(vec);
+            }
+            
+            output.clear_elem();
+            
+            DenseRealVector v;
+            MAST::copy(v, vec);
+            output_dof_indices = dof_indices;
+            
+            {
+                MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+                dof_map.constrain_element_vector(v, output_dof_indices);
+            }
+            
+            {
+                MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+                dq_dX[i]->add_vector(v, output_dof_indices);
+            }
+            
+            MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::VECTOR_ENTRIES_ADDED,
+                                          output_dof_indices.size());
+        }
     }
     
     // if a solution function is attached, clear it
     if (_sol_function)
         _sol_function->clear();
     
-    dq_dX.close();
+    {
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        for (unsigned int i=0; i<dq_dX.size(); i++)
+            dq_dX[i]->close();
+    }
     
-    output.clear_assembly();
+    for (unsigned int i=0; i<outputs.size(); i++)
+        outputs[i]->clear_assembly();
 }
 
 
@@ -443,6 +563,9 @@ calculate_output_direct_sensitivity(const libMesh::NumericVector<Real>& X,
     libmesh_assert(_discipline);
     libmesh_assert(_system);
 
+    MAST::AssemblyProfiler::Scope
+    profile("AssemblyBase::calculate_output_direct_sensitivity");
+    
     output.zero_for_sensitivity();
 
     MAST::NonlinearSystem& nonlin_sys = _system->system();
@@ -461,22 +584,14 @@ calculate_output_direct_sensitivity(const libMesh::NumericVector<Real>& X,
     *sol_vec  = nullptr,
     *dsol_vec = nullptr;
     
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_solution_sens;
-    
-    if (if_localize_sol) {
-        localized_solution.reset(build_localized_vector(nonlin_sys, X).release());
-        sol_vec = localized_solution.get();
-    }
+    if (if_localize_sol)
+        sol_vec = &localized_vector(nonlin_sys, X, "solution");
     else
         sol_vec = &X;
     
     if (dXdp) {
-        if (if_localize_sol_sens) {
-            localized_solution_sens.reset(build_localized_vector(nonlin_sys, *dXdp).release());
-            dsol_vec = localized_solution_sens.get();
-        }
+        if (if_localize_sol_sens)
+            dsol_vec = &localized_vector(nonlin_sys, *dXdp, "solution_sensitivity");
         else
             dsol_vec = dXdp;
     }
@@ -510,9 +625,16 @@ calculate_output_direct_sensitivity(const libMesh::NumericVector<Real>& X,
              (dXdp && _param_dependence->override_flag)))
             continue;
             
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         MAST::GeomElem geom_elem;
-        output.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
+        
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            output.set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+        }
 
         if (!output.if_evaluate_for_element(geom_elem)) continue;
         
@@ -533,10 +655,19 @@ calculate_output_direct_sensitivity(const libMesh::NumericVector<Real>& X,
         //            physics_elem->attach_active_solution_function(*_sol_function);
         
 
-        output.init(geom_elem);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            output.init(geom_elem);
+        }
+        
         output.set_elem_solution(sol);
         output.set_elem_solution_sensitivity(dsol);
-        output.evaluate_sensitivity(p);
+        
+        {
+            MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+            output.evaluate_sensitivity(p);
+        }
+        
         output.clear_elem();
         
         //        physics_elem->detach_active_solution_function();
@@ -567,6 +698,9 @@ calculate_output_adjoint_sensitivity(const libMesh::NumericVector<Real>& X,
     
     MAST::NonlinearSystem& nonlin_sys = _system->system();
 
+    MAST::AssemblyProfiler::Scope
+    profile("AssemblyBase::calculate_output_adjoint_sensitivity");
+    
     libMesh::NumericVector<Real>
     &dres_dp = nonlin_sys.add_sensitivity_rhs();
     
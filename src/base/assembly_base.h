@@ -23,10 +23,12 @@
 // C++ includes
 #include <map>
 #include <memory>
+#include <vector>
 
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "base/localized_vector_pool.h"
 
 
 // libMesh includes
@@ -270,6 +272,22 @@ namespace MAST {
                                     libMesh::NumericVector<Real>& dq_dX);
 
         
+        /*!
+         *   calculates \f$ \frac{\partial q_i(X, p)}{\partial X} \f$ for
+         *   all outputs in \p outputs in a single pass over the elements,
+         *   and returns the derivative of the i-th output in \p dq_dX[i].
+         *   The geometric element and the element solution are initialized
+         *   once per element and shared by all outputs, using the element
+         *   data of the first output. Hence, all outputs should be defined
+         *   for the same discipline.
+         */
+        virtual void
+        calculate_output_derivatives(const libMesh::NumericVector<Real>& X,
+                                     bool if_localize_sol,
+                                     const std::vector<MAST::OutputAssemblyElemOperations*>& outputs,
+                                     const std::vector<libMesh::NumericVector<Real>*>& dq_dX);
+
+        
         /*!
          *   evaluates the sensitivity of the outputs in the attached
          *   discipline with respect to the parametrs in \p params.
@@ -331,6 +349,34 @@ namespace MAST {
                                const libMesh::NumericVector<Real>& global) const;
         
         
+        /*!
+         *   @returns a localized copy of \p global for the element
+         *   calculations, stored by this object for \p sys and \p role
+         *   and reused across calls. \p global is returned without a copy
+         *   if it already provides the ghost entries. The reference is
+         *   valid until the next call with the same \p role.
+         *   See \p MAST::LocalizedVectorPool.
+         */
+        const libMesh::NumericVector<Real>&
+        localized_vector(const libMesh::System& sys,
+                         const libMesh::NumericVector<Real>& global,
+                         const std::string& role);
+        
+        
+        /*!
+         *   deletes the localized vector stored for \p sys and \p role.
+         */
+        void release_localized_vector(const libMesh::System& sys,
+                                      const std::string& role);
+        
+        
+        /*!
+         *   deletes the localized vectors stored by this object. These are
+         *   also deleted by \p clear_discipline_and_system().
+         */
+        void clear_localized_vectors();
+        
+        
     protected:
         
         /*!
@@ -367,6 +413,11 @@ namespace MAST {
          *   an element. This can be used to enhance computational efficiency.
          */
         MAST::AssemblyBase::ElemParameterDependence *_param_dependence;
+        
+        /*!
+         *   localized vectors reused across assembly calls
+         */
+        MAST::LocalizedVectorPool _localized_vectors;
     };
         
 }
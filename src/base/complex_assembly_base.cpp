@@ -29,6 +29,7 @@
 #include "mesh/geom_elem.h"
 #include "numerics/utility.h"
 #include "solver/complex_solver_base.h"
+#include "utility/assembly_profiler.h"
 
 
 // libMesh includes
@@ -111,6 +112,9 @@ MAST::ComplexAssemblyBase::residual_l2_norm(const libMesh::NumericVector<Real>&
                                             const libMesh::NumericVector<Real>& imag) {
     
     START_LOG("complex_solve()", "Residual-L2");
+    
+    MAST::AssemblyProfiler::Scope
+    profile("ComplexAssemblyBase::residual_l2_norm");
 
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
@@ -134,15 +138,16 @@ MAST::ComplexAssemblyBase::residual_l2_norm(const libMesh::NumericVector<Real>&
     
     std::unique_ptr<libMesh::NumericVector<Real> >
     residual_re(nonlin_sys.solution->zero_clone().release()),
-    residual_im(nonlin_sys.solution->zero_clone().release()),
-    localized_base_solution,
-    localized_real_solution(build_localized_vector(nonlin_sys, real).release()),
-    localized_imag_solution(build_localized_vector(nonlin_sys, imag).release());
+    residual_im(nonlin_sys.solution->zero_clone().release());
+    
+    const libMesh::NumericVector<Real>
+    *localized_base_solution = nullptr,
+    *localized_real_solution = &localized_vector(nonlin_sys, real, "real_solution"),
+    *localized_imag_solution = &localized_vector(nonlin_sys, imag, "imag_solution");
     
     
     if (_base_sol)
-        localized_base_solution.reset(build_localized_vector(nonlin_sys,
-                                                              *_base_sol).release());
+        localized_base_solution = &localized_vector(nonlin_sys, *_base_sol, "base_solution");
 
     
     // if a solution function is attached, initialize it
@@ -162,13 +167,20 @@ MAST::ComplexAssemblyBase::residual_l2_norm(const libMesh::NumericVector<Real>&
         
         const libMesh::Elem* elem = *el;
         
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         dof_map.dof_indices (elem, dof_indices);
         
         MAST::GeomElem geom_elem;
-        ops.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
         
-        ops.init(geom_elem);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            ops.set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+            
+            ops.init(geom_elem);
+        }
         
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -199,8 +211,11 @@ MAST::ComplexAssemblyBase::residual_l2_norm(const libMesh::NumericVector<Real>&
         
         
         // perform the element level calculations
-        ops.elem_calculations(false,
-                                             vec, mat);
+        {
+            MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+            ops.elem_calculations(false,
+                                  vec, mat);
+        }
         ops.clear_elem();
         
 //        ops.detach_active_solution_function();
@@ -254,6 +269,9 @@ residual_and_jacobian_field_split (const libMesh::NumericVector<Real>& X_R,
     libmesh_assert(_discipline);
     libmesh_assert(_elem_ops);
 
+    MAST::AssemblyProfiler::Scope
+    profile("ComplexAssemblyBase::residual_and_jacobian_field_split");
+    
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
     R_R.zero();
@@ -272,24 +290,21 @@ residual_and_jacobian_field_split (const libMesh::NumericVector<Real>& X_R,
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
     
     
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_base_solution,
-    localized_real_solution,
-    localized_imag_solution;
+    const libMesh::NumericVector<Real>
+    *localized_base_solution = nullptr,
+    *localized_real_solution = nullptr,
+    *localized_imag_solution = nullptr;
     
     
     // localize the base solution, if it was provided
     if (_base_sol)
-        localized_base_solution.reset(build_localized_vector(nonlin_sys,
-                                                              *_base_sol).release());
+        localized_base_solution = &localized_vector(nonlin_sys, *_base_sol, "base_solution");
     
     
     // localize sol to real vector
-    localized_real_solution.reset(build_localized_vector(nonlin_sys,
-                                                              X_R).release());
+    localized_real_solution = &localized_vector(nonlin_sys, X_R, "real_solution");
     // localize sol to imag vector
-    localized_imag_solution.reset(build_localized_vector(nonlin_sys,
-                                                              X_I).release());
+    localized_imag_solution = &localized_vector(nonlin_sys, X_I, "imag_solution");
     
     
     // if a solution function is attached, initialize it
@@ -309,13 +324,20 @@ residual_and_jacobian_field_split (const libMesh::NumericVector<Real>& X_R,
         
         const libMesh::Elem* elem = *el;
         
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         dof_map.dof_indices (elem, dof_indices);
         
         MAST::GeomElem geom_elem;
-        ops.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
         
-        ops.init(geom_elem);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            ops.set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+            
+            ops.init(geom_elem);
+        }
 
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -347,9 +369,12 @@ residual_and_jacobian_field_split (const libMesh::NumericVector<Real>& X_R,
         
         
         // perform the element level calculations
-        ops.elem_calculations(true,
-                                             vec,
-                                             mat);
+        {
+            MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+            ops.elem_calculations(true,
+                                  vec,
+                                  mat);
+        }
         ops.clear_elem();
 
         vec *= -1.;
@@ -370,9 +395,15 @@ residual_and_jacobian_field_split (const libMesh::NumericVector<Real>& X_R,
         MAST::copy(v, vec.real());
         MAST::copy(m, mat.real());
         
-        dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
-        R_R.add_vector(v, dof_indices);
-        J_R.add_matrix(m, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+            dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
+        }
+        {
+            MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+            R_R.add_vector(v, dof_indices);
+            J_R.add_matrix(m, dof_indices);
+        }
 
         
         // copy the imag part of the residual and Jacobian
@@ -381,9 +412,20 @@ residual_and_jacobian_field_split (const libMesh::NumericVector<Real>& X_R,
         MAST::copy(v, vec.imag());
         MAST::copy(m, mat.imag());
         
-        dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
-        R_I.add_vector(v, dof_indices);
-        J_I.add_matrix(m, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+            dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
+        }
+        {
+            MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+            R_I.add_vector(v, dof_indices);
+            J_I.add_matrix(m, dof_indices);
+        }
+        
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::VECTOR_ENTRIES_ADDED,
+                                      2*dof_indices.size());
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::MATRIX_ENTRIES_ADDED,
+                                      2*dof_indices.size()*dof_indices.size());
         dof_indices.clear();
     }
     
@@ -392,10 +434,13 @@ residual_and_jacobian_field_split (const libMesh::NumericVector<Real>& X_R,
     //if (_sol_function)
     //    _sol_function->clear();
     
-    R_R.close();
-    R_I.close();
-    J_R.close();
-    J_I.close();
+    {
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        R_R.close();
+        R_I.close();
+        J_R.close();
+        J_I.close();
+    }
     
     libMesh::out << "R_R: " << R_R.l2_norm() << "   R_I: " << R_I.l2_norm() << std::endl;
 }
@@ -419,6 +464,9 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
 
     START_LOG("residual_and_jacobian()", "ComplexSolve");
     
+    MAST::AssemblyProfiler::Scope
+    profile("ComplexAssemblyBase::residual_and_jacobian_blocked");
+    
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
     R.zero();
@@ -448,8 +496,10 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
     
     
     
+    const libMesh::NumericVector<Real>*
+    localized_base_solution = nullptr;
+    
     std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_base_solution,
     localized_complex_sol(libMesh::NumericVector<Real>::build(nonlin_sys.comm()).release());
     
     // prepare a send list for localization of the complex solution
@@ -461,17 +511,24 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
         complex_send_list[2*i+1] = 2*send_list[i]+1;
     }
 
-    localized_complex_sol->init(2*nonlin_sys.n_dofs(),
-                                2*nonlin_sys.n_local_dofs(),
-                                complex_send_list,
-                                false,
-                                libMesh::GHOSTED);
-    X.localize(*localized_complex_sol, complex_send_list);
+    {
+        MAST::AssemblyProfiler::Scope profile_localize(MAST::AssemblyProfiler::LOCALIZATION);
+        
+        localized_complex_sol->init(2*nonlin_sys.n_dofs(),
+                                    2*nonlin_sys.n_local_dofs(),
+                                    complex_send_list,
+                                    false,
+                                    libMesh::GHOSTED);
+        X.localize(*localized_complex_sol, complex_send_list);
+    }
+    
+    MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::LOCALIZED_VECTORS);
+    MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::LOCALIZED_ENTRIES,
+                                  2*(nonlin_sys.n_local_dofs() + send_list.size()));
     
     // localize the base solution, if it was provided
     if (_base_sol)
-        localized_base_solution.reset(build_localized_vector(nonlin_sys,
-                                                             *_base_sol).release());
+        localized_base_solution = &localized_vector(nonlin_sys, *_base_sol, "base_solution");
     
     
 
@@ -492,13 +549,20 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         dof_map.dof_indices (elem, dof_indices);
         
         MAST::GeomElem geom_elem;
-        ops.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
         
-        ops.init(geom_elem);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            ops.set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+            
+            ops.init(geom_elem);
+        }
 
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -533,17 +597,21 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
         
         
         // perform the element level calculations
-        ops.elem_calculations(true, vec, mat);
-        
-        // if sensitivity was requested, then ask the element for sensitivity
-        // of the residual
-        if (p) {
+        {
+            MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
             
-            // set the sensitivity of complex sol to zero
-            delta_sol.setZero();
-            ops.set_elem_complex_solution_sensitivity(delta_sol);
-            vec.setZero();
-            ops.elem_sensitivity_calculations(*p, vec);
+            ops.elem_calculations(true, vec, mat);
+            
+            // if sensitivity was requested, then ask the element for sensitivity
+            // of the residual
+            if (p) {
+                
+                // set the sensitivity of complex sol to zero
+                delta_sol.setZero();
+                ops.set_elem_complex_solution_sensitivity(delta_sol);
+                vec.setZero();
+                ops.elem_sensitivity_calculations(*p, vec);
+            }
         }
         
         ops.clear_elem();
@@ -567,12 +635,20 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
         MAST::copy(m_I2, mat.imag());                // this is the J_I component
         MAST::copy( v_R, vec.real());
         MAST::copy( v_I, vec.imag());
-        dof_map.constrain_element_matrix(m_R,  dof_indices);
-        dof_map.constrain_element_matrix(m_I1, dof_indices);
-        dof_map.constrain_element_matrix(m_I2, dof_indices);
-        dof_map.constrain_element_vector(v_R,  dof_indices);
-        dof_map.constrain_element_vector(v_I,  dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+            dof_map.constrain_element_matrix(m_R,  dof_indices);
+            dof_map.constrain_element_matrix(m_I1, dof_indices);
+            dof_map.constrain_element_matrix(m_I2, dof_indices);
+            dof_map.constrain_element_vector(v_R,  dof_indices);
+            dof_map.constrain_element_vector(v_I,  dof_indices);
+        }
         
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::VECTOR_ENTRIES_ADDED,
+                                      2*dof_indices.size());
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::MATRIX_ENTRIES_ADDED,
+                                      4*dof_indices.size()*dof_indices.size());
         
         for (unsigned int i=0; i<dof_indices.size(); i++) {
             
@@ -598,8 +674,11 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
     //if (_sol_function)
     //    _sol_function->clear();
     
-    R.close();
-    J.close();
+    {
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        R.close();
+        J.close();
+    }
     
     libMesh::out << "R: " << R.l2_norm() << std::endl;
     STOP_LOG("residual_and_jacobian()", "ComplexSolve");
@@ -0,0 +1,346 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <map>
+#include <functional>
+
+// MAST includes
+#include "base/constraint_operator.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+
+
+void
+MAST::ConstraintOperator::ElemOperator::
+constrain_vector(const RealVectorX& v,
+                 RealVectorX&       v_c) const {
+    
+    libmesh_assert_equal_to(v.size(), n_elem_dofs);
+    
+    v_c.setZero(dof_indices.size());
+    v_c.topRows(n_elem_dofs) = v;
+    
+    for (unsigned int i=0; i<rows.size(); i++) {
+        
+        const unsigned int
+        s = rows[i];
+        
+        for (unsigned int k=row_begin[i]; k<row_begin[i+1]; k++)
+            v_c(entries[k].first) += entries[k].second * v_c(s);
+        
+        v_c(s) = 0.;
+    }
+}
+
+
+
+void
+MAST::ConstraintOperator::ElemOperator::
+constrain_matrix(const RealMatrixX& m,
+                 RealMatrixX&       m_c) const {
+    
+    libmesh_assert_equal_to(m.rows(), n_elem_dofs);
+    libmesh_assert_equal_to(m.cols(), n_elem_dofs);
+    
+    const unsigned int
+    n = (unsigned int)dof_indices.size();
+    
+    m_c.setZero(n, n);
+    m_c.topLeftCorner(n_elem_dofs, n_elem_dofs) = m;
+    
+    // The masters of a resolved row are not constrained, so the column,
+    // and later the row, of a constrained dof is not modified before it
+    // is distributed to its masters.
+    
+    // m P
+    for (unsigned int i=0; i<rows.size(); i++) {
+        
+        const unsigned int
+        s = rows[i];
+        
+        for (unsigned int k=row_begin[i]; k<row_begin[i+1]; k++)
+            m_c.col(entries[k].first).topRows(n_elem_dofs) +=
+            entries[k].second * m_c.col(s).topRows(n_elem_dofs);
+        
+        m_c.col(s).setZero();
+    }
+    
+    // P^T (m P)
+    for (unsigned int i=0; i<rows.size(); i++) {
+        
+        const unsigned int
+        s = rows[i];
+        
+        for (unsigned int k=row_begin[i]; k<row_begin[i+1]; k++)
+            m_c.row(entries[k].first) += entries[k].second * m_c.row(s);
+        
+        m_c.row(s).setZero();
+    }
+    
+    // the rows of the constrained dofs are replaced by the constraint
+    // equations
+    for (unsigned int i=0; i<rows.size(); i++) {
+        
+        const unsigned int
+        s = rows[i];
+        
+        m_c(s, s) = 1.;
+        
+        for (unsigned int k=row_begin[i]; k<row_begin[i+1]; k++)
+            m_c(s, entries[k].first) = -entries[k].second;
+    }
+}
+
+
+
+MAST::ConstraintOperator::ConstraintOperator():
+_initialized   (false) {
+    
+}
+
+
+
+MAST::ConstraintOperator::~ConstraintOperator() {
+    
+}
+
+
+
+void
+MAST::ConstraintOperator::clear() {
+    
+    _initialized = false;
+    _row_id.clear();
+    _row_begin.clear();
+    _entries.clear();
+}
+
+
+
+std::size_t
+MAST::ConstraintOperator::checksum(const libMesh::DofMap& dof_map) {
+    
+    std::hash<libMesh::dof_id_type> hash_id;
+    std::hash<Real>                 hash_val;
+    
+    std::size_t
+    h = hash_id(dof_map.n_dofs());
+    
+    // combines the hash of each value with the running hash
+    auto combine = [&h](std::size_t v) {
+        h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2);
+    };
+    
+    libMesh::DofConstraints::const_iterator
+    it   = dof_map.constraint_rows_begin(),
+    end  = dof_map.constraint_rows_end();
+    
+    for ( ; it != end; it++) {
+        
+        combine(hash_id(it->first));
+        
+        libMesh::DofConstraintRow::const_iterator
+        m_it  = it->second.begin(),
+        m_end = it->second.end();
+        
+        for ( ; m_it != m_end; m_it++) {
+            
+            combine(hash_id(m_it->first));
+            combine(hash_val(m_it->second));
+        }
+    }
+    
+    return h;
+}
+
+
+
+void
+MAST::ConstraintOperator::init(const libMesh::DofMap& dof_map) {
+    
+    this->clear();
+    
+    // number the constrained dofs
+    std::vector<libMesh::DofConstraints::const_iterator> raw_rows;
+    
+    libMesh::DofConstraints::const_iterator
+    it   = dof_map.constraint_rows_begin(),
+    end  = dof_map.constraint_rows_end();
+    
+    for ( ; it != end; it++) {
+        
+        _row_id[it->first] = (unsigned int)raw_rows.size();
+        raw_rows.push_back(it);
+    }
+    
+    const unsigned int
+    n_rows = (unsigned int)raw_rows.size();
+    
+    // The rows are resolved in order of their dependence. A row is
+    // resolved once all constrained masters in the row are resolved, and
+    // the dependence is followed depth-first with an explicit stack, one
+    // master at a time. Hence, the stack is the current path of
+    // dependence, and a row that is found on the stack a second time
+    // identifies a cyclic constraint.
+    std::vector<std::map<libMesh::dof_id_type, Real>> rows(n_rows);
+    std::vector<char> status(n_rows, 0); // 0: new, 1: on stack, 2: resolved
+    std::vector<unsigned int> stack;
+    
+    for (unsigned int r=0; r<n_rows; r++) {
+        
+        if (status[r] == 2) continue;
+        
+        stack.push_back(r);
+        status[r] = 1;
+        
+        while (!stack.empty()) {
+            
+            const unsigned int
+            i = stack.back();
+            
+            bool
+            if_ready = true;
+            
+            const libMesh::DofConstraintRow& row = raw_rows[i]->second;
+            
+            libMesh::DofConstraintRow::const_iterator
+            m_it  = row.begin(),
+            m_end = row.end();
+            
+            for ( ; m_it != m_end; m_it++) {
+                
+                std::unordered_map<libMesh::dof_id_type, unsigned int>::const_iterator
+                id_it = _row_id.find(m_it->first);
+                
+                if (id_it == _row_id.end() || status[id_it->second] == 2)
+                    continue;
+                
+                if (status[id_it->second] == 1)
+                    libmesh_error_msg("Cyclic constraint for dof: " << m_it->first);
+                
+                stack.push_back(id_it->second);
+                status[id_it->second] = 1;
+                if_ready = false;
+                break;
+            }
+            
+            if (!if_ready) continue;
+            
+            std::map<libMesh::dof_id_type, Real>& r_row = rows[i];
+            
+            for (m_it = row.begin(); m_it != m_end; m_it++) {
+                
+                std::unordered_map<libMesh::dof_id_type, unsigned int>::const_iterator
+                id_it = _row_id.find(m_it->first);
+                
+                if (id_it == _row_id.end())
+                    r_row[m_it->first] += m_it->second;
+                else {
+                    
+                    // substitute the resolved row of the constrained master
+                    const std::map<libMesh::dof_id_type, Real>& m_row = rows[id_it->second];
+                    
+                    std::map<libMesh::dof_id_type, Real>::const_iterator
+                    it2  = m_row.begin(),
+                    end2 = m_row.end();
+                    
+                    for ( ; it2 != end2; it2++)
+                        r_row[it2->first] += m_it->second * it2->second;
+                }
+            }
+            
+            status[i] = 2;
+            stack.pop_back();
+        }
+    }
+    
+    // store the resolved rows
+    _row_begin.resize(n_rows+1, 0);
+    
+    unsigned int
+    n_entries = 0;
+    
+    for (unsigned int i=0; i<n_rows; i++) {
+        
+        _row_begin[i] = n_entries;
+        n_entries    += (unsigned int)rows[i].size();
+    }
+    
+    _row_begin[n_rows] = n_entries;
+    _entries.reserve(n_entries);
+    
+    for (unsigned int i=0; i<n_rows; i++)
+        _entries.insert(_entries.end(), rows[i].begin(), rows[i].end());
+    
+    _initialized = true;
+}
+
+
+
+void
+MAST::ConstraintOperator::
+init_elem_operator(const std::vector<libMesh::dof_id_type>& dof_indices,
+                   MAST::ConstraintOperator::ElemOperator& op) const {
+    
+    libmesh_assert(_initialized);
+    
+    op.n_elem_dofs = (unsigned int)dof_indices.size();
+    op.dof_indices = dof_indices;
+    op.rows.clear();
+    op.row_begin.clear();
+    op.entries.clear();
+    
+    for (unsigned int i=0; i<op.n_elem_dofs; i++) {
+        
+        std::unordered_map<libMesh::dof_id_type, unsigned int>::const_iterator
+        id_it = _row_id.find(dof_indices[i]);
+        
+        if (id_it == _row_id.end()) continue;
+        
+        op.rows.push_back(i);
+        op.row_begin.push_back((unsigned int)op.entries.size());
+        
+        for (unsigned int k=_row_begin[id_it->second];
+             k<_row_begin[id_it->second+1];
+             k++) {
+            
+            const libMesh::dof_id_type
+            dof = _entries[k].first;
+            
+            // the master dof is added to the element dofs if it is not
+            // already included
+            unsigned int
+            j = 0;
+            
+            for ( ; j<op.dof_indices.size(); j++)
+                if (op.dof_indices[j] == dof)
+                    break;
+            
+            if (j == op.dof_indices.size())
+                op.dof_indices.push_back(dof);
+            
+            op.entries.push_back(std::pair<unsigned int, Real>(j, _entries[k].second));
+        }
+    }
+    
+    op.row_begin.push_back((unsigned int)op.entries.size());
+}
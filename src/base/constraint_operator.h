@@ -0,0 +1,195 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__constraint_operator_h__
+#define __mast__constraint_operator_h__
+
+// C++ includes
+#include <vector>
+#include <unordered_map>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/id_types.h"
+
+
+namespace libMesh {
+    class DofMap;
+}
+
+
+namespace MAST {
+    
+    /*!
+     *   Sparse representation of the constraints of a \p libMesh::DofMap,
+     *   \f$ u = P \hat{u} \f$, where the row of \f$ P \f$ for a constrained
+     *   dof lists its master dofs and coefficients, and all other rows are
+     *   identity. The constraint rows are read once from the dof map in
+     *   \p init(), and chains of constraints, where a master dof is itself
+     *   constrained, are resolved at that point so that each row only
+     *   refers to unconstrained dofs. This applies to any constraint in the
+     *   dof map, for example the kinematic couplings of a structural
+     *   system, ties of a thermal system, or Dirichlet conditions.
+     *
+     *   The restriction of \f$ P \f$ to the dofs of an element is
+     *   initialized with \p init_elem_operator(), and can be stored and
+     *   reused in subsequent assemblies to compute \f$ P_e^T K_e P_e \f$ and
+     *   \f$ P_e^T f_e \f$. The rows of the constrained dofs are replaced by
+     *   the constraint equations, consistent with
+     *   \p libMesh::DofMap::constrain_element_matrix_and_vector() with
+     *   asymmetric constraint rows.
+     */
+    class ConstraintOperator {
+        
+    public:
+        
+        /*!
+         *   Restriction of the constraint operator to the dofs of an element.
+         */
+        class ElemOperator {
+            
+        public:
+            
+            ElemOperator(): n_elem_dofs(0) { }
+            
+            /*!
+             *   number of dofs of the element
+             */
+            unsigned int                       n_elem_dofs;
+            
+            /*!
+             *   dofs of the element followed by the master dofs of the
+             *   constrained element dofs that are not element dofs
+             */
+            std::vector<libMesh::dof_id_type>  dof_indices;
+            
+            /*!
+             *   local indices of the constrained element dofs
+             */
+            std::vector<unsigned int>          rows;
+            
+            /*!
+             *   the master dofs of \p rows[i] are
+             *   \p entries[row_begin[i]] to \p entries[row_begin[i+1]-1]
+             */
+            std::vector<unsigned int>          row_begin;
+            
+            /*!
+             *   index of the master dof in \p dof_indices and its coefficient
+             */
+            std::vector<std::pair<unsigned int, Real>> entries;
+            
+            /*!
+             *   @returns true if none of the element dofs is constrained
+             */
+            bool empty() const { return rows.empty(); }
+            
+            /*!
+             *   computes \f$ v_c = P_e^T v \f$. \p v_c is resized to the
+             *   size of \p dof_indices.
+             */
+            void constrain_vector(const RealVectorX& v,
+                                  RealVectorX&       v_c) const;
+            
+            /*!
+             *   computes \f$ m_c = P_e^T m P_e \f$ and replaces the rows
+             *   of the constrained dofs with the constraint equations.
+             *   \p m_c is resized to the size of \p dof_indices.
+             */
+            void constrain_matrix(const RealMatrixX& m,
+                                  RealMatrixX&       m_c) const;
+        };
+        
+        
+        ConstraintOperator();
+        
+        virtual ~ConstraintOperator();
+        
+        /*!
+         *   reads the constraint rows from \p dof_map and resolves the
+         *   chains of constraints.
+         */
+        void init(const libMesh::DofMap& dof_map);
+        
+        /*!
+         *   @returns true if \p init() has been called after construction
+         *   or the last call to \p clear()
+         */
+        bool initialized() const { return _initialized; }
+        
+        /*!
+         *   clears the data structures
+         */
+        void clear();
+        
+        /*!
+         *   @returns the number of constrained dofs
+         */
+        unsigned int n_constrained_dofs() const {
+            
+            return (unsigned int)_row_id.size();
+        }
+        
+        /*!
+         *   @returns true if \p dof is constrained
+         */
+        bool if_constrained_dof(libMesh::dof_id_type dof) const {
+            
+            return _row_id.count(dof);
+        }
+        
+        /*!
+         *   initializes the restriction of the operator to the element with
+         *   dofs \p dof_indices in \p op.
+         */
+        void init_elem_operator(const std::vector<libMesh::dof_id_type>& dof_indices,
+                                MAST::ConstraintOperator::ElemOperator& op) const;
+        
+        /*!
+         *   @returns a hash of the constraint rows of \p dof_map on this
+         *   processor. This changes with the constrained dofs, their master
+         *   dofs and the coefficients, for example when hanging nodes change
+         *   after refinement or when the dofs are renumbered.
+         */
+        static std::size_t checksum(const libMesh::DofMap& dof_map);
+        
+    protected:
+        
+        bool _initialized;
+        
+        /*!
+         *   row in \p _row_begin for each constrained dof
+         */
+        std::unordered_map<libMesh::dof_id_type, unsigned int> _row_id;
+        
+        /*!
+         *   the resolved row \p i of the constraint operator is
+         *   \p _entries[_row_begin[i]] to \p _entries[_row_begin[i+1]-1]
+         */
+        std::vector<unsigned int> _row_begin;
+        
+        std::vector<std::pair<libMesh::dof_id_type, Real>> _entries;
+    };
+}
+
+
+#endif // __mast__constraint_operator_h__
@@ -26,6 +26,7 @@
 #include "base/eigenproblem_assembly_elem_operations.h"
 #include "mesh/geom_elem.h"
 #include "numerics/utility.h"
+#include "utility/assembly_profiler.h"
 
 
 // libMesh includes
@@ -97,6 +98,9 @@ eigenproblem_assemble(libMesh::SparseMatrix<Real>* A,
     MAST::NonlinearSystem& eigen_sys =
     dynamic_cast<MAST::NonlinearSystem&>(_system->system());
     
+    MAST::AssemblyProfiler::Scope
+    profile("EigenproblemAssembly::eigenproblem_assemble");
+    
     libMesh::SparseMatrix<Real>
     &matrix_A = *A,
     &matrix_B = *B;
@@ -106,12 +110,11 @@ eigenproblem_assemble(libMesh::SparseMatrix<Real>* A,
     
 
     // build localized solutions if needed
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution;
+    const libMesh::NumericVector<Real>*
+    localized_solution = nullptr;
     
     if (_base_sol)
-        localized_solution.reset(build_localized_vector(eigen_sys,
-                                                         *_base_sol).release());
+        localized_solution = &localized_vector(eigen_sys, *_base_sol, "base_solution");
 
     
     // iterate over each element, initialize it and get the relevant
@@ -134,13 +137,20 @@ eigenproblem_assemble(libMesh::SparseMatrix<Real>* A,
         
         const libMesh::Elem* elem = *el;
         
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         dof_map.dof_indices (elem, dof_indices);
         
         MAST::GeomElem geom_elem;
-        ops.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
         
-        ops.init(geom_elem);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            ops.set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+            
+            ops.init(geom_elem);
+        }
 
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -155,7 +165,12 @@ eigenproblem_assemble(libMesh::SparseMatrix<Real>* A,
         }
         
         ops.set_elem_solution(sol);
-        ops.elem_calculations(mat_A, mat_B);
+        
+        {
+            MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+            ops.elem_calculations(mat_A, mat_B);
+        }
+        
         ops.clear_elem();
 
         // copy to the libMesh matrix for further processing
@@ -164,16 +179,28 @@ eigenproblem_assemble(libMesh::SparseMatrix<Real>* A,
         MAST::copy(B, mat_B);
 
         // constrain the element matrices.
-        dof_map.constrain_element_matrix(A, dof_indices);
-        dof_map.constrain_element_matrix(B, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+            dof_map.constrain_element_matrix(A, dof_indices);
+            dof_map.constrain_element_matrix(B, dof_indices);
+        }
         
-        matrix_A.add_matrix (A, dof_indices); // load independent
-        matrix_B.add_matrix (B, dof_indices); // load dependent
+        {
+            MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+            matrix_A.add_matrix (A, dof_indices); // load independent
+            matrix_B.add_matrix (B, dof_indices); // load dependent
+        }
+        
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::MATRIX_ENTRIES_ADDED,
+                                      2*dof_indices.size()*dof_indices.size());
     }
     
     // finalize the data structures
-    A->close();
-    B->close();
+    {
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        A->close();
+        B->close();
+    }
 }
 
 
@@ -193,6 +220,9 @@ eigenproblem_sensitivity_assemble(const MAST::FunctionBase& f,
     MAST::NonlinearSystem& eigen_sys =
     dynamic_cast<MAST::NonlinearSystem&>(_system->system());
     
+    MAST::AssemblyProfiler::Scope
+    profile("EigenproblemAssembly::eigenproblem_sensitivity_assemble");
+    
     libMesh::SparseMatrix<Real>&  matrix_A = *sensitivity_A;
     libMesh::SparseMatrix<Real>&  matrix_B = *sensitivity_B;
     
@@ -200,19 +230,19 @@ eigenproblem_sensitivity_assemble(const MAST::FunctionBase& f,
     matrix_B.zero();
     
     // build localized solutions if needed
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_solution_sens;
+    const libMesh::NumericVector<Real>
+    *localized_solution      = nullptr,
+    *localized_solution_sens = nullptr;
     
     if (_base_sol) {
         
-        localized_solution.reset(build_localized_vector(eigen_sys,
-                                                         *_base_sol).release());
+        localized_solution = &localized_vector(eigen_sys, *_base_sol, "base_solution");
         
         // make sure that the sensitivity was also provided
         libmesh_assert(_base_sol_sensitivity);
-        localized_solution_sens.reset(build_localized_vector(eigen_sys,
-                                                              *_base_sol_sensitivity).release());
+        localized_solution_sens = &localized_vector(eigen_sys,
+                                                    *_base_sol_sensitivity,
+                                                    "base_solution_sensitivity");
     }
     
 
@@ -236,13 +266,20 @@ eigenproblem_sensitivity_assemble(const MAST::FunctionBase& f,
         
         const libMesh::Elem* elem = *el;
         
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         dof_map.dof_indices (elem, dof_indices);
         
         MAST::GeomElem geom_elem;
-        ops.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
         
-        ops.init(geom_elem);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            ops.set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+            
+            ops.init(geom_elem);
+        }
 
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -268,10 +305,15 @@ eigenproblem_sensitivity_assemble(const MAST::FunctionBase& f,
         }
         
         ops.set_elem_solution_sensitivity(sol);
-        ops.elem_sensitivity_calculations(f,
-                                          _base_sol!=nullptr,
-                                          mat_A,
-                                          mat_B);
+        
+        {
+            MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+            ops.elem_sensitivity_calculations(f,
+                                              _base_sol!=nullptr,
+                                              mat_A,
+                                              mat_B);
+        }
+        
         ops.clear_elem();
 
         // copy to the libMesh matrix for further processing
@@ -280,16 +322,28 @@ eigenproblem_sensitivity_assemble(const MAST::FunctionBase& f,
         MAST::copy(B, mat_B);
         
         // constrain the element matrices.
-        dof_map.constrain_element_matrix(A, dof_indices);
-        dof_map.constrain_element_matrix(B, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+            dof_map.constrain_element_matrix(A, dof_indices);
+            dof_map.constrain_element_matrix(B, dof_indices);
+        }
         
-        matrix_A.add_matrix (A, dof_indices);
-        matrix_B.add_matrix (B, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+            matrix_A.add_matrix (A, dof_indices);
+            matrix_B.add_matrix (B, dof_indices);
+        }
+        
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::MATRIX_ENTRIES_ADDED,
+                                      2*dof_indices.size()*dof_indices.size());
     }
     
     // finalize the data structures
-    sensitivity_A->close();
-    sensitivity_B->close();
+    {
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        sensitivity_A->close();
+        sensitivity_B->close();
+    }
     
     return true;
 }
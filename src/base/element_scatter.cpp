@@ -0,0 +1,367 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+
+// MAST includes
+#include "base/element_scatter.h"
+#include "numerics/utility.h"
+#include "utility/assembly_profiler.h"
+
+// libMesh includes
+#include "libmesh/elem.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/sparse_matrix.h"
+#include "libmesh/petsc_matrix.h"
+
+
+MAST::ElementScatter::ElementScatter():
+_static_constraints   (true),
+_dof_map              (nullptr),
+_R                    (nullptr),
+_J                    (nullptr),
+_petsc_J              (nullptr),
+_block_size           (1),
+_n_constrained_dofs   (0),
+_constraint_checksum  (0),
+_n_constrained_elems  (0),
+_n_direct_elems       (0) {
+    
+}
+
+
+
+MAST::ElementScatter::~ElementScatter() {
+    
+}
+
+
+
+void
+MAST::ElementScatter::set_static_constraints(bool f) {
+    
+    _static_constraints = f;
+    this->clear();
+}
+
+
+
+void
+MAST::ElementScatter::clear() {
+    
+    _elem_status.clear();
+    _elem_operators.clear();
+    _constraints.clear();
+    _n_constrained_dofs  = 0;
+    _constraint_checksum = 0;
+}
+
+
+
+void
+MAST::ElementScatter::init(const libMesh::DofMap&         dof_map,
+                           libMesh::NumericVector<Real>*  R,
+                           libMesh::SparseMatrix<Real>*   J) {
+    
+    // the stored element status and operators are only valid for the
+    // dof map and the constraints for which they were computed. The
+    // checksum covers changes in the constraint coefficients and in the
+    // dof numbering that leave the dof counts unchanged.
+    if (_static_constraints) {
+        
+        const std::size_t
+        checksum = MAST::ConstraintOperator::checksum(dof_map);
+        
+        if (_dof_map != &dof_map ||
+            _constraint_checksum != checksum)
+            this->clear();
+        
+        _constraint_checksum = checksum;
+    }
+    
+    _dof_map             = &dof_map;
+    _n_constrained_dofs  = dof_map.n_constrained_dofs();
+    _R                   = R;
+    _J                   = J;
+    _petsc_J             = dynamic_cast<libMesh::PetscMatrix<Real>*>(J);
+    _block_size          = 1;
+    _n_constrained_elems = 0;
+    _n_direct_elems      = 0;
+    
+    if (_petsc_J) {
+        
+        PetscErrorCode ierr;
+        PetscInt bs = 1;
+        ierr = MatGetBlockSize(_petsc_J->mat(), &bs);
+        CHKERRABORT(dof_map.comm().get(), ierr);
+        _block_size = (unsigned int)bs;
+    }
+}
+
+
+
+void
+MAST::ElementScatter::add(const libMesh::Elem&                  elem,
+                          std::vector<libMesh::dof_id_type>&    dof_indices,
+                          const RealVectorX&                    vec,
+                          const RealMatrixX&                    mat) {
+    
+    libmesh_assert(_dof_map);
+    libmesh_assert(!_R || vec.size() == (int)dof_indices.size());
+    libmesh_assert(!_J || mat.rows() == (int)dof_indices.size());
+    libmesh_assert(!_J || mat.cols() == (int)dof_indices.size());
+    
+    const unsigned int
+    ndofs = (unsigned int)dof_indices.size();
+    
+    if (!_if_constrained(elem, dof_indices)) {
+        
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        
+        _n_direct_elems++;
+        
+        if (_R) _R->add_vector(vec.data(), dof_indices);
+        
+        if (_J) {
+            
+            if (_petsc_J)
+                _add_petsc_matrix(dof_indices, mat);
+            else {
+                
+                MAST::copy(_m, mat);
+                _J->add_matrix(_m, dof_indices);
+            }
+        }
+    }
+    else if (_static_constraints) {
+        
+        _n_constrained_elems++;
+        
+        // apply the stored constraint operator of the element to account
+        // for hanging dofs, Dirichlet constraints, couplings, etc.
+        {
+            MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+            
+            const MAST::ConstraintOperator::ElemOperator&
+            op = _elem_operator(elem, dof_indices);
+            
+            if (_R) op.constrain_vector(vec, _vec_c);
+            if (_J) op.constrain_matrix(mat, _mat_c);
+            
+            dof_indices = op.dof_indices;
+        }
+        
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        
+        if (_R) _R->add_vector(_vec_c.data(), dof_indices);
+        
+        if (_J) {
+            
+            if (_petsc_J)
+                _add_petsc_matrix(dof_indices, _mat_c);
+            else {
+                
+                MAST::copy(_m, _mat_c);
+                _J->add_matrix(_m, dof_indices);
+            }
+        }
+    }
+    else {
+        
+        _n_constrained_elems++;
+        
+        // copy to the libMesh types and constrain the quantities to
+        // account for hanging dofs, Dirichlet constraints, etc.
+        {
+            MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+            
+            if (_R) MAST::copy(_v, vec);
+            if (_J) MAST::copy(_m, mat);
+            
+            if (_R && _J)
+                _dof_map->constrain_element_matrix_and_vector(_m, _v, dof_indices);
+            else if (_R)
+                _dof_map->constrain_element_vector(_v, dof_indices);
+            else if (_J)
+                _dof_map->constrain_element_matrix(_m, dof_indices);
+        }
+        
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        
+        if (_R) _R->add_vector(_v, dof_indices);
+        if (_J) _J->add_matrix(_m, dof_indices);
+    }
+    
+    if (_R) MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::VECTOR_ENTRIES_ADDED,
+                                          ndofs);
+    if (_J) MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::MATRIX_ENTRIES_ADDED,
+                                          ndofs*ndofs);
+}
+
+
+
+bool
+MAST::ElementScatter::_if_constrained(const libMesh::Elem& elem,
+                                      const std::vector<libMesh::dof_id_type>& dof_indices) {
+    
+    if (!_n_constrained_dofs)
+        return false;
+    
+    const libMesh::dof_id_type
+    id = elem.id();
+    
+    if (_static_constraints &&
+        id < _elem_status.size() &&
+        _elem_status[id])
+        return _elem_status[id] == 1;
+    
+    bool
+    constrained = false;
+    
+    for (unsigned int i=0; i<dof_indices.size(); i++)
+        if (_dof_map->is_constrained_dof(dof_indices[i])) {
+            constrained = true;
+            break;
+        }
+    
+    if (_static_constraints) {
+        
+        if (id >= _elem_status.size())
+            _elem_status.resize(id+1, 0);
+        _elem_status[id] = constrained ? 1 : 2;
+    }
+    
+    return constrained;
+}
+
+
+
+const MAST::ConstraintOperator::ElemOperator&
+MAST::ElementScatter::_elem_operator(const libMesh::Elem& elem,
+                                     const std::vector<libMesh::dof_id_type>& dof_indices) {
+    
+    std::unordered_map<libMesh::dof_id_type, MAST::ConstraintOperator::ElemOperator>::iterator
+    it = _elem_operators.find(elem.id());
+    
+    // the stored operator is reused if the element has the same dofs,
+    // which may not be the case if the elements were renumbered
+    if (it != _elem_operators.end() &&
+        it->second.n_elem_dofs == dof_indices.size() &&
+        std::equal(dof_indices.begin(),
+                   dof_indices.end(),
+                   it->second.dof_indices.begin()))
+        return it->second;
+    
+    if (!_constraints.initialized())
+        _constraints.init(*_dof_map);
+    
+    MAST::ConstraintOperator::ElemOperator&
+    op = _elem_operators[elem.id()];
+    _constraints.init_elem_operator(dof_indices, op);
+    
+    return op;
+}
+
+
+
+void
+MAST::ElementScatter::_add_petsc_matrix(const std::vector<libMesh::dof_id_type>& dof_indices,
+                                        const RealMatrixX& mat) {
+    
+    const unsigned int
+    ndofs = (unsigned int)dof_indices.size();
+    
+    PetscErrorCode ierr;
+    
+    if (_block_size > 1 && _init_blocks(dof_indices)) {
+        
+        // permute the element matrix from the libMesh ordering to the
+        // node-block ordering expected by MatSetValuesBlocked
+        _mat_rm.resize(ndofs, ndofs);
+        for (unsigned int i=0; i<ndofs; i++)
+            for (unsigned int j=0; j<ndofs; j++)
+                _mat_rm(i, j) = mat(_perm[i], _perm[j]);
+        
+        ierr = MatSetValuesBlocked(_petsc_J->mat(),
+                                   (PetscInt)_block_idx.size(), _block_idx.data(),
+                                   (PetscInt)_block_idx.size(), _block_idx.data(),
+                                   _mat_rm.data(),
+                                   ADD_VALUES);
+    }
+    else {
+        
+        // PETSc expects row-major values by default
+        _mat_rm = mat;
+        
+        _idx.resize(ndofs);
+        for (unsigned int i=0; i<ndofs; i++)
+            _idx[i] = (PetscInt)dof_indices[i];
+        
+        ierr = MatSetValues(_petsc_J->mat(),
+                            (PetscInt)ndofs, _idx.data(),
+                            (PetscInt)ndofs, _idx.data(),
+                            _mat_rm.data(),
+                            ADD_VALUES);
+    }
+    
+    CHKERRABORT(_dof_map->comm().get(), ierr);
+}
+
+
+
+bool
+MAST::ElementScatter::_init_blocks(const std::vector<libMesh::dof_id_type>& dof_indices) {
+    
+    const unsigned int
+    ndofs = (unsigned int)dof_indices.size(),
+    bs    = _block_size;
+    
+    if (ndofs % bs)
+        return false;
+    
+    const unsigned int
+    n_nodes = ndofs / bs;
+    
+    _block_idx.resize(n_nodes);
+    _perm.resize(ndofs);
+    
+    for (unsigned int k=0; k<n_nodes; k++) {
+        
+        const libMesh::dof_id_type
+        d0 = dof_indices[k];
+        
+        if (d0 % bs)
+            return false;
+        
+        for (unsigned int v=0; v<bs; v++) {
+            
+            if (dof_indices[v*n_nodes+k] != d0 + v)
+                return false;
+            
+            _perm[k*bs+v] = v*n_nodes+k;
+        }
+        
+        _block_idx[k] = (PetscInt)(d0 / bs);
+    }
+    
+    return true;
+}
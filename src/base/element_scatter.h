@@ -0,0 +1,223 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__element_scatter_h__
+#define __mast__element_scatter_h__
+
+// C++ includes
+#include <vector>
+#include <unordered_map>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/constraint_operator.h"
+
+// libMesh includes
+#include "libmesh/id_types.h"
+
+// PETSc includes
+#include <petscmat.h>
+
+
+namespace libMesh {
+    class Elem;
+    class DofMap;
+    template <typename T> class NumericVector;
+    template <typename T> class SparseMatrix;
+    template <typename T> class PetscMatrix;
+}
+
+
+namespace MAST {
+    
+    /*!
+     *   Adds element residuals and Jacobians to the global vector and
+     *   matrix. Most elements in a mesh do not have constrained dofs, and
+     *   for these the constraint application is a no-op. For such elements
+     *   the residual is added from the Eigen storage of the element vector,
+     *   and the Jacobian is added with a single \p MatSetValues call from a
+     *   row-major work buffer that is reused across elements. If the
+     *   global matrix has a block size, for example six for structural
+     *   systems, and the element dofs form complete node blocks, the
+     *   Jacobian is added with \p MatSetValuesBlocked instead.
+     *
+     *   With static constraints, which is the default, whether an element
+     *   has constrained dofs is determined once and stored by element id.
+     *   The constraint rows of the \p DofMap are then read once into a
+     *   \p MAST::ConstraintOperator, and the restriction of the operator
+     *   to each constrained element is stored and applied directly to the
+     *   Eigen element quantities in subsequent assemblies. This avoids
+     *   rebuilding the constraint matrix of the element from the
+     *   constraint rows in every assembly, which is costly for models with
+     *   many kinematic couplings. The stored values are discarded in
+     *   \p init() if the dof map or the checksum of its constraint rows,
+     *   see \p MAST::ConstraintOperator::checksum(), has changed, for
+     *   example after refinement changes the hanging nodes or the dofs
+     *   are renumbered, and if \p clear() is called. The stored operator
+     *   of an element is rebuilt if the element dofs differ from the ones
+     *   it was built for. Without static constraints, elements with
+     *   constrained dofs go through the copy into libMesh dense types and
+     *   \p DofMap::constrain_element_matrix_and_vector().
+     */
+    class ElementScatter {
+        
+    public:
+        
+        ElementScatter();
+        
+        virtual ~ElementScatter();
+        
+        /*!
+         *   if \p f is true, the constrained status of each element is
+         *   computed once and reused in subsequent assemblies.
+         */
+        void set_static_constraints(bool f);
+        
+        /*!
+         *   prepares for an assembly into \p R and \p J, either of which
+         *   can be \p nullptr. This should be called after the global
+         *   vector and matrix have been zeroed.
+         */
+        void init(const libMesh::DofMap&         dof_map,
+                  libMesh::NumericVector<Real>*  R,
+                  libMesh::SparseMatrix<Real>*   J);
+        
+        /*!
+         *   adds the element vector \p vec and element matrix \p mat of
+         *   \p elem to the vector and matrix provided to \p init(). The
+         *   constraints of the dof map are applied if \p elem has any
+         *   constrained dofs, in which case \p dof_indices may be modified.
+         */
+        void add(const libMesh::Elem&                  elem,
+                 std::vector<libMesh::dof_id_type>&    dof_indices,
+                 const RealVectorX&                    vec,
+                 const RealMatrixX&                    mat);
+        
+        /*!
+         *   discards the stored constrained status of the elements
+         */
+        void clear();
+        
+        /*!
+         *   @returns the number of elements since the last call to \p init()
+         *   for which the constraints were applied.
+         */
+        unsigned int n_constrained_elems() const { return _n_constrained_elems; }
+        
+        /*!
+         *   @returns the number of elements since the last call to \p init()
+         *   that were added without constraint application.
+         */
+        unsigned int n_direct_elems() const { return _n_direct_elems; }
+        
+    protected:
+        
+        /*!
+         *   @returns true if any of \p dof_indices of \p elem is constrained
+         */
+        bool _if_constrained(const libMesh::Elem& elem,
+                             const std::vector<libMesh::dof_id_type>& dof_indices);
+        
+        /*!
+         *   @returns the stored constraint operator of \p elem, which is
+         *   initialized if this is the first call for \p elem.
+         */
+        const MAST::ConstraintOperator::ElemOperator&
+        _elem_operator(const libMesh::Elem& elem,
+                       const std::vector<libMesh::dof_id_type>& dof_indices);
+        
+        /*!
+         *   adds \p mat to the PETSc matrix without constraints
+         */
+        void _add_petsc_matrix(const std::vector<libMesh::dof_id_type>& dof_indices,
+                               const RealMatrixX& mat);
+        
+        /*!
+         *   @returns true if the element dofs, which libMesh orders by
+         *   variable and then by node, can be grouped into node blocks of
+         *   size \p _block_size. If true, \p _perm and \p _block_idx are
+         *   initialized for the element.
+         */
+        bool _init_blocks(const std::vector<libMesh::dof_id_type>& dof_indices);
+        
+        bool                            _static_constraints;
+        
+        const libMesh::DofMap*          _dof_map;
+        
+        libMesh::NumericVector<Real>*   _R;
+        
+        libMesh::SparseMatrix<Real>*    _J;
+        
+        /*!
+         *   \p _J if it is a PETSc matrix, and \p nullptr otherwise.
+         */
+        libMesh::PetscMatrix<Real>*     _petsc_J;
+        
+        /*!
+         *   block size of \p _petsc_J
+         */
+        unsigned int                    _block_size;
+        
+        /*!
+         *   number of constrained dofs of the dof map for which
+         *   \p _elem_status was computed
+         */
+        libMesh::dof_id_type            _n_constrained_dofs;
+        
+        /*!
+         *   checksum of the constraint rows for which \p _elem_status and
+         *   \p _elem_operators were computed
+         */
+        std::size_t                     _constraint_checksum;
+        
+        /*!
+         *   status of each element by id: 0 if not yet computed, 1 if the
+         *   element has constrained dofs and 2 otherwise.
+         */
+        std::vector<char>               _elem_status;
+        
+        /*!
+         *   constraints of the dof map, used with static constraints
+         */
+        MAST::ConstraintOperator        _constraints;
+        
+        /*!
+         *   constraint operators of the constrained elements by element id
+         */
+        std::unordered_map<libMesh::dof_id_type, MAST::ConstraintOperator::ElemOperator>
+        _elem_operators;
+        
+        unsigned int                    _n_constrained_elems, _n_direct_elems;
+        
+        /*!
+         *   work buffers reused across elements
+         */
+        Eigen::Matrix<Real, Dynamic, Dynamic, Eigen::RowMajor> _mat_rm;
+        std::vector<PetscInt>           _idx, _block_idx;
+        std::vector<unsigned int>       _perm;
+        DenseRealVector                 _v;
+        DenseRealMatrix                 _m;
+        RealVectorX                     _vec_c;
+        RealMatrixX                     _mat_c;
+    };
+}
+
+
+#endif // __mast__element_scatter_h__
@@ -0,0 +1,189 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "base/localized_vector_pool.h"
+#include "utility/assembly_profiler.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+
+
+MAST::LocalizedVectorPool::LocalizedVectorPool():
+_n_allocations (0),
+_n_views       (0) {
+    
+}
+
+
+
+MAST::LocalizedVectorPool::~LocalizedVectorPool() {
+    
+}
+
+
+
+const libMesh::NumericVector<Real>&
+MAST::LocalizedVectorPool::localize(const libMesh::System&               sys,
+                                    const libMesh::NumericVector<Real>&  global,
+                                    const std::string&                   role,
+                                    libMesh::ParallelType                type,
+                                    bool                                 allow_view) {
+    
+    libmesh_assert(type == libMesh::GHOSTED || type == libMesh::SERIAL);
+    libmesh_assert_equal_to(global.size(), sys.n_dofs());
+    
+    if (allow_view && global.closed()) {
+        
+        // a serial vector can be used for either type, and a ghosted vector
+        // of the system, whose ghost set is the send list, can be used in
+        // place of a ghosted copy.
+        if (global.type() == libMesh::SERIAL ||
+            (type == libMesh::GHOSTED && _if_system_ghosted(sys, global))) {
+            
+            _n_views++;
+            return global;
+        }
+    }
+    
+    MAST::AssemblyProfiler::Scope profile(MAST::AssemblyProfiler::LOCALIZATION);
+    
+    const std::vector<libMesh::dof_id_type>&
+    send_list = sys.get_dof_map().get_send_list();
+    
+    Entry& e = _vectors[std::make_pair(&sys, role)];
+    
+    if (!_if_reusable(e, sys, type)) {
+        
+        e.type = type;
+        e.vec.reset(libMesh::NumericVector<Real>::build(sys.comm()).release());
+        
+        if (type == libMesh::SERIAL) {
+            
+            e.vec->init(sys.n_dofs(), false, libMesh::SERIAL);
+            e.send_list.clear();
+        }
+        else {
+            
+            e.vec->init(sys.n_dofs(),
+                        sys.n_local_dofs(),
+                        send_list,
+                        false,
+                        libMesh::GHOSTED);
+            e.send_list = send_list;
+        }
+        
+        _n_allocations++;
+    }
+    
+    if (type == libMesh::SERIAL) {
+        
+        global.localize(*e.vec);
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::LOCALIZED_ENTRIES,
+                                      sys.n_dofs());
+    }
+    else {
+        
+        // for a parallel vector with the dof distribution of the system, or
+        // a ghosted vector of the system, the assignment copies the owned
+        // entries, and closing the ghosted vector updates the ghost entries
+        // using its own scatter. Other ghosted vectors may have a
+        // different ghost set and are localized through the send list.
+        if ((global.type() == libMesh::PARALLEL &&
+             global.local_size() == sys.n_local_dofs()) ||
+            _if_system_ghosted(sys, global)) {
+            
+            *e.vec = global;
+            e.vec->close();
+        }
+        else
+            global.localize(*e.vec, send_list);
+        
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::LOCALIZED_ENTRIES,
+                                      sys.n_local_dofs() + send_list.size());
+    }
+    
+    MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::LOCALIZED_VECTORS);
+    
+    return *e.vec;
+}
+
+
+
+void
+MAST::LocalizedVectorPool::release(const libMesh::System& sys,
+                                   const std::string&     role) {
+    
+    _vectors.erase(std::make_pair(&sys, role));
+}
+
+
+
+void
+MAST::LocalizedVectorPool::clear() {
+    
+    _vectors.clear();
+}
+
+
+
+bool
+MAST::LocalizedVectorPool::_if_system_ghosted(const libMesh::System& sys,
+                                              const libMesh::NumericVector<Real>& v) const {
+    
+    if (v.type() != libMesh::GHOSTED)
+        return false;
+    
+    if (&v == sys.current_local_solution.get())
+        return true;
+    
+    // vectors added to the system as ghosted use the send list of the
+    // system, and are reinitialized with it.
+    libMesh::System::const_vectors_iterator
+    it  = sys.vectors_begin(),
+    end = sys.vectors_end();
+    
+    for ( ; it != end; it++)
+        if (&v == &*it->second)
+            return true;
+    
+    return false;
+}
+
+
+
+bool
+MAST::LocalizedVectorPool::_if_reusable(const Entry& e,
+                                        const libMesh::System& sys,
+                                        libMesh::ParallelType type) const {
+    
+    if (!e.vec                              ||
+        e.type != type                      ||
+        e.vec->size() != sys.n_dofs())
+        return false;
+    
+    if (type == libMesh::SERIAL)
+        return true;
+    
+    // the send list is compared, since it changes with the partitioning
+    // and with refinement of the mesh even if the number of dofs does not.
+    return (e.vec->local_size() == sys.n_local_dofs() &&
+            e.send_list == sys.get_dof_map().get_send_list());
+}
@@ -0,0 +1,148 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__localized_vector_pool_h__
+#define __mast__localized_vector_pool_h__
+
+// C++ includes
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/system.h"
+#include "libmesh/numeric_vector.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Provides localized copies of global vectors for element calculations
+     *   without allocating a new vector for each assembly. A vector is
+     *   stored for each pair of system and role, for example the solution
+     *   and the solution sensitivity in a sensitivity assembly, and is
+     *   reused as long as the dof distribution and send list of the system
+     *   do not change. For ghosted copies, the owned entries are copied
+     *   and the ghost entries are updated by the scatter created with the
+     *   ghosted vector, so that the cost of each call scales with the
+     *   number of local and ghost entries.
+     *
+     *   If the global vector already provides all entries needed on this
+     *   rank, that is, it is a closed \p SERIAL vector, or a closed
+     *   \p GHOSTED vector of the system, it is returned without a copy
+     *   when views are allowed. The ghosted vectors of the system are
+     *   \p current_local_solution and the vectors added to the system as
+     *   \p GHOSTED, which use the send list of the system as their ghost
+     *   set. Other ghosted vectors are copied, since their ghost set may
+     *   not include the send list.
+     *
+     *   The reference returned by \p localize() remains valid until the
+     *   next call for the same system and role, or until \p release() or
+     *   \p clear(). Vectors needed only for a single assembly, such as
+     *   those of a reduced basis, should be released after use so that
+     *   the pool does not keep one vector per basis vector.
+     */
+    class LocalizedVectorPool {
+        
+    public:
+        
+        LocalizedVectorPool();
+        
+        virtual ~LocalizedVectorPool();
+        
+        /*!
+         *   @returns a vector of type \p type that stores the entries of
+         *   \p global needed for calculations on the local elements of
+         *   \p sys. If \p allow_view is true, \p global is returned if it
+         *   already provides these entries.
+         */
+        const libMesh::NumericVector<Real>&
+        localize(const libMesh::System&               sys,
+                 const libMesh::NumericVector<Real>&  global,
+                 const std::string&                   role,
+                 libMesh::ParallelType                type       = libMesh::GHOSTED,
+                 bool                                 allow_view = true);
+        
+        /*!
+         *   deletes the vector stored for \p sys and \p role, if any
+         */
+        void release(const libMesh::System& sys,
+                     const std::string&     role);
+        
+        /*!
+         *   deletes all stored vectors
+         */
+        void clear();
+        
+        /*!
+         *   @returns the number of stored vectors
+         */
+        unsigned int n_vectors() const { return (unsigned int)_vectors.size(); }
+        
+        /*!
+         *   @returns the number of vectors allocated since construction
+         */
+        unsigned int n_allocations() const { return _n_allocations; }
+        
+        /*!
+         *   @returns the number of calls that returned the global vector
+         */
+        unsigned int n_views() const { return _n_views; }
+        
+    protected:
+        
+        struct Entry {
+            
+            Entry(): type(libMesh::AUTOMATIC) { }
+            
+            libMesh::ParallelType                           type;
+            std::unique_ptr<libMesh::NumericVector<Real> >  vec;
+            std::vector<libMesh::dof_id_type>               send_list;
+        };
+        
+        /*!
+         *   @returns true if \p e can store the localized vector of type
+         *   \p type for the current dof distribution of \p sys
+         */
+        bool _if_reusable(const Entry& e,
+                          const libMesh::System& sys,
+                          libMesh::ParallelType type) const;
+        
+        /*!
+         *   @returns true if \p v is a ghosted vector of \p sys, whose
+         *   ghost set is the send list of \p sys
+         */
+        bool _if_system_ghosted(const libMesh::System& sys,
+                                const libMesh::NumericVector<Real>& v) const;
+        
+        std::map<std::pair<const libMesh::System*, std::string>, Entry> _vectors;
+        
+        unsigned int _n_allocations;
+        
+        unsigned int _n_views;
+    };
+}
+
+
+#endif // __mast__localized_vector_pool_h__
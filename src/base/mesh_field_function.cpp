@@ -285,7 +285,7 @@ MAST::MeshFieldFunction::init(const libMesh::NumericVector<Real>& sol,
     libmesh_assert(!_function);
     
     _function = new MAST::MeshFieldFunction::SolFunc;
-    _init_sol_func(reuse_vector, sol, *_function);
+    _init_sol_func(reuse_vector, sol, "solution", *_function);
 }
 
 
@@ -303,7 +303,14 @@ MAST::MeshFieldFunction::init_sens(const MAST::FunctionBase& f,
     libmesh_assert(it == _function_sens.end());
     
     MAST::MeshFieldFunction::SolFunc* func = new MAST::MeshFieldFunction::SolFunc;
-    _init_sol_func(reuse_vector, sol, *func);
+    
+    // the vectors are stored by the number of sensitivity functions
+    // initialized since the last clear(), so that the number of stored
+    // vectors does not grow with the number of parameters.
+    _init_sol_func(reuse_vector,
+                   sol,
+                   "sensitivity_" + std::to_string(_function_sens.size()),
+                   *func);
     
     _function_sens[&f] = func;
 }
@@ -365,6 +372,7 @@ clear_element_quadrature_point_solution() {
 void
 MAST::MeshFieldFunction::_init_sol_func(bool reuse_sol,
                                         const libMesh::NumericVector<Real> &sol,
+                                        const std::string& role,
                                         MAST::MeshFieldFunction::SolFunc& sol_func) {
     
     // make sure it has not already been initialized
@@ -378,33 +386,19 @@ MAST::MeshFieldFunction::_init_sol_func(bool reuse_sol,
     }
     else  {
         
-        sol_func._cloned_sol = libMesh::NumericVector<Real>::build(_sys->comm()).release();
-        sol_func._sol        = sol_func._cloned_sol;
+        // not implemented for other types.
+        if (_p_type != libMesh::SERIAL &&
+            _p_type != libMesh::GHOSTED)
+            libmesh_error();
         
-        switch (_p_type) {
-                
-            case libMesh::SERIAL: {
-                sol_func._cloned_sol->init(sol.size(), true, libMesh::SERIAL);
-                sol.localize(*sol_func._cloned_sol);
-            }
-                break;
-                
-            case libMesh::GHOSTED: {
-                
-                sol_func._cloned_sol->init(_sys->n_dofs(),
-                                           _sys->n_local_dofs(),
-                                           _sys->get_dof_map().get_send_list(),
-                                           true,
-                                           libMesh::GHOSTED);
-                sol.localize(*sol_func._cloned_sol, _sys->get_dof_map().get_send_list());
-            }
-                break;
-                
-            default:
-                // not implemented for other types.
-                libmesh_error();
-                break;
-        }
+        // the copy is owned by the pool, which reuses it in the next call
+        // to init. A view of sol is not used, since sol may change while
+        // this function is in use.
+        sol_func._sol = &_localized_vectors.localize(*_sys,
+                                                     sol,
+                                                     role,
+                                                     _p_type,
+                                                     false);
     }
 
     // finally, create the mesh interpolation function
@@ -22,6 +22,7 @@
 
 // MAST includes
 #include "base/field_function_base.h"
+#include "base/localized_vector_pool.h"
 
 
 // libMesh includes
@@ -201,8 +202,13 @@ namespace MAST {
         };
         
         
+        /*!
+         *   initializes \p sol_func for \p sol. Unless \p reuse_sol is
+         *   true, \p sol is copied to the vector stored for \p role.
+         */
         void _init_sol_func(bool reuse_sol,
                             const libMesh::NumericVector<Real>& sol,
+                            const std::string& role,
                             MAST::MeshFieldFunction::SolFunc& sol_func);
         
         /*!
@@ -230,6 +236,13 @@ namespace MAST {
          *   current solution that is going to be interpolated
          */
         SolFunc*  _function;
+        
+        /*!
+         *   copies of the solution vectors, which are retained across calls
+         *   to \p clear() so that subsequent calls to \p init() do not
+         *   allocate new vectors
+         */
+        MAST::LocalizedVectorPool _localized_vectors;
 
         
         /*!
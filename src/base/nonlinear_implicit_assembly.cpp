@@ -27,6 +27,7 @@
 #include "boundary_condition/point_load_condition.h"
 #include "numerics/utility.h"
 #include "mesh/geom_elem.h"
+#include "utility/assembly_profiler.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_solver.h"
@@ -78,6 +79,9 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     // and the system passed through the function call are the same
     libmesh_assert_equal_to(&S, &(nonlin_sys));
     
+    MAST::AssemblyProfiler::Scope
+    profile("NonlinearImplicitAssembly::residual_and_jacobian");
+    
     if (R) R->zero();
     if (J) J->zero();
     
@@ -89,10 +93,11 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     std::vector<libMesh::dof_id_type> dof_indices;
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
     
+    _scatter.init(dof_map, R, J);
+    
     
-    std::unique_ptr<libMesh::NumericVector<Real> > localized_solution;
-    localized_solution.reset(build_localized_vector(nonlin_sys,
-                                                     X).release());
+    const libMesh::NumericVector<Real>&
+    localized_solution = localized_vector(nonlin_sys, X, "solution");
     
     
     // if a solution function is attached, initialize it
@@ -112,6 +117,8 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         dof_map.dof_indices (elem, dof_indices);
         
         if (diagonal_elem_subdomain_id.count(elem->subdomain_id())) {
@@ -131,10 +138,15 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         else {
                         
             MAST::GeomElem geom_elem;
-            ops.set_elem_data(elem->dim(), *elem, geom_elem);
-            geom_elem.init(*elem, *_system);
             
-            ops.init(geom_elem);
+            {
+                MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+                
+                ops.set_elem_data(elem->dim(), *elem, geom_elem);
+                geom_elem.init(*elem, *_system);
+                
+                ops.init(geom_elem);
+            }
             
             // get the solution
             unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -143,7 +155,7 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
             mat.setZero(ndofs, ndofs);
             
             for (unsigned int i=0; i<dof_indices.size(); i++)
-                sol(i) = (*localized_solution)(dof_indices[i]);
+                sol(i) = localized_solution(dof_indices[i]);
             
             ops.set_elem_solution(sol);
             
@@ -154,33 +166,20 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
             //_check_element_numerical_jacobian(*physics_elem, sol);
             
             // perform the element level calculations
-            ops.elem_calculations(J!=nullptr?true:false,
-                                  vec, mat);
+            {
+                MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+                
+                ops.elem_calculations(J!=nullptr?true:false,
+                                      vec, mat);
+            }
             
             //        physics_elem->detach_active_solution_function();
             
             ops.clear_elem();
             
-            // copy to the libMesh matrix for further processing
-            DenseRealVector v;
-            DenseRealMatrix m;
-            if (R)
-                MAST::copy(v, vec);
-            if (J)
-                MAST::copy(m, mat);
-            
             // constrain the quantities to account for hanging dofs,
-            // Dirichlet constraints, etc.
-            if (R && J)
-                dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
-            else if (R)
-                dof_map.constrain_element_vector(v, dof_indices);
-            else
-                dof_map.constrain_element_matrix(m, dof_indices);
-            
-            // add to the global matrices
-            if (R) R->add_vector(v, dof_indices);
-            if (J) J->add_matrix(m, dof_indices);
+            // Dirichlet constraints, etc. and add to the global matrices
+            _scatter.add(*elem, dof_indices, vec, mat);
             dof_indices.clear();
         }
     }
@@ -255,14 +254,19 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     if (_sol_function)
         _sol_function->clear();
     
+    {
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        
+        if (R) R->close();
+        if (J && close_matrix) J->close();
+    }
+    
     if (R) {
         
-        R->close();
         _res_l2_norm = R->l2_norm();
         if (_first_iter_res_l2_norm < 0.)
             _first_iter_res_l2_norm = _res_l2_norm;
     }
-    if (J && close_matrix) J->close();
 }
 
 
@@ -279,6 +283,9 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
     libmesh_assert(_discipline);
     libmesh_assert(_elem_ops);
 
+    MAST::AssemblyProfiler::Scope
+    profile("NonlinearImplicitAssembly::linearized_jacobian_solution_product");
+    
     // zero the solution vector
     JdX.zero();
     
@@ -297,14 +304,9 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
     
     
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_perturbed_solution;
-    
-    localized_solution.reset(build_localized_vector(nonlin_sys,
-                                                     X).release());
-    localized_perturbed_solution.reset(build_localized_vector(nonlin_sys,
-                                                               dX).release());
+    const libMesh::NumericVector<Real>
+    &localized_solution           = localized_vector(nonlin_sys,  X, "solution"),
+    &localized_perturbed_solution = localized_vector(nonlin_sys, dX, "perturbed_solution");
     
     
     // if a solution function is attached, initialize it
@@ -329,11 +331,18 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
             
         dof_map.dof_indices (elem, dof_indices);
         
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         MAST::GeomElem geom_elem;
-        ops.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
         
-        ops.init(geom_elem);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            ops.set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+            
+            ops.init(geom_elem);
+        }
 
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -343,8 +352,8 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
         mat.setZero(ndofs, ndofs);
         
         for (unsigned int i=0; i<dof_indices.size(); i++) {
-            sol (i) = (*localized_solution)          (dof_indices[i]);
-            dsol(i) = (*localized_perturbed_solution)(dof_indices[i]);
+            sol (i) = localized_solution          (dof_indices[i]);
+            dsol(i) = localized_perturbed_solution(dof_indices[i]);
         }
         
         ops.set_elem_solution(sol);
@@ -356,7 +365,11 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
         //_check_element_numerical_jacobian(*physics_elem, sol);
         
         // perform the element level calculations
-        ops.elem_linearized_jacobian_solution_product(vec);
+        {
+            MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+            
+            ops.elem_linearized_jacobian_solution_product(vec);
+        }
         
         //physics_elem->detach_active_solution_function();
         ops.clear_elem();
@@ -367,10 +380,18 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
         
         // constrain the quantities to account for hanging dofs,
         // Dirichlet constraints, etc.
-        dof_map.constrain_element_vector(v, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+            dof_map.constrain_element_vector(v, dof_indices);
+        }
         
         // add to the global matrices
-        JdX.add_vector(v, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+            JdX.add_vector(v, dof_indices);
+        }
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::VECTOR_ENTRIES_ADDED,
+                                      dof_indices.size());
         dof_indices.clear();
     }
     
@@ -379,7 +400,10 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
     if (_sol_function)
         _sol_function->clear();
     
-    JdX.close();
+    {
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        JdX.close();
+    }
 }
 
 
@@ -397,6 +421,9 @@ second_derivative_dot_solution_assembly (const libMesh::NumericVector<Real>& X,
     libmesh_assert(_discipline);
     libmesh_assert(_elem_ops);
 
+    MAST::AssemblyProfiler::Scope
+    profile("NonlinearImplicitAssembly::second_derivative_dot_solution_assembly");
+    
     // zero the matrix
     d_JdX_dX.zero();
     
@@ -418,21 +445,13 @@ second_derivative_dot_solution_assembly (const libMesh::NumericVector<Real>& X,
     *sol_vec  = nullptr,
     *dsol_vec = nullptr;
     
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_perturbed_solution;
-    
-    if (if_localize_sol) {
-        localized_solution.reset(build_localized_vector(nonlin_sys, X).release());
-        sol_vec = localized_solution.get();
-    }
+    if (if_localize_sol)
+        sol_vec = &localized_vector(nonlin_sys, X, "solution");
     else
         sol_vec = &X;
     
-    if (if_localize_sol_sens) {
-        localized_perturbed_solution.reset(build_localized_vector(nonlin_sys, dX).release());
-        dsol_vec = localized_perturbed_solution.get();
-    }
+    if (if_localize_sol_sens)
+        dsol_vec = &localized_vector(nonlin_sys, dX, "solution_sensitivity");
     else
         dsol_vec = &dX;
     
@@ -459,11 +478,18 @@ second_derivative_dot_solution_assembly (const libMesh::NumericVector<Real>& X,
 
         dof_map.dof_indices (elem, dof_indices);
         
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         MAST::GeomElem geom_elem;
-        ops.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
         
-        ops.init(geom_elem);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            ops.set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+            
+            ops.init(geom_elem);
+        }
 
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -483,7 +509,11 @@ second_derivative_dot_solution_assembly (const libMesh::NumericVector<Real>& X,
 //            physics_elem->attach_active_solution_function(*_sol_function);
         
         // perform the element level calculations
-        ops.elem_second_derivative_dot_solution_assembly(mat);
+        {
+            MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+            
+            ops.elem_second_derivative_dot_solution_assembly(mat);
+        }
         
 //        physics_elem->detach_active_solution_function();
         ops.clear_elem();
@@ -494,10 +524,18 @@ second_derivative_dot_solution_assembly (const libMesh::NumericVector<Real>& X,
         
         // constrain the quantities to account for hanging dofs,
         // Dirichlet constraints, etc.
-        dof_map.constrain_element_matrix(m, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+            dof_map.constrain_element_matrix(m, dof_indices);
+        }
         
         // add to the global matrices
-        d_JdX_dX.add_matrix(m, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+            d_JdX_dX.add_matrix(m, dof_indices);
+        }
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::MATRIX_ENTRIES_ADDED,
+                                      dof_indices.size()*dof_indices.size());
     }
     
     
@@ -505,7 +543,10 @@ second_derivative_dot_solution_assembly (const libMesh::NumericVector<Real>& X,
     if (_sol_function)
         _sol_function->clear();
     
-    d_JdX_dX.close();
+    {
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+        d_JdX_dX.close();
+    }
 }
 
 
@@ -526,6 +567,9 @@ sensitivity_assemble (const libMesh::NumericVector<Real>& X,
 
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
+    MAST::AssemblyProfiler::Scope
+    profile("NonlinearImplicitAssembly::sensitivity_assemble");
+    
     sensitivity_rhs.zero();
     
     // iterate over each element, initialize it and get the relevant
@@ -538,12 +582,8 @@ sensitivity_assemble (const libMesh::NumericVector<Real>& X,
     const libMesh::NumericVector<Real>
     *sol_vec = nullptr;
     
-    std::unique_ptr<libMesh::NumericVector<Real> > localized_solution;
-    
-    if (if_localize_sol) {
-        localized_solution.reset(build_localized_vector(nonlin_sys, X).release());
-        sol_vec = localized_solution.get();
-    }
+    if (if_localize_sol)
+        sol_vec = &localized_vector(nonlin_sys, X, "solution");
     else
         sol_vec = &X;
     
@@ -574,11 +614,18 @@ sensitivity_assemble (const libMesh::NumericVector<Real>& X,
 
         dof_map.dof_indices (elem, dof_indices);
         
+        MAST::AssemblyProfiler::ElemScope profile_elem(*elem);
+        
         MAST::GeomElem geom_elem;
-        ops.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
         
-        ops.init(geom_elem);
+        {
+            MAST::AssemblyProfiler::Scope profile_init(MAST::AssemblyProfiler::ELEM_INIT);
+            
+            ops.set_elem_data(elem->dim(), *elem, geom_elem);
+            geom_elem.init(*elem, *_system);
+            
+            ops.init(geom_elem);
+        }
 
         // get the solution
         unsigned int ndofs = (unsigned int)dof_indices.size();
@@ -594,10 +641,14 @@ sensitivity_assemble (const libMesh::NumericVector<Real>& X,
 //        if (_sol_function)
 //            physics_elem->attach_active_solution_function(*_sol_function);
         
-        ops.elem_sensitivity_calculations(f, vec);
-        if (f.is_topology_parameter()) {
-            ops.elem_topology_sensitivity_calculations(f, vec1);
-            vec += vec1;
+        {
+            MAST::AssemblyProfiler::Scope profile_kernel(MAST::AssemblyProfiler::ELEM_KERNEL);
+            
+            ops.elem_sensitivity_calculations(f, vec);
+            if (f.is_topology_parameter()) {
+                ops.elem_topology_sensitivity_calculations(f, vec1);
+                vec += vec1;
+            }
         }
         
         
@@ -610,10 +661,18 @@ sensitivity_assemble (const libMesh::NumericVector<Real>& X,
 
         // constrain the quantities to account for hanging dofs,
         // Dirichlet constraints, etc.
-        dof_map.constrain_element_vector(v, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_constraints(MAST::AssemblyProfiler::CONSTRAINTS);
+            dof_map.constrain_element_vector(v, dof_indices);
+        }
         
         // add to the global matrices
-        sensitivity_rhs.add_vector(v, dof_indices);
+        {
+            MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
+            sensitivity_rhs.add_vector(v, dof_indices);
+        }
+        MAST::AssemblyProfiler::count(MAST::AssemblyProfiler::VECTOR_ENTRIES_ADDED,
+                                      dof_indices.size());
         dof_indices.clear();
     }
     
@@ -679,8 +738,11 @@ sensitivity_assemble (const libMesh::NumericVector<Real>& X,
     if (_sol_function)
         _sol_function->clear();
     
-    if (close_vector)
+    if (close_vector) {
+        
+        MAST::AssemblyProfiler::Scope profile_scatter(MAST::AssemblyProfiler::SCATTER);
         sensitivity_rhs.close();
+    }
     
     return true;
 }
@@ -22,6 +22,7 @@
 
 // MAST includes
 #include "base/assembly_base.h"
+#include "base/element_scatter.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_implicit_system.h"
@@ -75,6 +76,13 @@ namespace MAST {
         
         Real first_iter_res_l2_norm() const { return _first_iter_res_l2_norm; }
 
+        /*!
+         *   @returns the object used to add element quantities to the
+         *   global residual and Jacobian. This can be used to specify
+         *   whether the constraints change between assemblies.
+         */
+        MAST::ElementScatter& element_scatter() { return _scatter; }
+
         /*!
          *   reset L2 norm of the last-assembled residual
          */
@@ -158,6 +166,12 @@ namespace MAST {
          */
         MAST::NonlinearImplicitAssembly::PostAssemblyOperation* _post_assembly;
 
+        /*!
+         *   adds the element residuals and Jacobians to the global
+         *   quantities in \p residual_and_jacobian()
+         */
+        MAST::ElementScatter _scatter;
+
         /*!
          *   L2 norm of the last-assembled residual
          */
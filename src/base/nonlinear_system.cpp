@@ -32,6 +32,7 @@
 #include "base/parameter.h"
 #include "base/output_assembly_elem_operations.h"
 #include "solver/slepc_eigen_solver.h"
+#include "utility/hdf5_restart_file.h"
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
@@ -40,6 +41,9 @@
 #include "libmesh/dof_map.h"
 #include "libmesh/nonlinear_solver.h"
 #include "libmesh/petsc_linear_solver.h"
+#include "libmesh/petsc_matrix.h"
+#include "libmesh/petsc_vector.h"
+#include "libmesh/petsc_nonlinear_solver.h"
 #include "libmesh/xdr_cxx.h"
 #include "libmesh/mesh_tools.h"
 #include "libmesh/utility.h"
@@ -55,6 +59,12 @@ MAST::NonlinearSystem::NonlinearSystem(libMesh::EquationSystems& es,
                                        const unsigned int number):
 libMesh::NonlinearImplicitSystem(es, name, number),
 _initialize_B_matrix                  (false),
+_matrix_block_size                    (1),
+_if_blocked_matrices                  (false),
+_if_near_null_space_attached          (false),
+_if_jacobian_free_newton_krylov       (false),
+_jfnk_pc_lag                          (1),
+_jfnk_user_presolve                   (nullptr),
 matrix_A                              (nullptr),
 matrix_B                              (nullptr),
 eigen_solver                          (nullptr),
@@ -140,6 +150,8 @@ MAST::NonlinearSystem::init_data () {
         matrix_B->zero();
     }
     
+    _init_block_matrices();
+    
     eigen_solver.reset(new MAST::SlepcEigenSolver(this->comm()));
     if (libMesh::on_command_line("--solver_system_names")) {
         
@@ -196,6 +208,168 @@ void MAST::NonlinearSystem::reinit () {
         matrix_B->init();
         matrix_B->zero();
     }
+    
+    _init_block_matrices();
+}
+
+
+
+bool
+MAST::NonlinearSystem::_if_block_compatible() const {
+    
+    const libMesh::DofMap& dof_map = this->get_dof_map();
+    
+    const unsigned int
+    bs = _matrix_block_size;
+    
+    // libMesh numbers the dofs of a variable group node by node, so that
+    // a single group with bs variables and one dof per variable on each
+    // node gives contiguous node blocks.
+    bool
+    compatible = (dof_map.n_variable_groups() == 1 &&
+                  this->n_vars()              == bs &&
+                  dof_map.n_dofs()      % bs  == 0 &&
+                  dof_map.first_dof()   % bs  == 0 &&
+                  dof_map.n_local_dofs() % bs == 0);
+    
+    // the rows of each block must have the same number of nonzeros, and
+    // this number must be a multiple of the block size.
+    if (compatible) {
+        
+        const std::vector<libMesh::dof_id_type>
+        & n_nz = dof_map.get_n_nz(),
+        & n_oz = dof_map.get_n_oz();
+        
+        for (unsigned int i=0; compatible && i<n_nz.size(); i+=bs)
+            for (unsigned int j=0; j<bs; j++)
+                if (n_nz[i+j] != n_nz[i] || n_oz[i+j] != n_oz[i] ||
+                    n_nz[i+j] % bs || n_oz[i+j] % bs) {
+                    compatible = false;
+                    break;
+                }
+    }
+    
+    this->comm().min(compatible);
+    
+    return compatible;
+}
+
+
+
+void
+MAST::NonlinearSystem::_init_block_matrices() {
+    
+    _if_blocked_matrices        = false;
+    _if_near_null_space_attached = false;
+    
+    if (_matrix_block_size == 1)
+        return;
+    
+    // the nonzero counts are used for the compatibility check and the
+    // preallocation. libMesh computes them in the initialization of the
+    // matrices, but they are recomputed here if the dof map has already
+    // released them.
+    libMesh::DofMap& dof_map = this->get_dof_map();
+    
+    if (!dof_map.computed_sparsity_already())
+        dof_map.compute_sparsity(this->get_mesh());
+    
+    libmesh_assert_equal_to(dof_map.get_n_nz().size(), dof_map.n_local_dofs());
+    libmesh_assert_equal_to(dof_map.get_n_oz().size(), dof_map.n_local_dofs());
+    
+    if (!_if_block_compatible()) {
+        
+        libMesh::out
+        << "Warning: dof numbering of system " << this->name()
+        << " does not allow matrix block size " << _matrix_block_size
+        << ". Using unblocked storage." << std::endl;
+        return;
+    }
+    
+    std::vector<libMesh::SparseMatrix<Real>*>
+    mats = {this->matrix, matrix_A, matrix_B};
+    
+    for (unsigned int i=0; i<mats.size(); i++) {
+        
+        libMesh::PetscMatrix<Real>*
+        m = dynamic_cast<libMesh::PetscMatrix<Real>*>(mats[i]);
+        
+        if (!m || !m->initialized())
+            continue;
+        
+        m->clear();
+        m->init(dof_map.n_dofs(),
+                dof_map.n_dofs(),
+                dof_map.n_local_dofs(),
+                dof_map.n_local_dofs(),
+                dof_map.get_n_nz(),
+                dof_map.get_n_oz(),
+                _matrix_block_size);
+        m->zero();
+    }
+    
+    _if_blocked_matrices = true;
+}
+
+
+
+void
+MAST::NonlinearSystem::_attach_near_null_space() {
+    
+    // libMesh attaches the near-null space to the Jacobian in the
+    // nonlinear solves. The linear solves of the sensitivity and adjoint
+    // problems use the same matrix, to which the vectors are attached
+    // once after each initialization of the blocked matrices.
+    if (!_if_blocked_matrices         ||
+        _if_near_null_space_attached  ||
+        !nonlinear_solver->nearnullspace_object)
+        return;
+    
+    libMesh::PetscMatrix<Real>
+    *m = dynamic_cast<libMesh::PetscMatrix<Real>*>(matrix);
+    
+    if (!m)
+        return;
+    
+    std::vector<libMesh::NumericVector<Real>*> sp;
+    (*nonlinear_solver->nearnullspace_object)(sp, *this);
+    
+    if (sp.empty())
+        return;
+    
+    // PETSc requires an orthonormal basis
+    const PetscInt
+    n_modes = (PetscInt)sp.size();
+    
+    std::vector<Vec>         modes(n_modes);
+    std::vector<PetscScalar> dots(n_modes);
+    
+    for (PetscInt i=0; i<n_modes; i++) {
+        
+        libMesh::PetscVector<Real>
+        &v = dynamic_cast<libMesh::PetscVector<Real>&>(*sp[i]);
+        
+        VecDuplicate(v.vec(), &modes[i]);
+        VecCopy(v.vec(), modes[i]);
+        
+        if (i) {
+            VecMDot(modes[i], i, modes.data(), dots.data());
+            for (PetscInt j=0; j<i; j++)
+                dots[j] *= -1.;
+            VecMAXPY(modes[i], i, dots.data(), modes.data());
+        }
+        VecNormalize(modes[i], nullptr);
+    }
+    
+    MatNullSpace msp;
+    MatNullSpaceCreate(this->comm().get(), PETSC_FALSE, n_modes, modes.data(), &msp);
+    MatSetNearNullSpace(m->mat(), msp);
+    MatNullSpaceDestroy(&msp);
+    
+    for (PetscInt i=0; i<n_modes; i++)
+        VecDestroy(&modes[i]);
+    
+    _if_near_null_space_attached = true;
 }
 
 std::pair<unsigned int, Real>
@@ -222,8 +396,28 @@ MAST::NonlinearSystem::solve(MAST::AssemblyElemOperations& elem_ops,
     //if (assembly.get_solver_monitor())
     //    assembly.get_solver_monitor()->init(assembly);
     
+    // libMesh resets the SNES Jacobian at the beginning of each solve.
+    // Hence, the matrix-free operator is attached from the presolve
+    // hook, which is called after the Jacobian has been set and before
+    // the SNES solve.
+    void (*old_presolve)(libMesh::NonlinearImplicitSystem&) =
+    this->nonlinear_solver->user_presolve;
+    
+    if (_if_jacobian_free_newton_krylov) {
+        
+        _jfnk_user_presolve                   = old_presolve;
+        this->nonlinear_solver->user_presolve = &_jacobian_free_newton_krylov_presolve;
+    }
+    
     libMesh::NonlinearImplicitSystem::solve();
     
+    if (_if_jacobian_free_newton_krylov) {
+        
+        _set_jacobian_free_newton_krylov_options(false);
+        this->nonlinear_solver->user_presolve = old_presolve;
+        _jfnk_user_presolve                   = nullptr;
+    }
+    
     // enforce constraints on the solution since NonlinearImplicitSystem only
     // enforces the constraints on current_local_solution.
     this->get_dof_map().enforce_constraints_exactly(*this, this->solution.get());
@@ -236,6 +430,71 @@ MAST::NonlinearSystem::solve(MAST::AssemblyElemOperations& elem_ops,
 
 
 
+void
+MAST::NonlinearSystem::
+_jacobian_free_newton_krylov_presolve(libMesh::NonlinearImplicitSystem& s) {
+    
+    MAST::NonlinearSystem& sys = dynamic_cast<MAST::NonlinearSystem&>(s);
+    
+    if (sys._jfnk_user_presolve)
+        sys._jfnk_user_presolve(s);
+    
+    sys._set_jacobian_free_newton_krylov_options(true);
+}
+
+
+
+void
+MAST::NonlinearSystem::_set_jacobian_free_newton_krylov_options(bool f) {
+    
+    libMesh::PetscNonlinearSolver<Real> &petsc_nonlinear_solver =
+    dynamic_cast<libMesh::PetscNonlinearSolver<Real>&>(*this->nonlinear_solver);
+    
+    SNES snes = petsc_nonlinear_solver.snes();
+    
+    PetscErrorCode ierr = 0;
+    
+    if (f) {
+        
+        // replace the operator set by libMesh with a matrix-free
+        // operator, and keep the libMesh matrix and Jacobian routine for
+        // the preconditioner. The SNES keeps a reference to the operator,
+        // which is released when libMesh sets the Jacobian for the next
+        // solve.
+        Mat
+        J   = nullptr,
+        P   = nullptr;
+        void
+        *ctx = nullptr;
+        PetscErrorCode (*jac)(SNES, Vec, Mat, Mat, void*) = nullptr;
+        
+        ierr = SNESGetJacobian(snes, nullptr, &P, &jac, &ctx);
+        CHKERRABORT(this->comm().get(), ierr);
+        
+        ierr = MatCreateSNESMF(snes, &J);
+        CHKERRABORT(this->comm().get(), ierr);
+        
+        ierr = MatSetFromOptions(J);
+        CHKERRABORT(this->comm().get(), ierr);
+        
+        ierr = SNESSetJacobian(snes, J, P, jac, ctx);
+        CHKERRABORT(this->comm().get(), ierr);
+        
+        ierr = MatDestroy(&J);
+        CHKERRABORT(this->comm().get(), ierr);
+    }
+    
+    // The lag counter persists across solves so that the preconditioner
+    // is not reassembled at the first iteration of each time-step.
+    ierr = SNESSetLagJacobian(snes, f?(PetscInt)_jfnk_pc_lag:1);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    ierr = SNESSetLagJacobianPersists(snes, f?PETSC_TRUE:PETSC_FALSE);
+    CHKERRABORT(this->comm().get(), ierr);
+}
+
+
+
 void
 MAST::NonlinearSystem::eigenproblem_solve(MAST::AssemblyElemOperations& elem_ops,
                                           MAST::EigenproblemAssembly& assembly) {
@@ -765,6 +1024,8 @@ MAST::NonlinearSystem::sensitivity_solve(const libMesh::NumericVector<Real>& X,
     
     rhs.scale(-1.);
     
+    _attach_near_null_space();
+    
     // The sensitivity problem is linear
     // Our iteration counts and residuals will be sums of the individual
     // results
@@ -803,45 +1064,94 @@ MAST::NonlinearSystem::adjoint_solve(const libMesh::NumericVector<Real>& X,
                                      MAST::AssemblyBase&                 assembly,
                                      bool if_assemble_jacobian) {
     
+    std::vector<MAST::OutputAssemblyElemOperations*>
+    outputs(1, &output);
+    
+    this->adjoint_solve(X, if_localize_sol, elem_ops, outputs, assembly, if_assemble_jacobian);
+}
+
+
+
+void
+MAST::NonlinearSystem::
+adjoint_solve(const libMesh::NumericVector<Real>& X,
+              bool if_localize_sol,
+              MAST::AssemblyElemOperations&       elem_ops,
+              const std::vector<MAST::OutputAssemblyElemOperations*>& outputs,
+              MAST::AssemblyBase&                 assembly,
+              bool if_assemble_jacobian) {
+    
 
     libmesh_assert(_operation == MAST::NonlinearSystem::NONE);
     
+    if (outputs.empty())
+        return;
+    
     _operation = MAST::NonlinearSystem::ADJOINT_SOLVE;
     
     // Log how long the linear solve takes.
     LOG_SCOPE("adjoint_solve()", "NonlinearSystem");
     
-    libMesh::NumericVector<Real>
-    &dsol  = this->add_adjoint_solution(),
-    &rhs   = this->add_adjoint_rhs();
+    const unsigned int
+    n_outputs = (unsigned int)outputs.size();
+    
+    std::vector<libMesh::NumericVector<Real>*>
+    rhs(n_outputs, nullptr);
+    
+    for (unsigned int i=0; i<n_outputs; i++) {
+        
+        this->add_adjoint_solution(i);
+        rhs[i] = &this->add_adjoint_rhs(i);
+    }
 
     assembly.set_elem_operation_object(elem_ops);
 
     if (if_assemble_jacobian)
         assembly.residual_and_jacobian(*solution, nullptr, matrix, *this);
     
-    assembly.calculate_output_derivative(X, if_localize_sol, output, rhs);
+    // the derivatives of all outputs are computed in a single pass
+    // over the elements
+    assembly.calculate_output_derivatives(X, if_localize_sol, outputs, rhs);
 
     assembly.clear_elem_operation_object();
 
-    rhs.scale(-1.);
+    _attach_near_null_space();
     
     // Our iteration counts and residuals will be sums of the individual
     // results
     std::pair<unsigned int, Real>
     solver_params = this->get_linear_solve_parameters();
     
-    const std::pair<unsigned int, Real> rval =
-    linear_solver->adjoint_solve (*matrix,
-                                  dsol,
-                                  rhs,
-                                  solver_params.second,
-                                  solver_params.first);
+    // The transposed system is the same for all outputs. The
+    // preconditioner, or the factorization for direct solvers, is set up
+    // only for the first right-hand side and reused for the rest. Only
+    // the preconditioner is shared: libMesh forms the transposed
+    // operator again in each adjoint_solve call.
+    const bool
+    reuse_pc = linear_solver->get_same_preconditioner();
     
-    // The linear solver may not have fit our constraints exactly
+    for (unsigned int i=0; i<n_outputs; i++) {
+        
+        libMesh::NumericVector<Real>
+        &dsol  = this->get_adjoint_solution(i);
+        
+        rhs[i]->scale(-1.);
+        
+        linear_solver->reuse_preconditioner(i > 0);
+        
+        linear_solver->adjoint_solve (*matrix,
+                                      dsol,
+                                      *rhs[i],
+                                      solver_params.second,
+                                      solver_params.first);
+        
+        // The linear solver may not have fit our constraints exactly
 #ifdef LIBMESH_ENABLE_CONSTRAINTS
-    this->get_dof_map().enforce_adjoint_constraints_exactly(dsol, 0);
+        this->get_dof_map().enforce_adjoint_constraints_exactly(dsol, i);
 #endif
+    }
+    
+    linear_solver->reuse_preconditioner(reuse_pc);
     
     _operation = MAST::NonlinearSystem::NONE;
 }
@@ -1053,3 +1363,52 @@ project_vector_without_dirichlet (libMesh::NumericVector<Real> & new_vector,
     
     new_vector.close();
 }
+
+
+
+void
+MAST::NonlinearSystem::write_restart(MAST::HDF5RestartFile& file) {
+    
+    LOG_SCOPE("write_restart()", "NonlinearSystem");
+    
+    const std::string
+    root  = "system/" + this->name() + "/";
+    
+    file.write_scalar(root + "time", this->time);
+    file.write_vector(root + "solution", *this->solution);
+    
+    // serial vectors do not have the layout of the dofs and are skipped
+    libMesh::System::const_vectors_iterator
+    it    = this->vectors_begin(),
+    end   = this->vectors_end();
+    
+    for ( ; it != end; it++)
+        if (it->second->type() != libMesh::SERIAL)
+            file.write_vector(root + "vectors/" + it->first, *it->second);
+}
+
+
+
+void
+MAST::NonlinearSystem::read_restart(MAST::HDF5RestartFile& file) {
+    
+    LOG_SCOPE("read_restart()", "NonlinearSystem");
+    
+    const std::string
+    root  = "system/" + this->name() + "/";
+    
+    this->time = file.read_scalar(root + "time");
+    file.read_vector(root + "solution", *this->solution);
+    
+    libMesh::System::vectors_iterator
+    it    = this->vectors_begin(),
+    end   = this->vectors_end();
+    
+    for ( ; it != end; it++)
+        if (it->second->type() != libMesh::SERIAL &&
+            file.contains(root + "vectors/" + it->first))
+            file.read_vector(root + "vectors/" + it->first, *it->second);
+    
+    // localize the solution to current_local_solution
+    this->update();
+}
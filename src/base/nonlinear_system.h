@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <memory>
+#include <vector>
 
 // MAST includes
 #include "base/mast_data_types.h"
@@ -44,6 +45,7 @@ namespace MAST {
     class OutputAssemblyElemOperations;
     class FunctionBase;
     class EigenproblemAssembly;
+    class HDF5RestartFile;
     
     
     /*!
@@ -104,6 +106,51 @@ namespace MAST {
         }
         
         
+        /*!
+         *    sets the block size of the system matrices. If \p bs is
+         *    greater than one, the matrices are stored in the PETSc BAIJ
+         *    format with \p bs x \p bs blocks, which stores one column
+         *    index per block and uses blocked kernels for matrix-vector
+         *    products, ILU and block-Jacobi factorization. This requires
+         *    all \p bs variables of the system to share the same FE type,
+         *    so that libMesh numbers the dofs of each node contiguously.
+         *    If the dof numbering does not allow blocked storage, the
+         *    matrices are created in the AIJ format. Must be called before
+         *    EquationsSystems::init(). The default block size is one.
+         */
+        void set_matrix_block_size(unsigned int bs) {
+            libmesh_assert_greater(bs, 0);
+            _matrix_block_size = bs;
+        }
+        
+        /*!
+         *    @returns the block size used for the system matrices, which
+         *    is one if blocked storage was not requested or not possible.
+         */
+        unsigned int matrix_block_size() const {
+            return _if_blocked_matrices ? _matrix_block_size : 1;
+        }
+        
+        
+        /*!
+         *   If \p f is true, the nonlinear solves use a Jacobian-free
+         *   Newton-Krylov method. The Jacobian-vector products in the Krylov
+         *   iterations are computed by finite differencing of the residual,
+         *   and the Jacobian assembled by the assembly object is used only
+         *   to build the preconditioner. This matrix is reassembled once
+         *   every \p pc_lag Newton iterations, counted across successive
+         *   solves, so that an approximate, lagged Jacobian can be used.
+         *   The finite difference parameters can be changed with the
+         *   PETSc \p -mat_mffd_* options. This is false by default.
+         */
+        void set_jacobian_free_newton_krylov(bool f,
+                                             unsigned int pc_lag = 1) {
+            libmesh_assert_greater(pc_lag, 0);
+            _if_jacobian_free_newton_krylov = f;
+            _jfnk_pc_lag                    = pc_lag;
+        }
+        
+        
         /*!
          * Clear all the data structures associated with
          * the system.
@@ -160,6 +207,26 @@ namespace MAST {
                                    bool if_assemble_jacobian           = true);
         
         
+        /*!
+         *   solves the adjoint problem for all output functions in
+         *   \p outputs. The adjoint of the i-th output is stored in
+         *   \p get_adjoint_solution(i). The output derivatives are
+         *   computed in a single pass over the elements, and the
+         *   preconditioner (or the factorization, for direct solvers) is
+         *   set up for the first right-hand side and reused for the rest.
+         *   The transposed operator is still formed by libMesh in each
+         *   call to \p LinearSolver::adjoint_solve(). The Jacobian will be
+         *   assembled before adjoint solve if \p if_assemble_jacobian is
+         *   \p true.
+         */
+        virtual void adjoint_solve(const libMesh::NumericVector<Real>& X,
+                                   bool if_localize_sol,
+                                   MAST::AssemblyElemOperations&       elem_ops,
+                                   const std::vector<MAST::OutputAssemblyElemOperations*>& outputs,
+                                   MAST::AssemblyBase&                 assembly,
+                                   bool if_assemble_jacobian           = true);
+        
+        
         /**
          * Assembles & solves the eigen system.
          */
@@ -313,6 +380,19 @@ namespace MAST {
                             const std::string & data_name,
                             const bool read_binary_vectors);
 
+        /*!
+         *   writes the solution, time and all parallel vectors of this
+         *   system, which include the transient history and the sensitivity
+         *   and adjoint solutions, to the restart file \p file.
+         */
+        void write_restart(MAST::HDF5RestartFile& file);
+
+        /*!
+         *   reads the data written by \p write_restart(). Vectors of this
+         *   system that are not in \p file are left unchanged.
+         */
+        void read_restart(MAST::HDF5RestartFile& file);
+
         void
         project_vector_without_dirichlet (libMesh::NumericVector<Real> & new_vector,
                                           libMesh::FunctionBase<Real>& f) const;
@@ -348,6 +428,74 @@ namespace MAST {
          */
         bool _initialize_B_matrix;
         
+        /*!
+         *   block size requested for the system matrices
+         */
+        unsigned int _matrix_block_size;
+        
+        /*!
+         *   true if the system matrices are stored in the blocked format
+         */
+        bool _if_blocked_matrices;
+        
+        /*!
+         *   @returns true if the dof numbering and sparsity pattern allow
+         *   storage of the matrices with \p _matrix_block_size.
+         */
+        bool _if_block_compatible() const;
+        
+        /*!
+         *   reinitializes the system matrices in the blocked format if
+         *   a block size greater than one was requested.
+         */
+        void _init_block_matrices();
+        
+        /*!
+         *   true if the near-null space has been attached to the blocked
+         *   system matrix since its last initialization
+         */
+        bool _if_near_null_space_attached;
+        
+        /*!
+         *   attaches the vectors of the near-null space object of the
+         *   nonlinear solver to the blocked system matrix, so that the
+         *   preconditioners of the sensitivity and adjoint solves, such as
+         *   PETSc GAMG, can use them with the node blocks.
+         */
+        void _attach_near_null_space();
+        
+        /*!
+         *   flag to use Jacobian-free Newton-Krylov for nonlinear solves
+         */
+        bool _if_jacobian_free_newton_krylov;
+        
+        /*!
+         *   number of Newton iterations between preconditioner updates
+         *   for the Jacobian-free Newton-Krylov solves
+         */
+        unsigned int _jfnk_pc_lag;
+        
+        /*!
+         *   presolve function set by the user on the nonlinear solver,
+         *   which is called from the Jacobian-free Newton-Krylov presolve
+         *   function during a solve.
+         */
+        void (*_jfnk_user_presolve)(libMesh::NonlinearImplicitSystem&);
+        
+        /*!
+         *   presolve function attached to the nonlinear solver for
+         *   Jacobian-free Newton-Krylov solves. This is called after
+         *   libMesh has set the Jacobian of the SNES object.
+         */
+        static void
+        _jacobian_free_newton_krylov_presolve(libMesh::NonlinearImplicitSystem& s);
+        
+        /*!
+         *   sets the matrix-free operator and the preconditioner lag for
+         *   the PETSc nonlinear solver. \p f = false restores the defaults.
+         */
+        void _set_jacobian_free_newton_krylov_options(bool f);
+        
         
         /**
          * A private flag to indicate whether the condensed dofs
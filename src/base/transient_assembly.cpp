@@ -27,6 +27,7 @@
 #include "solver/transient_solver_base.h"
 #include "numerics/utility.h"
 #include "mesh/geom_elem.h"
+#include "level_set/level_set_narrow_band.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_solver.h"
@@ -38,7 +39,8 @@
 
 MAST::TransientAssembly::TransientAssembly():
 MAST::AssemblyBase       (),
-_post_assembly           (nullptr) {
+_post_assembly           (nullptr),
+_narrow_band             (nullptr) {
 
 }
 
@@ -59,6 +61,60 @@ set_post_assembly_operation(MAST::TransientAssembly::PostAssemblyOperation& post
 
 
 
+void
+MAST::TransientAssembly::
+set_narrow_band(const MAST::LevelSetNarrowBand& band) {
+    
+    _narrow_band = &band;
+}
+
+
+
+void
+MAST::TransientAssembly::clear_narrow_band() {
+    
+    _narrow_band = nullptr;
+}
+
+
+
+void
+MAST::TransientAssembly::
+_add_narrow_band_fixed_dofs(libMesh::SparseMatrix<Real>* J) const {
+    
+    if (!_narrow_band || !J)
+        return;
+    
+    libmesh_assert(_narrow_band->initialized());
+    
+    const std::vector<libMesh::dof_id_type>
+    &dofs = _narrow_band->local_fixed_dofs();
+    
+    for (unsigned int i=0; i<dofs.size(); i++)
+        J->add(dofs[i], dofs[i], 1.);
+}
+
+
+
+void
+MAST::TransientAssembly::
+_add_narrow_band_fixed_dofs(const libMesh::NumericVector<Real>& dX,
+                            libMesh::NumericVector<Real>& JdX) const {
+    
+    if (!_narrow_band)
+        return;
+    
+    libmesh_assert(_narrow_band->initialized());
+    
+    const std::vector<libMesh::dof_id_type>
+    &dofs = _narrow_band->local_fixed_dofs();
+    
+    for (unsigned int i=0; i<dofs.size(); i++)
+        JdX.add(dofs[i], dX(dofs[i]));
+}
+
+
+
 void
 MAST::TransientAssembly::
 residual_and_jacobian (const libMesh::NumericVector<Real>& X,
@@ -114,6 +170,9 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
+        if (_narrow_band && !_narrow_band->if_elem_in_band(*elem))
+            continue;
+        
         dof_map.dof_indices (elem, dof_indices);
         
         MAST::GeomElem geom_elem;
@@ -159,6 +218,9 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         if (J) J->add_matrix(m, dof_indices);
     }
     
+    // dofs outside the narrow band are held fixed
+    _add_narrow_band_fixed_dofs(J);
+    
     // call the post assembly object, if provided by user
     if (_post_assembly)
         _post_assembly->post_assembly(X, R, J, S);
@@ -231,6 +293,9 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
+        if (_narrow_band && !_narrow_band->if_elem_in_band(*elem))
+            continue;
+        
         dof_map.dof_indices (elem, dof_indices);
 
         MAST::GeomElem geom_elem;
@@ -268,6 +333,9 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
         dof_indices.clear();
     }
     
+    // the unit diagonal of the dofs outside the narrow band
+    _add_narrow_band_fixed_dofs(dX, JdX);
+    
     // delete pointers to the local solutions
     for (unsigned int i=0; i<local_qtys.size(); i++) {
         
@@ -328,6 +396,9 @@ sensitivity_assemble (const MAST::FunctionBase& f,
         
         const libMesh::Elem* elem = *el;
         
+        if (_narrow_band && !_narrow_band->if_elem_in_band(*elem))
+            continue;
+        
         dof_map.dof_indices (elem, dof_indices);
         
         MAST::GeomElem geom_elem;
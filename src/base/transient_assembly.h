@@ -33,6 +33,7 @@ namespace MAST {
     // Forward declerations
     class TransientSolverBase;
     class TransientAssemblyElemOperations;
+    class LevelSetNarrowBand;
     
     
     class TransientAssembly:
@@ -77,6 +78,22 @@ namespace MAST {
         void
         set_post_assembly_operation(MAST::TransientAssembly::PostAssemblyOperation& post);
 
+        /*!
+         *    restricts the residual, Jacobian, Jacobian-vector product and
+         *    sensitivity assembly to the elements in \p band. The dofs outside
+         *    the band have a zero residual and sensitivity and a unit diagonal
+         *    in the Jacobian, so that they are not changed by the solver. The
+         *    band must be initialized before assembly.
+         */
+        void
+        set_narrow_band(const MAST::LevelSetNarrowBand& band);
+        
+        /*!
+         *    removes the restriction to a narrow band
+         */
+        void
+        clear_narrow_band();
+
 
         /*!
          *    function that assembles the matrices and vectors quantities for
@@ -126,6 +143,24 @@ namespace MAST {
          */
         MAST::TransientAssembly::PostAssemblyOperation* _post_assembly;
 
+        /*!
+         *    narrow band to which the assembly is restricted, if non-NULL
+         */
+        const MAST::LevelSetNarrowBand* _narrow_band;
+
+        /*!
+         *    adds a unit diagonal in \p J for the dofs held fixed by the
+         *    narrow band
+         */
+        void _add_narrow_band_fixed_dofs(libMesh::SparseMatrix<Real>* J) const;
+
+        /*!
+         *    adds the product of the unit diagonal for the dofs held fixed by
+         *    the narrow band and \p dX to \p JdX
+         */
+        void _add_narrow_band_fixed_dofs(const libMesh::NumericVector<Real>& dX,
+                                         libMesh::NumericVector<Real>& JdX) const;
+
     };
     
     
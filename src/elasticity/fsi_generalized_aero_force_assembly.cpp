@@ -143,17 +143,21 @@ assemble_generalized_aerodynamic_force_matrix
     std::vector<libMesh::dof_id_type> dof_indices;
     
     
+    const libMesh::NumericVector<Real>*
+    localized_solution = nullptr;
     std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
     localized_zero;
-    std::vector<libMesh::NumericVector<Real>*> localized_basis(n_basis);
+    std::vector<const libMesh::NumericVector<Real>*> localized_basis(n_basis);
 
     if (_base_sol)
-        localized_solution.reset(build_localized_vector(_system->system(),
-                                                         *_base_sol).release());
+        localized_solution = &localized_vector(_system->system(),
+                                               *_base_sol,
+                                               "base_solution");
     
     for (unsigned int i=0; i<n_basis; i++)
-        localized_basis[i] = build_localized_vector(_system->system(), *basis[i]).release();
+        localized_basis[i] = &localized_vector(_system->system(),
+                                               *basis[i],
+                                               "basis_" + std::to_string(i));
     
     //create a zero-clone copy for the imaginary component of the solution
     localized_zero.reset(localized_basis[0]->zero_clone().release());
@@ -267,10 +271,10 @@ assemble_generalized_aerodynamic_force_matrix
     if (_sol_function)
         _sol_function->clear();
     
+    // the localized basis vectors are not reused by later assemblies
+    for (unsigned int i=0; i<n_basis; i++)
+        release_localized_vector(_system->system(), "basis_" + std::to_string(i));
     
-    // delete the localized basis vectors
-    for (unsigned int i=0; i<basis.size(); i++)
-        delete localized_basis[i];
     
     // sum the matrix and provide it to each processor
     // this assumes that the structural comm is a subset of fluid comm
@@ -130,7 +130,7 @@ get_constraint_rows
         it->second->get_dof_constraint_row(constraints);
         
         for (unsigned int i=0; i<constraints.size(); i++)
-            constrs.push_back(constraints[i]);
+            constrs.push_back(std::move(constraints[i]));
     }
 
     libmesh_assert_equal_to(constrs.size(), idx);
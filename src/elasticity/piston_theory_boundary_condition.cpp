@@ -20,6 +20,7 @@
 
 // MAST includes
 #include "elasticity/piston_theory_boundary_condition.h"
+#include "base/constant_field_function.h"
 
 
 
@@ -593,3 +594,117 @@ get_dpdxdot_function(const MAST::FieldFunction<Real>& dwdx,
 }
 
 
+
+bool
+MAST::PistonTheoryBoundaryCondition::if_constant_flow() const {
+    
+    return
+    dynamic_cast<const MAST::ConstantFieldFunction*>
+    (&this->get<MAST::FieldFunction<Real> >("V")) &&
+    dynamic_cast<const MAST::ConstantFieldFunction*>
+    (&this->get<MAST::FieldFunction<Real> >("mach")) &&
+    dynamic_cast<const MAST::ConstantFieldFunction*>
+    (&this->get<MAST::FieldFunction<Real> >("rho")) &&
+    dynamic_cast<const MAST::ConstantFieldFunction*>
+    (&this->get<MAST::FieldFunction<Real> >("gamma"));
+}
+
+
+
+void
+MAST::PistonTheoryBoundaryCondition::
+pressure(const std::vector<libMesh::Point>& pts,
+         const Real t,
+         const RealVectorX& dwdx,
+         const RealVectorX& dwdt,
+         RealVectorX& p,
+         RealVectorX* dp_dx,
+         RealVectorX* dp_dxdot) const {
+    
+    const unsigned int
+    n = (unsigned int)pts.size();
+    
+    libmesh_assert_equal_to(dwdx.size(), n);
+    libmesh_assert_equal_to(dwdt.size(), n);
+    
+    p.setZero(n);
+    if (dp_dx)    dp_dx->setZero(n);
+    if (dp_dxdot) dp_dxdot->setZero(n);
+    
+    // the flow coefficients are evaluated at the first point, if the
+    // flow is constant
+    if (n == 0)
+        return;
+    
+    const MAST::FieldFunction<Real>
+    &V_f     = this->get<MAST::FieldFunction<Real> >("V"),
+    &M_f     = this->get<MAST::FieldFunction<Real> >("mach"),
+    &rho_f   = this->get<MAST::FieldFunction<Real> >("rho"),
+    &gamma_f = this->get<MAST::FieldFunction<Real> >("gamma");
+    
+    //
+    //  With u = V dw/dx + Mf dw/dt, the pressure is
+    //     p = f1 (V u + a2 u^2 + a3 u^3/V)
+    //  where  Mf = (M^2-2)/(M^2-1),  f1 = rho/sqrt(M^2-1),
+    //         a2 = (gamma+1)/4 M  for order >= 2, and
+    //         a3 = (gamma+1)/12 M^2 for order 3.
+    //
+    const unsigned int
+    n_coeffs = if_constant_flow()? 1 : n;
+    
+    RealVectorX
+    V   = RealVectorX::Zero(n_coeffs),
+    Mf  = RealVectorX::Zero(n_coeffs),
+    f1  = RealVectorX::Zero(n_coeffs),
+    a2  = RealVectorX::Zero(n_coeffs),
+    a3  = RealVectorX::Zero(n_coeffs);
+    
+    Real
+    M     = 0.,
+    rho   = 0.,
+    gamma = 0.;
+    
+    for (unsigned int i=0; i<n_coeffs; i++) {
+        
+        V_f     (pts[i], t,  V(i));
+        M_f     (pts[i], t,     M);
+        rho_f   (pts[i], t,   rho);
+        gamma_f (pts[i], t, gamma);
+        
+        Mf(i)   = (M*M-2)/(M*M-1);
+        f1(i)   = rho/sqrt(M*M-1.);
+        
+        switch (_order) {
+                
+            case 3:
+                a3(i) = (gamma+1)/12.*M*M;
+            case 2:
+                a2(i) = (gamma+1)/4.*M;
+        }
+    }
+    
+    if (n_coeffs == 1 && n > 1) {
+        
+        V   = RealVectorX::Constant(n,  V(0));
+        Mf  = RealVectorX::Constant(n, Mf(0));
+        f1  = RealVectorX::Constant(n, f1(0));
+        a2  = RealVectorX::Constant(n, a2(0));
+        a3  = RealVectorX::Constant(n, a3(0));
+    }
+    
+    const Eigen::ArrayXd
+    u   = V.array() * dwdx.array() + Mf.array() * dwdt.array(),
+    // derivative of the bracketed term with respect to u
+    c   = V.array() + 2.*a2.array()*u + 3.*a3.array()*u.square()/V.array();
+    
+    p = (f1.array() * (V.array()*u +
+                       a2.array()*u.square() +
+                       a3.array()*u.cube()/V.array())).matrix();
+    
+    if (dp_dx)
+        *dp_dx    = (f1.array() * c * V.array()).matrix();
+    
+    if (dp_dxdot)
+        *dp_dxdot = (f1.array() * c * Mf.array()).matrix();
+}
+
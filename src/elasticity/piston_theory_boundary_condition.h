@@ -220,6 +220,35 @@ namespace MAST {
         std::unique_ptr<MAST::FieldFunction<Real> >
         get_dpdxdot_function(const MAST::FieldFunction<Real>& dwdx,
                              const MAST::FieldFunction<Real>& dwdt) const;
+        
+        
+        /*!
+         *   @returns true if the velocity, Mach number, density and ratio of
+         *   specific heats are all defined by constant field functions. In
+         *   this case, the flow coefficients of the piston theory pressure
+         *   are evaluated only once per call to \p pressure().
+         */
+        bool if_constant_flow() const;
+        
+        
+        /*!
+         *   calculates the piston theory pressure at all points \p pts of
+         *   an element in a single call, for surface slopes \p dwdx and
+         *   normal velocities \p dwdt at these points. The pressure is
+         *   returned in \p p. If provided, the derivatives of the pressure
+         *   with respect to the slope and the normal velocity are returned in
+         *   \p dp_dx and \p dp_dxdot. This provides the same values as the
+         *   functions returned by \p get_pressure_function(),
+         *   \p get_dpdx_function() and \p get_dpdxdot_function(), without
+         *   the per-point evaluation of the flow properties.
+         */
+        void pressure(const std::vector<libMesh::Point>& pts,
+                      const Real t,
+                      const RealVectorX& dwdx,
+                      const RealVectorX& dwdt,
+                      RealVectorX& p,
+                      RealVectorX* dp_dx    = nullptr,
+                      RealVectorX* dp_dxdot = nullptr) const;
 
         
     protected:
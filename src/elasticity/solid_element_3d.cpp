@@ -26,8 +26,10 @@
 #include "base/assembly_base.h"
 #include "base/field_function_base.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/fixed_size_kernels.h"
 #include "mesh/geom_elem.h"
 #include "mesh/fe_base.h"
+#include "utility/assembly_profiler.h"
 #include "property_cards/element_property_card_base.h"
 
 
@@ -181,6 +183,11 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
     std::unique_ptr<MAST::FieldFunction<RealMatrixX> > mat_stiff =
     _property.stiffness_A_matrix(*this);
     
+    // kernel for the constitutive and strain operator products, selected
+    // once for this element topology
+    std::unique_ptr<MAST::StrainOperatorKernelBase>
+    kernel(MAST::build_strain_operator_kernel(n1, n2));
+    
     MAST::FEMOperatorMatrix
     Bmat_lin,
     Bmat_nl_x,
@@ -269,7 +276,10 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
         // get the material matrix
-        (*mat_stiff)(xyz[qp], _time, material_mat);
+        {
+            MAST::AssemblyProfiler::Scope profile(MAST::AssemblyProfiler::PROPERTY_EVALUATION);
+            (*mat_stiff)(xyz[qp], _time, material_mat);
+        }
         
         this->initialize_green_lagrange_strain_operator(qp,
                                                         *fe,
@@ -293,8 +303,7 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
         
         // calculate contribution to the residual
         // linear strain operator
-        Bmat_lin.vector_mult_transpose(vec2_n2, stress);
-        f.topRows(n2) += JxW[qp] * vec2_n2;
+        kernel->add_Bt_vec(JxW[qp], Bmat_lin, stress, f);
         
         if (_property.strain_type() == MAST::NONLINEAR_STRAIN) {
             
@@ -324,12 +333,12 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
             
             ////////////////////////////////////////////////////////
             // B_lin^T C B_lin
-            Bmat_lin.left_multiply(mat1_n1n2, material_mat);
-            Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
-            jac.topLeftCorner(n2, n2) += JxW[qp] * mat2_n2n2;
+            kernel->add_Bt_D_B(JxW[qp], Bmat_lin, material_mat, Bmat_lin, jac);
             
             if (_property.strain_type() == MAST::NONLINEAR_STRAIN) {
                 
+                Bmat_lin.left_multiply(mat1_n1n2, material_mat);
+                
                 // B_x^T mat_x^T C B_lin
                 mat3_3n2 = mat_x.transpose() * mat1_n1n2;
                 Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat3_3n2);
@@ -613,6 +622,11 @@ MAST::StructuralElement3D::internal_residual_sensitivity(const MAST::FunctionBas
     std::unique_ptr<MAST::FieldFunction<RealMatrixX> > mat_stiff =
     _property.stiffness_A_matrix(*this);
     
+    // kernel for the constitutive and strain operator products, selected
+    // once for this element topology
+    std::unique_ptr<MAST::StrainOperatorKernelBase>
+    kernel(MAST::build_strain_operator_kernel(n1, n2));
+    
     MAST::FEMOperatorMatrix
     Bmat_lin,
     Bmat_nl_x,
@@ -661,8 +675,7 @@ MAST::StructuralElement3D::internal_residual_sensitivity(const MAST::FunctionBas
         
         // calculate contribution to the residual
         // linear strain operator
-        Bmat_lin.vector_mult_transpose(vec2_n2, stress);
-        f.topRows(n2) += JxW[qp] * vec2_n2;
+        kernel->add_Bt_vec(JxW[qp], Bmat_lin, stress, f);
         
         if (_property.strain_type() == MAST::NONLINEAR_STRAIN) {
             
@@ -692,12 +705,12 @@ MAST::StructuralElement3D::internal_residual_sensitivity(const MAST::FunctionBas
             
             ////////////////////////////////////////////////////////
             // B_lin^T C B_lin
-            Bmat_lin.left_multiply(mat1_n1n2, material_mat);
-            Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
-            jac.topLeftCorner(n2, n2) += JxW[qp] * mat2_n2n2;
+            kernel->add_Bt_D_B(JxW[qp], Bmat_lin, material_mat, Bmat_lin, jac);
             
             if (_property.strain_type() == MAST::NONLINEAR_STRAIN) {
                 
+                Bmat_lin.left_multiply(mat1_n1n2, material_mat);
+                
                 // B_x^T mat_x^T C B_lin
                 mat3_3n2 = mat_x.transpose() * mat1_n1n2;
                 Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat3_3n2);
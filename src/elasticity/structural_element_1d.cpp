@@ -32,6 +32,7 @@
 #include "base/assembly_base.h"
 #include "mesh/fe_base.h"
 #include "mesh/geom_elem.h"
+#include "utility/assembly_profiler.h"
 
 #define eps 2.2204460492503131e-16 //numpy.spacing(1), used to avoid singular stiffness matrices
 
@@ -618,11 +619,15 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
         // get the material matrix
-        (*mat_stiff_A)(xyz[qp], _time, material_A_mat);
-        
-        if (bend.get()) {
-            (*mat_stiff_B)(xyz[qp], _time, material_B_mat);
-            (*mat_stiff_D)(xyz[qp], _time, material_D_mat);
+        {
+            MAST::AssemblyProfiler::Scope profile(MAST::AssemblyProfiler::PROPERTY_EVALUATION);
+            
+            (*mat_stiff_A)(xyz[qp], _time, material_A_mat);
+            
+            if (bend.get()) {
+                (*mat_stiff_B)(xyz[qp], _time, material_B_mat);
+                (*mat_stiff_D)(xyz[qp], _time, material_D_mat);
+            }
         }
         
         // now calculte the quantity for these matrices
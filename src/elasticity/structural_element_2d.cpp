@@ -25,8 +25,10 @@
 #include "property_cards/element_property_card_2D.h"
 #include "property_cards/material_property_card_base.h"
 #include "numerics/fem_operator_matrix.h"
+#include "numerics/fixed_size_kernels.h"
 #include "mesh/fe_base.h"
 #include "mesh/geom_elem.h"
+#include "utility/assembly_profiler.h"
 #include "base/system_initialization.h"
 #include "base/boundary_condition_base.h"
 #include "base/parameter.h"
@@ -1144,6 +1146,11 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
                                                    *this,
                                                    fe->get_qpoints()).release());
 
+    // kernel for the constitutive and strain operator products, selected
+    // once for this element topology
+    std::unique_ptr<MAST::StrainOperatorKernelBase>
+    kernel(MAST::build_strain_operator_kernel(n1, n2));
+
     std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
     mat_stiff_A  = _property.stiffness_A_matrix(*this),
     mat_stiff_B  = _property.stiffness_B_matrix(*this),
@@ -1152,11 +1159,15 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
         // get the material matrix
-        (*mat_stiff_A)(xyz[qp], _time, material_A_mat);
-        
-        if (bend.get()) {
-            (*mat_stiff_B)(xyz[qp], _time, material_B_mat);
-            (*mat_stiff_D)(xyz[qp], _time, material_D_mat);
+        {
+            MAST::AssemblyProfiler::Scope profile(MAST::AssemblyProfiler::PROPERTY_EVALUATION);
+            
+            (*mat_stiff_A)(xyz[qp], _time, material_A_mat);
+            
+            if (bend.get()) {
+                (*mat_stiff_B)(xyz[qp], _time, material_B_mat);
+                (*mat_stiff_D)(xyz[qp], _time, material_D_mat);
+            }
         }
         
         // now calculte the quantity for these matrices
@@ -1171,6 +1182,7 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
                                      _local_sol,
                                      strain,
                                      bend.get(),
+                                     *kernel,
                                      Bmat_lin,
                                      Bmat_nl_x,
                                      Bmat_nl_y,
@@ -1317,6 +1329,11 @@ MAST::StructuralElement2D::internal_residual_sensitivity (const MAST::FunctionBa
                                                    *this,
                                                    fe->get_qpoints()).release());
 
+    // kernel for the constitutive and strain operator products, selected
+    // once for this element topology
+    std::unique_ptr<MAST::StrainOperatorKernelBase>
+    kernel(MAST::build_strain_operator_kernel(n1, n2));
+
     std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
     mat_stiff_A = _property.stiffness_A_matrix(*this),
     mat_stiff_B = _property.stiffness_B_matrix(*this),
@@ -1347,6 +1364,7 @@ MAST::StructuralElement2D::internal_residual_sensitivity (const MAST::FunctionBa
                                      _local_sol,
                                      strain,
                                      bend.get(),
+                                     *kernel,
                                      Bmat_lin,
                                      Bmat_nl_x,
                                      Bmat_nl_y,
@@ -1478,6 +1496,11 @@ internal_residual_boundary_velocity(const MAST::FunctionBase& p,
                                                    *this,
                                                    fe->get_qpoints()).release());
 
+    // kernel for the constitutive and strain operator products, selected
+    // once for this element topology
+    std::unique_ptr<MAST::StrainOperatorKernelBase>
+    kernel(MAST::build_strain_operator_kernel(n1, n2));
+
     std::unique_ptr<MAST::FieldFunction<RealMatrixX > >
     mat_stiff_A = _property.stiffness_A_matrix(*this),
     mat_stiff_B = _property.stiffness_B_matrix(*this),
@@ -1521,6 +1544,7 @@ internal_residual_boundary_velocity(const MAST::FunctionBase& p,
                                      _local_sol,
                                      strain,
                                      bend.get(),
+                                     *kernel,
                                      Bmat_lin,
                                      Bmat_nl_x,
                                      Bmat_nl_y,
@@ -1775,6 +1799,7 @@ MAST::StructuralElement2D::_internal_residual_operation
  RealVectorX&               local_disp,
  RealVectorX&               strain_mem,
  MAST::BendingOperator2D*   bend,
+ const MAST::StrainOperatorKernelBase& kernel,
  FEMOperatorMatrix&         Bmat_lin,
  FEMOperatorMatrix&         Bmat_nl_x,
  FEMOperatorMatrix&         Bmat_nl_y,
@@ -1813,7 +1838,7 @@ MAST::StructuralElement2D::_internal_residual_operation
                                                     Bmat_nl_u,
                                                     Bmat_nl_v);
 
-    vec2_n1 = material_A_mat * strain_mem; // membrane stress
+    kernel.stress(material_A_mat, strain_mem, vec2_n1); // membrane stress
     
     if (bend) {
 
@@ -1843,8 +1868,7 @@ MAST::StructuralElement2D::_internal_residual_operation
     
     // now the internal force vector
     // this includes the membrane strain operator with all A and B material operators
-    Bmat_lin.vector_mult_transpose(vec3_n2, vec2_n1);
-    local_f.topRows(n2) += JxW[qp] * vec3_n2;
+    kernel.add_Bt_vec(JxW[qp], Bmat_lin, vec2_n1, local_f);
     
     if (_property.strain_type() == MAST::NONLINEAR_STRAIN) {
         
@@ -1877,16 +1901,13 @@ MAST::StructuralElement2D::_internal_residual_operation
         
         // now bending stress
         Bmat_bend.vector_mult(vec2_n1, local_disp);
-        vec1_n1 = material_D_mat * vec2_n1;
-        Bmat_bend.vector_mult_transpose(vec3_n2, vec1_n1);
-        local_f += JxW[qp] * vec3_n2;
+        kernel.stress(material_D_mat, vec2_n1, vec1_n1);
+        kernel.add_Bt_vec(JxW[qp], Bmat_bend, vec1_n1, local_f);
     }
     
     if (request_jacobian) {
         // membrane - membrane
-        Bmat_lin.left_multiply(mat1_n1n2, material_A_mat);
-        Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
-        local_jac += JxW[qp] * mat2_n2n2;
+        kernel.add_Bt_D_B(JxW[qp], Bmat_lin, material_A_mat, Bmat_lin, local_jac);
         
         if (_property.strain_type() == MAST::NONLINEAR_STRAIN) {
 
@@ -2001,19 +2022,13 @@ MAST::StructuralElement2D::_internal_residual_operation
             
             // bending - membrane
             mat3 = material_B_mat.transpose();
-            Bmat_lin.left_multiply(mat1_n1n2, mat3);
-            Bmat_bend.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
-            local_jac += JxW[qp] * mat2_n2n2;
+            kernel.add_Bt_D_B(JxW[qp], Bmat_bend, mat3, Bmat_lin, local_jac);
             
             // membrane - bending
-            Bmat_bend.left_multiply(mat1_n1n2, material_B_mat);
-            Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
-            local_jac += JxW[qp] * mat2_n2n2;
+            kernel.add_Bt_D_B(JxW[qp], Bmat_lin, material_B_mat, Bmat_bend, local_jac);
             
             // bending - bending
-            Bmat_bend.left_multiply(mat1_n1n2, material_D_mat);
-            Bmat_bend.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
-            local_jac += JxW[qp] * mat2_n2n2;
+            kernel.add_Bt_D_B(JxW[qp], Bmat_bend, material_D_mat, Bmat_bend, local_jac);
         }
     }
 }
@@ -2571,6 +2586,16 @@ surface_traction_residual_shifted_boundary(bool request_jacobian,
     stress_grad_dX(2, RealMatrixX::Zero(n1,n2)),
     *stress_grad_mat = request_jacobian?&stress_grad_dX:nullptr;
     
+    // find the projected points corresponding to the boundary quadrature
+    // points
+    std::vector<libMesh::Point>
+    bnd_pts;
+    
+    interface.search_nearest_interface_points(_elem.get_reference_elem(),
+                                              side,
+                                              qpoint,
+                                              _time,
+                                              bnd_pts);
     
     for (unsigned int qp=0; qp<qpoint.size(); qp++) {
         
@@ -2580,13 +2605,8 @@ surface_traction_residual_shifted_boundary(bool request_jacobian,
         
         Bmat.reinit(2*n1, phi_vec);
         
-        // first find the projected point corresponding to this boundary location
-        interface.search_nearest_interface_point(_elem.get_reference_elem(),
-                                                 side,
-                                                 qpoint[qp],
-                                                 _time,
-                                                 bnd_pt);
-        pt(0) = bnd_pt(0); pt(1) = bnd_pt(1); pt(2) = bnd_pt(2);
+        pt = bnd_pts[qp];
+        bnd_pt(0) = pt(0); bnd_pt(1) = pt(1); bnd_pt(2) = pt(2);
         // now evaluate the traction and normal at this projected point
         trac_func   (pt, _time,   trac);
         interface.normal_at_point(pt, _time, normal);
@@ -2729,6 +2749,16 @@ surface_traction_residual_shifted_boundary_sensitivity(const MAST::FunctionBase&
     stress_grad_dX(2, RealMatrixX::Zero(n1,n2)),
     *stress_grad_mat = request_jacobian?&stress_grad_dX:nullptr;
     
+    // find the projected points corresponding to the boundary quadrature
+    // points
+    std::vector<libMesh::Point>
+    bnd_pts;
+    
+    interface.search_nearest_interface_points(_elem.get_reference_elem(),
+                                              side,
+                                              qpoint,
+                                              _time,
+                                              bnd_pts);
     
     for (unsigned int qp=0; qp<qpoint.size(); qp++) {
         
@@ -2738,19 +2768,13 @@ surface_traction_residual_shifted_boundary_sensitivity(const MAST::FunctionBase&
         
         Bmat.reinit(2*n1, phi_vec);
         
-        // first find the projected point corresponding to this boundary location
-        interface.search_nearest_interface_point(_elem.get_reference_elem(),
-                                                 side,
-                                                 qpoint[qp],
-                                                 _time,
-                                                 bnd_pt);
-        interface.search_nearest_interface_point_derivative(p,
-                                                            _elem.get_reference_elem(),
-                                                            side,
-                                                            qpoint[qp],
-                                                            _time,
-                                                            bnd_pt_sens);
-        pt(0) = bnd_pt(0); pt(1) = bnd_pt(1); pt(2) = bnd_pt(2);
+        pt = bnd_pts[qp];
+        bnd_pt(0) = pt(0); bnd_pt(1) = pt(1); bnd_pt(2) = pt(2);
+        
+        // the sensitivity of the projected point is the boundary velocity
+        // at this point
+        bnd_pt_sens.setZero();
+        interface.velocity(p, pt, _time, bnd_pt_sens);
 
         // now evaluate the traction and normal at this projected point
         trac_func(pt, _time,   trac);
@@ -3831,6 +3855,7 @@ piston_theory_residual(bool request_jacobian,
     const std::vector<std::vector<Real> >& phi  = fe->get_phi();
     const unsigned int
     n_phi = (unsigned int)phi.size(),
+    n_qp  = (unsigned int)qpoint.size(),
     n1    = 2,
     n2    = _system.n_vars()*n_phi;
     
@@ -3848,27 +3873,12 @@ piston_theory_residual(bool request_jacobian,
     dynamic_cast<MAST::PistonTheoryBoundaryCondition&>(bc);
 
     
-    // create the constant field functions to pass the dwdx and dwdt values
-    // to the piston theory pressure functions
-    MAST::Parameter
-    dwdx_p  ("dwdx", 0.),
-    dwdt_p  ("dwdt", 0.);
-    
-    MAST::ConstantFieldFunction
-    dwdx_f  ("dwdx", dwdx_p),
-    dwdt_f  ("dwdx", dwdt_p);
-    
-    
-    std::unique_ptr<MAST::FieldFunction<Real> >
-    pressure        (piston_bc.get_pressure_function(dwdx_f, dwdt_f).release()),
-    dpressure_dx    (piston_bc.get_dpdx_function    (dwdx_f, dwdt_f).release()),
-    dpressure_dxdot (piston_bc.get_dpdxdot_function (dwdx_f, dwdt_f).release());
-    
-    FEMOperatorMatrix
-    Bmat_w,         // operator matrix for the w-displacement
-    dBmat;          // operator matrix to calculate the derivativ of w wrt x and y
-    
-    dBmat.reinit(n1, _system.n_vars(), n_phi);
+    // the operators for w and its derivatives are stored for all
+    // quadrature points, so that the pressure for the element can be
+    // evaluated in a single call.
+    std::vector<FEMOperatorMatrix>
+    Bmat_w(n_qp),   // operator matrix for the w-displacement
+    dBmat(n_qp);    // operator matrix to calculate the derivativ of w wrt x and y
     
     RealVectorX
     phi_vec  = RealVectorX::Zero(n_phi),
@@ -3877,7 +3887,12 @@ piston_theory_residual(bool request_jacobian,
     vec_n1   = RealVectorX::Zero(n1),
     vec_n2   = RealVectorX::Zero(n2),
     vel_vec  = RealVectorX::Zero(3),
-    dummy    = RealVectorX::Zero(3);
+    dummy    = RealVectorX::Zero(3),
+    dwdx_val = RealVectorX::Zero(n_qp),
+    dwdt_val = RealVectorX::Zero(n_qp),
+    p_val    = RealVectorX::Zero(n_qp),
+    dp_dx    = RealVectorX::Zero(n_qp),
+    dp_dxdot = RealVectorX::Zero(n_qp);
 
     RealMatrixX
     dwdx            = RealMatrixX::Zero(3,2),
@@ -3891,13 +3906,11 @@ piston_theory_residual(bool request_jacobian,
     // the appropriate component of the w-derivative can be used
     vel_vec = _elem.T_matrix().transpose() * piston_bc.vel_vec();
     
-    Real
-    dwdt_val = 0.,
-    dwdx_val = 0.,
-    p_val    = 0.;
-    
+    // derivative of normal velocity wrt the x and y derivatives of w
+    mat_22(0,0)  =  vel_vec(0);
+    mat_22(1,1)  =  vel_vec(1);
     
-    for (unsigned int qp=0; qp<qpoint.size(); qp++)
+    for (unsigned int qp=0; qp<n_qp; qp++)
     {
 
         // now set the shape function values
@@ -3905,68 +3918,57 @@ piston_theory_residual(bool request_jacobian,
             phi_vec(i_nd) = phi[i_nd][qp];
         
         // initialize the B matrix for only the w-displacement
-        Bmat_w.reinit(n1, _system.n_vars(), n_phi);
-        Bmat_w.set_shape_function(0, 2, phi_vec);  // interpolates w-displacement
+        Bmat_w[qp].reinit(n1, _system.n_vars(), n_phi);
+        Bmat_w[qp].set_shape_function(0, 2, phi_vec);  // interpolates w-displacement
         
         // use the Bmat to calculate the velocity vector. Only the w-displacement
         // is of interest in the local coordinate, since that is the only
         // component normal to the surface.
-        Bmat_w.right_multiply(vec_n1, _local_vel);
-        dwdt_val = vec_n1(0);
+        Bmat_w[qp].right_multiply(vec_n1, _local_vel);
+        dwdt_val(qp) = vec_n1(0);
         
         // get the operators for dw/dx and dw/dy to calculate the
         // normal velocity. We will use the von Karman strain operators
         // for this
+        dBmat[qp].reinit(n1, _system.n_vars(), n_phi);
         this->initialize_von_karman_strain_operator(qp,
                                                     *fe,
                                                     dummy,
                                                     dwdx,
-                                                    dBmat);
+                                                    dBmat[qp]);
 
         // the diagonal of dwdx matrix stores the
-        dwdx_val = 0.;
         for (unsigned int i=0; i<2; i++)
-            dwdx_val  +=  dwdx(i,i) * vel_vec(i);   // (dw/dx_i)*U_inf . n_i
-        
-        // calculate the pressure value
-        dwdx_p = dwdx_val;
-        dwdt_p = dwdt_val;
-        (*pressure)(qpoint[qp], _time, p_val);
-        
+            dwdx_val(qp)  +=  dwdx(i,i) * vel_vec(i);   // (dw/dx_i)*U_inf . n_i
+    }
+    
+    // calculate the pressure and its derivatives at all quadrature points
+    piston_bc.pressure(qpoint, _time,
+                       dwdx_val, dwdt_val,
+                       p_val,
+                       request_jacobian? &dp_dx   : nullptr,
+                       request_jacobian? &dp_dxdot: nullptr);
+    
+    for (unsigned int qp=0; qp<n_qp; qp++)
+    {
         // calculate force
-        force(0) = p_val * normal(2);
-        
+        force(0) = p_val(qp) * normal(2);
         
-        Bmat_w.vector_mult_transpose(vec_n2, force);
+        Bmat_w[qp].vector_mult_transpose(vec_n2, force);
         local_f += JxW[qp] * vec_n2;
         
 
         // calculate the Jacobian if requested
         if (request_jacobian) {
             
-            // we need the derivative of cp wrt normal velocity
-            (*dpressure_dxdot)(qpoint[qp], _time, p_val);
-            
             // calculate the component of Jacobian due to w-velocity
-            Bmat_w.right_multiply_transpose(mat_n2n2, Bmat_w);
-            local_jac_xdot += (JxW[qp] * p_val * normal(2)) * mat_n2n2;
+            Bmat_w[qp].right_multiply_transpose(mat_n2n2, Bmat_w[qp]);
+            local_jac_xdot += (JxW[qp] * dp_dxdot(qp) * normal(2)) * mat_n2n2;
 
-            // now calculate the component of Jacobian
-            (*dpressure_dx)(qpoint[qp], _time, p_val);
-            
-            // derivative wrt x
-            mat_22.setZero(2,2);
-            mat_22(0,0)  =  vel_vec(0);
-            dBmat.left_multiply(mat_n1n2, mat_22);
-            Bmat_w.right_multiply_transpose(mat_n2n2, mat_n1n2);  // v: B^T dB/dx
-            local_jac += (JxW[qp] * p_val * normal(2)) * mat_n2n2;
-            
-            // derivative wrt y
-            mat_22.setZero(2,2);
-            mat_22(1,1)  =  vel_vec(1);
-            dBmat.left_multiply(mat_n1n2, mat_22);
-            Bmat_w.right_multiply_transpose(mat_n2n2, mat_n1n2);  // v: B^T dB/dy
-            local_jac += (JxW[qp] * p_val * normal(2)) * mat_n2n2;
+            // derivative wrt x and y
+            dBmat[qp].left_multiply(mat_n1n2, mat_22);
+            Bmat_w[qp].right_multiply_transpose(mat_n2n2, mat_n1n2);  // v: B^T dB/dx
+            local_jac += (JxW[qp] * dp_dx(qp) * normal(2)) * mat_n2n2;
         }
     }
     
@@ -36,6 +36,7 @@ namespace MAST {
     class BendingOperator2D;
     class BoundaryCondition;
     class FEMOperatorMatrix;
+    class StrainOperatorKernelBase;
     
     
     
@@ -446,6 +447,7 @@ namespace MAST {
                                      RealVectorX&               local_disp,
                                      RealVectorX&               strain_mem,
                                      MAST::BendingOperator2D*   bend,
+                                     const MAST::StrainOperatorKernelBase& kernel,
                                      FEMOperatorMatrix&         Bmat_lin,
                                      FEMOperatorMatrix&         Bmat_nl_x,
                                      FEMOperatorMatrix&         Bmat_nl_y,
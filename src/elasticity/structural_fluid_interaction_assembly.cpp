@@ -35,12 +35,17 @@
 #include "libmesh/dof_map.h"
 #include "libmesh/petsc_nonlinear_solver.h"
 #include "libmesh/petsc_vector.h"
+#include "libmesh/petsc_matrix.h"
+
+// PETSc includes
+#include <petscmat.h>
 
 
 
 MAST::StructuralFluidInteractionAssembly::
 StructuralFluidInteractionAssembly():
 MAST::AssemblyBase(),
+_if_project_assembled_quantities (true),
 _base_sol             (nullptr),
 _base_sol_sensitivity (nullptr) {
     
@@ -110,6 +115,12 @@ assemble_reduced_order_quantity
     
     libmesh_assert(_elem_ops);
     
+    if (_if_project_assembled_quantities) {
+        
+        _project_assembled_quantity(nullptr, basis, mat_qty_map);
+        return;
+    }
+    
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
     unsigned int
@@ -132,15 +143,17 @@ assemble_reduced_order_quantity
     const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
     
     
-    std::unique_ptr<libMesh::NumericVector<Real> > localized_solution;
+    const libMesh::NumericVector<Real>*
+    localized_solution = nullptr;
     if (_base_sol)
-        localized_solution.reset(build_localized_vector(nonlin_sys,
-                                                        *_base_sol).release());
+        localized_solution = &localized_vector(nonlin_sys, *_base_sol, "base_solution");
     
     // also create localized solution vectos for the bassis vectors
-    std::vector<libMesh::NumericVector<Real>*> localized_basis(n_basis);
+    std::vector<const libMesh::NumericVector<Real>*> localized_basis(n_basis);
     for (unsigned int i=0; i<n_basis; i++)
-        localized_basis[i] = build_localized_vector(nonlin_sys, *basis[i]).release();
+        localized_basis[i] = &localized_vector(nonlin_sys,
+                                               *basis[i],
+                                               "basis_" + std::to_string(i));
     
     
     // if a solution function is attached, initialize it
@@ -221,10 +234,10 @@ assemble_reduced_order_quantity
     if (_sol_function)
         _sol_function->clear();
     
+    // the localized basis vectors are not reused by later assemblies
+    for (unsigned int i=0; i<n_basis; i++)
+        release_localized_vector(nonlin_sys, "basis_" + std::to_string(i));
     
-    // delete the localized basis vectors
-    for (unsigned int i=0; i<basis.size(); i++)
-        delete localized_basis[i];
     
     // sum the matrix and provide it to each processor
     it  = mat_qty_map.begin();
@@ -247,6 +260,14 @@ assemble_reduced_order_quantity_sensitivity
  std::map<MAST::StructuralQuantityType, RealMatrixX*>& mat_qty_map) {
     
     
+    libmesh_assert(_elem_ops);
+    
+    if (_if_project_assembled_quantities) {
+        
+        _project_assembled_quantity(&f, basis, mat_qty_map);
+        return;
+    }
+    
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
     unsigned int
@@ -270,25 +291,29 @@ assemble_reduced_order_quantity_sensitivity
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
     
     
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_solution_sens;
+    const libMesh::NumericVector<Real>
+    *localized_solution      = nullptr,
+    *localized_solution_sens = nullptr;
     
     if (_base_sol) {
         
         // make sure that the solution sensitivity is provided
         libmesh_assert(_base_sol_sensitivity);
         
-        localized_solution.reset(build_localized_vector(nonlin_sys,
-                                                        *_base_sol).release());
-        localized_solution_sens.reset(build_localized_vector(nonlin_sys,
-                                                             *_base_sol_sensitivity).release());
+        localized_solution      = &localized_vector(nonlin_sys,
+                                                    *_base_sol,
+                                                    "base_solution");
+        localized_solution_sens = &localized_vector(nonlin_sys,
+                                                    *_base_sol_sensitivity,
+                                                    "base_solution_sensitivity");
     }
     
     // also create localized solution vectos for the bassis vectors
-    std::vector<libMesh::NumericVector<Real>*> localized_basis(n_basis);
+    std::vector<const libMesh::NumericVector<Real>*> localized_basis(n_basis);
     for (unsigned int i=0; i<n_basis; i++)
-        localized_basis[i] = build_localized_vector(nonlin_sys, *basis[i]).release();
+        localized_basis[i] = &localized_vector(nonlin_sys,
+                                               *basis[i],
+                                               "basis_" + std::to_string(i));
     
     
     // if a solution function is attached, initialize it
@@ -373,10 +398,10 @@ assemble_reduced_order_quantity_sensitivity
     if (_sol_function)
         _sol_function->clear();
     
+    // the localized basis vectors are not reused by later assemblies
+    for (unsigned int i=0; i<n_basis; i++)
+        release_localized_vector(nonlin_sys, "basis_" + std::to_string(i));
     
-    // delete the localized basis vectors
-    for (unsigned int i=0; i<basis.size(); i++)
-        delete localized_basis[i];
     
     // sum the matrix and provide it to each processor
     it  = mat_qty_map.begin();
@@ -387,3 +412,220 @@ assemble_reduced_order_quantity_sensitivity
         MAST::parallel_sum(_system->system().comm(), *(it->second));
 }
 
+
+
+
+
+void
+MAST::StructuralFluidInteractionAssembly::
+_project_assembled_quantity
+(const MAST::FunctionBase* f,
+ std::vector<libMesh::NumericVector<Real>*>& basis,
+ std::map<MAST::StructuralQuantityType, RealMatrixX*>& mat_qty_map) {
+    
+    libmesh_assert(_elem_ops);
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    const libMesh::Parallel::Communicator& comm = nonlin_sys.comm();
+    
+    const unsigned int
+    n_basis   = (unsigned int)basis.size(),
+    n_local   = nonlin_sys.n_local_dofs(),
+    first_dof = nonlin_sys.get_dof_map().first_dof();
+    
+    PetscErrorCode   ierr;
+    
+    //////////////////////////////////////////////////////////////////
+    // create a global matrix for each quantity with the sparsity of the
+    // system matrix
+    //////////////////////////////////////////////////////////////////
+    Mat
+    sys_mat = dynamic_cast<libMesh::PetscMatrix<Real>*>(nonlin_sys.matrix)->mat();
+    
+    std::map<MAST::StructuralQuantityType, Mat> qty_mats;
+    std::map<MAST::StructuralQuantityType, libMesh::SparseMatrix<Real>*> qty_sparse_mats;
+    
+    std::map<MAST::StructuralQuantityType, RealMatrixX*>::iterator
+    it  = mat_qty_map.begin(),
+    end = mat_qty_map.end();
+    
+    for ( ; it != end; it++) {
+        
+        Mat m;
+        ierr = MatDuplicate(sys_mat, MAT_DO_NOT_COPY_VALUES, &m);  CHKERRABORT(comm.get(), ierr);
+        qty_mats[it->first]        = m;
+        qty_sparse_mats[it->first] = new libMesh::PetscMatrix<Real>(m, comm);
+        qty_sparse_mats[it->first]->zero();
+    }
+    
+    //////////////////////////////////////////////////////////////////
+    // assemble the global matrices in a single pass over the elements
+    //////////////////////////////////////////////////////////////////
+    RealVectorX vec, sol, dsol;
+    RealMatrixX mat;
+    
+    std::vector<libMesh::dof_id_type> dof_indices;
+    const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
+    
+    const libMesh::NumericVector<Real>
+    *localized_solution      = nullptr,
+    *localized_solution_sens = nullptr;
+    
+    if (_base_sol) {
+        
+        localized_solution = &localized_vector(nonlin_sys,
+                                               *_base_sol,
+                                               "base_solution");
+        if (f) {
+            
+            // make sure that the solution sensitivity is provided
+            libmesh_assert(_base_sol_sensitivity);
+            localized_solution_sens = &localized_vector(nonlin_sys,
+                                                        *_base_sol_sensitivity,
+                                                        "base_solution_sensitivity");
+        }
+    }
+    
+    // if a solution function is attached, initialize it
+    if (_sol_function && _base_sol)
+        _sol_function->init( *_base_sol, false);
+    
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    nonlin_sys.get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    nonlin_sys.get_mesh().active_local_elements_end();
+    
+    MAST::FluidStructureAssemblyElemOperations
+    &ops = dynamic_cast<MAST::FluidStructureAssemblyElemOperations&>(*_elem_ops);
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        dof_map.dof_indices (elem, dof_indices);
+        
+        // get the solution
+        unsigned int ndofs = (unsigned int)dof_indices.size();
+        sol.setZero(ndofs);
+        dsol.setZero(ndofs);
+        vec.setZero(ndofs);
+        mat.setZero(ndofs, ndofs);
+        
+        if (_base_sol) {
+            
+            for (unsigned int i=0; i<dof_indices.size(); i++) {
+                
+                sol(i) = (*localized_solution)(dof_indices[i]);
+                if (f)
+                    dsol(i) = (*localized_solution_sens)(dof_indices[i]);
+            }
+            
+            if (f)
+                ops.use_base_sol_for_sensitivity(true);
+        }
+        
+        MAST::GeomElem geom_elem;
+        _elem_ops->set_elem_data(elem->dim(), *elem, geom_elem);
+        geom_elem.init(*elem, *_system);
+        
+        _elem_ops->init(geom_elem);
+        _elem_ops->set_elem_solution(sol);
+        if (f)
+            _elem_ops->set_elem_solution_sensitivity(dsol);
+        _elem_ops->set_elem_velocity(vec);     // set to zero value
+        _elem_ops->set_elem_acceleration(vec); // set to zero value
+        
+        // now iterative over all qty types in the map and assemble them
+        for (it = mat_qty_map.begin(); it != end; it++) {
+            
+            ops.set_qty_to_evaluate(it->first);
+            if (f)
+                ops.elem_sensitivity_calculations(*f, true, vec, mat);
+            else
+                ops.elem_calculations(true, vec, mat);
+            
+            DenseRealMatrix m;
+            MAST::copy(m, mat);
+            dof_map.constrain_element_matrix(m, dof_indices);
+            qty_sparse_mats[it->first]->add_matrix(m, dof_indices);
+        }
+        
+        _elem_ops->clear_elem();
+    }
+    
+    // if a solution function is attached, clear it
+    if (_sol_function)
+        _sol_function->clear();
+    
+    //////////////////////////////////////////////////////////////////
+    // store the basis as a distributed dense matrix. Each processor
+    // only copies the rows of the dofs that it owns.
+    //////////////////////////////////////////////////////////////////
+    Mat basis_mat;
+    PetscScalar *basis_vals = nullptr;
+    
+    ierr = MatCreateDense(comm.get(),
+                          n_local, PETSC_DECIDE,
+                          nonlin_sys.n_dofs(), n_basis,
+                          nullptr,
+                          &basis_mat);                         CHKERRABORT(comm.get(), ierr);
+    ierr = MatDenseGetArray(basis_mat, &basis_vals);          CHKERRABORT(comm.get(), ierr);
+    
+    for (unsigned int j=0; j<n_basis; j++)
+        for (unsigned int i=0; i<n_local; i++)
+            basis_vals[j*n_local+i] = (*basis[j])(first_dof+i);
+    
+    ierr = MatDenseRestoreArray(basis_mat, &basis_vals);      CHKERRABORT(comm.get(), ierr);
+    ierr = MatAssemblyBegin(basis_mat, MAT_FINAL_ASSEMBLY);   CHKERRABORT(comm.get(), ierr);
+    ierr = MatAssemblyEnd(basis_mat, MAT_FINAL_ASSEMBLY);     CHKERRABORT(comm.get(), ierr);
+    
+    //////////////////////////////////////////////////////////////////
+    // now compute [A] [Phi] with a sparse-dense product, and
+    // [Phi]^T [A] [Phi] from the local rows, followed by a sum over
+    // all processors.
+    //////////////////////////////////////////////////////////////////
+    Mat a_basis_mat = nullptr;
+    const PetscScalar
+    *a_basis_vals   = nullptr,
+    *basis_vals_r   = nullptr;
+    
+    for (it = mat_qty_map.begin(); it != end; it++) {
+        
+        qty_sparse_mats[it->first]->close();
+        
+        ierr = MatMatMult(qty_mats[it->first],
+                          basis_mat,
+                          MAT_INITIAL_MATRIX,
+                          PETSC_DEFAULT,
+                          &a_basis_mat);                       CHKERRABORT(comm.get(), ierr);
+        
+        ierr = MatDenseGetArrayRead(basis_mat, &basis_vals_r);    CHKERRABORT(comm.get(), ierr);
+        ierr = MatDenseGetArrayRead(a_basis_mat, &a_basis_vals);  CHKERRABORT(comm.get(), ierr);
+        
+        Map<const RealMatrixX>
+        phi   (basis_vals_r, n_local, n_basis),
+        a_phi (a_basis_vals, n_local, n_basis);
+        
+        *it->second = phi.transpose() * a_phi;
+        
+        ierr = MatDenseRestoreArrayRead(a_basis_mat, &a_basis_vals); CHKERRABORT(comm.get(), ierr);
+        ierr = MatDenseRestoreArrayRead(basis_mat, &basis_vals_r);   CHKERRABORT(comm.get(), ierr);
+        
+        ierr = MatDestroy(&a_basis_mat);                          CHKERRABORT(comm.get(), ierr);
+        
+        // sum the matrix and provide it to each processor
+        MAST::parallel_sum(comm, *(it->second));
+    }
+    
+    //////////////////////////////////////////////////////////////////
+    // clean up the PETSc data structures
+    //////////////////////////////////////////////////////////////////
+    ierr = MatDestroy(&basis_mat);                            CHKERRABORT(comm.get(), ierr);
+    
+    for (it = mat_qty_map.begin(); it != end; it++) {
+        
+        delete qty_sparse_mats[it->first];
+        ierr = MatDestroy(&qty_mats[it->first]);              CHKERRABORT(comm.get(), ierr);
+    }
+}
@@ -122,10 +122,41 @@ namespace MAST {
          std::map<MAST::StructuralQuantityType, RealMatrixX*>& mat_qty_map);
 
         
+        /*!
+         *   if \p f is true (default), the reduced order quantities are
+         *   computed by assembling the global matrix for each quantity and
+         *   projecting it on the basis stored as a distributed dense
+         *   matrix. Otherwise, each basis vector is localized on every
+         *   processor and the element matrices are projected one at a time.
+         */
+        void set_project_assembled_quantities(bool f) {
+            _if_project_assembled_quantities = f;
+        }
+        
 
     protected:
         
         
+        /*!
+         *   assembles the global matrix of each quantity in \p mat_qty_map
+         *   (or its sensitivity with respect to \p f, if \p f is not
+         *   nullptr) and computes \f$ \Phi^T A \Phi \f$ using a sparse-dense
+         *   matrix product with the basis followed by a parallel reduction.
+         */
+        void
+        _project_assembled_quantity
+        (const MAST::FunctionBase* f,
+         std::vector<libMesh::NumericVector<Real>*>& basis,
+         std::map<MAST::StructuralQuantityType, RealMatrixX*>& mat_qty_map);
+        
+        
+        /*!
+         *   flag to use \p _project_assembled_quantity for the reduced order
+         *   quantities. This is \p true by default.
+         */
+        bool _if_project_assembled_quantities;
+        
+        
         /*!
          *   base solution about which this eigenproblem is defined. This
          *   vector stores the localized values necessary to perform element
@@ -32,7 +32,15 @@ namespace MAST {
     
     /*!
      *  this defines the near-null space of a structural finite element 
-     *  model, which is composed of the six rigid-body nodes.
+     *  model, which is composed of the six rigid-body nodes. When set as
+     *  the \p nearnullspace_object of the nonlinear solver, libMesh
+     *  attaches these vectors to the Jacobian of the nonlinear solves, and
+     *  \p MAST::NonlinearSystem attaches them to the matrix of the
+     *  sensitivity and adjoint solves. Since the structural system
+     *  matrices use 6x6 node blocks (see
+     *  \p MAST::NonlinearSystem::set_matrix_block_size()), PETSc GAMG
+     *  aggregates the nodes and uses these six vectors per node to build
+     *  the coarse spaces.
      */
     
     class StructuralNearNullVectorSpace:
@@ -54,6 +54,11 @@ _stress_output_sys(nullptr) {
     nm = prefix + "_tz";
     _vars[5] = sys.add_variable(nm, fe_type);
 
+    // the six variables share the same FE type, so that the dofs of
+    // each node are numbered contiguously and the matrices can be
+    // stored in 6x6 blocks
+    sys.set_matrix_block_size(6);
+
     
     // now initialize the stress system for output of stress data
     _stress_output_sys  =
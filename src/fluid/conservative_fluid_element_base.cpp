@@ -38,7 +38,9 @@ ConservativeFluidElementBase(MAST::SystemInitialization&    sys,
                              const MAST::GeomElem&           elem,
                              const MAST::FlightCondition&   f):
 MAST::FluidElemBase(elem.dim(), f),
-MAST::ElementBase(sys, elem) {
+MAST::ElementBase(sys, elem),
+_if_frozen_coefficient_jacobian(false),
+_max_spectral_radius(0.) {
     
 }
 
@@ -90,15 +92,22 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
     std::vector<RealMatrixX>
     Ai_adv  (dim);
     
+    // the flux Jacobian sensitivities are not needed for the residual,
+    // or for the Jacobian with frozen coefficients
+    const bool
+    if_sens = request_jacobian && !_if_frozen_coefficient_jacobian;
+    
     std::vector<std::vector<RealMatrixX> >
-    Ai_sens  (dim);
+    Ai_sens  (if_sens?dim:0);
     
     
     for (unsigned int i=0; i<dim; i++) {
-        Ai_sens [i].resize(n1);
         Ai_adv  [i].setZero(n1, n1);
-        for (unsigned int j=0; j<n1; j++)
-            Ai_sens[i][j].setZero(n1, n1);
+        if (if_sens) {
+            Ai_sens [i].resize(n1);
+            for (unsigned int j=0; j<n1; j++)
+                Ai_sens[i][j].setZero(n1, n1);
+        }
     }
     
     
@@ -146,8 +155,9 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
         for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
             
             calculate_advection_flux_jacobian(i_dim, primitive_sol, Ai_adv[i_dim]);
-            calculate_advection_flux_jacobian_sensitivity_for_conservative_variable
-            (i_dim, primitive_sol, Ai_sens[i_dim]);
+            if (if_sens)
+                calculate_advection_flux_jacobian_sensitivity_for_conservative_variable
+                (i_dim, primitive_sol, Ai_sens[i_dim]);
             
             dBmat[i_dim].left_multiply(mat3_n1n2, Ai_adv[i_dim]);
             AiBi_adv += mat3_n1n2;
@@ -234,12 +244,15 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
                 jac -= JxW[qp]*mat4_n2n2;
                 
                 // sensitivity of Ai_Bi with respect to U:   [dAi/dUj.Bi.U  ...  dAi/dUn.Bi.U]
-                dBmat[i_dim].vector_mult(vec1_n1, _sol);
-                for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++) {
+                if (if_sens) {
                     
-                    vec2_n1 = Ai_sens[i_dim][i_cvar] * vec1_n1;
-                    for (unsigned int i_phi=0; i_phi<nphi; i_phi++)
-                        A_sens.col(nphi*i_cvar+i_phi) += phi[i_phi][qp] *vec2_n1; // assuming that all variables have same n_phi
+                    dBmat[i_dim].vector_mult(vec1_n1, _sol);
+                    for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++) {
+                        
+                        vec2_n1 = Ai_sens[i_dim][i_cvar] * vec1_n1;
+                        for (unsigned int i_phi=0; i_phi<nphi; i_phi++)
+                            A_sens.col(nphi*i_cvar+i_phi) += phi[i_phi][qp] *vec2_n1; // assuming that all variables have same n_phi
+                    }
                 }
                 
                 // viscous flux Jacobian
@@ -282,9 +295,12 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
             }
 
             // linearization of the Jacobian terms
-            jac += JxW[qp] * LS.transpose() * A_sens; // LS^T tau d^2F^adv_i / dx dU  (Ai sensitivity)
-                                          // linearization of the LS terms
-            jac += JxW[qp] * LS_sens;
+            if (if_sens) {
+                
+                jac += JxW[qp] * LS.transpose() * A_sens; // LS^T tau d^2F^adv_i / dx dU  (Ai sensitivity)
+                                              // linearization of the LS terms
+                jac += JxW[qp] * LS_sens;
+            }
             
         }
     }
@@ -351,7 +367,7 @@ MAST::ConservativeFluidElementBase::velocity_residual (bool request_jacobian,
     AiBi_adv         = RealMatrixX::Zero(n1, n2),
     A_sens           = RealMatrixX::Zero(n1, n2),
     LS               = RealMatrixX::Zero(n1, n2),
-    LS_sens          = RealMatrixX::Zero(n2, n2);
+    LS_sens;
     RealVectorX
     vec1_n1          = RealVectorX::Zero(n1),
     vec2_n1          = RealVectorX::Zero(n1),
@@ -364,17 +380,16 @@ MAST::ConservativeFluidElementBase::velocity_residual (bool request_jacobian,
     std::vector<RealMatrixX>
     Ai_adv  (dim);
     
+    // LS_sens is not needed for the velocity term, so the flux Jacobian
+    // sensitivities are not computed
     std::vector<std::vector<RealMatrixX> >
-    Ai_sens  (dim);
+    Ai_sens;
     
     
-    for (unsigned int i=0; i<dim; i++) {
-        Ai_sens [i].resize(n1);
+    for (unsigned int i=0; i<dim; i++)
         Ai_adv  [i].setZero(n1, n1);
-        for (unsigned int j=0; j<n1; j++)
-            Ai_sens[i][j].setZero(n1, n1);
-    }
     
+    _max_spectral_radius = 0.;
     
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
@@ -390,6 +405,11 @@ MAST::ConservativeFluidElementBase::velocity_residual (bool request_jacobian,
                            flight_condition->gas_property.cv,
                            if_viscous());
         
+        // the spectral radius for local time-stepping uses the same
+        // quadrature point solution
+        _max_spectral_radius = std::max(_max_spectral_radius,
+                                        calculate_spectral_radius(qp, *fe, primitive_sol));
+        
         // initialize the FEM derivative operator
         _initialize_fem_gradient_operator(qp, dim, *fe, dBmat);
         
@@ -52,6 +52,20 @@ namespace MAST {
         virtual ~ConservativeFluidElementBase();
         
         
+        /*!
+         *   If \p f is true, the Jacobian of the internal residual is
+         *   computed with frozen flux Jacobians and stabilization
+         *   coefficients, which ignores the sensitivity of \f$ A_i \f$ and
+         *   of the least-squares operator with respect to the solution. The
+         *   residual is not affected. This is intended for use as the
+         *   preconditioner matrix of a Jacobian-free Newton-Krylov solver.
+         *   This is false by default.
+         */
+        void set_frozen_coefficient_jacobian(bool f) {
+            _if_frozen_coefficient_jacobian = f;
+        }
+        
+        
         /*!
          *   internal force contribution to system residual
          */
@@ -71,6 +85,18 @@ namespace MAST {
                                       RealMatrixX& jac);
 
         
+        /*!
+         *   @returns the maximum spectral radius of the flux Jacobians over
+         *   the quadrature points of the element, which defines the local
+         *   time-step for a given CFL number. This is computed with the
+         *   quadrature point solutions of the last call to
+         *   \p velocity_residual().
+         */
+        Real max_spectral_radius() const {
+            return _max_spectral_radius;
+        }
+        
+        
         /*!
          *   inertial force contribution to system residual
          */
@@ -243,6 +269,16 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   flag to compute the Jacobian with frozen coefficients
+         */
+        bool _if_frozen_coefficient_jacobian;
+        
+        /*!
+         *   maximum spectral radius over the quadrature points from the
+         *   last call to \p velocity_residual()
+         */
+        Real _max_spectral_radius;
 
         /*!
          *   calculates the surface integrated force vector
@@ -52,6 +52,10 @@ _dim(dim) {
     
     nm = prefix + "_rhoe";
     _vars[dim+1] = sys.add_variable(nm, fe_type);
+    
+    // the conservative variables share the same FE type, so that the
+    // matrices can be stored in blocks of the node dofs
+    sys.set_matrix_block_size(dim+2);
 }
 
 
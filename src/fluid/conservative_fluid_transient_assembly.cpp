@@ -28,7 +28,14 @@
 
 MAST::ConservativeFluidTransientAssemblyElemOperations::
 ConservativeFluidTransientAssemblyElemOperations():
-MAST::TransientAssemblyElemOperations() {
+MAST::TransientAssemblyElemOperations(),
+_if_pseudo_transient  (false),
+_cfl                  (1.),
+_cfl_min              (1.e-3),
+_cfl_max              (1.e5),
+_ser_exponent         (1.),
+_res_prev             (-1.),
+_if_frozen_coefficient_jacobian (false) {
     
 }
 
@@ -68,6 +75,18 @@ elem_calculations(bool if_jac,
     
     //assembly of the capacitance term
     e.velocity_residual(if_jac, f_m, f_m_jac_xdot, f_m_jac);
+    
+    // with local time-stepping the capacitance term is scaled by the
+    // inverse of the element CFL-based time-step
+    if (_if_pseudo_transient) {
+        
+        const Real
+        factor = e.max_spectral_radius()/_cfl;
+        
+        f_m          *= factor;
+        f_m_jac_xdot *= factor;
+        f_m_jac      *= factor;
+    }
 }
 
 
@@ -87,14 +106,22 @@ linearized_jacobian_solution_product(RealVectorX& f) {
     RealMatrixX
     dummy = RealMatrixX::Zero(n, n);
     
+    RealVectorX
+    f_m   = RealVectorX::Zero(n);
+    
     f.setZero();
     
     
     e.linearized_internal_residual(false, f, dummy);
     e.linearized_side_external_residual(false, f, dummy, _discipline->side_loads());
     
-    // velocity term
-    e.linearized_velocity_residual(false, f, dummy, dummy);
+    // velocity term, with the same scaling as in elem_calculations
+    e.linearized_velocity_residual(false, f_m, dummy, dummy);
+    
+    if (_if_pseudo_transient)
+        f_m *= e.max_spectral_radius()/_cfl;
+    
+    f += f_m;
 }
 
 
@@ -127,6 +154,11 @@ elem_sensitivity_calculations(const MAST::FunctionBase& f,
     //assembly of the capacitance term
     e.velocity_residual_sensitivity(f, false, f_m, dummy, dummy);
 
+    // same scaling as in elem_calculations. The sensitivity of the
+    // spectral radius multiplies the capacitance term, which vanishes
+    // at the converged steady state, and is not included.
+    if (_if_pseudo_transient)
+        f_m *= e.max_spectral_radius()/_cfl;
 }
 
 
@@ -151,7 +183,69 @@ init(const MAST::GeomElem& elem) {
     dynamic_cast<MAST::ConservativeFluidDiscipline&>
     (_assembly->discipline()).flight_condition();
     
-    _physics_elem =
-    new MAST::ConservativeFluidElementBase(*_system, elem, p);
+    MAST::ConservativeFluidElementBase*
+    e = new MAST::ConservativeFluidElementBase(*_system, elem, p);
+    e->set_frozen_coefficient_jacobian(_if_frozen_coefficient_jacobian);
+    
+    _physics_elem = e;
+}
+
+
+
+
+void
+MAST::ConservativeFluidTransientAssemblyElemOperations::
+set_pseudo_transient_continuation(bool f,
+                                  const Real cfl_init,
+                                  const Real cfl_max,
+                                  const Real cfl_min) {
+    
+    libmesh_assert_greater(cfl_min, 0.);
+    libmesh_assert_greater_equal(cfl_init, cfl_min);
+    libmesh_assert_greater_equal(cfl_max, cfl_init);
+    
+    _if_pseudo_transient = f;
+    _cfl                 = cfl_init;
+    _cfl_min             = cfl_min;
+    _cfl_max             = cfl_max;
+    _res_prev            = -1.;
 }
 
+
+
+bool
+MAST::ConservativeFluidTransientAssemblyElemOperations::
+update_cfl(const Real res_norm,
+           const bool if_converged) {
+    
+    libmesh_assert(_if_pseudo_transient);
+    
+    // growth of the residual by more than this factor in a single step is
+    // treated the same as a failure of the Newton iterations
+    const Real
+    max_res_growth = 10.,
+    cfl_cut        = 0.1;
+    
+    if ((!if_converged ||
+         (_res_prev > 0. && res_norm > max_res_growth * _res_prev)) &&
+        _cfl > _cfl_min) {
+        
+        // the residual of the rejected step is not used for the next
+        // update
+        _cfl = std::max(_cfl * cfl_cut, _cfl_min);
+        
+        libMesh::out
+        << "Pseudo-transient continuation: rejecting step and reducing CFL to "
+        << _cfl << std::endl;
+        
+        return false;
+    }
+    else if (_res_prev > 0. && res_norm > 0.)
+        _cfl = std::min(std::max(_cfl * pow(_res_prev/res_norm, _ser_exponent),
+                                 _cfl_min),
+                        _cfl_max);
+    
+    _res_prev = res_norm;
+    
+    return true;
+}
@@ -124,10 +124,89 @@ namespace MAST {
          */
         virtual void
         init(const MAST::GeomElem& elem);
-
+        
+        
+        /*!
+         *   If \p f is true, the velocity terms of each element are scaled
+         *   by the inverse of a local time-step, defined by the CFL number
+         *   and the spectral radius of the element flux Jacobians. The
+         *   pseudo-time step of each element is then
+         *   \f$ \Delta t_e = CFL \, dt / \lambda_e \f$, where \p dt
+         *   is the time-step of the transient solver, which should be set
+         *   to unity for a steady-state solution. The CFL number starts at
+         *   \p cfl_init and is updated within the bounds
+         *   [\p cfl_min, \p cfl_max] with \p update_cfl().
+         */
+        void set_pseudo_transient_continuation(bool f,
+                                               const Real cfl_init = 1.,
+                                               const Real cfl_max  = 1.e5,
+                                               const Real cfl_min  = 1.e-3);
+        
+        
+        /*!
+         *   @returns the current CFL number for pseudo-transient continuation
+         */
+        Real cfl() const {
+            return _cfl;
+        }
+        
+        
+        /*!
+         *   updates the CFL number using the switched-evolution-relaxation
+         *   strategy, \f$ CFL_{n+1} = CFL_n \, (\|r_{n-1}\|/\|r_n\|)^p \f$,
+         *   with \p res_norm as the norm of the steady-state residual (or
+         *   of its pseudo-time rate) after the last time-step. If
+         *   \p if_converged is false, which happens if Newton iterations
+         *   for the last time-step stalled, or if the residual grew
+         *   significantly, then the CFL number is reduced instead and the
+         *   step is rejected.
+         *   @returns false if the step is rejected, in which case the
+         *   user should restore the solution from the previous time-step
+         *   and repeat the step with the reduced CFL number. A step taken
+         *   at the minimum CFL number is always accepted.
+         */
+        bool update_cfl(const Real res_norm,
+                        const bool if_converged = true);
+        
+        
+        /*!
+         *   If \p f is true, the element Jacobians are computed with frozen
+         *   flux Jacobians and stabilization coefficients. This should be
+         *   used along with \p MAST::NonlinearSystem::set_jacobian_free_newton_krylov(),
+         *   where the assembled Jacobian is used only for preconditioning.
+         */
+        void set_frozen_coefficient_jacobian(bool f) {
+            _if_frozen_coefficient_jacobian = f;
+        }
+        
     protected:
         
+        /*!
+         *   flag for pseudo-transient continuation with local time-steps
+         */
+        bool _if_pseudo_transient;
+        
+        /*!
+         *   current, minimum and maximum CFL numbers
+         */
+        Real _cfl, _cfl_min, _cfl_max;
+        
+        /*!
+         *   exponent for the switched-evolution-relaxation update of the
+         *   CFL number
+         */
+        Real _ser_exponent;
+        
+        /*!
+         *   residual norm from the previous call to \p update_cfl().
+         *   This is negative if not yet set.
+         */
+        Real _res_prev;
         
+        /*!
+         *   flag to compute the element Jacobians with frozen coefficients
+         */
+        bool _if_frozen_coefficient_jacobian;
     };
     
     
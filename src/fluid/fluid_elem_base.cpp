@@ -22,6 +22,7 @@
 
 // MAST includes
 #include "fluid/fluid_elem_base.h"
+#include "fluid/fluid_flux_kernels.h"
 #include "fluid/primitive_fluid_solution.h"
 #include "fluid/small_disturbance_primitive_fluid_solution.h"
 #include "fluid/flight_condition.h"
@@ -44,6 +45,9 @@ flight_condition(&f),
 dim(d),
 _dissipation_scaling(1.) {
     
+    // the kernel for the flux Jacobians is chosen once for the element
+    // dimension
+    _flux_kernel = MAST::build_fluid_flux_kernel(dim, f.gas_property);
     
     // prepare the variable vector
     _active_primitive_vars.push_back(RHO_PRIM);
@@ -341,84 +345,7 @@ calculate_conservative_variable_jacobian(const MAST::PrimitiveSolution& sol,
                                          RealMatrixX& dcons_dprim,
                                          RealMatrixX& dprim_dcons) {
     
-    
-    // calculate Ai = d F_adv / d x_i, where F_adv is the Euler advection flux vector
-    
-    const unsigned int n1 = 2 + dim;
-    
-    dcons_dprim.setZero();
-    dprim_dcons.setZero();
-    
-    const Real u1 = sol.u1,
-    u2 = sol.u2,
-    u3 = sol.u3,
-    rho = sol.rho,
-    k = sol.k,
-    e_tot = sol.e_tot,
-    cv = flight_condition->gas_property.cv;
-    
-    switch (dim)
-    {
-        case 3:
-        {
-            dcons_dprim(3, 0) = u3;
-            dcons_dprim(3, 3) = rho;
-            
-            dcons_dprim(n1-1, 3) = rho*u3;
-        }
-            
-        case 2:
-        {
-            dcons_dprim(2, 0) = u2;
-            dcons_dprim(2, 2) = rho;
-            
-            dcons_dprim(n1-1, 2) = rho*u2;
-        }
-            
-        case 1:
-        {
-            dcons_dprim(0, 0) = 1.;
-            
-            dcons_dprim(1, 0) = u1;
-            dcons_dprim(1, 1) = rho;
-            
-            dcons_dprim(n1-1, 0) = e_tot;
-            dcons_dprim(n1-1, 1) = rho*u1;
-            dcons_dprim(n1-1, n1-1) = rho*cv;
-        }
-    }
-    
-    switch (dim)
-    {
-        case 3:
-        {
-            dprim_dcons(3, 0) = -u3/rho;
-            dprim_dcons(3, 3) = 1./rho;
-            
-            dprim_dcons(n1-1, 3) = -u3/cv/rho;
-        }
-            
-        case 2:
-        {
-            dprim_dcons(2, 0) = -u2/rho;
-            dprim_dcons(2, 2) = 1./rho;
-            
-            dprim_dcons(n1-1, 2) = -u2/cv/rho;
-        }
-            
-        case 1:
-        {
-            dprim_dcons(0, 0) = 1.;
-            
-            dprim_dcons(1, 0) = -u1/rho;
-            dprim_dcons(1, 1) = 1./rho;
-            
-            dprim_dcons(n1-1, 0) = (-e_tot+2*k)/cv/rho;
-            dprim_dcons(n1-1, 1) = -u1/cv/rho;
-            dprim_dcons(n1-1, n1-1) = 1./cv/rho;
-        }
-    }
-    
+    _flux_kernel->conservative_variable_jacobian(sol, dcons_dprim, dprim_dcons);
 }
 
 
@@ -429,141 +356,8 @@ calculate_advection_flux_jacobian(const unsigned int calculate_dim,
                                   const MAST::PrimitiveSolution& sol,
                                   RealMatrixX& mat) {
     
-    
     // calculate Ai = d F_adv / d x_i, where F_adv is the Euler advection flux vector
-    
-    const unsigned int n1 = 2 + dim;
-    
-    mat.setZero();
-    
-    const Real u1 = sol.u1,
-    u2 = sol.u2,
-    u3 = sol.u3,
-    k = sol.k,
-    e_tot = sol.e_tot,
-    T = sol.T,
-    gamma = flight_condition->gas_property.gamma,
-    R = flight_condition->gas_property.R,
-    cv = flight_condition->gas_property.cv;
-    
-    switch (calculate_dim)
-    {
-        case 0:
-        {
-            switch (dim)
-            {
-                case 3:
-                {
-                    mat(1, 3) = -u3*R/cv;
-                    
-                    mat(3, 0) = -u1*u3;
-                    mat(3, 1) = u3;
-                    mat(3, 3) = u1;
-                    
-                    mat(n1-1, 3) = -u1*u3*R/cv;
-                }
-                    
-                case 2:
-                {
-                    mat(1, 2) = -u2*R/cv;
-                    
-                    mat(2, 0) = -u1*u2;
-                    mat(2, 1) = u2;
-                    mat(2, 2) = u1;
-                    
-                    mat(n1-1, 2) = -u1*u2*R/cv;
-                }
-                    
-                case 1:
-                {
-                    mat(0, 1) = 1.0; // d U / d (rho u1)
-                    
-                    mat(1, 0) = -u1*u1+R*k/cv;
-                    mat(1, 1) = u1*(2.0-R/cv);
-                    mat(1, n1-1) = R/cv;
-                    
-                    mat(n1-1, 0) = u1*(R*(-e_tot+2.0*k)-e_tot*cv)/cv;
-                    mat(n1-1, 1) = e_tot+R*(T-u1*u1/cv);
-                    mat(n1-1, n1-1) = u1*gamma;
-                }
-                    break;
-            }
-        }
-            break;
-            
-        case 1:
-        {
-            switch (dim)
-            {
-                case 3:
-                {
-                    mat(2, 3) = -u3*R/cv;
-                    
-                    mat(3, 0) = -u2*u3;
-                    mat(3, 2) = u3;
-                    mat(3, 3) = u2;
-                    
-                    mat(n1-1, 3) = -u2*u3*R/cv;
-                }
-                    
-                case 2:
-                {
-                    mat(0, 2) = 1.0; // d U / d (rho u2)
-                    
-                    mat(1, 0) = -u1*u2;
-                    mat(1, 1) = u2;
-                    mat(1, 2) = u1;
-                    
-                    mat(2, 0) = -u2*u2+R*k/cv;
-                    mat(2, 1) = -u1*R/cv;
-                    mat(2, 2) = u2*(2.0-R/cv);
-                    mat(2, n1-1) = R/cv;
-                    
-                    mat(n1-1, 0) = u2*(R*(-e_tot+2.0*k)-e_tot*cv)/cv;
-                    mat(n1-1, 1) = -u1*u2*R/cv;
-                    mat(n1-1, 2) = e_tot+R*(T-u2*u2/cv);
-                    mat(n1-1, n1-1) = u2*gamma;
-                }
-                    break;
-                    
-                case 1:
-                    // if second coordinate divergence is being asked for, then the element is atleast 2D
-                    libmesh_assert_msg(false, "invalid dim");
-                    break;
-            }
-        }
-            break;
-            
-        case 2:
-        {
-            mat(0, 3) = 1.0; // d U / d (rho u3)
-            
-            mat(1, 0) = -u1*u3;
-            mat(1, 1) = u3;
-            mat(1, 3) = u1;
-            
-            mat(2, 0) = -u2*u3;
-            mat(2, 2) = u3;
-            mat(2, 3) = u2;
-            
-            mat(3, 0) = -u3*u3+R*k/cv;
-            mat(3, 1) = -u1*R/cv;
-            mat(3, 2) = -u2*R/cv;
-            mat(3, 3) = u3*(2.0-R/cv);
-            mat(3, n1-1) = R/cv;
-            
-            mat(n1-1, 0) = u3*(R*(-e_tot+2.0*k)-e_tot*cv)/cv;
-            mat(n1-1, 1) = -u1*u3*R/cv;
-            mat(n1-1, 2) = -u2*u3*R/cv;
-            mat(n1-1, 3) = e_tot+R*(T-u3*u3/cv);
-            mat(n1-1, n1-1) = u3*gamma;
-        }
-            break;
-            
-        default:
-            libmesh_assert_msg(false, "invalid dim");
-            break;
-    }
+    _flux_kernel->advection_flux_jacobian(calculate_dim, sol, mat);
 }
 
 
@@ -977,28 +771,8 @@ calculate_advection_flux_jacobian_sensitivity_for_conservative_variable
  const MAST::PrimitiveSolution& sol,
  std::vector<RealMatrixX >& jac) {
     
-    const unsigned int n1 = 2 + dim;
-    
-    RealMatrixX
-    dprim_dcons      = RealMatrixX::Zero(n1, n1),
-    mat              = RealMatrixX::Zero(n1, n1);
-    
-    for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
-        jac[i_cvar].setZero();
-    
-    this->calculate_conservative_variable_jacobian(sol, mat, dprim_dcons);
-    
-    // calculate based on chain rule of the primary variables
-    for (unsigned int i_pvar=0; i_pvar<n1; i_pvar++) // iterate over the primitive variables for chain rule
-    {
-        this->calculate_advection_flux_jacobian_sensitivity_for_primitive_variable
-        (calculate_dim, i_pvar, sol, mat);
-        for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
-        {
-            if (fabs(dprim_dcons(i_pvar, i_cvar)) > 0.0)
-                jac[i_cvar] += dprim_dcons(i_pvar, i_cvar) * mat;
-        }
-    }
+    _flux_kernel->advection_flux_jacobian_sensitivity_for_conservative_variable
+    (calculate_dim, sol, jac);
 }
 
 
@@ -1949,6 +1723,65 @@ calculate_barth_tau_matrix (const unsigned int qp,
 
 
 
+Real
+MAST::FluidElemBase::
+calculate_spectral_radius (const unsigned int qp,
+                           const MAST::FEBase& fe,
+                           const MAST::PrimitiveSolution& sol) const {
+    
+    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi =
+    fe.get_dphi(); // assuming that all variables have the same interpolation
+    
+    RealVectorX
+    u                = RealVectorX::Zero(dim),
+    dN               = RealVectorX::Zero(dim);
+    
+    switch (dim)
+    {
+        case 3:
+            u(2) = sol.u3;
+            
+        case 2:
+            u(1) = sol.u2;
+            
+        case 1:
+            u(0) = sol.u1;
+            break;
+            
+        default:
+            break;
+    }
+    
+    // the streamwise element length is the same as that used in the
+    // Aliabadi stabilization. For a fluid at rest, the maximum shape
+    // function gradient is used instead.
+    Real h = 0., u_val = u.norm();
+    if (u_val > 0.)
+        u /= u_val;
+    
+    for (unsigned int i_nodes=0; i_nodes<dphi.size(); i_nodes++)
+    {
+        for (unsigned int i_dim=0; i_dim<dim; i_dim++)
+            dN(i_dim) = dphi[i_nodes][qp](i_dim);
+        
+        h += (u_val > 0.)? fabs(dN.dot(u)) : dN.norm();
+    }
+    
+    h = 2.0/h;
+    
+    Real
+    lambda = 2.0/h*(u_val+sol.a);
+    
+    if (_if_viscous)
+        lambda += 4.0/h/h *
+        std::max(sol.mu, sol.k_thermal/flight_condition->gas_property.cp)/sol.rho;
+    
+    return lambda;
+}
+
+
+
+
 bool
 MAST::FluidElemBase::
 calculate_aliabadi_tau_matrix (const unsigned int qp,
@@ -2500,13 +2333,19 @@ calculate_differential_operator_matrix (const unsigned int qp,
     const std::vector<std::vector<Real> >& phi =
     fe.get_phi(); // assuming that all variables have the same interpolation
     const unsigned int n_phi = (unsigned int) phi.size();
+    
+    // LS_sens is computed only if the flux Jacobian sensitivities
+    // are provided
+    const bool if_sens = Ai_sens.size() > 0;
+    
     std::vector<RealMatrixX > tau_sens(n1);
     for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
         tau_sens[i_cvar].setZero(n1, n1);
     
     // contribution of unsteady term
     LS_operator.setZero();
-    LS_sens.setZero();
+    if (if_sens)
+        LS_sens.setZero();
     
     bool if_diagonal_tau = false;
     
@@ -2518,6 +2357,18 @@ calculate_differential_operator_matrix (const unsigned int qp,
     if_diagonal_tau = this->calculate_barth_tau_matrix
     (qp, fe, sol, tau, tau_sens);
     
+    // tau times the strong form of residual, and its sensitivity, are
+    // the same for all directions
+    RealMatrixX
+    dtau_vec2;
+    if (if_sens) {
+        
+        vec1 = tau * vec2;
+        dtau_vec2.setZero(n1, n1);
+        for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
+            dtau_vec2.col(i_cvar) = tau_sens[i_cvar] * vec2;
+    }
+    
     // contribution of advection flux term
     for (unsigned int i=0; i<dim; i++)
     {
@@ -2525,23 +2376,15 @@ calculate_differential_operator_matrix (const unsigned int qp,
         dB_mat[i].left_multiply(mat2, mat);
         LS_operator += mat2;  // A_i^T dB/dx_i
         
+        if (!if_sens)
+            continue;
         
         // sensitivity of the LS operator times strong form of residual
-        // Bi^T dAi/dalpha tau
-        vec1 = tau * vec2;
-        for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
-        {
-            vec3 = Ai_sens[i][i_cvar] * vec1;
-            dB_mat[i].vector_mult_transpose(vec4_n2, vec3);
-            for (unsigned int i_phi=0; i_phi<n_phi; i_phi++)
-                LS_sens.col((n_phi*i_cvar)+i_phi) += phi[i_phi][qp] * vec4_n2;
-        }
-        
-        // Bi^T Ai dtau/dalpha
+        // Bi^T (dAi/dalpha tau + Ai dtau/dalpha)
         for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
         {
-            vec1 = tau_sens[i_cvar] * vec2;
-            vec3 = Ai_advection[i] * vec1;
+            vec3  = Ai_sens[i][i_cvar] * vec1;
+            vec3 += Ai_advection[i] * dtau_vec2.col(i_cvar);
             dB_mat[i].vector_mult_transpose(vec4_n2, vec3);
             for (unsigned int i_phi=0; i_phi<n_phi; i_phi++)
                 LS_sens.col((n_phi*i_cvar)+i_phi) += phi[i_phi][qp] * vec4_n2;
@@ -23,6 +23,7 @@
 // C++ includes
 #include <ostream>
 #include <map>
+#include <memory>
 
 // MAST includes
 #include "base/mast_data_types.h"
@@ -41,6 +42,7 @@ namespace MAST {
     class PrimitiveSolution;
     template <typename ValType> class SmallPerturbationPrimitiveSolution;
     class FEBase;
+    class FluidFluxKernelBase;
     
     /*!
      *   enumeration of the primitive fluid variables
@@ -394,6 +396,16 @@ namespace MAST {
                                            RealMatrixX& tau,
                                            std::vector<RealMatrixX >& tau_sens);
         
+        /*!
+         *   @returns the spectral radius of the advection and diffusion
+         *   operators at quadrature point \p qp, based on the streamwise
+         *   element length used in the SUPG stabilization matrix. This is
+         *   used to define the local time-step for a CFL number.
+         */
+        Real calculate_spectral_radius(const unsigned int qp,
+                                       const MAST::FEBase& fe,
+                                       const MAST::PrimitiveSolution& sol) const;
+        
         void calculate_hartmann_discontinuity_operator
         (const unsigned int qp,
          const MAST::FEBase& fe,
@@ -426,6 +438,12 @@ namespace MAST {
          RealVectorX& discontinuity_val);
         
         
+        /*!
+         *   calculates the least-squares stabilization operator
+         *   \p LS_operator. Its linearization with respect to the
+         *   conservative variables, \p LS_sens, is calculated only if
+         *   \p Ai_sens is not empty, otherwise \p LS_sens is not modified.
+         */
         void calculate_differential_operator_matrix
         (const unsigned int qp,
          const MAST::FEBase& fe,
@@ -450,6 +468,11 @@ namespace MAST {
         bool _include_pressure_switch;
         
         Real _dissipation_scaling;
+        
+        /*!
+         *   kernel for the flux Jacobians of the element dimension
+         */
+        std::unique_ptr<MAST::FluidFluxKernelBase> _flux_kernel;
     };
     
     
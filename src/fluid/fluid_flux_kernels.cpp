@@ -0,0 +1,50 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "fluid/fluid_flux_kernels.h"
+
+
+std::unique_ptr<MAST::FluidFluxKernelBase>
+MAST::build_fluid_flux_kernel(unsigned int dim,
+                              const MAST::GasProperty& gas) {
+    
+    std::unique_ptr<MAST::FluidFluxKernelBase> rval;
+    
+    switch (dim) {
+            
+        case 1:
+            rval.reset(new MAST::FluidFluxKernel<1>(gas));
+            break;
+            
+        case 2:
+            rval.reset(new MAST::FluidFluxKernel<2>(gas));
+            break;
+            
+        case 3:
+            rval.reset(new MAST::FluidFluxKernel<3>(gas));
+            break;
+            
+        default:
+            libmesh_error_msg("Invalid dimension for fluid flux kernel: " << dim);
+    }
+    
+    return rval;
+}
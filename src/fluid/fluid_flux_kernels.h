@@ -0,0 +1,340 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__fluid_flux_kernels_h__
+#define __mast__fluid_flux_kernels_h__
+
+// C++ includes
+#include <memory>
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "fluid/gas_property.h"
+#include "fluid/primitive_fluid_solution.h"
+
+
+namespace MAST {
+
+    /*!
+     *   Interface for the ideal-gas flux Jacobians of the conservative
+     *   fluid variables. The specializations use compile-time sized
+     *   \f$ (d+2) \times (d+2) \f$ matrices for spatial dimension \f$ d \f$,
+     *   so that the Jacobians are evaluated without branching on the
+     *   dimension. An object of this class is created once per element
+     *   using \p MAST::build_fluid_flux_kernel(), so that the dispatch on
+     *   the dimension is not repeated at each quadrature point.
+     */
+    class FluidFluxKernelBase {
+        
+    public:
+        
+        FluidFluxKernelBase(unsigned int dim,
+                            const MAST::GasProperty& gas):
+        _dim(dim),
+        _gas(gas)
+        { }
+        
+        virtual ~FluidFluxKernelBase() { }
+        
+        /*!
+         *   @returns the spatial dimension of the kernel
+         */
+        unsigned int dim() const { return _dim; }
+        
+        /*!
+         *   calculates \f$ A_i = \partial F^{adv}_i / \partial U \f$ for
+         *   \p i_dim and returns it in \p mat.
+         */
+        virtual void
+        advection_flux_jacobian(const unsigned int             i_dim,
+                                const MAST::PrimitiveSolution& sol,
+                                RealMatrixX&                   mat) const = 0;
+        
+        /*!
+         *   calculates \f$ \partial A_i / \partial U_j \f$ for
+         *   \p i_dim and returns it in \p jac[j].
+         */
+        virtual void
+        advection_flux_jacobian_sensitivity_for_conservative_variable
+        (const unsigned int             i_dim,
+         const MAST::PrimitiveSolution& sol,
+         std::vector<RealMatrixX>&      jac) const = 0;
+        
+        /*!
+         *   calculates the Jacobian of conservative variables with respect
+         *   to the primitive variables, and its inverse.
+         */
+        virtual void
+        conservative_variable_jacobian(const MAST::PrimitiveSolution& sol,
+                                       RealMatrixX&                   dcons_dprim,
+                                       RealMatrixX&                   dprim_dcons) const = 0;
+        
+    protected:
+        
+        const unsigned int _dim;
+        
+        const MAST::GasProperty& _gas;
+    };
+    
+    
+    
+    /*!
+     *   Implementation of the flux Jacobians for spatial dimension \p Dim.
+     */
+    template <int Dim>
+    class FluidFluxKernel:
+    public MAST::FluidFluxKernelBase {
+        
+    public:
+        
+        enum { N1 = Dim+2 };
+        
+        typedef Matrix<Real, N1, N1> FluxMatType;
+        
+        FluidFluxKernel(const MAST::GasProperty& gas):
+        MAST::FluidFluxKernelBase(Dim, gas)
+        { }
+        
+        virtual ~FluidFluxKernel() { }
+        
+        
+        virtual void
+        advection_flux_jacobian(const unsigned int             i_dim,
+                                const MAST::PrimitiveSolution& sol,
+                                RealMatrixX&                   mat) const {
+            
+            libmesh_assert_less(i_dim, Dim);
+            
+            FluxMatType A;
+            _advection_flux_jacobian(i_dim, sol, A);
+            mat = A;
+        }
+        
+        
+        virtual void
+        advection_flux_jacobian_sensitivity_for_conservative_variable
+        (const unsigned int             i_dim,
+         const MAST::PrimitiveSolution& sol,
+         std::vector<RealMatrixX>&      jac) const {
+            
+            libmesh_assert_less(i_dim, Dim);
+            libmesh_assert_equal_to(jac.size(), N1);
+            
+            const Real
+            u[3]  = {sol.u1, sol.u2, sol.u3},
+            rho   = sol.rho,
+            k     = sol.k,
+            e_tot = sol.e_tot,
+            cv    = _gas.cv;
+            
+            FluxMatType
+            dA_dT,
+            dA_du[Dim],
+            mat0;
+            
+            _advection_flux_jacobian_temperature_sensitivity(i_dim, sol, dA_dT);
+            for (unsigned int m=0; m<Dim; m++)
+                _advection_flux_jacobian_velocity_sensitivity(i_dim, m, sol, dA_du[m]);
+            
+            // chain rule with the derivative of primitive variables with
+            // respect to the conservative variables. The flux Jacobian does
+            // not depend on density for a fixed velocity and temperature.
+            mat0 = (-e_tot+2.*k)/cv/rho * dA_dT;
+            for (unsigned int m=0; m<Dim; m++) {
+                
+                mat0          -= u[m]/rho * dA_du[m];
+                jac[m+1]       = 1./rho * dA_du[m] - u[m]/cv/rho * dA_dT;
+            }
+            jac[0]             = mat0;
+            jac[N1-1]          = 1./cv/rho * dA_dT;
+        }
+        
+        
+        virtual void
+        conservative_variable_jacobian(const MAST::PrimitiveSolution& sol,
+                                       RealMatrixX&                   dcons_dprim,
+                                       RealMatrixX&                   dprim_dcons) const {
+            
+            const Real
+            u[3]  = {sol.u1, sol.u2, sol.u3},
+            rho   = sol.rho,
+            k     = sol.k,
+            e_tot = sol.e_tot,
+            cv    = _gas.cv;
+            
+            FluxMatType
+            dc_dp = FluxMatType::Zero(),
+            dp_dc = FluxMatType::Zero();
+            
+            dc_dp(0, 0)       = 1.;
+            dc_dp(N1-1, 0)    = e_tot;
+            dc_dp(N1-1, N1-1) = rho*cv;
+            
+            dp_dc(0, 0)       = 1.;
+            dp_dc(N1-1, 0)    = (-e_tot+2*k)/cv/rho;
+            dp_dc(N1-1, N1-1) = 1./cv/rho;
+            
+            for (unsigned int m=0; m<Dim; m++) {
+                
+                dc_dp(m+1, 0)     = u[m];
+                dc_dp(m+1, m+1)   = rho;
+                dc_dp(N1-1, m+1)  = rho*u[m];
+                
+                dp_dc(m+1, 0)     = -u[m]/rho;
+                dp_dc(m+1, m+1)   = 1./rho;
+                dp_dc(N1-1, m+1)  = -u[m]/cv/rho;
+            }
+            
+            dcons_dprim = dc_dp;
+            dprim_dcons = dp_dc;
+        }
+        
+    protected:
+        
+        /*!
+         *   flux Jacobian in direction \p d. The velocity components
+         *   normal to \p d only appear in rows and columns of the
+         *   corresponding momentum, so that all dimensions share this form.
+         */
+        void
+        _advection_flux_jacobian(const unsigned int             d,
+                                 const MAST::PrimitiveSolution& sol,
+                                 FluxMatType&                   A) const {
+            
+            const Real
+            u[3]  = {sol.u1, sol.u2, sol.u3},
+            ud    = u[d],
+            k     = sol.k,
+            e_tot = sol.e_tot,
+            T     = sol.T,
+            gamma = _gas.gamma,
+            R     = _gas.R,
+            cv    = _gas.cv;
+            
+            A.setZero();
+            
+            A(0, d+1)       = 1.0; // d U / d (rho u_d)
+            
+            for (unsigned int j=0; j<Dim; j++) {
+                
+                if (j == d)
+                    continue;
+                
+                A(j+1, 0)     = -ud*u[j];
+                A(j+1, d+1)   = u[j];
+                A(j+1, j+1)   = ud;
+                
+                A(d+1, j+1)   = -u[j]*R/cv;
+                A(N1-1, j+1)  = -ud*u[j]*R/cv;
+            }
+            
+            A(d+1, 0)       = -ud*ud+R*k/cv;
+            A(d+1, d+1)     = ud*(2.0-R/cv);
+            A(d+1, N1-1)    = R/cv;
+            
+            A(N1-1, 0)      = ud*(R*(-e_tot+2.0*k)-e_tot*cv)/cv;
+            A(N1-1, d+1)    = e_tot+R*(T-ud*ud/cv);
+            A(N1-1, N1-1)   = ud*gamma;
+        }
+        
+        
+        /*!
+         *   derivative of the flux Jacobian in direction \p d with
+         *   respect to the velocity component \p m
+         */
+        void
+        _advection_flux_jacobian_velocity_sensitivity
+        (const unsigned int             d,
+         const unsigned int             m,
+         const MAST::PrimitiveSolution& sol,
+         FluxMatType&                   A) const {
+            
+            const Real
+            u[3]  = {sol.u1, sol.u2, sol.u3},
+            ud    = u[d],
+            k     = sol.k,
+            e_tot = sol.e_tot,
+            gamma = _gas.gamma,
+            R     = _gas.R,
+            cv    = _gas.cv,
+            dd    = (m == d)? 1.: 0.;
+            
+            A.setZero();
+            
+            for (unsigned int j=0; j<Dim; j++) {
+                
+                if (j == d)
+                    continue;
+                
+                const Real
+                dj    = (m == j)? 1.: 0.,
+                duduj = dd*u[j] + dj*ud;        // d(u_d u_j)/du_m
+                
+                A(j+1, 0)     = -duduj;
+                A(j+1, d+1)   = dj;
+                A(j+1, j+1)   = dd;
+                
+                A(d+1, j+1)   = -dj*R/cv;
+                A(N1-1, j+1)  = -duduj*R/cv;
+            }
+            
+            A(d+1, 0)       = -2.*ud*dd + R*u[m]/cv;
+            A(d+1, d+1)     = dd*(2.0-R/cv);
+            
+            A(N1-1, 0)      = dd*(R*(-e_tot+2.0*k)-e_tot*cv)/cv + ud*u[m]*(R-cv)/cv;
+            A(N1-1, d+1)    = u[m] - 2.*R*ud*dd/cv;
+            A(N1-1, N1-1)   = dd*gamma;
+        }
+        
+        
+        /*!
+         *   derivative of the flux Jacobian in direction \p d with
+         *   respect to temperature
+         */
+        void
+        _advection_flux_jacobian_temperature_sensitivity
+        (const unsigned int             d,
+         const MAST::PrimitiveSolution& sol,
+         FluxMatType&                   A) const {
+            
+            const Real
+            u[3]  = {sol.u1, sol.u2, sol.u3},
+            R     = _gas.R,
+            cv    = _gas.cv;
+            
+            A.setZero();
+            
+            A(N1-1, 0)      = -u[d]*(cv+R);
+            A(N1-1, d+1)    = cv+R;
+        }
+    };
+    
+    
+    /*!
+     *   @returns the flux Jacobian kernel for spatial dimension \p dim
+     *   using the gas properties in \p gas.
+     */
+    std::unique_ptr<MAST::FluidFluxKernelBase>
+    build_fluid_flux_kernel(unsigned int dim,
+                            const MAST::GasProperty& gas);
+}
+
+
+#endif // __mast__fluid_flux_kernels_h__
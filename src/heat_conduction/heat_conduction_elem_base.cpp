@@ -29,6 +29,7 @@
 #include "base/assembly_base.h"
 #include "mesh/fe_base.h"
 #include "mesh/geom_elem.h"
+#include "utility/assembly_profiler.h"
 #include "property_cards/element_property_card_base.h"
 
 
@@ -89,7 +90,10 @@ MAST::HeatConductionElementBase::internal_residual (bool request_jacobian,
             dynamic_cast<MAST::MeshFieldFunction*>
             (_active_sol_function)->set_element_quadrature_point_solution(vec1);
         
-        (*conductance)(xyz[qp], _time, material_mat);
+        {
+            MAST::AssemblyProfiler::Scope profile(MAST::AssemblyProfiler::PROPERTY_EVALUATION);
+            (*conductance)(xyz[qp], _time, material_mat);
+        }
 
         _initialize_fem_gradient_operator(qp, dim, *fe, dBmat);
         
@@ -46,6 +46,9 @@ MAST::LevelSetBoundaryVelocity::init(MAST::SystemInitialization& sys,
     
     _phi             = &phi;
     _mesh            = &sys.system().get_mesh();
+    
+    if (_level_set_func)
+        this->update_interface();
 }
 
 
@@ -56,6 +59,7 @@ MAST::LevelSetBoundaryVelocity::clear() {
     _phi            = nullptr;
     _mesh           = nullptr;
     _level_set_func = nullptr;
+    _interface.reset();
 }
 
 
@@ -123,6 +127,9 @@ attach_level_set_function(const MAST::FieldFunction<Real>& phi) {
     libmesh_assert(!_level_set_func);
     
     _level_set_func  = &phi;
+    
+    if (_mesh)
+        this->update_interface();
 }
 
 
@@ -130,6 +137,21 @@ void
 MAST::LevelSetBoundaryVelocity::clear_level_set_function() {
     
     _level_set_func = nullptr;
+    _interface.reset();
+}
+
+
+
+void
+MAST::LevelSetBoundaryVelocity::update_interface() {
+    
+    libmesh_assert(_mesh);
+    libmesh_assert(_level_set_func);
+    
+    if (!_interface)
+        _interface.reset(new MAST::LevelSetInterface(_mesh->comm(), _dim));
+    
+    _interface->init(*_level_set_func, *_mesh);
 }
 
 
@@ -144,6 +166,16 @@ search_nearest_interface_point(const libMesh::Elem& e,
     
     libmesh_assert(_level_set_func);
     
+    libMesh::Point p2;
+    
+    // an empty interface has no closest point, in which case the
+    // neighbor is searched
+    if (_interface && _interface->closest_point(p, p2)) {
+        
+        pt(0) = p2(0); pt(1) = p2(1); pt(2) = p2(2);
+        return;
+    }
+    
     MAST::LevelSetIntersection intersection;
     
     const libMesh::Elem*
@@ -156,7 +188,6 @@ search_nearest_interface_point(const libMesh::Elem& e,
                       _mesh->max_elem_id(),
                       _mesh->max_node_id());
 
-    libMesh::Point p2;
     intersection.get_nearest_intersection_point(p, p2);
     pt(0) = p2(0); pt(1) = p2(1); pt(2) = p2(2);
 //    std::fstream o;
@@ -166,6 +197,30 @@ search_nearest_interface_point(const libMesh::Elem& e,
 }
 
 
+void
+MAST::LevelSetBoundaryVelocity::
+search_nearest_interface_points(const libMesh::Elem& e,
+                                const unsigned int side,
+                                const std::vector<libMesh::Point>& p,
+                                const Real t,
+                                std::vector<libMesh::Point>& pts) const {
+    
+    if (_interface && _interface->closest_points(p, pts))
+        return;
+    
+    RealVectorX
+    pt = RealVectorX::Zero(3);
+    
+    pts.resize(p.size());
+    
+    for (unsigned int i=0; i<p.size(); i++) {
+        
+        this->search_nearest_interface_point(e, side, p[i], t, pt);
+        pts[i] = libMesh::Point(pt(0), pt(1), pt(2));
+    }
+}
+
+
 void
 MAST::LevelSetBoundaryVelocity::
 search_nearest_interface_point_derivative(const MAST::FunctionBase& f,
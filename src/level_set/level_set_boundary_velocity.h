@@ -20,8 +20,12 @@
 #ifndef __mast__level_set_boundary_velocity_h__
 #define __mast__level_set_boundary_velocity_h__
 
+// C++ includes
+#include <memory>
+
 // MAST includes
 #include "base/mesh_field_function.h"
+#include "level_set/level_set_interface.h"
 
 
 namespace MAST {
@@ -51,7 +55,10 @@ namespace MAST {
 
         /*!
          * attaches the level set function \p phi with this object. This is necessary only when the
-         * interface point functions are used.
+         * interface point functions are used. If the mesh is available, the interface is
+         * extracted here from the current values of \p phi. The extracted interface is not
+         * updated when \p phi changes, for example with the design variables, so
+         * \p update_interface() must be called on all ranks after each change.
          */
         void attach_level_set_function(const MAST::FieldFunction<Real>& phi);
 
@@ -60,12 +67,49 @@ namespace MAST {
          */
         void clear_level_set_function();
         
+        /*!
+         * extracts the zero level set of the attached level set function as
+         * explicit facets and builds the search tree used by the
+         * interface point searches. This is called by \p init() and
+         * \p attach_level_set_function() once both the mesh and the level
+         * set function are available, and should be called again on all
+         * ranks if the level set function changes.
+         */
+        void update_interface();
+        
+        /*!
+         * @returns the explicit interface, or \p nullptr if it has not
+         * been extracted.
+         */
+        const MAST::LevelSetInterface* interface() const {
+            return _interface.get();
+        }
+        
+        /*!
+         * identifies the point \p pt on the interface closest to \p p. If
+         * the interface has been extracted and is not empty, this is a
+         * search in the bounding-volume hierarchy of \p interface(),
+         * otherwise the closest intersection node of the neighbor of \p e
+         * across \p side is returned.
+         */
         void search_nearest_interface_point(const libMesh::Elem& e,
                                             const unsigned int side,
                                             const libMesh::Point& p,
                                             const Real t,
                                             RealVectorX& pt) const;
 
+        /*!
+         * identifies the interface points closest to each of the points in
+         * \p p, which are typically the quadrature points on \p side of
+         * \p e. The searches in the extracted interface are distributed
+         * over the libMesh thread pool.
+         */
+        void search_nearest_interface_points(const libMesh::Elem& e,
+                                             const unsigned int side,
+                                             const std::vector<libMesh::Point>& p,
+                                             const Real t,
+                                             std::vector<libMesh::Point>& pts) const;
+
         void search_nearest_interface_point_derivative(const MAST::FunctionBase& f,
                                                        const libMesh::Elem& e,
                                                        const unsigned int side,
@@ -119,6 +163,7 @@ namespace MAST {
         const MAST::MeshFieldFunction*   _phi;
         libMesh::MeshBase*               _mesh;
         const MAST::FieldFunction<Real>* _level_set_func;
+        std::unique_ptr<MAST::LevelSetInterface> _interface;
     };
 }
 
@@ -0,0 +1,485 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+#include <limits>
+
+// MAST includes
+#include "level_set/level_set_interface.h"
+#include "level_set/level_set_intersection.h"
+
+// libMesh includes
+#include "libmesh/mesh_base.h"
+#include "libmesh/elem.h"
+#include "libmesh/parallel.h"
+#include "libmesh/threads.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   computes the closest interface points for a range of query points
+     *   on one thread
+     */
+    class LevelSetInterfaceClosestPoints {
+    public:
+        
+        LevelSetInterfaceClosestPoints(const MAST::LevelSetInterface& interface,
+                                       const std::vector<libMesh::Point>& p,
+                                       std::vector<libMesh::Point>& pt):
+        _interface (interface),
+        _p         (p),
+        _pt        (pt)
+        { }
+        
+        void operator() (const libMesh::Threads::BlockedRange<unsigned int>& r) const {
+            
+            for (unsigned int i=r.begin(); i<r.end(); i++)
+                _interface.closest_point(_p[i], _pt[i]);
+        }
+        
+    protected:
+        
+        const MAST::LevelSetInterface&      _interface;
+        const std::vector<libMesh::Point>&  _p;
+        std::vector<libMesh::Point>&        _pt;
+    };
+}
+
+
+
+MAST::LevelSetInterface::LevelSetInterface(const libMesh::Parallel::Communicator& comm_in,
+                                           const unsigned int dim):
+libMesh::ParallelObject (comm_in),
+_dim                    (dim) {
+    
+    libmesh_assert(dim == 2 || dim == 3);
+}
+
+
+
+MAST::LevelSetInterface::~LevelSetInterface() {
+    
+}
+
+
+
+void
+MAST::LevelSetInterface::init(const MAST::FieldFunction<Real>& phi,
+                              const libMesh::MeshBase& mesh) {
+    
+    std::vector<const libMesh::Elem*>
+    elems(mesh.active_local_elements_begin(),
+          mesh.active_local_elements_end());
+    
+    this->init(phi, mesh, elems);
+}
+
+
+
+void
+MAST::LevelSetInterface::init(const MAST::FieldFunction<Real>& phi,
+                              const libMesh::MeshBase& mesh,
+                              const std::vector<const libMesh::Elem*>& elems) {
+    
+    this->clear();
+    
+    libMesh::Point
+    x[3];
+    
+    for (unsigned int e=0; e<elems.size(); e++) {
+        
+        MAST::LevelSetIntersection intersection;
+        intersection.init(phi, *elems[e], 0., mesh.max_elem_id(), mesh.max_node_id());
+        
+        if (intersection.if_elem_has_boundary()) {
+            
+            // the interface is the set of sides of the positive-phi
+            // sub-elements that lie on the zero level set
+            const std::vector<const libMesh::Elem*>&
+            sub_elems = intersection.get_sub_elems_positive_phi();
+            
+            for (unsigned int i=0; i<sub_elems.size(); i++) {
+                
+                if (!intersection.has_side_on_interface(*sub_elems[i]))
+                    continue;
+                
+                std::unique_ptr<const libMesh::Elem>
+                s(sub_elems[i]->side_ptr(intersection.get_side_on_interface(*sub_elems[i])).release());
+                
+                if (_dim == 2) {
+                    
+                    x[0] = s->point(0);
+                    x[1] = s->point(1);
+                    this->add_facet(x);
+                }
+                else {
+                    
+                    // faces are split into triangles about the first vertex
+                    for (unsigned int j=1; j+1<s->n_vertices(); j++) {
+                        
+                        x[0] = s->point(0);
+                        x[1] = s->point(j);
+                        x[2] = s->point(j+1);
+                        this->add_facet(x);
+                    }
+                }
+            }
+        }
+    }
+    
+    // the closest point of a local query point can be on a facet
+    // extracted on another rank, so all facets are stored on all ranks
+    std::vector<Real>
+    coords(3*_x.size(), 0.);
+    
+    for (unsigned int i=0; i<_x.size(); i++)
+        for (unsigned int j=0; j<3; j++)
+            coords[3*i+j] = _x[i](j);
+    
+    this->comm().allgather(coords, false);
+    
+    _x.clear();
+    _centroid.clear();
+    
+    for (unsigned int i=0; i<coords.size()/(3*_dim); i++) {
+        
+        for (unsigned int j=0; j<_dim; j++)
+            x[j] = libMesh::Point(coords[3*(i*_dim+j)],
+                                  coords[3*(i*_dim+j)+1],
+                                  coords[3*(i*_dim+j)+2]);
+        this->add_facet(x);
+    }
+    
+    this->build_tree();
+}
+
+
+
+void
+MAST::LevelSetInterface::clear() {
+    
+    _x.clear();
+    _centroid.clear();
+    _facet_ids.clear();
+    _nodes.clear();
+}
+
+
+
+void
+MAST::LevelSetInterface::add_facet(const libMesh::Point* x) {
+    
+    libMesh::Point
+    c;
+    
+    for (unsigned int i=0; i<_dim; i++) {
+        
+        _x.push_back(x[i]);
+        c += x[i];
+    }
+    
+    _centroid.push_back(c/(1.*_dim));
+}
+
+
+
+void
+MAST::LevelSetInterface::build_tree() {
+    
+    _nodes.clear();
+    _facet_ids.resize(_centroid.size());
+    
+    for (unsigned int i=0; i<_facet_ids.size(); i++)
+        _facet_ids[i] = i;
+    
+    if (_facet_ids.size()) {
+        
+        // a balanced binary tree has fewer than 2n/leaf_size nodes
+        _nodes.reserve(2*_facet_ids.size());
+        _build_node(0, (unsigned int)_facet_ids.size());
+    }
+}
+
+
+
+unsigned int
+MAST::LevelSetInterface::_build_node(unsigned int begin,
+                                     unsigned int end) {
+    
+    const unsigned int
+    max_leaf_facets = 4,
+    id              = (unsigned int)_nodes.size();
+    
+    _nodes.push_back(TreeNode());
+    
+    // bounding box of the facets and of their centroids
+    libMesh::Point
+    lo, hi, c_lo, c_hi;
+    
+    const Real
+    big = std::numeric_limits<Real>::max();
+    
+    for (unsigned int j=0; j<3; j++) {
+        lo(j) = c_lo(j) =  big;
+        hi(j) = c_hi(j) = -big;
+    }
+    
+    for (unsigned int i=begin; i<end; i++) {
+        
+        const unsigned int f = _facet_ids[i];
+        
+        for (unsigned int j=0; j<3; j++) {
+            
+            for (unsigned int k=0; k<_dim; k++) {
+                lo(j) = std::min(lo(j), _x[f*_dim+k](j));
+                hi(j) = std::max(hi(j), _x[f*_dim+k](j));
+            }
+            
+            c_lo(j) = std::min(c_lo(j), _centroid[f](j));
+            c_hi(j) = std::max(c_hi(j), _centroid[f](j));
+        }
+    }
+    
+    _nodes[id].lo    = lo;
+    _nodes[id].hi    = hi;
+    _nodes[id].first = begin;
+    _nodes[id].n     = end - begin;
+    _nodes[id].left  = 0;
+    _nodes[id].right = 0;
+    
+    if (end - begin <= max_leaf_facets)
+        return id;
+    
+    // split at the median centroid along the longest extent of the
+    // centroid bounding box
+    unsigned int
+    axis = 0;
+    
+    for (unsigned int j=1; j<3; j++)
+        if (c_hi(j) - c_lo(j) > c_hi(axis) - c_lo(axis))
+            axis = j;
+    
+    const unsigned int
+    mid  = (begin + end)/2;
+    
+    std::nth_element(_facet_ids.begin() + begin,
+                     _facet_ids.begin() + mid,
+                     _facet_ids.begin() + end,
+                     [this, axis](unsigned int a, unsigned int b) {
+                         return _centroid[a](axis) < _centroid[b](axis);
+                     });
+    
+    // the vector of nodes may be reallocated by the recursive calls, so
+    // the node is accessed by its index
+    const unsigned int
+    left  = _build_node(begin, mid),
+    right = _build_node(mid,   end);
+    
+    _nodes[id].n     = 0;
+    _nodes[id].left  = left;
+    _nodes[id].right = right;
+    
+    return id;
+}
+
+
+
+bool
+MAST::LevelSetInterface::closest_point(const libMesh::Point& p,
+                                       libMesh::Point& pt) const {
+    
+    pt = p;
+    
+    if (_nodes.empty())
+        return false;
+    
+    Real
+    d_min = std::numeric_limits<Real>::max();
+    
+    // squared distance from p to the bounding box of a node
+    auto
+    box_dist = [&p](const TreeNode& nd) {
+        Real d = 0., v = 0.;
+        for (unsigned int j=0; j<3; j++) {
+            v = std::max(std::max(nd.lo(j) - p(j), p(j) - nd.hi(j)), 0.);
+            d += v*v;
+        }
+        return d;
+    };
+    
+    // depth-first search that visits the nearer child first and skips
+    // nodes whose boxes are farther than the closest point found so far
+    std::vector<unsigned int>
+    stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    
+    libMesh::Point
+    x;
+    
+    while (!stack.empty()) {
+        
+        const TreeNode&
+        nd = _nodes[stack.back()];
+        stack.pop_back();
+        
+        if (box_dist(nd) >= d_min)
+            continue;
+        
+        if (nd.n) {
+            
+            for (unsigned int i=nd.first; i<nd.first+nd.n; i++) {
+                
+                x = _closest_point_on_facet(_facet_ids[i], p);
+                
+                const Real d = (x - p).norm_sq();
+                if (d < d_min) {
+                    d_min = d;
+                    pt    = x;
+                }
+            }
+        }
+        else {
+            
+            const Real
+            d_l = box_dist(_nodes[nd.left]),
+            d_r = box_dist(_nodes[nd.right]);
+            
+            if (d_l < d_r) {
+                stack.push_back(nd.right);
+                stack.push_back(nd.left);
+            }
+            else {
+                stack.push_back(nd.left);
+                stack.push_back(nd.right);
+            }
+        }
+    }
+    
+    return true;
+}
+
+
+
+bool
+MAST::LevelSetInterface::closest_points(const std::vector<libMesh::Point>& p,
+                                        std::vector<libMesh::Point>& pt) const {
+    
+    if (_nodes.empty()) {
+        
+        pt = p;
+        return false;
+    }
+    
+    pt.resize(p.size());
+    
+    libMesh::Threads::parallel_for
+    (libMesh::Threads::BlockedRange<unsigned int>(0, (unsigned int)p.size()),
+     MAST::LevelSetInterfaceClosestPoints(*this, p, pt));
+    
+    return true;
+}
+
+
+
+libMesh::Point
+MAST::LevelSetInterface::_closest_point_on_facet(unsigned int i,
+                                                 const libMesh::Point& p) const {
+    
+    const libMesh::Point
+    &a  = _x[i*_dim],
+    &b  = _x[i*_dim+1];
+    
+    const libMesh::Point
+    ab  = b - a,
+    ap  = p - a;
+    
+    if (_dim == 2) {
+        
+        const Real
+        l2 = ab.norm_sq();
+        
+        if (l2 == 0.)
+            return a;
+        
+        const Real
+        t  = std::min(std::max((ap * ab)/l2, 0.), 1.);
+        
+        return a + t * ab;
+    }
+    
+    // closest point on a triangle, following the Voronoi region tests
+    // in Ericson, Real-Time Collision Detection, Sec. 5.1.5
+    const libMesh::Point
+    &c  = _x[i*_dim+2],
+    ac  = c - a;
+    
+    const Real
+    d1  = ab * ap,
+    d2  = ac * ap;
+    
+    if (d1 <= 0. && d2 <= 0.)
+        return a;
+    
+    const libMesh::Point
+    bp  = p - b;
+    
+    const Real
+    d3  = ab * bp,
+    d4  = ac * bp;
+    
+    if (d3 >= 0. && d4 <= d3)
+        return b;
+    
+    const Real
+    vc  = d1*d4 - d3*d2;
+    
+    if (vc <= 0. && d1 >= 0. && d3 <= 0.)
+        return a + (d1 / (d1 - d3)) * ab;
+    
+    const libMesh::Point
+    cp  = p - c;
+    
+    const Real
+    d5  = ab * cp,
+    d6  = ac * cp;
+    
+    if (d6 >= 0. && d5 <= d6)
+        return c;
+    
+    const Real
+    vb  = d5*d2 - d1*d6;
+    
+    if (vb <= 0. && d2 >= 0. && d6 <= 0.)
+        return a + (d2 / (d2 - d6)) * ac;
+    
+    const Real
+    va  = d3*d6 - d5*d4;
+    
+    if (va <= 0. && (d4 - d3) >= 0. && (d5 - d6) >= 0.)
+        return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b);
+    
+    const Real
+    denom = 1. / (va + vb + vc);
+    
+    return a + (vb * denom) * ab + (vc * denom) * ac;
+}
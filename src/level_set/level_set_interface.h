@@ -0,0 +1,173 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__level_set_interface_h__
+#define __mast__level_set_interface_h__
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/parallel_object.h"
+#include "libmesh/point.h"
+
+
+namespace libMesh {
+    class MeshBase;
+    class Elem;
+}
+
+
+namespace MAST {
+    
+    // Forward declerations
+    template <typename ValType> class FieldFunction;
+    
+    /*!
+     *   Explicit representation of the zero level set as line segments in
+     *   2D and triangles in 3D. The facets are extracted from the sides of
+     *   the positive-phi sub-elements created by
+     *   \p MAST::LevelSetIntersection that lie on the interface, gathered
+     *   from all ranks and stored in a bounding-volume hierarchy of
+     *   axis-aligned boxes, so that the closest point on the interface is
+     *   found in \f$ O(\log n) \f$ operations for \p n facets. The
+     *   facets are a snapshot of the level set at the time of \p init(),
+     *   and are not updated when the level set changes. The extraction
+     *   must be repeated with \p init() after every change, typically
+     *   once per design.
+     */
+    class LevelSetInterface:
+    public libMesh::ParallelObject {
+        
+    public:
+        
+        LevelSetInterface(const libMesh::Parallel::Communicator& comm_in,
+                          const unsigned int dim);
+        
+        virtual ~LevelSetInterface();
+        
+        /*!
+         *   extracts the zero level set of \p phi on the active local
+         *   elements of \p mesh and builds the search tree. This must be
+         *   called on all ranks of the communicator.
+         */
+        void init(const MAST::FieldFunction<Real>& phi,
+                  const libMesh::MeshBase& mesh);
+        
+        /*!
+         *   extracts the zero level set of \p phi on the local elements
+         *   \p elems of \p mesh, which must include all local elements
+         *   intersected by the level set, and builds the search tree. This
+         *   must be called on all ranks of the communicator.
+         */
+        void init(const MAST::FieldFunction<Real>& phi,
+                  const libMesh::MeshBase& mesh,
+                  const std::vector<const libMesh::Elem*>& elems);
+        
+        void clear();
+        
+        /*!
+         *   @returns the number of segments or triangles on the interface
+         */
+        unsigned int n_facets() const {
+            return (unsigned int)_centroid.size();
+        }
+        
+        /*!
+         *   adds a facet with \p dim vertices in \p x. This is used by
+         *   \p init() and can be used to define the interface directly,
+         *   followed by \p build_tree().
+         */
+        void add_facet(const libMesh::Point* x);
+        
+        /*!
+         *   builds the bounding-volume hierarchy for the facets added to
+         *   this object. This does not communicate.
+         */
+        void build_tree();
+        
+        /*!
+         *   computes the point \p pt on the interface closest to \p p.
+         *   @returns false if the interface is empty, in which case no
+         *   closest point exists and \p pt is set to \p p. Callers must
+         *   check the returned value.
+         */
+        bool closest_point(const libMesh::Point& p,
+                           libMesh::Point& pt) const;
+        
+        /*!
+         *   computes the closest points for all points in \p p using the
+         *   libMesh thread pool.
+         *   @returns false if the interface is empty, in which case \p pt
+         *   is set to \p p.
+         */
+        bool closest_points(const std::vector<libMesh::Point>& p,
+                            std::vector<libMesh::Point>& pt) const;
+        
+    protected:
+        
+        /*!
+         *   node of the bounding-volume hierarchy. Leaf nodes store the
+         *   range of facets in \p _facet_ids, and interior nodes store the
+         *   indices of their two children.
+         */
+        struct TreeNode {
+            
+            libMesh::Point  lo, hi;
+            unsigned int    first, n, left, right;
+        };
+        
+        /*!
+         *   creates the node for facets in [\p begin, \p end) of
+         *   \p _facet_ids and recursively partitions them.
+         *   @returns the index of the node.
+         */
+        unsigned int _build_node(unsigned int begin,
+                                 unsigned int end);
+        
+        /*!
+         *   @returns the closest point to \p p on facet \p i
+         */
+        libMesh::Point _closest_point_on_facet(unsigned int i,
+                                               const libMesh::Point& p) const;
+        
+        const unsigned int        _dim;
+        
+        /*!
+         *   vertices of the facets, with \p _dim vertices per facet
+         */
+        std::vector<libMesh::Point> _x;
+        
+        /*!
+         *   facet centroids used to partition the tree
+         */
+        std::vector<libMesh::Point> _centroid;
+        
+        std::vector<unsigned int> _facet_ids;
+        
+        std::vector<TreeNode>     _nodes;
+    };
+}
+
+
+#endif // __mast__level_set_interface_h__
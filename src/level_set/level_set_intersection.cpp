@@ -21,12 +21,84 @@
 #include <memory>
 #include <map>
 #include <numeric>
+#include <algorithm>
 
 // MAST includes
 #include "level_set/level_set_intersection.h"
 #include "base/field_function_base.h"
 
 
+namespace MAST {
+
+    /*!
+     *   HEX8 node numbers with the bits of the x, y and z coordinates of
+     *   the node on the reference element as the bits 0, 1 and 2 of the
+     *   number, and vice versa. The reflection of the element that moves
+     *   node k to node 0 moves node i to hex8_bits[hex8_bits[i]^hex8_bits[k]].
+     */
+    static const unsigned int hex8_bits[8] = {0, 1, 3, 2, 4, 5, 7, 6};
+
+    /*!
+     *   for a HEX8 with the lowest node id at node 0, the faces opposite to
+     *   node 0, the two nodes of each face that define the diagonal through
+     *   node 6, and the two prisms that the element is split into if the
+     *   face is split along this diagonal. The prisms are numbered as in
+     *   \p LevelSetIntersection::_add_sub_prism.
+     */
+    static const unsigned int hex8_faces_at_node6[3][4] = {
+        {4, 5, 6, 7},
+        {1, 2, 6, 5},
+        {2, 3, 7, 6}};
+
+    static const unsigned int hex8_diagonals_at_node6[3][2] = {
+        {4, 6},
+        {1, 6},
+        {3, 6}};
+
+    static const unsigned int hex8_prisms[3][2][6] = {
+        {{0, 1, 2, 4, 5, 6}, {0, 2, 3, 4, 6, 7}},
+        {{0, 3, 7, 1, 2, 6}, {0, 7, 4, 1, 6, 5}},
+        {{0, 1, 5, 3, 2, 6}, {0, 5, 4, 3, 6, 7}}};
+
+    /*!
+     *   decomposition of a HEX8 with the lowest node id at node 0 into five
+     *   tetrahedra if none of the faces at node 6 is split through node 6
+     */
+    static const unsigned int hex8_five_tets[5][4] = {
+        {0, 1, 2, 5},
+        {0, 2, 3, 7},
+        {0, 4, 5, 7},
+        {2, 5, 6, 7},
+        {0, 2, 5, 7}};
+
+    /*!
+     *   renumbering of a PRISM6 that moves each node to node 0, and the
+     *   decompositions of a prism with the lowest key at node 0 into three
+     *   tetrahedra, following Dompierre et al., "How to subdivide
+     *   pyramids, prisms and hexahedra into tetrahedra".
+     */
+    static const unsigned int prism6_perm[6][6] = {
+        {0, 1, 2, 3, 4, 5},
+        {1, 2, 0, 4, 5, 3},
+        {2, 0, 1, 5, 3, 4},
+        {3, 5, 4, 0, 2, 1},
+        {4, 3, 5, 1, 0, 2},
+        {5, 4, 3, 2, 1, 0}};
+
+    static const unsigned int prism6_tets[2][3][4] = {
+        {{0, 1, 2, 5}, {0, 1, 5, 4}, {0, 4, 5, 3}},
+        {{0, 1, 2, 4}, {0, 4, 2, 5}, {0, 4, 5, 3}}};
+
+    static const unsigned int tet4_tets[1][4] = {
+        {0, 1, 2, 3}};
+
+    /*!
+     *   side of a TET4 that is opposite to each of its nodes
+     */
+    static const unsigned int tet4_side_opposite_node[4] = {2, 3, 1, 0};
+}
+
+
 
 MAST::LevelSetIntersection::LevelSetIntersection():
 _tol                             (1.e-8),
@@ -150,7 +222,8 @@ MAST::LevelSetIntersection::if_intersection_through_elem() const {
             (_mode == MAST::OPPOSITE_NODES)      ||
             (_mode == MAST::NODE_AND_EDGE)       ||
             (_mode == MAST::NODE_AND_TWO_EDGES)  ||
-            (_mode == MAST::TWO_ADJACENT_EDGES));
+            (_mode == MAST::TWO_ADJACENT_EDGES)  ||
+            (_mode == MAST::SUB_TETRAHEDRA));
 }
 
 
@@ -250,8 +323,11 @@ MAST::LevelSetIntersection::init(const MAST::FieldFunction<Real>& phi,
 
     // make sure that this has not been initialized already
     libmesh_assert(!_initialized);
-    libmesh_assert_equal_to(e.dim(), 2); // this is only for 2D elements
+    libmesh_assert(e.dim() == 2 || e.dim() == 3);
     
+    // a HEX8 is split into six tetrahedra, each of which can be split
+    // into six sub-elements
+    _max_elem_divs    = (e.dim() == 3)? 36 : 4;
     _max_mesh_elem_id = max_elem_id;
     _max_mesh_node_id = max_node_id;
     
@@ -260,19 +336,24 @@ MAST::LevelSetIntersection::init(const MAST::FieldFunction<Real>& phi,
     
     switch (e.type()) {
         case libMesh::QUAD4:
+        case libMesh::HEX8:
+        case libMesh::TET4:
             _init_on_first_order_ref_elem(phi, e, t);
             break;
 
-        case libMesh::QUAD9: {
+        case libMesh::QUAD9:
+        case libMesh::HEX20:
+        case libMesh::HEX27:
+        case libMesh::TET10: {
             
             std::unique_ptr<libMesh::Elem>
-            quad4(_first_order_elem(e));
-            _init_on_first_order_ref_elem(phi, *quad4, t);
+            first_order(_first_order_elem(e));
+            _init_on_first_order_ref_elem(phi, *first_order, t);
         }
             break;
             
         default:
-            // currently only QUAD4/9 are handled.
+            // currently only QUAD4/9, HEX8/20/27 and TET4/10 are handled.
             libmesh_error();
     }
 }
@@ -297,8 +378,31 @@ MAST::LevelSetIntersection::_first_order_elem(const libMesh::Elem &e) {
         }
             break;
             
+        case libMesh::HEX20:
+        case libMesh::HEX27: {
+            
+            first_order_elem.reset(libMesh::Elem::build(libMesh::HEX8).release());
+            
+            for (unsigned int i=0; i<8; i++)
+                first_order_elem->set_node(i) = const_cast<libMesh::Node*>(e.node_ptr(i));
+            
+            first_order_elem->set_id() = e.id();
+        }
+            break;
+            
+        case libMesh::TET10: {
+            
+            first_order_elem.reset(libMesh::Elem::build(libMesh::TET4).release());
+            
+            for (unsigned int i=0; i<4; i++)
+                first_order_elem->set_node(i) = const_cast<libMesh::Node*>(e.node_ptr(i));
+            
+            first_order_elem->set_id() = e.id();
+        }
+            break;
+            
         default:
-            // currently only QUAD4/9 are handled.
+            // currently only QUAD9, HEX20/27 and TET10 are handled.
             libmesh_error();
     }
     
@@ -316,7 +420,7 @@ _init_on_first_order_ref_elem(const MAST::FieldFunction<Real>& phi,
     
     // make sure that this has not been initialized already
     libmesh_assert(!_initialized);
-    libmesh_assert_equal_to(e.dim(), 2); // this is only for 2D elements
+    libmesh_assert(e.dim() == 2 || e.dim() == 3);
     libmesh_assert(_elem);
     
     // this assumes that the phi=0 interface is not fully contained inside
@@ -476,6 +580,29 @@ _init_on_first_order_ref_elem(const MAST::FieldFunction<Real>& phi,
         }
     }
 
+    /////////////////////////////////////////////////////////////////////
+    //   Check to see if the function touches a 3D element without a
+    //   sign change
+    /////////////////////////////////////////////////////////////////////
+    // In 3D the level set can touch the element at several nodes or along
+    // an edge without passing through its interior. This is handled
+    // in the same manner as the intersection through a node.
+    if (e.dim() == 3 && !sign_change) {
+        
+        _mode = MAST::THROUGH_NODE;
+        
+        if (max_val > _tol)
+            _positive_phi_elems.push_back(_elem);
+        else
+            _negative_phi_elems.push_back(_elem);
+        
+        std::vector<std::pair<libMesh::Point, libMesh::Point> >
+        side_nondim_points;
+        _add_node_local_coords(e, side_nondim_points, _node_local_coords);
+        _initialized = true;
+        return;
+    }
+    
     /////////////////////////////////////////////////////////////////////
     //   Identify the edges and locations where intersection occurs
     /////////////////////////////////////////////////////////////////////
@@ -490,6 +617,11 @@ _init_on_first_order_ref_elem(const MAST::FieldFunction<Real>& phi,
             _find_quad4_intersections(phi, e, t, _node_phi_vals);
             break;
             
+        case libMesh::HEX8:
+        case libMesh::TET4:
+            _find_solid_intersections(phi, e, t, _node_phi_vals);
+            break;
+            
         default:
             libmesh_error_msg("level-set intersections for elem type not handled.");
             break;
@@ -553,9 +685,17 @@ get_corner_nodes_on_negative_phi(std::set<const libMesh::Node*>& nodes) const {
         case libMesh::QUAD4:
         case libMesh::QUAD8:
         case libMesh::QUAD9:
+        case libMesh::TET4:
+        case libMesh::TET10:
             n_corner_nodes = 4;
             break;
             
+        case libMesh::HEX8:
+        case libMesh::HEX20:
+        case libMesh::HEX27:
+            n_corner_nodes = 8;
+            break;
+            
         default:
             libmesh_error(); // other cases not yet handled
     }
@@ -646,6 +786,33 @@ MAST::LevelSetIntersection::_add_node_local_coords
         }
             break;
             
+        case libMesh::HEX8: {
+            
+            const Real
+            xi[8][3] = {
+                {-1., -1., -1.},
+                {+1., -1., -1.},
+                {+1., +1., -1.},
+                {-1., +1., -1.},
+                {-1., -1., +1.},
+                {+1., -1., +1.},
+                {+1., +1., +1.},
+                {-1., +1., +1.}};
+            
+            for (unsigned int i=0; i<8; i++)
+                node_coord_map[e.node_ptr(i)] = libMesh::Point(xi[i][0], xi[i][1], xi[i][2]);
+        }
+            break;
+            
+        case libMesh::TET4: {
+            
+            node_coord_map[e.node_ptr(0)] = libMesh::Point(0., 0., 0.);
+            node_coord_map[e.node_ptr(1)] = libMesh::Point(1., 0., 0.);
+            node_coord_map[e.node_ptr(2)] = libMesh::Point(0., 1., 0.);
+            node_coord_map[e.node_ptr(3)] = libMesh::Point(0., 0., 1.);
+        }
+            break;
+            
         default:
             libmesh_assert(false); // not handled.
     }
@@ -1582,6 +1749,522 @@ MAST::LevelSetIntersection::_find_quad4_intersections
 
 
 
+void
+MAST::LevelSetIntersection::_find_solid_intersections
+(const MAST::FieldFunction<Real>& phi,
+ const libMesh::Elem& e,
+ const Real t,
+ const std::map<const libMesh::Node*, std::pair<Real, bool> >&
+ node_phi_vals) {
+    
+    libmesh_assert(e.type() == libMesh::HEX8 || e.type() == libMesh::TET4);
+    libmesh_assert(!_initialized);
+    
+    std::vector<std::pair<libMesh::Point, libMesh::Point> >
+    side_nondim_points;
+    _add_node_local_coords(e, side_nondim_points, _node_local_coords);
+    
+    _mode = MAST::SUB_TETRAHEDRA;
+    
+    unsigned int
+    tets[6][4],
+    n_tets       = 0;
+    
+    switch (e.type()) {
+        case libMesh::HEX8:
+            n_tets = _hex8_tets(e, tets);
+            break;
+            
+        case libMesh::TET4:
+            for (unsigned int j=0; j<4; j++)
+                tets[0][j] = MAST::tet4_tets[0][j];
+            n_tets = 1;
+            break;
+            
+        default:
+            libmesh_error();
+    }
+    
+    // sign of the level set on the element nodes, with zero for nodes on
+    // the level set
+    int
+    sgn[8];
+    
+    std::map<const libMesh::Node*, std::pair<Real, bool> >::const_iterator
+    it,
+    it_end = node_phi_vals.end();
+    
+    for (unsigned int i=0; i<e.n_nodes(); i++) {
+        
+        it = node_phi_vals.find(e.node_ptr(i));
+        libmesh_assert(it != it_end);
+        
+        if (it->second.second)
+            sgn[i] = 0;
+        else
+            sgn[i] = (it->second.first > 0.)? 1 : -1;
+        
+        for (unsigned int j=0; j<e.n_nodes(); j++)
+            _edge_nodes[i][j] = nullptr;
+    }
+    
+    unsigned int
+    pos[4],
+    neg[4],
+    zero[4],
+    n_pos   = 0,
+    n_neg   = 0,
+    n_zero  = 0,
+    lone    = 0;
+    
+    const unsigned int
+    *other  = nullptr;
+    
+    const libMesh::Node
+    *nodes[6];
+    
+    bool
+    on_interface[6],
+    lone_positive = false;
+    
+    for (unsigned int i=0; i<n_tets; i++) {
+        
+        n_pos  = 0;
+        n_neg  = 0;
+        n_zero = 0;
+        
+        for (unsigned int j=0; j<4; j++) {
+            
+            const unsigned int
+            v = tets[i][j];
+            
+            if (sgn[v] > 0)       pos[n_pos++]   = v;
+            else if (sgn[v] < 0)  neg[n_neg++]   = v;
+            else                  zero[n_zero++] = v;
+        }
+        
+        if (n_pos == 0 || n_neg == 0) {
+            
+            // the tetrahedron is on one side of the level set. Its face
+            // is on the interface if all three nodes are on the level set.
+            for (unsigned int j=0; j<4; j++) {
+                
+                nodes[j]        = e.node_ptr(tets[i][j]);
+                on_interface[j] = (sgn[tets[i][j]] == 0);
+            }
+            
+            _add_sub_tet(e, nodes, on_interface, n_neg == 0);
+        }
+        else if (n_zero == 2) {
+            
+            // the interface is the triangle through the two nodes on the
+            // level set and the intersection on the remaining edge. Each
+            // side is a single tetrahedron.
+            nodes[1]        = e.node_ptr(zero[0]);
+            nodes[2]        = e.node_ptr(zero[1]);
+            nodes[3]        = _add_edge_node(e, pos[0], neg[0], phi, t);
+            on_interface[0] = false;
+            on_interface[1] = true;
+            on_interface[2] = true;
+            on_interface[3] = true;
+            
+            nodes[0]        = e.node_ptr(pos[0]);
+            _add_sub_tet(e, nodes, on_interface, true);
+            
+            nodes[0]        = e.node_ptr(neg[0]);
+            _add_sub_tet(e, nodes, on_interface, false);
+        }
+        else {
+            
+            // the remaining cases with one node on one side of the level
+            // set, which is cut off by the interface from the other nodes.
+            if (n_pos == 1) {
+                
+                lone          = pos[0];
+                other         = neg;
+                lone_positive = true;
+            }
+            else {
+                
+                lone          = neg[0];
+                other         = pos;
+                lone_positive = false;
+            }
+            
+            if (n_zero == 1) {
+                
+                // the interface is the triangle through the node on the
+                // level set and the two edge intersections. The side of the
+                // lone node is a tetrahedron, and the other side a pyramid
+                // with its apex at the node on the level set.
+                nodes[0]        = e.node_ptr(lone);
+                nodes[1]        = _add_edge_node(e, lone, other[0], phi, t);
+                nodes[2]        = _add_edge_node(e, lone, other[1], phi, t);
+                nodes[3]        = e.node_ptr(zero[0]);
+                on_interface[0] = false;
+                on_interface[1] = true;
+                on_interface[2] = true;
+                on_interface[3] = true;
+                _add_sub_tet(e, nodes, on_interface, lone_positive);
+                
+                nodes[0]        = e.node_ptr(other[0]);
+                nodes[1]        = e.node_ptr(other[1]);
+                nodes[2]        = _add_edge_node(e, lone, other[1], phi, t);
+                nodes[3]        = _add_edge_node(e, lone, other[0], phi, t);
+                nodes[4]        = e.node_ptr(zero[0]);
+                on_interface[0] = false;
+                on_interface[1] = false;
+                on_interface[2] = true;
+                on_interface[3] = true;
+                on_interface[4] = true;
+                _add_sub_pyramid(e, nodes, on_interface, !lone_positive);
+            }
+            else if (n_pos == 1 || n_neg == 1) {
+                
+                // the interface is a triangle with one intersection on
+                // each edge of the lone node. The other side is a prism.
+                nodes[0]        = e.node_ptr(lone);
+                on_interface[0] = false;
+                for (unsigned int j=0; j<3; j++) {
+                    
+                    nodes[j+1]        = _add_edge_node(e, lone, other[j], phi, t);
+                    on_interface[j+1] = true;
+                }
+                _add_sub_tet(e, nodes, on_interface, lone_positive);
+                
+                for (unsigned int j=0; j<3; j++) {
+                    
+                    nodes[j]          = e.node_ptr(other[j]);
+                    nodes[j+3]        = _add_edge_node(e, lone, other[j], phi, t);
+                    on_interface[j]   = false;
+                    on_interface[j+3] = true;
+                }
+                _add_sub_prism(e, nodes, on_interface, !lone_positive);
+            }
+            else {
+                
+                // two nodes on each side. The interface is the quadrilateral
+                // through the four edges between the two sides, and each
+                // side is a prism.
+                libmesh_assert_equal_to(n_pos, 2);
+                libmesh_assert_equal_to(n_neg, 2);
+                
+                on_interface[0] = false;
+                on_interface[1] = true;
+                on_interface[2] = true;
+                on_interface[3] = false;
+                on_interface[4] = true;
+                on_interface[5] = true;
+                
+                nodes[0] = e.node_ptr(pos[0]);
+                nodes[1] = _add_edge_node(e, pos[0], neg[0], phi, t);
+                nodes[2] = _add_edge_node(e, pos[0], neg[1], phi, t);
+                nodes[3] = e.node_ptr(pos[1]);
+                nodes[4] = _add_edge_node(e, pos[1], neg[0], phi, t);
+                nodes[5] = _add_edge_node(e, pos[1], neg[1], phi, t);
+                _add_sub_prism(e, nodes, on_interface, true);
+                
+                nodes[0] = e.node_ptr(neg[0]);
+                nodes[1] = _add_edge_node(e, pos[0], neg[0], phi, t);
+                nodes[2] = _add_edge_node(e, pos[1], neg[0], phi, t);
+                nodes[3] = e.node_ptr(neg[1]);
+                nodes[4] = _add_edge_node(e, pos[0], neg[1], phi, t);
+                nodes[5] = _add_edge_node(e, pos[1], neg[1], phi, t);
+                _add_sub_prism(e, nodes, on_interface, false);
+            }
+        }
+    }
+}
+
+
+
+libMesh::Node*
+MAST::LevelSetIntersection::_add_edge_node(const libMesh::Elem& e,
+                                           unsigned int i,
+                                           unsigned int j,
+                                           const MAST::FieldFunction<Real>& phi,
+                                           const Real t) {
+    
+    if (i > j) std::swap(i, j);
+    
+    if (_edge_nodes[i][j])
+        return _edge_nodes[i][j];
+    
+    const libMesh::Node
+    *n0 = e.node_ptr(i),
+    *n1 = e.node_ptr(j);
+    
+    const Real
+    xi  = _find_intersection_on_straight_edge(*n0, *n1, phi, t);
+    
+    libMesh::Node
+    *nd = new libMesh::Node(*n0 + xi * (*n1 - *n0));
+    
+    // used this to set unique node ids, since some of libMesh's operations
+    // depend on valid and unique ids for nodes.
+    nd->set_id(_max_mesh_node_id + (unsigned int)_new_nodes.size() + 1);
+    _new_nodes.push_back(nd);
+    _bounding_nodes[nd]    = std::make_pair(n0, n1);
+    
+    const libMesh::Point
+    &p0 = _node_local_coords[n0],
+    &p1 = _node_local_coords[n1];
+    _node_local_coords[nd] = p0 + xi * (p1 - p0);
+    
+    _edge_nodes[i][j]      = nd;
+    
+    return nd;
+}
+
+
+
+void
+MAST::LevelSetIntersection::_add_sub_tet(const libMesh::Elem& e,
+                                         const libMesh::Node* const* nodes,
+                                         const bool* on_interface,
+                                         bool positive) {
+    
+    const libMesh::Node
+    *n[4]   = {nodes[0], nodes[1], nodes[2], nodes[3]};
+    
+    bool
+    f[4]    = {on_interface[0], on_interface[1], on_interface[2], on_interface[3]};
+    
+    const libMesh::Point
+    a  = *n[1] - *n[0],
+    b  = *n[2] - *n[0],
+    c  = *n[3] - *n[0];
+    
+    const Real
+    v  = a.cross(b) * c;
+    
+    // the volume relative to the product of edge lengths identifies
+    // slivers created by intersections close to the nodes, which do not
+    // contribute to the integrals.
+    if (std::fabs(v) <= _tol * a.norm() * b.norm() * c.norm())
+        return;
+    
+    // libMesh requires a positive Jacobian for the sub-element
+    if (v < 0.) {
+        
+        std::swap(n[1], n[2]);
+        std::swap(f[1], f[2]);
+    }
+    
+    libMesh::Elem
+    *e_p   = const_cast<libMesh::Elem*>(&e),
+    *child = libMesh::Elem::build(libMesh::TET4, e_p).release();
+    
+    for (unsigned int i=0; i<4; i++)
+        child->set_node(i) = const_cast<libMesh::Node*>(n[i]);
+    
+    _new_elems.push_back(child);
+    
+    // the side on the interface is opposite to the only node that is not
+    // on the interface
+    int
+    side = -1;
+    
+    if (f[0] + f[1] + f[2] + f[3] == 3)
+        for (unsigned int i=0; i<4; i++)
+            if (!f[i])
+                side = MAST::tet4_side_opposite_node[i];
+    
+    _elem_sides_on_interface[child] = side;
+    
+    if (positive)
+        _positive_phi_elems.push_back(child);
+    else
+        _negative_phi_elems.push_back(child);
+}
+
+
+
+void
+MAST::LevelSetIntersection::_add_sub_pyramid(const libMesh::Elem& e,
+                                             const libMesh::Node* const* nodes,
+                                             const bool* on_interface,
+                                             bool positive) {
+    
+    // the base is split along the diagonal through its node with the
+    // lowest key, which is the same choice made for the sub-elements
+    // on the other side of the base.
+    unsigned int
+    k = 0;
+    for (unsigned int i=1; i<4; i++)
+        if (_node_key(*nodes[i]) < _node_key(*nodes[k]))
+            k = i;
+    
+    const unsigned int
+    tets[2][2][4] = {
+        {{0, 1, 2, 4}, {0, 2, 3, 4}},
+        {{0, 1, 3, 4}, {1, 2, 3, 4}}};
+    
+    const libMesh::Node
+    *n[4];
+    
+    bool
+    f[4];
+    
+    for (unsigned int i=0; i<2; i++) {
+        
+        for (unsigned int j=0; j<4; j++) {
+            
+            n[j] = nodes[tets[k%2][i][j]];
+            f[j] = on_interface[tets[k%2][i][j]];
+        }
+        
+        _add_sub_tet(e, n, f, positive);
+    }
+}
+
+
+
+void
+MAST::LevelSetIntersection::_add_sub_prism(const libMesh::Elem& e,
+                                           const libMesh::Node* const* nodes,
+                                           const bool* on_interface,
+                                           bool positive) {
+    
+    // The quadrilateral faces are split along the diagonals through
+    // their nodes with the lowest key, following Dompierre et al., "How
+    // to subdivide pyramids, prisms and hexahedra into tetrahedra". The
+    // prism is first renumbered so that node 0 has the lowest key.
+    unsigned int
+    k = 0;
+    for (unsigned int i=1; i<6; i++)
+        if (_node_key(*nodes[i]) < _node_key(*nodes[k]))
+            k = i;
+    
+    const libMesh::Node
+    *p[6],
+    *n[4];
+    
+    bool
+    pf[6],
+    f[4];
+    
+    for (unsigned int i=0; i<6; i++) {
+        
+        p[i]  = nodes[MAST::prism6_perm[k][i]];
+        pf[i] = on_interface[MAST::prism6_perm[k][i]];
+    }
+    
+    const unsigned int
+    c = (std::min(_node_key(*p[1]), _node_key(*p[5])) <
+         std::min(_node_key(*p[2]), _node_key(*p[4])))? 0 : 1;
+    
+    for (unsigned int i=0; i<3; i++) {
+        
+        for (unsigned int j=0; j<4; j++) {
+            
+            n[j] = p[MAST::prism6_tets[c][i][j]];
+            f[j] = pf[MAST::prism6_tets[c][i][j]];
+        }
+        
+        _add_sub_tet(e, n, f, positive);
+    }
+}
+
+
+
+unsigned int
+MAST::LevelSetIntersection::_hex8_tets(const libMesh::Elem& e,
+                                       unsigned int (&tets)[6][4]) const {
+    
+    libmesh_assert(e.type() == libMesh::HEX8);
+    
+    // the element is reflected so that node 0 has the lowest id. The
+    // faces at node 0 are then split through node 0, and the
+    // decomposition depends on the diagonals of the faces at node 6.
+    unsigned int
+    k = 0;
+    for (unsigned int i=1; i<8; i++)
+        if (e.node_id(i) < e.node_id(k))
+            k = i;
+    
+    unsigned int
+    h[8];
+    for (unsigned int i=0; i<8; i++)
+        h[i] = MAST::hex8_bits[MAST::hex8_bits[i] ^ MAST::hex8_bits[k]];
+    
+    for (unsigned int i=0; i<3; i++) {
+        
+        const unsigned int
+        *face = MAST::hex8_faces_at_node6[i];
+        
+        unsigned int
+        m     = face[0];
+        for (unsigned int j=1; j<4; j++)
+            if (e.node_id(h[face[j]]) < e.node_id(h[m]))
+                m = face[j];
+        
+        if (m != MAST::hex8_diagonals_at_node6[i][0] &&
+            m != MAST::hex8_diagonals_at_node6[i][1])
+            continue;
+        
+        // the face is split through node 6, and the element is split
+        // into two prisms along the plane through this diagonal and the
+        // parallel diagonal through node 0. Each prism is split as in
+        // _add_sub_prism, which uses the same diagonals on the faces.
+        for (unsigned int j=0; j<2; j++) {
+            
+            unsigned int
+            q[6],
+            p[6],
+            l = 0;
+            
+            for (unsigned int r=0; r<6; r++) {
+                q[r] = h[MAST::hex8_prisms[i][j][r]];
+                if (e.node_id(q[r]) < e.node_id(q[l]))
+                    l = r;
+            }
+            
+            for (unsigned int r=0; r<6; r++)
+                p[r] = q[MAST::prism6_perm[l][r]];
+            
+            const unsigned int
+            c = (std::min(e.node_id(p[1]), e.node_id(p[5])) <
+                 std::min(e.node_id(p[2]), e.node_id(p[4])))? 0 : 1;
+            
+            for (unsigned int r=0; r<3; r++)
+                for (unsigned int s=0; s<4; s++)
+                    tets[3*j+r][s] = p[MAST::prism6_tets[c][r][s]];
+        }
+        
+        return 6;
+    }
+    
+    // none of the faces at node 6 is split through node 6
+    for (unsigned int i=0; i<5; i++)
+        for (unsigned int j=0; j<4; j++)
+            tets[i][j] = h[MAST::hex8_five_tets[i][j]];
+    
+    return 5;
+}
+
+
+
+std::pair<libMesh::dof_id_type, libMesh::dof_id_type>
+MAST::LevelSetIntersection::_node_key(const libMesh::Node& n) const {
+    
+    // new nodes are identified by the mesh nodes that bound them, which
+    // provides the same ordering of nodes on all elements sharing a face
+    std::map<const libMesh::Node*, std::pair<const libMesh::Node*, const libMesh::Node*>>::const_iterator
+    it  = _bounding_nodes.find(&n);
+    
+    if (it == _bounding_nodes.end())
+        return std::make_pair(n.id(), n.id());
+    
+    const libMesh::dof_id_type
+    i0 = it->second.first->id(),
+    i1 = it->second.second->id();
+    
+    return std::make_pair(std::min(i0, i1), std::max(i0, i1));
+}
+
+
+
 Real
 MAST::LevelSetIntersection::_find_intersection_on_straight_edge
 (const libMesh::Point& p0,
@@ -42,6 +42,7 @@ namespace MAST {
         NODE_AND_EDGE,          // level set passes through a node and edge
         TWO_ADJACENT_EDGES,     // level set passes through four edges
         NODE_AND_TWO_EDGES,     // level set passes through a node and two edges
+        SUB_TETRAHEDRA,         // 3D element split into tetrahedra on either side
         NO_INTERSECTION
     };
     
@@ -90,7 +91,8 @@ namespace MAST {
 
         /*!
          *   @returns the edge number on the element if the mode is COLINEAR_EDGE,
-         *   otherwise throws an error.
+         *   otherwise throws an error. For 3D elements this is the number of
+         *   the face on the level set.
          */
         unsigned int edge_on_boundary() const;
 
@@ -100,7 +102,7 @@ namespace MAST {
          *  the element
          */
         Real get_positive_phi_volume_fraction() const;
-        
+
         /*!
          *   @returns value of phi on element node. This can only be the
          *   node in the
@@ -220,7 +222,8 @@ namespace MAST {
         
         /*!
          *   creates a first order element from the given high-order element.
-         *   For a QUAD9 a QUAD4 is obtained by only using the corner nodes.
+         *   For a QUAD9 a QUAD4 is obtained by only using the corner nodes,
+         *   and similarly a HEX8 for HEX20/27 and TET4 for a TET10.
          *   Note that this does not create any new nodes. The element can be
          *   deleted after use.
          */
@@ -230,7 +233,8 @@ namespace MAST {
         /*!
          *   initializes on a reference element that is a first-order
          *   counterpart of the given high-order element. For two-dimensional
-         *   elements this is a QUAD4.
+         *   elements this is a QUAD4, and a HEX8 or TET4 for three-dimensional
+         *   elements.
          */
         void _init_on_first_order_ref_elem(const MAST::FieldFunction<Real>& phi,
                                            const libMesh::Elem& e,
@@ -249,6 +253,84 @@ namespace MAST {
                                   const std::map<const libMesh::Node*, std::pair<Real, bool> >&
                                   node_phi_vals);
 
+        /*!
+         *   creates the sub-elements of a HEX8 or TET4 element. The element
+         *   is decomposed into tetrahedra, and each tetrahedron is split
+         *   based on the number of its nodes with positive, negative and zero
+         *   level set. Nodes on the level set belong to both sides, so that
+         *   an interface through nodes, edges or faces does not create
+         *   sub-elements of zero volume.
+         */
+        void
+        _find_solid_intersections(const MAST::FieldFunction<Real>& phi,
+                                  const libMesh::Elem& e,
+                                  const Real t,
+                                  const std::map<const libMesh::Node*, std::pair<Real, bool> >&
+                                  node_phi_vals);
+
+        /*!
+         *   @returns the node at the intersection of the level set with the
+         *   straight line between nodes \p i and \p j of \p e. The node is
+         *   created only once for each pair of nodes, so that tetrahedra
+         *   sharing this line also share the node.
+         */
+        libMesh::Node*
+        _add_edge_node(const libMesh::Elem& e,
+                       unsigned int i,
+                       unsigned int j,
+                       const MAST::FieldFunction<Real>& phi,
+                       const Real t);
+
+        /*!
+         *   adds a TET4 sub-element with \p nodes to the positive or negative
+         *   phi elements. The nodes are reordered for a positive volume, and
+         *   \p on_interface identifies the nodes on the level set, which
+         *   define the side of the element on the interface. Tetrahedra of
+         *   negligible volume are not added.
+         */
+        void _add_sub_tet(const libMesh::Elem& e,
+                          const libMesh::Node* const* nodes,
+                          const bool* on_interface,
+                          bool positive);
+
+        /*!
+         *   adds a pyramid with base nodes 0, 1, 2, 3 and apex node 4 as two
+         *   TET4 sub-elements.
+         */
+        void _add_sub_pyramid(const libMesh::Elem& e,
+                              const libMesh::Node* const* nodes,
+                              const bool* on_interface,
+                              bool positive);
+
+        /*!
+         *   adds a prism with bottom nodes 0, 1, 2 and corresponding top
+         *   nodes 3, 4, 5 as three TET4 sub-elements.
+         */
+        void _add_sub_prism(const libMesh::Elem& e,
+                            const libMesh::Node* const* nodes,
+                            const bool* on_interface,
+                            bool positive);
+
+        /*!
+         *   decomposes the HEX8 \p e into tetrahedra of its nodes. Each
+         *   face of the hexahedron is split along the diagonal through its
+         *   node with the lowest id, so that the tetrahedra of neighboring
+         *   elements are conforming for any orientation of the elements.
+         *   @returns the number of tetrahedra in \p tets, which is five or
+         *   six.
+         */
+        unsigned int _hex8_tets(const libMesh::Elem& e,
+                                unsigned int (&tets)[6][4]) const;
+
+        /*!
+         *   @returns a key that orders the nodes of the sub-elements
+         *   identically on all elements sharing these nodes. This is used
+         *   to choose the diagonals on the faces of pyramids and prisms,
+         *   so that sub-elements of neighboring tetrahedra are conforming.
+         */
+        std::pair<libMesh::dof_id_type, libMesh::dof_id_type>
+        _node_key(const libMesh::Node& n) const;
+
         /*!
          *   @returns the value along a straight edge where the level-set
          *   function zero.
@@ -264,7 +346,7 @@ namespace MAST {
         unsigned int                                 _max_iters;
         unsigned int                                 _max_mesh_elem_id;
         unsigned int                                 _max_mesh_node_id;
-        const unsigned int                           _max_elem_divs;
+        unsigned int                                 _max_elem_divs;
         const libMesh::Elem*                         _elem;
         bool                                         _initialized;
 
@@ -301,6 +383,12 @@ namespace MAST {
         std::set<const libMesh::Node*>               _interior_nodes;
         std::map<const libMesh::Node*, std::pair<const libMesh::Node*, const libMesh::Node*>> _bounding_nodes;
         std::set<const libMesh::Node*>               _hanging_node;
+
+        /*!
+         *   new nodes on the lines between pairs of nodes of a HEX8 or TET4,
+         *   used to share intersection nodes between the tetrahedra
+         */
+        libMesh::Node*                               _edge_nodes[8][8];
     };
     
 }
@@ -0,0 +1,250 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "level_set/level_set_narrow_band.h"
+#include "level_set/level_set_interface.h"
+
+// libMesh includes
+#include "libmesh/mesh_base.h"
+#include "libmesh/elem.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/parallel.h"
+
+
+MAST::LevelSetNarrowBand::LevelSetNarrowBand(libMesh::System& sys,
+                                             const unsigned int n_layers):
+_system       (sys),
+_n_layers     (n_layers),
+_initialized  (false) {
+    
+}
+
+
+
+MAST::LevelSetNarrowBand::~LevelSetNarrowBand() {
+    
+}
+
+
+
+void
+MAST::LevelSetNarrowBand::init(const libMesh::NumericVector<Real>& phi) {
+    
+    this->clear();
+    
+    const libMesh::MeshBase
+    &mesh     = _system.get_mesh();
+    
+    const libMesh::DofMap
+    &dof_map  = _system.get_dof_map();
+    
+    // currently only implemented for replicated mesh
+    libmesh_assert(mesh.is_replicated());
+    
+    // localize the level set for the local elements
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    local_phi(libMesh::NumericVector<Real>::build(_system.comm()).release());
+    
+    const std::vector<libMesh::dof_id_type>
+    &send_list = dof_map.get_send_list();
+    
+    local_phi->init(_system.n_dofs(),
+                    _system.n_local_dofs(),
+                    send_list,
+                    false,
+                    libMesh::GHOSTED);
+    phi.localize(*local_phi, send_list);
+    
+    std::vector<libMesh::dof_id_type>
+    dof_indices,
+    interface_ids;
+    
+    libMesh::MeshBase::const_element_iterator
+    e_it    = mesh.active_local_elements_begin(),
+    e_end   = mesh.active_local_elements_end();
+    
+    // the band is seeded by elements on which the nodal level set
+    // changes sign
+    for ( ; e_it != e_end; e_it++) {
+        
+        const libMesh::Elem* elem = *e_it;
+        
+        dof_indices.clear();
+        dof_map.dof_indices(elem, dof_indices);
+        
+        Real
+        v_min = 0.,
+        v_max = 0.;
+        
+        for (unsigned int i=0; i<dof_indices.size(); i++) {
+            
+            Real v = (*local_phi)(dof_indices[i]);
+            
+            if (i == 0 || v < v_min) v_min = v;
+            if (i == 0 || v > v_max) v_max = v;
+        }
+        
+        if (dof_indices.size() && v_min <= 0. && v_max >= 0.) {
+            
+            interface_ids.push_back(elem->id());
+            _local_interface_elems.push_back(elem);
+        }
+    }
+    
+    _system.comm().allgather(interface_ids, false);
+    
+    // the band is grown by one layer of face neighbors at a time. Since
+    // the mesh is replicated, all ranks identify the same band.
+    std::vector<const libMesh::Elem*>
+    front,
+    next;
+    
+    for (unsigned int i=0; i<interface_ids.size(); i++) {
+        
+        const libMesh::Elem* elem = mesh.elem_ptr(interface_ids[i]);
+        
+        if (_elems.insert(elem).second)
+            front.push_back(elem);
+    }
+    
+    for (unsigned int l=0; l<_n_layers; l++) {
+        
+        next.clear();
+        
+        for (unsigned int i=0; i<front.size(); i++)
+            for (unsigned int s=0; s<front[i]->n_sides(); s++) {
+                
+                const libMesh::Elem* nb = front[i]->neighbor_ptr(s);
+                
+                if (nb && nb->active() && _elems.insert(nb).second)
+                    next.push_back(nb);
+            }
+        
+        front.swap(next);
+    }
+    
+    // dofs connected to the elements in the band
+    std::set<libMesh::dof_id_type>
+    band_dofs;
+    
+    std::set<const libMesh::Elem*>::const_iterator
+    it  = _elems.begin(),
+    end = _elems.end();
+    
+    for ( ; it != end; it++) {
+        
+        if ((*it)->processor_id() == _system.comm().rank())
+            _local_elems.push_back(*it);
+        
+        dof_indices.clear();
+        dof_map.dof_indices(*it, dof_indices);
+        band_dofs.insert(dof_indices.begin(), dof_indices.end());
+    }
+    
+    // the remaining local dofs are held fixed
+    const libMesh::dof_id_type
+    first_dof  = dof_map.first_dof(),
+    end_dof    = dof_map.end_dof();
+    
+    libMesh::MeshBase::const_node_iterator
+    n_it    = mesh.local_nodes_begin(),
+    n_end   = mesh.local_nodes_end();
+    
+    for ( ; n_it != n_end; n_it++) {
+        
+        const libMesh::Node* node = *n_it;
+        
+        dof_indices.clear();
+        dof_map.dof_indices(node, dof_indices);
+        
+        for (unsigned int i=0; i<dof_indices.size(); i++)
+            if (dof_indices[i] >= first_dof &&
+                dof_indices[i] <  end_dof   &&
+                !band_dofs.count(dof_indices[i])) {
+                
+                _fixed_dofs.push_back(dof_indices[i]);
+                _fixed_nodes.push_back(node);
+            }
+    }
+    
+    _initialized = true;
+}
+
+
+
+void
+MAST::LevelSetNarrowBand::clear() {
+    
+    _elems.clear();
+    _local_elems.clear();
+    _local_interface_elems.clear();
+    _fixed_dofs.clear();
+    _fixed_nodes.clear();
+    _initialized = false;
+}
+
+
+
+void
+MAST::LevelSetNarrowBand::
+reinitialize_outside_band(const MAST::FieldFunction<Real>& phi,
+                          libMesh::NumericVector<Real>& sol) const {
+    
+    libmesh_assert(_initialized);
+    
+    const libMesh::MeshBase
+    &mesh     = _system.get_mesh();
+    
+    MAST::LevelSetInterface
+    interface(_system.comm(), mesh.mesh_dimension());
+    
+    // the interface lies entirely within the elements with a sign change
+    interface.init(phi, mesh, _local_interface_elems);
+    
+    // the level set has no zero in the domain, and the distance
+    // is not defined
+    if (!interface.n_facets())
+        return;
+    
+    std::vector<libMesh::Point>
+    p(_fixed_nodes.size()),
+    pt;
+    
+    std::vector<Real>
+    v(_fixed_dofs.size(), 0.);
+    
+    for (unsigned int i=0; i<_fixed_nodes.size(); i++) {
+        
+        p[i] = *_fixed_nodes[i];
+        v[i] = sol(_fixed_dofs[i]);
+    }
+    
+    interface.closest_points(p, pt);
+    
+    for (unsigned int i=0; i<_fixed_dofs.size(); i++) {
+        
+        Real d = (p[i] - pt[i]).norm();
+        sol.set(_fixed_dofs[i], v[i] < 0.? -d : d);
+    }
+    
+    sol.close();
+}
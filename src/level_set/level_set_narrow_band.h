@@ -0,0 +1,152 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__level_set_narrow_band_h__
+#define __mast__level_set_narrow_band_h__
+
+// C++ includes
+#include <set>
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/system.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    template <typename ValType> class FieldFunction;
+    
+    /*!
+     *   Identifies the elements within \p n_layers elements of the zero
+     *   level set, so that the propagation and reinitialization of the
+     *   level set can be restricted to a narrow band around the interface.
+     *   The band is seeded by the elements on which the nodal level set
+     *   changes sign and is grown through face neighbors. \p init() visits
+     *   all local elements and nodes once, so its cost is proportional to
+     *   the local mesh size, while the assembly cost is proportional to
+     *   the size of the band.
+     *   Assemblies that use the band, see
+     *   \p MAST::TransientAssembly::set_narrow_band(), skip elements outside
+     *   the band and hold the dofs outside the band fixed. Outside the band,
+     *   the level set is replaced with the signed distance to the interface
+     *   by \p reinitialize_outside_band(). The band should be recomputed
+     *   before the interface leaves it, typically once per design update.
+     *   Currently, this assumes a replicated mesh.
+     */
+    class LevelSetNarrowBand {
+        
+    public:
+        
+        LevelSetNarrowBand(libMesh::System& sys,
+                           const unsigned int n_layers);
+        
+        virtual ~LevelSetNarrowBand();
+        
+        /*!
+         *   @returns the number of element layers on either side of the
+         *   interface elements
+         */
+        unsigned int n_layers() const { return _n_layers; }
+        
+        bool initialized() const { return _initialized; }
+        
+        /*!
+         *   identifies the band for the level set solution \p phi. This
+         *   must be called on all ranks.
+         */
+        void init(const libMesh::NumericVector<Real>& phi);
+        
+        void clear();
+        
+        /*!
+         *   @returns true if \p e is in the band
+         */
+        bool if_elem_in_band(const libMesh::Elem& e) const {
+            
+            libmesh_assert(_initialized);
+            return _elems.count(&e);
+        }
+        
+        /*!
+         *   @returns the total number of elements in the band
+         */
+        unsigned int n_elems() const { return (unsigned int)_elems.size(); }
+        
+        /*!
+         *   @returns the local elements in the band
+         */
+        const std::vector<const libMesh::Elem*>&
+        local_elems() const { return _local_elems; }
+        
+        /*!
+         *   @returns the local elements on which the level set changes sign
+         */
+        const std::vector<const libMesh::Elem*>&
+        local_interface_elems() const { return _local_interface_elems; }
+        
+        /*!
+         *   @returns the local dofs that are not connected to any element in
+         *   the band. These are held fixed by the band-restricted assembly.
+         */
+        const std::vector<libMesh::dof_id_type>&
+        local_fixed_dofs() const { return _fixed_dofs; }
+        
+        /*!
+         *   sets the dofs outside the band in \p sol to the signed distance
+         *   from the zero level set of \p phi, which should be the field
+         *   function for \p sol. The distance is computed from the closest
+         *   point on the interface extracted from the band, see
+         *   \p MAST::LevelSetInterface, and the sign of \p sol is retained.
+         */
+        void reinitialize_outside_band(const MAST::FieldFunction<Real>& phi,
+                                       libMesh::NumericVector<Real>& sol) const;
+        
+    protected:
+        
+        libMesh::System&                      _system;
+        
+        const unsigned int                    _n_layers;
+        
+        bool                                  _initialized;
+        
+        /*!
+         *   all elements in the band
+         */
+        std::set<const libMesh::Elem*>        _elems;
+        
+        std::vector<const libMesh::Elem*>     _local_elems;
+        
+        std::vector<const libMesh::Elem*>     _local_interface_elems;
+        
+        /*!
+         *   local dofs outside the band and the nodes they belong to
+         */
+        std::vector<libMesh::dof_id_type>     _fixed_dofs;
+        
+        std::vector<const libMesh::Node*>     _fixed_nodes;
+    };
+}
+
+
+#endif // __mast__level_set_narrow_band_h__
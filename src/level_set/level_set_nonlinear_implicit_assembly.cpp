@@ -937,25 +937,52 @@ calculate_output_derivative(const libMesh::NumericVector<Real>& X,
                             MAST::OutputAssemblyElemOperations& output,
                             libMesh::NumericVector<Real>& dq_dX) {
     
+    std::vector<MAST::OutputAssemblyElemOperations*>
+    outputs(1, &output);
+    
+    std::vector<libMesh::NumericVector<Real>*>
+    dq_dX_vecs(1, &dq_dX);
+    
+    this->calculate_output_derivatives(X, if_localize_sol, outputs, dq_dX_vecs);
+}
+
+
+
+
+void
+MAST::LevelSetNonlinearImplicitAssembly::
+calculate_output_derivatives(const libMesh::NumericVector<Real>& X,
+                             bool if_localize_sol,
+                             const std::vector<MAST::OutputAssemblyElemOperations*>& outputs,
+                             const std::vector<libMesh::NumericVector<Real>*>& dq_dX) {
+    
     libmesh_assert(_discipline);
     libmesh_assert(_system);
+    libmesh_assert_equal_to(outputs.size(), dq_dX.size());
+    
+    if (outputs.empty())
+        return;
     
-    output.zero_for_sensitivity();
-
     MAST::NonlinearSystem& nonlin_sys = _system->system();
-    output.set_assembly(*this);
     
-    dq_dX.zero();
+    for (unsigned int i=0; i<outputs.size(); i++) {
+        
+        outputs[i]->zero_for_sensitivity();
+        outputs[i]->set_assembly(*this);
+        dq_dX[i]->zero();
+    }
 
     const Real
     tol   = 1.e-10;
 
+    const unsigned int
+    n_outputs = (unsigned int)outputs.size();
+
     // iterate over each element, initialize it and get the relevant
     // analysis quantities
     RealVectorX
     vec1,
     vec2,
-    vec_total,
     sol,
     res_factored_u,
     nd_indicator = RealVectorX::Ones(1),
@@ -964,8 +991,13 @@ calculate_output_derivative(const libMesh::NumericVector<Real>& X,
     mat,
     jac_factored_uu;
 
+    // element contribution of each output
+    std::vector<RealVectorX>
+    vec_total(n_outputs);
+
     std::vector<libMesh::dof_id_type>
     dof_indices,
+    output_dof_indices,
     material_rows;
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
     
@@ -1000,6 +1032,7 @@ calculate_output_derivative(const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
 
+        // the intersection is computed once and shared by all outputs
         _intersection->init(*_level_set, *elem, nonlin_sys.time,
                             nonlin_sys.get_mesh().max_elem_id(),
                             nonlin_sys.get_mesh().max_node_id());
@@ -1014,26 +1047,40 @@ calculate_output_derivative(const libMesh::NumericVector<Real>& X,
             }
         }
 
+        const bool
+        if_negative  = (_evaluate_output_on_negative_phi &&
+                        _intersection->get_sub_elems_negative_phi().size()),
+        if_positive  = (nd_indicator.maxCoeff() > tol &&
+                        _intersection->if_elem_has_positive_phi_region()),
+        if_factor    = (_dof_handler && _dof_handler->if_factor_element(*elem));
 
-        if (_evaluate_output_on_negative_phi &&
-            _intersection->get_sub_elems_negative_phi().size()) {
-            
-            dof_map.dof_indices (elem, dof_indices);
-            
-            // get the solution
-            unsigned int ndofs = (unsigned int)dof_indices.size();
-            sol.setZero(ndofs);
-            vec1.setZero(ndofs);
-            vec2.setZero(ndofs);
-            vec_total.setZero(ndofs);
-            
-            for (unsigned int i=0; i<dof_indices.size(); i++)
-                sol(i) = (*sol_vec)(dof_indices[i]);
+        if (!if_negative && !if_positive) {
             
-            // if the element has been marked for factorization then
-            // get the void solution from the storage
-            if (_dof_handler && _dof_handler->if_factor_element(*elem))
+            _intersection->clear();
+            continue;
+        }
+        
+        dof_map.dof_indices (elem, dof_indices);
+        
+        // get the solution
+        unsigned int ndofs = (unsigned int)dof_indices.size();
+        sol.setZero(ndofs);
+        vec1.setZero(ndofs);
+        vec2.setZero(ndofs);
+        
+        for (unsigned int i=0; i<dof_indices.size(); i++)
+            sol(i) = (*sol_vec)(dof_indices[i]);
+        
+        // if the element has been marked for factorization then
+        // get the void solution from the storage
+        if (if_factor)
             _dof_handler->solution_of_factored_element(*elem, sol);
+
+
+        if (if_negative) {
+            
+            for (unsigned int j=0; j<n_outputs; j++)
+                vec_total[j].setZero(ndofs);
             
             const std::vector<const libMesh::Elem *> &
             elems_low = _intersection->get_sub_elems_negative_phi();
@@ -1049,44 +1096,54 @@ calculate_output_derivative(const libMesh::NumericVector<Real>& X,
                 //        if (_sol_function)
                 //            physics_elem->attach_active_solution_function(*_sol_function);
                 MAST::LevelSetIntersectedElem geom_sub_elem;
-                output.set_elem_data(elem->dim(), *elem, geom_sub_elem);
+                outputs[0]->set_elem_data(elem->dim(), *elem, geom_sub_elem);
                 geom_sub_elem.init(*sub_elem, *_system, *_intersection);
                 
-                output.init(geom_sub_elem);
-                output.set_elem_solution(sol);
-                output.output_derivative_for_elem(vec1);
-                output.clear_elem();
-                
-                vec_total += vec1;
+                for (unsigned int j=0; j<n_outputs; j++) {
+                    
+                    MAST::OutputAssemblyElemOperations& output = *outputs[j];
+                    
+                    output.init(geom_sub_elem);
+                    output.set_elem_solution(sol);
+                    output.output_derivative_for_elem(vec1);
+                    output.clear_elem();
+                    
+                    vec_total[j] += vec1;
+                }
             }
             
-            DenseRealVector v;
-            MAST::copy(v, vec_total);
-            dof_map.constrain_element_vector(v, dof_indices);
-            dq_dX.add_vector(v, dof_indices);
-            dof_indices.clear();
+            for (unsigned int j=0; j<n_outputs; j++) {
+                
+                DenseRealVector v;
+                MAST::copy(v, vec_total[j]);
+                output_dof_indices = dof_indices;
+                dof_map.constrain_element_vector(v, output_dof_indices);
+                dq_dX[j]->add_vector(v, output_dof_indices);
+            }
         }
 
 
-        if (nd_indicator.maxCoeff() > tol &&
-            _intersection->if_elem_has_positive_phi_region()) {
+        if (if_positive) {
 
-            dof_map.dof_indices (elem, dof_indices);
-            
-            // get the solution
-            unsigned int ndofs = (unsigned int)dof_indices.size();
-            sol.setZero(ndofs);
-            vec1.setZero(ndofs);
-            vec2.setZero(ndofs);
-            vec_total.setZero(ndofs);
-            
-            for (unsigned int i=0; i<dof_indices.size(); i++)
-                sol(i) = (*sol_vec)(dof_indices[i]);
+            for (unsigned int j=0; j<n_outputs; j++)
+                vec_total[j].setZero(ndofs);
             
-            // if the element has been marked for factorization then
-            // get the void solution from the storage
-            if (_dof_handler && _dof_handler->if_factor_element(*elem))
-                _dof_handler->solution_of_factored_element(*elem, sol);
+            // the Jacobian of the factored element does not depend on
+            // the output, and is computed once for all outputs.
+            if (if_factor) {
+                
+                mat.setZero(ndofs, ndofs);
+                
+                MAST::GeomElem geom_elem;
+                ops.set_elem_data(elem->dim(), *elem, geom_elem);
+                geom_elem.init(*elem, *_system);
+                
+                ops.init(geom_elem);
+                ops.set_elem_solution(sol);
+                ops.elem_calculations(true, vec2, mat);
+                ops.clear_elem();
+                mat *= _intersection->get_positive_phi_volume_fraction();
+            }
 
             const std::vector<const libMesh::Elem *> &
             elems_hi = _intersection->get_sub_elems_positive_phi();
@@ -1102,52 +1159,48 @@ calculate_output_derivative(const libMesh::NumericVector<Real>& X,
                 //        if (_sol_function)
                 //            physics_elem->attach_active_solution_function(*_sol_function);
                 MAST::LevelSetIntersectedElem geom_sub_elem;
-                output.set_elem_data(elem->dim(), *elem, geom_sub_elem);
+                outputs[0]->set_elem_data(elem->dim(), *elem, geom_sub_elem);
                 geom_sub_elem.init(*sub_elem, *_system, *_intersection);
                 
-                output.init(geom_sub_elem);
-                output.set_elem_solution(sol);
-                output.output_derivative_for_elem(vec1);
-                output.clear_elem();
-
-                if (_dof_handler && _dof_handler->if_factor_element(*elem)) {
+                for (unsigned int j=0; j<n_outputs; j++) {
                     
-                    vec2.setZero(ndofs);
-                    mat.setZero(ndofs, ndofs);
-                    
-                    MAST::GeomElem geom_elem;
-                    ops.set_elem_data(elem->dim(), *elem, geom_elem);
-                    geom_elem.init(*elem, *_system);
+                    MAST::OutputAssemblyElemOperations& output = *outputs[j];
                     
-                    ops.init(geom_elem);
-                    ops.set_elem_solution(sol);
-                    ops.elem_calculations(true, vec2, mat);
-                    ops.clear_elem();
-                    mat *= _intersection->get_positive_phi_volume_fraction();
+                    output.init(geom_sub_elem);
+                    output.set_elem_solution(sol);
+                    output.output_derivative_for_elem(vec1);
+                    output.clear_elem();
                     
-                    _dof_handler->element_factored_residual_and_jacobian(*elem,
-                                                                         mat.transpose(),
-                                                                         vec1,
-                                                                         material_rows,
-                                                                         jac_factored_uu,
-                                                                         res_factored_u);
+                    if (if_factor) {
+                        
+                        _dof_handler->element_factored_residual_and_jacobian(*elem,
+                                                                             mat.transpose(),
+                                                                             vec1,
+                                                                             material_rows,
+                                                                             jac_factored_uu,
+                                                                             res_factored_u);
+                        
+                        vec1.setZero();
+                        
+                        for (unsigned int i=0; i<material_rows.size(); i++)
+                            vec1(material_rows[i])   = res_factored_u(i);
+                    }
                     
-                    vec1.setZero();
-                    
-                    for (unsigned int i=0; i<material_rows.size(); i++)
-                        vec1(material_rows[i])   = res_factored_u(i);
+                    vec_total[j] += vec1;
                 }
-
-                vec_total += vec1;
             }
 
-            DenseRealVector v;
-            MAST::copy(v, vec_total);
-            dof_map.constrain_element_vector(v, dof_indices);
-            dq_dX.add_vector(v, dof_indices);
-            dof_indices.clear();
+            for (unsigned int j=0; j<n_outputs; j++) {
+                
+                DenseRealVector v;
+                MAST::copy(v, vec_total[j]);
+                output_dof_indices = dof_indices;
+                dof_map.constrain_element_vector(v, output_dof_indices);
+                dq_dX[j]->add_vector(v, output_dof_indices);
+            }
         }
         
+        dof_indices.clear();
         _intersection->clear();
     }
     
@@ -1155,8 +1208,11 @@ calculate_output_derivative(const libMesh::NumericVector<Real>& X,
     if (_sol_function)
         _sol_function->clear();
     
-    dq_dX.close();
-    output.clear_assembly();
+    for (unsigned int i=0; i<n_outputs; i++) {
+        
+        dq_dX[i]->close();
+        outputs[i]->clear_assembly();
+    }
 }
 
 
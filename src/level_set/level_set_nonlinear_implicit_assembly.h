@@ -135,6 +135,18 @@ namespace MAST {
                                     MAST::OutputAssemblyElemOperations& output,
                                     libMesh::NumericVector<Real>& dq_dX);
         
+        /*!
+         *   calculates the derivatives of all outputs in \p outputs with
+         *   one pass over the elements. The level set intersection of each
+         *   element, and the Jacobian of factored elements, are computed
+         *   once and shared by all outputs.
+         */
+        virtual void
+        calculate_output_derivatives(const libMesh::NumericVector<Real>& X,
+                                     bool if_localize_sol,
+                                     const std::vector<MAST::OutputAssemblyElemOperations*>& outputs,
+                                     const std::vector<libMesh::NumericVector<Real>*>& dq_dX);
+        
 //#define MAST_ENABLE_PLPLOT 1
 #if MAST_ENABLE_PLPLOT == 1
         void plot_sub_elems(bool plot_reference_elem,
@@ -27,6 +27,7 @@
 #include "solver/transient_solver_base.h"
 #include "numerics/utility.h"
 #include "mesh/geom_elem.h"
+#include "level_set/level_set_narrow_band.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_solver.h"
@@ -125,6 +126,9 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         
         const libMesh::Elem* elem = *el;
         
+        if (_narrow_band && !_narrow_band->if_elem_in_band(*elem))
+            continue;
+        
         dof_map.dof_indices (elem, dof_indices);
         
         MAST::GeomElem geom_elem;
@@ -174,6 +178,9 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         dof_indices.clear();
     }
     
+    // dofs outside the narrow band are held fixed
+    _add_narrow_band_fixed_dofs(J);
+    
     // delete pointers to the local solutions
     for (unsigned int i=0; i<local_qtys.size(); i++)
         delete local_qtys[i];
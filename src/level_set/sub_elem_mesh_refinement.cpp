@@ -34,6 +34,7 @@ MAST::SubElemMeshRefinement::SubElemMeshRefinement(libMesh::MeshBase& mesh,
                                                    libMesh::System&   sys):
 libMesh::System::Constraint          (),
 _initialized                         (false),
+_subdomains_changed                  (false),
 _strong_discontinuity                (false),
 _negative_level_set_subdomain_offset (0),
 _inactive_subdomain_offset           (0),
@@ -63,6 +64,7 @@ MAST::SubElemMeshRefinement::process_mesh(const MAST::FieldFunction<Real>& phi,
                                           unsigned int level_set_boundary_id) {
 
     libmesh_assert(!_initialized);
+    libmesh_assert(_elem_data.empty());
     
     // currently only implemented for replicated mesh
     libmesh_assert(_mesh.is_replicated());
@@ -75,105 +77,172 @@ MAST::SubElemMeshRefinement::process_mesh(const MAST::FieldFunction<Real>& phi,
 #endif
     }
     
+    _strong_discontinuity                = strong_discontinuity;
+    _negative_level_set_subdomain_offset = negative_level_set_subdomain_offset;
+    _inactive_subdomain_offset           = inactive_subdomain_offset;
+    _level_set_boundary_id               = level_set_boundary_id;
+
+    // with no sub-elements in the mesh, all elements that are not on
+    // the positive level set are identified as changed.
+    bool
+    mesh_changed = _update(phi, time);
+    
+    _initialized                         = true;
+    
+    return mesh_changed;
+}
+
+
+
+bool
+MAST::SubElemMeshRefinement::update_mesh(const MAST::FieldFunction<Real>& phi,
+                                         Real time) {
+    
+    libmesh_assert(_initialized);
+    
+    // the sub-elements of the changed elements are modified below
+    _initialized = false;
+    
+    bool
+    mesh_changed = _update(phi, time);
+    
+    _initialized = true;
+    
+    return mesh_changed;
+}
+
+
+
+bool
+MAST::SubElemMeshRefinement::_update(const MAST::FieldFunction<Real>& phi,
+                                     Real time) {
+    
+    libmesh_assert(_mesh.is_replicated());
+    
     MAST::LevelSetIntersection intersect;
     
     libMesh::MeshBase::element_iterator
     e_it    =  _mesh.active_local_elements_begin(),
     e_end   =  _mesh.active_local_elements_end();
 
-    // for a replicated mesh all processors have to do the exct same operations
-    // to the mesh in the same order. Hence, we modify the iterators.
-    if (_mesh.is_replicated()) {
-        
-        e_it    =  _mesh.active_elements_begin(),
-        e_end   =  _mesh.active_elements_end();
-    }
-
-    // first we need to identify all the elements that will be refined.
-    // Then we will iterate over all of them. Otherwise, the addition of
-    // new elemnts can invalidate the element iterators.
-    std::vector<libMesh::Elem*>
-    elems_to_partition;
+    // each processor classifies the elements that it owns and identifies
+    // the elements with a change in the intersection state. The nodal
+    // level set is stored for intersected elements since a change in these
+    // values moves the nodes of the sub-elements.
+    std::vector<libMesh::dof_id_type>
+    changed_ids;
+    
+    std::vector<unsigned int>
+    changed_states;
+    
+    std::vector<Real>
+    changed_phi,
+    elem_phi;
     
     for ( ; e_it != e_end; e_it++) {
         
         libMesh::Elem* elem = *e_it;
         
+        // sub-elements are not processed
+        if (_sub_elems.count(elem)) continue;
+        
         intersect.init(phi, *elem, time, _mesh.max_elem_id(), _mesh.max_node_id());
-
-        if (intersect.if_intersection_through_elem() ||
-            ((intersect.get_intersection_mode() == MAST::COLINEAR_EDGE ||
-              intersect.get_intersection_mode() == MAST::THROUGH_NODE) &&
-             intersect.get_sub_elems_negative_phi().size() == 1) ||
-            intersect.if_elem_on_negative_phi())
-            elems_to_partition.push_back(elem);
+        
+        MAST::SubElemMeshRefinement::ElemState
+        state      = _elem_state(intersect),
+        old_state  = MAST::SubElemMeshRefinement::POSITIVE_PHI;
+        
+        std::map<libMesh::Elem*, MAST::SubElemMeshRefinement::ElemData>::const_iterator
+        it = _elem_data.find(elem);
+        
+        if (it != _elem_data.end())
+            old_state = it->second.state;
+        
+        elem_phi.clear();
+        if (state == MAST::SubElemMeshRefinement::INTERSECTED ||
+            state == MAST::SubElemMeshRefinement::NEGATIVE_BOUNDARY) {
+            
+            elem_phi.resize(elem->n_nodes());
+            for (unsigned int i=0; i<elem->n_nodes(); i++)
+                elem_phi[i] = intersect.get_node_phi_value(elem->node_ptr(i));
+        }
+        
+        if (state != old_state ||
+            (it != _elem_data.end() && elem_phi != it->second.phi)) {
+            
+            changed_ids.push_back(elem->id());
+            changed_states.push_back(state);
+            changed_phi.insert(changed_phi.end(), elem_phi.begin(), elem_phi.end());
+        }
         
         intersect.clear();
     }
     
+    // for a replicated mesh all processors have to do the exact same
+    // operations to the mesh in the same order. Hence, the changed elements
+    // are communicated to all processors. The nodal level set values are
+    // stored in the order of the elements.
+    _mesh.comm().allgather(changed_ids, false);
+    _mesh.comm().allgather(changed_states, false);
+    _mesh.comm().allgather(changed_phi, false);
+    
+    libmesh_assert_equal_to(changed_ids.size(), changed_states.size());
+    
+    _changed_elems.resize(changed_ids.size());
+    
+    // the subdomain id of each changed element is modified, even if
+    // the mesh itself is not
+    _subdomains_changed = !changed_ids.empty();
     
-    // now we process only the selected elements
     bool
     mesh_changed = false;
     
-    for (unsigned int i=0; i<elems_to_partition.size(); i++) {
+    // first remove the sub-elements of all changed elements so that the
+    // nodes that are not shared with unchanged elements are deleted before
+    // the new sub-elements are added. The element pointers are obtained
+    // before any modification to the mesh.
+    std::vector<libMesh::Elem*>
+    elems(changed_ids.size(), nullptr);
+    
+    for (unsigned int i=0; i<changed_ids.size(); i++) {
+        
+        elems[i]          = _mesh.elem_ptr(changed_ids[i]);
+        _changed_elems[i] = elems[i];
+        
+        mesh_changed = _remove_sub_elems(*elems[i]) || mesh_changed;
+    }
+    
+    // node ids may have been renumbered after the last update
+    if (!elems.empty())
+        _rebuild_node_map();
+    
+    // now we process only the selected elements
+    unsigned int
+    phi_offset = 0;
+    
+    for (unsigned int i=0; i<elems.size(); i++) {
+        
+        libMesh::Elem* elem = elems[i];
         
-        libMesh::Elem* elem = elems_to_partition[i];
+        if (changed_states[i] == MAST::SubElemMeshRefinement::POSITIVE_PHI)
+            continue;
         
         intersect.init(phi, *elem, time, _mesh.max_elem_id(), _mesh.max_node_id());
         
-        // if the intersection is through the element then
-        if (intersect.if_intersection_through_elem()) {
-            
-            _process_sub_elements(strong_discontinuity,
-                                  negative_level_set_subdomain_offset,
-                                  level_set_boundary_id,
-                                  *elem,
-                                  intersect,
-                                  true,
-                                  intersect.get_sub_elems_positive_phi());
-            
-            _process_sub_elements(strong_discontinuity,
-                                  negative_level_set_subdomain_offset,
-                                  level_set_boundary_id,
-                                  *elem,
-                                  intersect,
-                                  false,
-                                  intersect.get_sub_elems_negative_phi());
-            
-            // since the element has been partitioned, we set its subdomain
-            // id with an offset so that the assembly routines can choose to
-            // ignore them
-            _old_elems.push_back(std::make_pair(elem, elem->subdomain_id()));
-            elem->subdomain_id() += inactive_subdomain_offset;
-            mesh_changed = true;
-        }
-        else if ((intersect.get_intersection_mode() == MAST::COLINEAR_EDGE ||
-                  intersect.get_intersection_mode() == MAST::THROUGH_NODE) &&
-                 intersect.get_sub_elems_negative_phi().size() == 1) {
-
-            if (strong_discontinuity) {
-                _process_negative_element(negative_level_set_subdomain_offset,
-                                          level_set_boundary_id,
-                                          *elem,
-                                          intersect);
-                
-                _old_elems.push_back(std::make_pair(elem, elem->subdomain_id()));
-                elem->subdomain_id() += inactive_subdomain_offset;
-            }
-            else {
-                
-                _old_elems.push_back(std::make_pair(elem, elem->subdomain_id()));
-                elem->subdomain_id() += negative_level_set_subdomain_offset;
+        libmesh_assert_equal_to(_elem_state(intersect), changed_states[i]);
+        
+        mesh_changed = _process_elem(*elem, intersect) || mesh_changed;
 
-            }
-        }
-        else if (intersect.if_elem_on_negative_phi()) {
-            // if the element has no positive region, then we set its
-            // subdomain id to that of negative level set offset
+        MAST::SubElemMeshRefinement::ElemData
+        &data = _elem_data[elem];
+        
+        if (changed_states[i] == MAST::SubElemMeshRefinement::INTERSECTED ||
+            changed_states[i] == MAST::SubElemMeshRefinement::NEGATIVE_BOUNDARY) {
             
-            _old_elems.push_back(std::make_pair(elem, elem->subdomain_id()));
-            elem->subdomain_id() += negative_level_set_subdomain_offset;
+            libmesh_assert_less_equal(phi_offset + elem->n_nodes(), changed_phi.size());
+            data.phi.assign(changed_phi.begin() + phi_offset,
+                            changed_phi.begin() + phi_offset + elem->n_nodes());
+            phi_offset += elem->n_nodes();
         }
         
         intersect.clear();
@@ -206,56 +275,291 @@ MAST::SubElemMeshRefinement::process_mesh(const MAST::FieldFunction<Real>& phi,
     if (mesh_changed)
         _mesh.prepare_for_use(/*skip_renumber =*/ false);
     
-    _strong_discontinuity                = strong_discontinuity;
-    _negative_level_set_subdomain_offset = negative_level_set_subdomain_offset;
-    _inactive_subdomain_offset           = inactive_subdomain_offset;
-    _level_set_boundary_id               = level_set_boundary_id;
-    _initialized                         = true;
+    return mesh_changed;
+}
+
+
+
+MAST::SubElemMeshRefinement::ElemState
+MAST::SubElemMeshRefinement::_elem_state(const MAST::LevelSetIntersection& intersect) const {
+    
+    if (intersect.if_intersection_through_elem())
+        return MAST::SubElemMeshRefinement::INTERSECTED;
+    else if ((intersect.get_intersection_mode() == MAST::COLINEAR_EDGE ||
+              intersect.get_intersection_mode() == MAST::THROUGH_NODE) &&
+             intersect.get_sub_elems_negative_phi().size() == 1)
+        return MAST::SubElemMeshRefinement::NEGATIVE_BOUNDARY;
+    else if (intersect.if_elem_on_negative_phi())
+        return MAST::SubElemMeshRefinement::NEGATIVE_PHI;
+    else
+        return MAST::SubElemMeshRefinement::POSITIVE_PHI;
+}
+
+
+
+bool
+MAST::SubElemMeshRefinement::_process_elem(libMesh::Elem& e,
+                                           MAST::LevelSetIntersection& intersect) {
+    
+    libmesh_assert(!_elem_data.count(&e));
+    
+    MAST::SubElemMeshRefinement::ElemData
+    &data = _elem_data[&e];
+    
+    data.subdomain_id = e.subdomain_id();
+    data.state        = _elem_state(intersect);
+    
+    bool
+    mesh_changed = false;
+    
+    switch (data.state) {
+            
+        case MAST::SubElemMeshRefinement::INTERSECTED: {
+            
+            _process_sub_elements(_strong_discontinuity,
+                                  _negative_level_set_subdomain_offset,
+                                  _level_set_boundary_id,
+                                  e,
+                                  intersect,
+                                  true,
+                                  intersect.get_sub_elems_positive_phi());
+            
+            _process_sub_elements(_strong_discontinuity,
+                                  _negative_level_set_subdomain_offset,
+                                  _level_set_boundary_id,
+                                  e,
+                                  intersect,
+                                  false,
+                                  intersect.get_sub_elems_negative_phi());
+            
+            // since the element has been partitioned, we set its subdomain
+            // id with an offset so that the assembly routines can choose to
+            // ignore them
+            e.subdomain_id() += _inactive_subdomain_offset;
+            mesh_changed = true;
+        }
+            break;
+            
+        case MAST::SubElemMeshRefinement::NEGATIVE_BOUNDARY: {
+            
+            if (_strong_discontinuity) {
+                
+                _process_negative_element(_negative_level_set_subdomain_offset,
+                                          _level_set_boundary_id,
+                                          e,
+                                          intersect);
+                
+                e.subdomain_id() += _inactive_subdomain_offset;
+                mesh_changed = true;
+            }
+            else
+                e.subdomain_id() += _negative_level_set_subdomain_offset;
+        }
+            break;
+
+        case MAST::SubElemMeshRefinement::NEGATIVE_PHI:
+            // if the element has no positive region, then we set its
+            // subdomain id to that of negative level set offset
+            e.subdomain_id() += _negative_level_set_subdomain_offset;
+            break;
+            
+        default:
+            // should not get here
+            libmesh_assert(false);
+    }
     
     return mesh_changed;
 }
 
 
+
 bool
-MAST::SubElemMeshRefinement::clear_mesh() {
+MAST::SubElemMeshRefinement::_remove_sub_elems(libMesh::Elem& e) {
     
-    // clear the data structure
-    _hanging_node.clear();
+    std::map<libMesh::Elem*, MAST::SubElemMeshRefinement::ElemData>::iterator
+    it = _elem_data.find(&e);
+    
+    if (it == _elem_data.end())
+        return false;
     
-    // modify the original element subdomain
-    for (unsigned int i=0; i<_old_elems.size(); i++)
-        _old_elems[i].first->subdomain_id() = _old_elems[i].second;
-    _old_elems.clear();
+    // restore the original element subdomain
+    e.subdomain_id() = it->second.subdomain_id;
     
-    // remove all the new nodes and elements from the mesh
-    for (unsigned int i=0; i<_new_elems.size(); i++) {
+    std::vector<libMesh::Elem*>
+    &sub_elems = it->second.sub_elems;
+
+    bool
+    mesh_changed = !sub_elems.empty();
+    
+    std::vector<libMesh::Node*>
+    nodes_to_delete;
+    
+    for (unsigned int i=0; i<sub_elems.size(); i++) {
+        
+        libMesh::Elem* child = sub_elems[i];
+        
+        // nodes are deleted only if they are not used by the sub-elements
+        // of any other element
+        for (unsigned int j=0; j<child->n_nodes(); j++) {
+            
+            std::map<libMesh::Node*, MAST::SubElemMeshRefinement::NodeData>::iterator
+            n_it = _new_nodes.find(child->node_ptr(j));
+            
+            if (n_it != _new_nodes.end()) {
+                
+                libmesh_assert_greater(n_it->second.n_elems, 0);
+                n_it->second.n_elems--;
+                
+                if (n_it->second.n_elems == 0) {
+                    
+                    nodes_to_delete.push_back(n_it->first);
+                    _new_nodes.erase(n_it);
+                }
+            }
+        }
+        
+        _sub_elems.erase(child);
         
         // Remove this element from any neighbor
         // lists that point to it.
-        _new_elems[i]->nullify_neighbors();
+        child->nullify_neighbors();
         
         // Remove any boundary information associated
         // with this element
-        _mesh.get_boundary_info().remove(_new_elems[i]);
+        _mesh.get_boundary_info().remove(child);
+        
+        _mesh.delete_elem(child);
+    }
+    
+    for (unsigned int i=0; i<nodes_to_delete.size(); i++) {
+        
+        // remove the hanging node constraint for this node
+        std::set<std::pair<const libMesh::Node*, std::pair<const libMesh::Node*, const libMesh::Node*>>>::iterator
+        n_it  = _hanging_node.begin();
+        
+        while (n_it != _hanging_node.end()) {
+            
+            if (n_it->first == nodes_to_delete[i])
+                n_it = _hanging_node.erase(n_it);
+            else
+                n_it++;
+        }
+        
+        _mesh.delete_node(nodes_to_delete[i]);
+    }
+    
+    _elem_data.erase(it);
+    
+    return mesh_changed;
+}
+
 
-        _mesh.delete_elem(_new_elems[i]);
+
+void
+MAST::SubElemMeshRefinement::_rebuild_node_map() {
+    
+    _node_map->clear();
+    
+    std::map<libMesh::Node*, MAST::SubElemMeshRefinement::NodeData>::const_iterator
+    it  = _new_nodes.begin(),
+    end = _new_nodes.end();
+    
+    for ( ; it != end; it++) {
+        
+        const MAST::SubElemMeshRefinement::NodeData
+        &data = it->second;
+        
+        std::pair<libMesh::Node*, libMesh::Node*>&
+        node_pair = _node_map->add(std::min(data.bounding1->id(), data.bounding2->id()),
+                                   std::max(data.bounding1->id(), data.bounding2->id()));
+        
+        if (!_strong_discontinuity) {
+            
+            node_pair.first  = it->first;
+            node_pair.second = it->first;
+        }
+        else if (data.positive_phi)
+            node_pair.first  = it->first;
+        else
+            node_pair.second = it->first;
     }
+}
+
+
+
+void
+MAST::SubElemMeshRefinement::_add_node_references(const libMesh::Elem& child) {
     
-    for (unsigned int i=0; i<_new_nodes.size(); i++)
-        _mesh.delete_node(_new_nodes[i]);
+    for (unsigned int i=0; i<child.n_nodes(); i++) {
+        
+        std::map<libMesh::Node*, MAST::SubElemMeshRefinement::NodeData>::iterator
+        it = _new_nodes.find(const_cast<libMesh::Node*>(child.node_ptr(i)));
+        
+        if (it != _new_nodes.end())
+            it->second.n_elems++;
+    }
+}
+
+
+
+bool
+MAST::SubElemMeshRefinement::clear_mesh() {
     
+    // clear the data structure
+    _hanging_node.clear();
+    _changed_elems.clear();
     
     bool
     mesh_changed = false;
     
-    if (_new_elems.size() || _new_nodes.size()) mesh_changed = true;
+    _subdomains_changed = !_elem_data.empty();
+    _mesh.comm().max(_subdomains_changed);
+    
+    // modify the original element subdomain and remove all the new
+    // elements from the mesh
+    std::map<libMesh::Elem*, MAST::SubElemMeshRefinement::ElemData>::iterator
+    e_it  = _elem_data.begin(),
+    e_end = _elem_data.end();
+    
+    for ( ; e_it != e_end; e_it++) {
+        
+        e_it->first->subdomain_id() = e_it->second.subdomain_id;
+        
+        std::vector<libMesh::Elem*>
+        &sub_elems = e_it->second.sub_elems;
+        
+        for (unsigned int i=0; i<sub_elems.size(); i++) {
+            
+            // Remove this element from any neighbor
+            // lists that point to it.
+            sub_elems[i]->nullify_neighbors();
+            
+            // Remove any boundary information associated
+            // with this element
+            _mesh.get_boundary_info().remove(sub_elems[i]);
+            
+            _mesh.delete_elem(sub_elems[i]);
+            mesh_changed = true;
+        }
+    }
+    _elem_data.clear();
+    _sub_elems.clear();
+    
+    std::map<libMesh::Node*, MAST::SubElemMeshRefinement::NodeData>::iterator
+    n_it  = _new_nodes.begin(),
+    n_end = _new_nodes.end();
+    
+    for ( ; n_it != n_end; n_it++) {
+        
+        _mesh.delete_node(n_it->first);
+        mesh_changed = true;
+    }
     
     _mesh.comm().max(mesh_changed);
     
     if (mesh_changed) {
         
         _mesh.update_parallel_id_counts();
-        _new_elems.clear();
         _new_nodes.clear();
         _node_map->clear();
         _mesh.prepare_for_use();
@@ -412,6 +716,12 @@ MAST::SubElemMeshRefinement::_process_sub_elements(bool strong_discontinuity,
 
     libmesh_assert(!_initialized);
     
+    const std::vector<libMesh::Elem*>
+    &sub_elems = _elem_data[&e].sub_elems;
+    
+    const unsigned int
+    n_sub_elems = (unsigned int)sub_elems.size();
+    
     std::map<const libMesh::Node*, const libMesh::Node*>
     intersection_object_to_mesh_node_map;
 
@@ -521,7 +831,8 @@ MAST::SubElemMeshRefinement::_process_sub_elements(bool strong_discontinuity,
                                           intersect.get_side_on_interface(*sub_e),
                                           level_set_boundary_id);
         
-        _new_elems.push_back(child);
+        _elem_data[&e].sub_elems.push_back(child);
+        _sub_elems.insert(child);
     }
     
     
@@ -557,6 +868,11 @@ MAST::SubElemMeshRefinement::_process_sub_elements(bool strong_discontinuity,
         
         child->set_node(node_num) = child_node;
     }
+    
+    // the sub-elements are complete. Now, update the count of elements
+    // using each new node
+    for (unsigned int i=n_sub_elems; i<sub_elems.size(); i++)
+        _add_node_references(*sub_elems[i]);
 }
 
 
@@ -640,7 +956,9 @@ MAST::SubElemMeshRefinement::_process_negative_element(unsigned int negative_lev
 #endif
     _mesh.add_elem(child);
     
-    _new_elems.push_back(child);
+    _elem_data[&e].sub_elems.push_back(child);
+    _sub_elems.insert(child);
+    _add_node_references(*child);
 }
 
 
@@ -674,7 +992,7 @@ MAST::SubElemMeshRefinement::_add_node(const libMesh::Point& p,
             // for a weak discontinuity nodes on either side of the discontinuity
             // are the same
             node_pair.first = _mesh.add_point(p, libMesh::DofObject::invalid_id, processor_id);
-            _new_nodes.push_back(node_pair.first);
+            _new_nodes[node_pair.first] = {0, positive_phi, bounding_nodes.first, bounding_nodes.second};
             
             libmesh_assert(node_pair.first);
 
@@ -695,7 +1013,7 @@ MAST::SubElemMeshRefinement::_add_node(const libMesh::Point& p,
                 // create and store a separate node for the positive side of the
                 // level set
                 node_pair.first = _mesh.add_point(p, libMesh::DofObject::invalid_id, processor_id);
-                _new_nodes.push_back(node_pair.first);
+                _new_nodes[node_pair.first] = {0, positive_phi, bounding_nodes.first, bounding_nodes.second};
 
                 libmesh_assert(node_pair.first);
                 
@@ -713,7 +1031,7 @@ MAST::SubElemMeshRefinement::_add_node(const libMesh::Point& p,
                 // create and store a separate node for the positive side of the
                 // level set
                 node_pair.second = _mesh.add_point(p, libMesh::DofObject::invalid_id, processor_id);
-                _new_nodes.push_back(node_pair.second);
+                _new_nodes[node_pair.second] = {0, positive_phi, bounding_nodes.first, bounding_nodes.second};
 
                 libmesh_assert(node_pair.second);
                 
@@ -20,6 +20,11 @@
 #ifndef __mast__sub_elem_mesh_refinement_h__
 #define __mast__sub_elem_mesh_refinement_h__
 
+// C++ includes
+#include <map>
+#include <set>
+#include <vector>
+
 // MAST includes
 #include "base/mast_data_types.h"
 
@@ -47,6 +52,10 @@ namespace MAST {
         
         bool initialized() { return _initialized; }
         
+        /*!
+         *   creates the sub-elements for the level set \p phi.
+         *   @returns true if elements or nodes were added to the mesh.
+         */
         bool process_mesh(const MAST::FieldFunction<Real>& phi,
                           bool strong_discontinuity,
                           Real time,
@@ -54,6 +63,42 @@ namespace MAST {
                           unsigned int inactive_subdomain_offset,
                           unsigned int level_set_boundary_id);
 
+        /*!
+         *   updates the mesh processed by \p process_mesh() for a new level
+         *   set \p phi. Only elements whose intersection state has changed,
+         *   or whose nodal level set has changed for an intersected element,
+         *   are processed again, and the sub-elements of all other elements
+         *   are retained. The classification of elements is distributed over
+         *   the processors. Elements with changes are identified by
+         *   \p get_changed_elems().
+         *   @returns true if elements or nodes were added to or removed from
+         *   the mesh. Changed elements may also only have their subdomain
+         *   ids modified, which changes the dofs of subdomain-restricted
+         *   variables and the constraints, without a change to the
+         *   elements or nodes. Hence, the \p EquationSystems must be
+         *   reinitialized if \p if_subdomains_changed() is true, even if
+         *   this returns false.
+         */
+        bool update_mesh(const MAST::FieldFunction<Real>& phi,
+                         Real time);
+        
+        /*!
+         *   @returns true if the last call to \p process_mesh(),
+         *   \p update_mesh() or \p clear_mesh() changed any element,
+         *   which includes changes to the subdomain ids and to the hanging
+         *   node constraints. The \p EquationSystems needs to be
+         *   reinitialized only if this is true.
+         */
+        bool if_subdomains_changed() const { return _subdomains_changed; }
+
+        /*!
+         *   @returns the parent elements that were processed in the last
+         *   call to \p process_mesh() or \p update_mesh(). The mesh
+         *   and the sub-elements are unchanged outside of these elements.
+         */
+        const std::vector<const libMesh::Elem*>&
+        get_changed_elems() const { return _changed_elems; }
+
         bool clear_mesh();
 
         /*!
@@ -65,6 +110,90 @@ namespace MAST {
 
     protected:
 
+        /*!
+         *   intersection state of an element
+         */
+        enum ElemState {
+            POSITIVE_PHI      = 0,   // element is not modified
+            INTERSECTED,             // sub-elements are created on both sides
+            NEGATIVE_BOUNDARY,       // negative element with level set on a side or node
+            NEGATIVE_PHI             // element is entirely on the negative side
+        };
+
+        /*!
+         *   data stored for each element modified by this object
+         */
+        struct ElemData {
+            
+            ElemData(): subdomain_id(0), state(POSITIVE_PHI) { }
+
+            // subdomain id of the original element
+            libMesh::subdomain_id_type   subdomain_id;
+
+            MAST::SubElemMeshRefinement::ElemState state;
+
+            // nodal level set values of intersected elements
+            std::vector<Real>            phi;
+
+            // sub-elements added to the mesh for this element
+            std::vector<libMesh::Elem*>  sub_elems;
+        };
+
+        /*!
+         *   data stored for each node added to the mesh
+         */
+        struct NodeData {
+            
+            // number of sub-elements that use this node
+            unsigned int                 n_elems;
+
+            // true if the node is used on the positive side of the level
+            // set for a strong discontinuity
+            bool                         positive_phi;
+
+            // nodes between which this node is created
+            const libMesh::Node          *bounding1, *bounding2;
+        };
+
+        /*!
+         *   identifies the elements of the mesh with a change in their
+         *   intersection state and processes them on all processors.
+         *   @returns true if elements were added or removed.
+         */
+        bool _update(const MAST::FieldFunction<Real>& phi,
+                     Real time);
+
+        /*!
+         *   @returns the state of the element from its intersection.
+         */
+        MAST::SubElemMeshRefinement::ElemState
+        _elem_state(const MAST::LevelSetIntersection& intersect) const;
+
+        /*!
+         *   processes element \p e based on its initialized intersection.
+         *   @returns true if sub-elements were added to the mesh.
+         */
+        bool _process_elem(libMesh::Elem& e,
+                           MAST::LevelSetIntersection& intersect);
+
+        /*!
+         *   removes the sub-elements of \p e, the nodes that are not used
+         *   by any other sub-element and restores the subdomain id of \p e.
+         *   @returns true if elements were removed from the mesh.
+         */
+        bool _remove_sub_elems(libMesh::Elem& e);
+
+        /*!
+         *   recreates the map of new nodes using the current ids of their
+         *   bounding nodes, which may have been renumbered by the mesh.
+         */
+        void _rebuild_node_map();
+
+        /*!
+         *   increments the count of sub-elements for new nodes of \p child
+         */
+        void _add_node_references(const libMesh::Elem& child);
+
         void _process_sub_elements(bool strong_discontinuity,
                                    unsigned int negative_level_set_subdomain_offset,
                                    unsigned int level_set_boundary_id,
@@ -94,6 +223,11 @@ namespace MAST {
         libMesh::Elem* _add_elem();
         
         bool _initialized;
+        
+        /*!
+         *   true if the last update changed any element
+         */
+        bool _subdomains_changed;
 
         bool _strong_discontinuity;
 
@@ -111,9 +245,10 @@ namespace MAST {
         MAST::SubElemNodeMap       *_node_map;
         
         std::set<unsigned int>      _negative_level_set_ids;
-        std::vector<libMesh::Node*> _new_nodes;
-        std::vector<libMesh::Elem*> _new_elems;
-        std::vector<std::pair<libMesh::Elem*, unsigned int>> _old_elems;
+        std::map<libMesh::Node*, MAST::SubElemMeshRefinement::NodeData> _new_nodes;
+        std::map<libMesh::Elem*, MAST::SubElemMeshRefinement::ElemData> _elem_data;
+        std::set<const libMesh::Elem*> _sub_elems;
+        std::vector<const libMesh::Elem*> _changed_elems;
         std::set<std::pair<const libMesh::Node*, std::pair<const libMesh::Node*, const libMesh::Node*>>>    _hanging_node;
     };
 }
@@ -18,6 +18,10 @@
  */
 
 
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
 // MAST includes
 #include "mesh/mesh_coupling_base.h"
 #include "base/system_initialization.h"
@@ -26,7 +30,63 @@
 // libMesh includes
 #include "libmesh/mesh_base.h"
 #include "libmesh/boundary_info.h"
-#include "libmesh/point_locator_tree.h"
+#ifdef LIBMESH_HAVE_NANOFLANN
+#include "libmesh/nanoflann.hpp"
+#endif
+
+
+#ifdef LIBMESH_HAVE_NANOFLANN
+namespace {
+    
+    /*!
+     *   Nanoflann adaptor for the element centroids used in the search of
+     *   master elements.
+     */
+    class NanoflannCentroidAdaptor {
+        
+    public:
+        
+        NanoflannCentroidAdaptor(const std::vector<libMesh::Point>& pts):
+        _pts(pts)
+        { }
+        
+        typedef Real coord_t;
+        
+        inline size_t
+        kdtree_get_point_count() const { return _pts.size(); }
+        
+        inline coord_t
+        kdtree_distance(const coord_t* p1,
+                        const size_t idx_p2,
+                        size_t size) const {
+            
+            libmesh_assert_equal_to (size, 3);
+            
+            const libMesh::Point& p2 = _pts[idx_p2];
+            
+            return ((p1[0]-p2(0))*(p1[0]-p2(0)) +
+                    (p1[1]-p2(1))*(p1[1]-p2(1)) +
+                    (p1[2]-p2(2))*(p1[2]-p2(2)));
+        }
+        
+        inline coord_t
+        kdtree_get_pt(const size_t idx, int dim) const {
+            
+            libmesh_assert_less (idx, _pts.size());
+            libmesh_assert_less (dim, 3);
+            
+            return _pts[idx](dim);
+        }
+        
+        template <class BBOX>
+        bool kdtree_get_bbox(BBOX & /* bb */) const { return false; }
+        
+    private:
+        
+        const std::vector<libMesh::Point>& _pts;
+    };
+}
+#endif
 
 
 
@@ -51,96 +111,68 @@ add_master_and_slave_boundary_coupling(unsigned int master_b_id,
                                        unsigned int slave_b_id,
                                        Real tol) {
     
-    // iterate on all nodes and check with boundary info about
-    // current ids on it.
     libMesh::MeshBase& mesh = _sys_init.system().get_mesh();
     
-    std::unique_ptr<libMesh::PointLocatorBase>
-    pt_locator(mesh.sub_point_locator());
+    // slave nodes on the local elements
+    std::vector<const libMesh::Node*> slave_nodes;
+    _get_local_boundary_nodes(mesh, slave_b_id, slave_nodes);
     
-    libMesh::PointLocatorTree
-    &locator_tree = dynamic_cast<libMesh::PointLocatorTree&>(*pt_locator);
+    // elements with at least one side on the master boundary
+    std::vector<const libMesh::Elem*> master_elems;
     
     libMesh::MeshBase::const_element_iterator
-    e_it   =  mesh.local_elements_begin(),
-    e_end  =  mesh.local_elements_end();
+    e_it   =  mesh.active_elements_begin(),
+    e_end  =  mesh.active_elements_end();
     
-    std::set<const libMesh::Node*> slave_nodes;
+    for ( ; e_it != e_end; e_it++)
+        for (unsigned int master_side=0;
+             master_side < (*e_it)->n_sides();
+             master_side++)
+            if (_check_if_side_on_boundary(mesh, **e_it, master_side, master_b_id)) {
+                
+                master_elems.push_back(*e_it);
+                break;
+            }
     
-    for ( ; e_it != e_end; e_it++) {
+    std::vector<std::vector<const libMesh::Elem*>> elems;
+    _find_master_elems(master_elems, slave_nodes, tol, elems);
+    
+    _node_couplings.reserve(_node_couplings.size() + slave_nodes.size());
+    
+    for (unsigned int i=0; i<slave_nodes.size(); i++) {
         
-        // iterate on sides and check if it is on specified boundary id
-        for (unsigned int slave_side=0;
-             slave_side < (*e_it)->n_sides();
-             slave_side++) {
+        std::set<const libMesh::Node*> master_nodes;
+        
+        // now check which sides of these elements are on the boundary.
+        for (unsigned int j=0; j<elems[i].size(); j++) {
             
-            // check if the side is on the specified boundary
-            if (_check_if_side_on_boundary(mesh, **e_it, slave_side, slave_b_id)) {
-                
-                std::unique_ptr<const libMesh::Elem>
-                slave_side_ptr((*e_it)->side_ptr(slave_side));
+            const libMesh::Elem* master_e = elems[i][j];
+            
+            for (unsigned int master_side=0;
+                 master_side < master_e->n_sides();
+                 master_side++) {
                 
-                // check for coupling of nodes on this side
-                for (unsigned int slave_n_id=0;
-                     slave_n_id < slave_side_ptr->n_nodes();
-                     slave_n_id++) {
+                if (_check_if_side_on_boundary(mesh,
+                                               *master_e,
+                                               master_side,
+                                               master_b_id)) {
                     
-                    const libMesh::Node*
-                    slave_node = slave_side_ptr->node_ptr(slave_n_id);
+                    std::unique_ptr<const libMesh::Elem>
+                    master_side_ptr(master_e->side_ptr(master_side));
                     
-                    // if the node has not already been constrained, then
-                    // identify the constraint on it
-                    if (!slave_nodes.count(slave_node)) {
-                        
-                        std::set<const libMesh::Node*> master_nodes;
-                        
-                        std::set<const libMesh::Elem*>
-                        elems = locator_tree.perform_fuzzy_linear_search(*slave_node, nullptr, tol);
-                        
-                        // make sure some elements were found for this node
-                        libmesh_assert(elems.size());
-                        
-                        // now check which of these elements have sides on
-                        // the boundary.
-                        std::set<const libMesh::Elem*>::const_iterator
-                        master_e_it   = elems.begin(),
-                        master_e_end  = elems.end();
-                        
-                        for (; master_e_it!=master_e_end; master_e_it++) {
-                            
-                            
-                            for (unsigned int master_side=0;
-                                 master_side < (*master_e_it)->n_sides();
-                                 master_side++) {
-                                
-                                if (_check_if_side_on_boundary(mesh,
-                                                               **master_e_it,
-                                                               master_side,
-                                                               master_b_id)) {
-                                    
-                                    std::unique_ptr<const libMesh::Elem>
-                                    master_side_ptr((*master_e_it)->side_ptr(master_side));
-                                    
-                                    // check for coupling of nodes on this side
-                                    for (unsigned int master_n_id=0;
-                                         master_n_id < master_side_ptr->n_nodes();
-                                         master_n_id++)
-                                        master_nodes.insert(master_side_ptr->node_ptr(master_n_id));
-                                }
-                            }
-                        }
-                            
-                        // add this slave/master information to the data
-                        _node_couplings.push_back
-                        (std::pair<const libMesh::Node*, std::set<const libMesh::Node*>>
-                         (slave_node, master_nodes));
-                        
-                        // register this slave node as having been processed
-                        slave_nodes.insert(slave_node);
-                    }
+                    // check for coupling of nodes on this side
+                    for (unsigned int master_n_id=0;
+                         master_n_id < master_side_ptr->n_nodes();
+                         master_n_id++)
+                        master_nodes.insert(master_side_ptr->node_ptr(master_n_id));
                 }
             }
         }
+        
+        // add this slave/master information to the data
+        _node_couplings.push_back
+        (std::pair<const libMesh::Node*, std::set<const libMesh::Node*>>
+         (slave_nodes[i], master_nodes));
     }
 }
 
@@ -151,89 +183,98 @@ add_slave_boundary_and_master_subdomain_coupling(unsigned int master_id,
                                                  unsigned int slave_b_id,
                                                  Real tol) {
 
-    // iterate on all nodes and check with boundary info about
-    // current ids on it.
     libMesh::MeshBase& mesh = _sys_init.system().get_mesh();
     
-    std::unique_ptr<libMesh::PointLocatorBase>
-    pt_locator(mesh.sub_point_locator());
+    // slave nodes on the local elements
+    std::vector<const libMesh::Node*> slave_nodes;
+    _get_local_boundary_nodes(mesh, slave_b_id, slave_nodes);
     
-    libMesh::PointLocatorTree
-    &locator_tree = dynamic_cast<libMesh::PointLocatorTree&>(*pt_locator);
+    // elements in the master subdomain
+    std::vector<const libMesh::Elem*> master_elems;
+    
+    libMesh::MeshBase::const_element_iterator
+    e_it   =  mesh.active_elements_begin(),
+    e_end  =  mesh.active_elements_end();
+    
+    for ( ; e_it != e_end; e_it++)
+        if ((*e_it)->subdomain_id() == master_id)
+            master_elems.push_back(*e_it);
+    
+    std::vector<std::vector<const libMesh::Elem*>> elems;
+    _find_master_elems(master_elems, slave_nodes, tol, elems);
+    
+    _node_couplings.reserve(_node_couplings.size() + slave_nodes.size());
+    
+    for (unsigned int i=0; i<slave_nodes.size(); i++) {
+        
+        const libMesh::Node* slave_node = slave_nodes[i];
+        
+        std::set<const libMesh::Node*> master_nodes;
+        
+        for (unsigned int j=0; j<elems[i].size(); j++) {
+            
+            const libMesh::Elem* master_e = elems[i][j];
+            
+            // check for coupling of nodes on this element
+            for (unsigned int master_n_id=0;
+                 master_n_id < master_e->n_nodes();
+                 master_n_id++) {
+                
+                libMesh::Point
+                d = *master_e->node_ptr(master_n_id) - *slave_node;
+                
+                if (d.norm() <= tol)
+                    master_nodes.insert(master_e->node_ptr(master_n_id));
+            }
+        }
+        
+        // add this slave/master information to the data
+        _node_couplings.push_back
+        (std::pair<const libMesh::Node*, std::set<const libMesh::Node*>>
+         (slave_node, master_nodes));
+    }
+}
+
+
+
+void
+MAST::MeshCouplingBase::
+_get_local_boundary_nodes(libMesh::MeshBase& mesh,
+                          unsigned int b_id,
+                          std::vector<const libMesh::Node*>& nodes) {
+    
+    nodes.clear();
     
     libMesh::MeshBase::const_element_iterator
     e_it   =  mesh.local_elements_begin(),
     e_end  =  mesh.local_elements_end();
     
-    std::set<const libMesh::Node*> slave_nodes;
+    std::set<const libMesh::Node*> node_set;
     
     for ( ; e_it != e_end; e_it++) {
         
         // iterate on sides and check if it is on specified boundary id
-        for (unsigned int slave_side=0;
-             slave_side < (*e_it)->n_sides();
-             slave_side++) {
+        for (unsigned int side=0;
+             side < (*e_it)->n_sides();
+             side++) {
             
             // check if the side is on the specified boundary
-            if (_check_if_side_on_boundary(mesh, **e_it, slave_side, slave_b_id)) {
+            if (_check_if_side_on_boundary(mesh, **e_it, side, b_id)) {
                 
                 std::unique_ptr<const libMesh::Elem>
-                slave_side_ptr((*e_it)->side_ptr(slave_side));
+                side_ptr((*e_it)->side_ptr(side));
                 
-                // check for coupling of nodes on this side
-                for (unsigned int slave_n_id=0;
-                     slave_n_id < slave_side_ptr->n_nodes();
-                     slave_n_id++) {
+                for (unsigned int n_id=0;
+                     n_id < side_ptr->n_nodes();
+                     n_id++) {
                     
                     const libMesh::Node*
-                    slave_node = slave_side_ptr->node_ptr(slave_n_id);
+                    nd = side_ptr->node_ptr(n_id);
                     
-                    // if the node has not already been constrained, then
-                    // identify the constraint on it
-                    if (!slave_nodes.count(slave_node)) {
-                        
-                        std::set<const libMesh::Node*> master_nodes;
-                        
-                        std::set<const libMesh::Elem*>
-                        elems = locator_tree.perform_fuzzy_linear_search(*slave_node, nullptr, tol);
-                        
-                        // make sure some elements were found for this node
-                        libmesh_assert(elems.size());
-                        
-                        // now check which of these elements have the master
-                        // subdomain id.
-                        std::set<const libMesh::Elem*>::const_iterator
-                        master_e_it   = elems.begin(),
-                        master_e_end  = elems.end();
-                        
-                        for (; master_e_it!=master_e_end; master_e_it++) {
-                            
-                            const libMesh::Elem* master_e = *master_e_it;
-                            
-                            if (master_e->subdomain_id() == master_id) {
-                                
-                                // check for coupling of nodes on this side
-                                for (unsigned int master_n_id=0;
-                                     master_n_id < master_e->n_nodes();
-                                     master_n_id++) {
-                                    
-                                    libMesh::Point
-                                    d = *master_e->node_ptr(master_n_id) - *slave_node;
-                                    
-                                    if (d.norm() <= tol)
-                                        master_nodes.insert(master_e->node_ptr(master_n_id));
-                                }
-                            }
-                        }
-                        
-                        // add this slave/master information to the data
-                        _node_couplings.push_back
-                        (std::pair<const libMesh::Node*, std::set<const libMesh::Node*>>
-                         (slave_node, master_nodes));
-                        
-                        // register this slave node as having been processed
-                        slave_nodes.insert(slave_node);
-                    }
+                    // each node is included once, in the order in which
+                    // it is first encountered.
+                    if (node_set.insert(nd).second)
+                        nodes.push_back(nd);
                 }
             }
         }
@@ -242,6 +283,90 @@ add_slave_boundary_and_master_subdomain_coupling(unsigned int master_id,
 
 
 
+void
+MAST::MeshCouplingBase::
+_find_master_elems(const std::vector<const libMesh::Elem*>& master_elems,
+                   const std::vector<const libMesh::Node*>& slave_nodes,
+                   Real tol,
+                   std::vector<std::vector<const libMesh::Elem*>>& elems) {
+    
+    elems.clear();
+    elems.resize(slave_nodes.size());
+    
+    if (master_elems.empty())
+        return;
+    
+#ifdef LIBMESH_HAVE_NANOFLANN
+    
+    // the centroids of the master elements are stored in a kd-tree. All
+    // nodes of an element are within r_max of its centroid, so a point
+    // within tol of the element bounding box is within
+    // sqrt(3) (r_max + tol) of the centroid. This is used as the search
+    // radius, and the elements found are then checked with the same
+    // test as the fuzzy search of the point locator.
+    std::vector<libMesh::Point> centroids(master_elems.size());
+    
+    Real
+    r_max = 0.;
+    
+    for (unsigned int i=0; i<master_elems.size(); i++) {
+        
+        const libMesh::Elem& e = *master_elems[i];
+        
+        centroids[i] = e.centroid();
+        
+        for (unsigned int j=0; j<e.n_nodes(); j++)
+            r_max = std::max(r_max, (e.point(j) - centroids[i]).norm());
+    }
+    
+    typedef nanoflann::L2_Simple_Adaptor<Real, NanoflannCentroidAdaptor> adaptor_t;
+    typedef nanoflann::KDTreeSingleIndexAdaptor<adaptor_t, NanoflannCentroidAdaptor, 3> kd_tree_t;
+    
+    NanoflannCentroidAdaptor centroid_adaptor(centroids);
+    kd_tree_t kd_tree(3, centroid_adaptor, nanoflann::KDTreeSingleIndexAdaptorParams(/*max leaf=*/10));
+    kd_tree.buildIndex();
+    
+    const Real
+    r_search = std::sqrt(3.) * (r_max + tol) * (1. + 1.e-8);
+    
+    std::vector<std::pair<size_t, Real>>
+    indices_dists;
+    
+    for (unsigned int i=0; i<slave_nodes.size(); i++) {
+        
+        const libMesh::Node& nd = *slave_nodes[i];
+        
+        Real query_pt[3] = {nd(0), nd(1), nd(2)};
+        
+        indices_dists.clear();
+        nanoflann::RadiusResultSet<Real, size_t>
+        resultSet(r_search*r_search, indices_dists);
+        
+        kd_tree.findNeighbors(resultSet, query_pt, nanoflann::SearchParams());
+        
+        for (unsigned int r=0; r<indices_dists.size(); r++) {
+            
+            const libMesh::Elem* e = master_elems[indices_dists[r].first];
+            
+            if (e->close_to_point(nd, tol))
+                elems[i].push_back(e);
+        }
+    }
+    
+#else
+    
+    // without nanoflann each slave node is checked against all
+    // master elements.
+    for (unsigned int i=0; i<slave_nodes.size(); i++)
+        for (unsigned int j=0; j<master_elems.size(); j++)
+            if (master_elems[j]->close_to_point(*slave_nodes[i], tol))
+                elems[i].push_back(master_elems[j]);
+    
+#endif
+}
+
+
+
 bool
 MAST::MeshCouplingBase::
 _check_if_side_on_boundary(libMesh::MeshBase& mesh,
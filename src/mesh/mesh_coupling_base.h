@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <set>
+#include <vector>
 
 // MAST includes
 #include "base/mast_data_types.h"
@@ -36,7 +37,14 @@ namespace MAST {
     // Forward declerations
     class SystemInitialization;
 
-    
+    /*!
+     *   Identifies the master nodes for slave nodes on a boundary. The slave
+     *   nodes are taken from the local elements, and the elements of the
+     *   master boundary or subdomain are found with a kd-tree search on the
+     *   element centroids if libMesh is configured with nanoflann. Hence, the
+     *   cost of the search scales with the number of slave nodes times the
+     *   log of the number of master elements.
+     */
     class MeshCouplingBase {
  
     public:
@@ -72,6 +80,26 @@ namespace MAST {
         
     protected:
 
+        /*!
+         *   collects the nodes on the sides of local elements with boundary
+         *   id \p b_id, in the order in which they are first encountered.
+         */
+        void
+        _get_local_boundary_nodes(libMesh::MeshBase& mesh,
+                                  unsigned int b_id,
+                                  std::vector<const libMesh::Node*>& nodes);
+        
+        /*!
+         *   for each node in \p slave_nodes, identifies the elements in
+         *   \p master_elems that are within a distance \p tol of the node.
+         *   \p elems[i] contains the elements for \p slave_nodes[i].
+         */
+        void
+        _find_master_elems(const std::vector<const libMesh::Elem*>& master_elems,
+                           const std::vector<const libMesh::Node*>& slave_nodes,
+                           Real tol,
+                           std::vector<std::vector<const libMesh::Elem*>>& elems);
+        
         bool
         _check_if_side_on_boundary(libMesh::MeshBase& mesh,
                                    const libMesh::Elem& elem,
@@ -132,6 +132,15 @@ namespace MAST {
         void left_multiply_transpose(T& r, const T& m) const;
         
         
+        /*!
+         *   copies the operator to the dense matrix \p r, which must be
+         *   sized m() x n(). This is used by the fixed-size kernels that
+         *   operate on compile-time sized Eigen matrices.
+         */
+        template <typename T>
+        void copy_to_dense(T& r) const;
+        
+        
     protected:
         
         /*!
@@ -462,6 +471,29 @@ left_multiply_transpose(T& r, const T& m) const {
 
 
 
+template <typename T>
+inline
+void
+MAST::FEMOperatorMatrix::
+copy_to_dense(T& r) const {
+    
+    libmesh_assert_equal_to(r.rows(), _n_interpolated_vars);
+    libmesh_assert_equal_to(r.cols(), n());
+    
+    r.setZero();
+    unsigned int index = 0;
+    
+    for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
+        for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
+            index = j*_n_interpolated_vars+i;
+            if (_var_shape_functions[index]) // check if this is non-nullptr
+                for (unsigned int k=0; k<_n_dofs_per_var; k++)
+                    r(i,j*_n_dofs_per_var+k) = (*_var_shape_functions[index])(k);
+        }
+}
+
+
+
 
 #endif // __mast__fem_operator_matrix__
 
@@ -0,0 +1,71 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// MAST includes
+#include "numerics/fixed_size_kernels.h"
+
+
+std::unique_ptr<MAST::StrainOperatorKernelBase>
+MAST::build_strain_operator_kernel(unsigned int n1,
+                                   unsigned int n2) {
+    
+    std::unique_ptr<MAST::StrainOperatorKernelBase> rval;
+    
+    switch (n1) {
+            
+        case 3: {
+            // 2D elements: plane-stress strain, six dofs per node
+            switch (n2) {
+                case 18:  // TRI3
+                    rval.reset(new MAST::StrainOperatorKernel<3, 18>(n1, n2));
+                    break;
+                    
+                case 24:  // QUAD4
+                    rval.reset(new MAST::StrainOperatorKernel<3, 24>(n1, n2));
+                    break;
+                    
+                default:
+                    rval.reset(new MAST::StrainOperatorKernel<3, Dynamic>(n1, n2));
+            }
+        }
+            break;
+            
+        case 6: {
+            // 3D elements: six strain components, three dofs per node
+            switch (n2) {
+                case 12:  // TET4
+                    rval.reset(new MAST::StrainOperatorKernel<6, 12>(n1, n2));
+                    break;
+                    
+                case 24:  // HEX8
+                    rval.reset(new MAST::StrainOperatorKernel<6, 24>(n1, n2));
+                    break;
+                    
+                default:
+                    rval.reset(new MAST::StrainOperatorKernel<6, Dynamic>(n1, n2));
+            }
+        }
+            break;
+            
+        default:
+            rval.reset(new MAST::StrainOperatorKernel<Dynamic, Dynamic>(n1, n2));
+    }
+    
+    return rval;
+}
@@ -0,0 +1,238 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__fixed_size_kernels__
+#define __mast__fixed_size_kernels__
+
+// C++ includes
+#include <memory>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "numerics/fem_operator_matrix.h"
+
+
+namespace MAST {
+
+    /*!
+     *   Interface for the quadrature-point products of the strain operator
+     *   with the constitutive matrix. The material cards and the element
+     *   work buffers remain dynamically sized, and the specializations
+     *   map these onto compile-time sized Eigen types so that the
+     *   products are unrolled and vectorized. An object of this class
+     *   is created once per element calculation using
+     *   \p MAST::build_strain_operator_kernel(), so that the dispatch on
+     *   the element type is not repeated at each quadrature point.
+     */
+    class StrainOperatorKernelBase {
+
+    public:
+
+        StrainOperatorKernelBase(unsigned int n1,
+                                 unsigned int n2):
+        _n1(n1),
+        _n2(n2)
+        { }
+
+        virtual ~StrainOperatorKernelBase() { }
+
+        /*!
+         *   @returns the number of strain components
+         */
+        unsigned int n_strain() const { return _n1; }
+
+        /*!
+         *   @returns the number of element dofs coupled by the strain operator
+         */
+        unsigned int n_dofs() const { return _n2; }
+
+        /*!
+         *   @returns true if the kernel uses compile-time sized matrices
+         */
+        virtual bool if_fixed_size() const = 0;
+
+        /*!
+         *   \p sigma = [D] \p eps
+         */
+        virtual void
+        stress(const RealMatrixX& D,
+               const RealVectorX& eps,
+               RealVectorX&       sigma) const = 0;
+
+        /*!
+         *   adds \p JxW * [B]^T \p v to the first n_dofs() rows of \p f.
+         */
+        virtual void
+        add_Bt_vec(const Real                     JxW,
+                   const MAST::FEMOperatorMatrix& B,
+                   const RealVectorX&             v,
+                   RealVectorX&                   f) const = 0;
+
+        /*!
+         *   adds \p JxW * [B_l]^T [D] [B_r] to the leading
+         *   n_dofs() x n_dofs() block of \p jac.
+         */
+        virtual void
+        add_Bt_D_B(const Real                     JxW,
+                   const MAST::FEMOperatorMatrix& B_l,
+                   const RealMatrixX&             D,
+                   const MAST::FEMOperatorMatrix& B_r,
+                   RealMatrixX&                   jac) const = 0;
+
+    protected:
+
+        const unsigned int _n1;
+
+        const unsigned int _n2;
+    };
+
+
+
+    /*!
+     *   Implementation of the strain-operator kernel for \p N1 strain
+     *   components and \p N2 element dofs. Either of these can be
+     *   \p Eigen::Dynamic, which provides the fallback for element types
+     *   that do not have an explicit specialization. The dense copies of
+     *   the strain operators are stored in work buffers that are sized
+     *   once in the constructor, so that the dynamically sized fallback
+     *   does not allocate memory at each quadrature point.
+     */
+    template <int N1, int N2>
+    class StrainOperatorKernel:
+    public MAST::StrainOperatorKernelBase {
+
+    public:
+
+        typedef Matrix<Real, N1, N1> ConstitutiveMatType;
+        typedef Matrix<Real, N1,  1> StrainVecType;
+        typedef Matrix<Real, N2,  1> DofVecType;
+        typedef Matrix<Real, N1, N2> StrainOperatorType;
+        typedef Matrix<Real, N2, N2> DofMatType;
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        StrainOperatorKernel(unsigned int n1,
+                             unsigned int n2):
+        MAST::StrainOperatorKernelBase(n1, n2),
+        _Bl_d (n1, n2),
+        _Br_d (n1, n2),
+        _DB   (n1, n2) {
+
+            libmesh_assert(N1 == Dynamic || N1 == (int)n1);
+            libmesh_assert(N2 == Dynamic || N2 == (int)n2);
+        }
+
+        virtual ~StrainOperatorKernel() { }
+
+        virtual bool if_fixed_size() const {
+            return N1 != Dynamic && N2 != Dynamic;
+        }
+
+        virtual void
+        stress(const RealMatrixX& D,
+               const RealVectorX& eps,
+               RealVectorX&       sigma) const {
+
+            libmesh_assert_equal_to(D.rows(), _n1);
+            libmesh_assert_equal_to(D.cols(), _n1);
+            libmesh_assert_equal_to(eps.size(), _n1);
+
+            Map<const ConstitutiveMatType> D_m   (D.data(), _n1, _n1);
+            Map<const StrainVecType>       eps_m (eps.data(), _n1);
+
+            sigma.resize(_n1);
+            Map<StrainVecType>(sigma.data(), _n1).noalias() = D_m * eps_m;
+        }
+
+
+        virtual void
+        add_Bt_vec(const Real                     JxW,
+                   const MAST::FEMOperatorMatrix& B,
+                   const RealVectorX&             v,
+                   RealVectorX&                   f) const {
+
+            libmesh_assert_equal_to(B.m(), _n1);
+            libmesh_assert_equal_to(B.n(), _n2);
+            libmesh_assert_equal_to(v.size(), _n1);
+            libmesh_assert_greater_equal(f.size(), _n2);
+
+            B.copy_to_dense(_Bl_d);
+
+            Map<const StrainVecType>  v_m(v.data(), _n1);
+
+            f.template topRows<N2>(_n2).noalias() += JxW * (_Bl_d.transpose() * v_m);
+        }
+
+
+        virtual void
+        add_Bt_D_B(const Real                     JxW,
+                   const MAST::FEMOperatorMatrix& B_l,
+                   const RealMatrixX&             D,
+                   const MAST::FEMOperatorMatrix& B_r,
+                   RealMatrixX&                   jac) const {
+
+            libmesh_assert_equal_to(B_l.m(), _n1);
+            libmesh_assert_equal_to(B_l.n(), _n2);
+            libmesh_assert_equal_to(B_r.m(), _n1);
+            libmesh_assert_equal_to(B_r.n(), _n2);
+            libmesh_assert_equal_to(D.rows(), _n1);
+            libmesh_assert_equal_to(D.cols(), _n1);
+            libmesh_assert_greater_equal(jac.rows(), _n2);
+            libmesh_assert_greater_equal(jac.cols(), _n2);
+
+            Map<const ConstitutiveMatType> D_m(D.data(), _n1, _n1);
+
+            B_l.copy_to_dense(_Bl_d);
+
+            // the same operator is frequently used on both sides, in which
+            // case the dense copy is reused.
+            if (&B_l == &B_r)
+                _DB.noalias() = D_m * _Bl_d;
+            else {
+
+                B_r.copy_to_dense(_Br_d);
+                _DB.noalias() = D_m * _Br_d;
+            }
+
+            jac.template topLeftCorner<N2, N2>(_n2, _n2).noalias() +=
+            JxW * (_Bl_d.transpose() * _DB);
+        }
+
+    protected:
+
+        /*!
+         *   work buffers for the dense strain operators and for the
+         *   product of the constitutive matrix with the right operator
+         */
+        mutable StrainOperatorType _Bl_d, _Br_d, _DB;
+    };
+
+
+    /*!
+     *   @returns a kernel for \p n1 strain components and \p n2 element dofs.
+     *   Compile-time sized kernels are returned for the linear 2D and 3D
+     *   element topologies, and a dynamically sized kernel otherwise.
+     */
+    std::unique_ptr<MAST::StrainOperatorKernelBase>
+    build_strain_operator_kernel(unsigned int n1,
+                                 unsigned int n2);
+}
+
+
+#endif // __mast__fixed_size_kernels__
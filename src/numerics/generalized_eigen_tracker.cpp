@@ -0,0 +1,369 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// MAST includes
+#include "numerics/generalized_eigen_tracker.h"
+#include "numerics/lapack_zggev_interface.h"
+
+
+MAST::GeneralizedEigenTracker::GeneralizedEigenTracker(const Real tol,
+                                                       const unsigned int max_it):
+MAST::LAPACK_ZGGEV_Base(),
+_tol     (tol),
+_max_its (max_it),
+_n_its   (0),
+_n_factorizations (0),
+_shift   (0.) {
+
+}
+
+
+
+void
+MAST::GeneralizedEigenTracker::compute(const ComplexMatrixX &A,
+                                       const ComplexMatrixX &B,
+                                       bool computeEigenvectors) {
+
+    MAST::LAPACK_ZGGEV ges;
+    ges.compute(A, B, computeEigenvectors);
+
+    _A       = A;
+    _B       = B;
+    _n_its   = 0;
+    _n_factorizations = 0;
+    info_val = 0;
+    alpha    = ges.alphas();
+    beta     = ges.betas();
+    if (computeEigenvectors) {
+        VL   = ges.left_eigenvectors();
+        VR   = ges.right_eigenvectors();
+    }
+}
+
+
+
+bool
+MAST::GeneralizedEigenTracker::track(const ComplexMatrixX &A,
+                                     const ComplexMatrixX &B,
+                                     const ComplexVectorX &eig0,
+                                     const ComplexMatrixX &VR0,
+                                     const ComplexMatrixX *VL0) {
+
+    libmesh_assert(A.cols() == A.rows() &&
+                   B.cols() == A.rows() &&
+                   B.cols() == B.rows());
+
+    const unsigned int
+    n     = (unsigned int)A.rows(),
+    n_eig = (unsigned int)eig0.size();
+
+    libmesh_assert_equal_to(VR0.rows(), n);
+    libmesh_assert_equal_to(VR0.cols(), n_eig);
+    libmesh_assert(!VL0 || (VL0->rows() == n && VL0->cols() == n_eig));
+
+    _A       = A;
+    _B       = B;
+    _n_its   = 0;
+    _n_factorizations = 0;
+    info_val = -1;
+
+    alpha.setZero(n_eig);
+    beta.setOnes(n_eig);
+    VR.setZero(n, n_eig);
+    VL.setZero(n, n_eig);
+
+    const Real
+    A_norm = A.norm(),
+    B_norm = B.norm();
+
+    // the reduction is shared by the factorizations for all roots
+    _reduce(A, B);
+
+    ComplexVectorX
+    x,
+    y;
+
+    for (unsigned int i=0; i<n_eig; i++) {
+
+        // infinite or undefined eigenvalues in the starting solution
+        // cannot be tracked
+        if (!std::isfinite(std::abs(eig0(i))) ||
+            VR0.col(i).norm() == 0.)
+            return false;
+
+        Complex lambda = eig0(i);
+        x = VR0.col(i);
+
+        // the factorization is reused from the previous root if it
+        // was computed for the same shift
+        if (!_n_factorizations ||
+            std::abs(lambda - _shift) > _tol * (1. + std::abs(lambda)))
+            _factor(lambda);
+
+        if (!_refine_right(A, B, A_norm, B_norm, lambda, x))
+            return false;
+
+        // the tracked root should remain closer to its starting value
+        // than to the starting value of any other root. Otherwise, the
+        // iterations have likely jumped to a neighboring branch.
+        const Real d = std::abs(lambda - eig0(i));
+        for (unsigned int j=0; j<n_eig; j++)
+            if (j != i &&
+                eig0(j) != eig0(i) &&
+                std::abs(lambda - eig0(j)) < d)
+                return false;
+
+        if (VL0 && VL0->col(i).norm() > 0.)
+            y = VL0->col(i);
+        else
+            y = x;
+
+        if (!_refine_left(A, B, A_norm, B_norm, lambda, y))
+            return false;
+
+        alpha(i)    = lambda;
+        VR.col(i)   = x;
+        VL.col(i)   = y;
+    }
+
+    // two starting vectors converging to the same eigenpair identify
+    // a loss of mode identity, for example near coalescence of roots.
+    const Real
+    sep_tol  = std::sqrt(_tol);
+
+    for (unsigned int i=0; i<n_eig; i++)
+        for (unsigned int j=i+1; j<n_eig; j++)
+            if (std::abs(alpha(i)-alpha(j)) <=
+                sep_tol * (1. + std::abs(alpha(i))) &&
+                std::abs(VR.col(i).dot(VR.col(j))) > 1. - sep_tol)
+                return false;
+
+    info_val = 0;
+    return true;
+}
+
+
+
+void
+MAST::GeneralizedEigenTracker::_reduce(const ComplexMatrixX &A,
+                                       const ComplexMatrixX &B) {
+
+    const unsigned int
+    n     = (unsigned int)A.rows();
+
+    // B = Q T with T upper triangular
+    Eigen::HouseholderQR<ComplexMatrixX> qr(B);
+
+    _Q    = qr.householderQ();
+    _T    = qr.matrixQR().triangularView<Eigen::Upper>();
+    _H    = _Q.adjoint() * A;
+    _Z    = ComplexMatrixX::Identity(n, n);
+
+    // the subdiagonal entries of H are eliminated column by column with
+    // rotations from the left, and the fill-in of T below its diagonal
+    // is eliminated with rotations from the right, so that A = Q H Z and
+    // B = Q T Z are preserved.
+    Eigen::JacobiRotation<Complex> G;
+
+    for (unsigned int j=0; j+2<n; j++)
+        for (unsigned int i=n-1; i>=j+2; i--) {
+
+            // G^H zeros H(i,j) from rows i-1 and i
+            if (_H(i, j) != 0.) {
+
+                G.makeGivens(_H(i-1, j), _H(i, j));
+                _H.applyOnTheLeft(i-1, i, G.adjoint());
+                _T.applyOnTheLeft(i-1, i, G.adjoint());
+                _Q.applyOnTheRight(i-1, i, G);
+                _H(i, j) = 0.;
+            }
+
+            // G zeros T(i,i-1) from columns i and i-1, for which the
+            // rotation is computed from the conjugate of row i
+            if (_T(i, i-1) != 0.) {
+
+                G.makeGivens(std::conj(_T(i, i)), std::conj(_T(i, i-1)));
+                _H.applyOnTheRight(i, i-1, G);
+                _T.topRows(i+1).applyOnTheRight(i, i-1, G);
+                _Z.applyOnTheLeft(i, i-1, G.adjoint());
+                _T(i, i-1) = 0.;
+            }
+        }
+}
+
+
+
+void
+MAST::GeneralizedEigenTracker::_factor(const Complex sigma) {
+
+    const unsigned int
+    n     = (unsigned int)_H.rows();
+
+    _shift = sigma;
+    _R     = _H - (sigma + std::sqrt(_tol) * _tol * (1. + std::abs(sigma))) * _T;
+    _G.resize(n > 0 ? n-1 : 0);
+
+    // H - sigma T is upper Hessenberg, and its QR factorization needs
+    // one rotation per subdiagonal entry
+    for (unsigned int k=0; k+1<n; k++) {
+
+        _G[k].makeGivens(_R(k, k), _R(k+1, k), &_R(k, k));
+        _R(k+1, k) = 0.;
+        _R.rightCols(n-k-1).applyOnTheLeft(k, k+1, _G[k].adjoint());
+    }
+
+    _n_factorizations++;
+}
+
+
+
+void
+MAST::GeneralizedEigenTracker::_solve(const ComplexVectorX &b,
+                                      bool if_adjoint,
+                                      ComplexVectorX &x) const {
+
+    const unsigned int
+    n     = (unsigned int)_R.rows();
+
+    // A - sigma B = Q G R Z, where G is the product of the rotations
+    if (!if_adjoint) {
+
+        x = _Q.adjoint() * b;
+        for (unsigned int k=0; k+1<n; k++)
+            x.applyOnTheLeft(k, k+1, _G[k].adjoint());
+        _R.triangularView<Eigen::Upper>().solveInPlace(x);
+        x = _Z.adjoint() * x;
+        return;
+    }
+
+    // (A - sigma B)^H = Z^H R^H G^H Q^H
+    x = _Z * b;
+    _R.triangularView<Eigen::Upper>().adjoint().solveInPlace(x);
+    for (unsigned int k=n-1; k>0; k--)
+        x.applyOnTheLeft(k-1, k, _G[k-1]);
+    x = _Q * x;
+}
+
+
+
+bool
+MAST::GeneralizedEigenTracker::_refine_right(const ComplexMatrixX &A,
+                                             const ComplexMatrixX &B,
+                                             const Real A_norm,
+                                             const Real B_norm,
+                                             Complex &lambda,
+                                             ComplexVectorX &x) {
+
+    ComplexVectorX
+    Ax,
+    Bx;
+
+    Complex
+    val    = 0.;
+
+    Real
+    res    = 0.,
+    res0   = 0.;
+
+    x /= x.norm();
+
+    for (unsigned int it=0; it<=_max_its; it++) {
+
+        Ax  = A * x;
+        Bx  = B * x;
+
+        // Rayleigh quotient that minimizes || A x - lambda B x ||
+        val = Bx.squaredNorm();
+        if (val == 0.)
+            return false;
+        lambda = Bx.dot(Ax) / val;
+
+        res = (Ax - lambda * Bx).norm() / (A_norm + std::abs(lambda) * B_norm);
+        if (res <= _tol)
+            return true;
+
+        if (it == _max_its)
+            break;
+
+        // inverse iteration with a fixed shift converges linearly. If the
+        // residual does not drop by at least an order of magnitude, the
+        // shift is moved to the current Rayleigh quotient.
+        if (it > 0 && res > 0.1 * res0)
+            _factor(lambda);
+        res0 = res;
+
+        _solve(Bx, false, x);
+        _n_its++;
+
+        val = x.norm();
+        if (!std::isfinite(std::abs(val)) || val == 0.)
+            return false;
+        x /= val;
+    }
+
+    return false;
+}
+
+
+
+bool
+MAST::GeneralizedEigenTracker::_refine_left(const ComplexMatrixX &A,
+                                            const ComplexMatrixX &B,
+                                            const Real A_norm,
+                                            const Real B_norm,
+                                            const Complex lambda,
+                                            ComplexVectorX &y) {
+
+    // the left eigenvector satisfies  (A - lambda B)^H y = 0, and is
+    // computed by inverse iteration with the factorization used for the
+    // right eigenvector.
+    const ComplexMatrixX
+    Bh    = B.adjoint();
+
+    Real
+    val   = 0.,
+    res   = 0.,
+    res0  = 0.;
+
+    y /= y.norm();
+
+    for (unsigned int it=0; it<_max_its; it++) {
+
+        _solve(Bh * y, true, y);
+        _n_its++;
+
+        val = y.norm();
+        if (!std::isfinite(val) || val == 0.)
+            return false;
+        y /= val;
+
+        res = (A.adjoint() * y - std::conj(lambda) * (Bh * y)).norm() /
+        (A_norm + std::abs(lambda) * B_norm);
+        if (res <= _tol)
+            return true;
+
+        // move the shift to the converged eigenvalue if the iterations
+        // stagnate
+        if (it > 0 && res > 0.1 * res0)
+            _factor(lambda);
+        res0 = res;
+    }
+
+    return false;
+}
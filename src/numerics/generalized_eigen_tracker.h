@@ -0,0 +1,193 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__generalized_eigen_tracker_h__
+#define __mast__generalized_eigen_tracker_h__
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "numerics/lapack_zggev_base.h"
+
+
+namespace MAST {
+
+    /*!
+     *   Computes the eigenpairs of \f$A x = \lambda B x\f$ by continuation
+     *   from the eigenpairs of a neighboring pencil. Each eigenvalue is
+     *   refined independently with a shifted inverse iteration, so that
+     *   eigenpair \p i of this object is the continuation of eigenpair \p i
+     *   of the starting solution.
+     *
+     *   The pencil is reduced once per call to \p track() to the
+     *   Hessenberg-triangular form \f$ A = Q H Z \f$, \f$ B = Q T Z \f$,
+     *   which is shared by all roots. The Hessenberg matrix
+     *   \f$ H - \sigma T \f$ is then factored for the starting
+     *   eigenvalue \f$ \sigma \f$ of each root at \f$ O(n^2) \f$ cost,
+     *   and is reused for all iterations of the right and left
+     *   eigenvectors, with the eigenvalue estimated from the Rayleigh
+     *   quotient. The shift is updated to the current Rayleigh quotient,
+     *   with a new factorization, only when the residual does not
+     *   decrease fast enough.
+     *
+     *   \p track() reports failure if any of the eigenpairs does not
+     *   converge, or if two starting vectors converge to the same
+     *   eigenpair, in which case the user should fall back on
+     *   \p compute(), which uses the full QZ solution of
+     *   \p LAPACK_ZGGEV.
+     */
+    class GeneralizedEigenTracker:
+    public MAST::LAPACK_ZGGEV_Base {
+
+    public:
+
+        GeneralizedEigenTracker(const Real tol            = 1.e-10,
+                                const unsigned int max_it = 20);
+
+        virtual ~GeneralizedEigenTracker() { }
+
+        /*!
+         *   computes the full eigensolution using \p LAPACK_ZGGEV.
+         */
+        virtual void compute(const ComplexMatrixX& A,
+                             const ComplexMatrixX& B,
+                             bool computeEigenvectors = true);
+
+        /*!
+         *   tracks the eigenpairs \p eig0 and \p VR0 of a neighboring pencil
+         *   to the pencil (\p A, \p B). If provided, columns of \p VL0 are
+         *   used as starting vectors for the left eigenvectors. The
+         *   eigenvalues are returned in \p alphas() with unit \p betas().
+         *   @returns true if all eigenpairs were successfully tracked.
+         */
+        bool track(const ComplexMatrixX& A,
+                   const ComplexMatrixX& B,
+                   const ComplexVectorX& eig0,
+                   const ComplexMatrixX& VR0,
+                   const ComplexMatrixX* VL0 = nullptr);
+
+        /*!
+         *   @returns the total number of inverse iterations used by the
+         *   last call to \p track()
+         */
+        unsigned int n_iterations() const {
+            return _n_its;
+        }
+
+        /*!
+         *   @returns the number of factorizations of \f$ H - \sigma T \f$
+         *   used by the last call to \p track()
+         */
+        unsigned int n_factorizations() const {
+            return _n_factorizations;
+        }
+
+    protected:
+
+        /*!
+         *   reduces the pencil (\p A, \p B) to the Hessenberg-triangular
+         *   form (\p _H, \p _T) with unitary \p _Q and \p _Z.
+         */
+        void _reduce(const ComplexMatrixX& A,
+                     const ComplexMatrixX& B);
+
+        /*!
+         *   factors \f$ H - \sigma T \f$ for the shift \p sigma with
+         *   Givens rotations. The shift is perturbed by a small amount so
+         *   that the factorization remains nonsingular if \p sigma is an
+         *   exact eigenvalue.
+         */
+        void _factor(const Complex sigma);
+
+        /*!
+         *   solves \f$ (A - \sigma B) x = b \f$, or
+         *   \f$ (A - \sigma B)^H x = b \f$ if \p if_adjoint is true, with
+         *   the current factorization.
+         */
+        void _solve(const ComplexVectorX& b,
+                    bool                  if_adjoint,
+                    ComplexVectorX&       x) const;
+
+        /*!
+         *   refines the eigenvalue \p lambda and right eigenvector \p x.
+         *   @returns true if the relative residual is below the tolerance.
+         */
+        bool _refine_right(const ComplexMatrixX& A,
+                           const ComplexMatrixX& B,
+                           const Real            A_norm,
+                           const Real            B_norm,
+                           Complex&              lambda,
+                           ComplexVectorX&       x);
+
+        /*!
+         *   computes the left eigenvector \p y for converged eigenvalue
+         *   \p lambda using \p y as the starting vector.
+         *   @returns true if the relative residual is below the tolerance.
+         */
+        bool _refine_left(const ComplexMatrixX& A,
+                          const ComplexMatrixX& B,
+                          const Real            A_norm,
+                          const Real            B_norm,
+                          const Complex         lambda,
+                          ComplexVectorX&       y);
+
+        /*!
+         *   convergence tolerance on the relative residual
+         */
+        const Real _tol;
+
+        /*!
+         *   maximum number of iterations per eigenpair
+         */
+        const unsigned int _max_its;
+
+        /*!
+         *   number of iterations used in the last call to \p track()
+         */
+        unsigned int _n_its;
+
+        /*!
+         *   number of factorizations used in the last call to \p track()
+         */
+        unsigned int _n_factorizations;
+
+        /*!
+         *   shift of the current factorization
+         */
+        Complex _shift;
+
+        /*!
+         *   Hessenberg-triangular form of the pencil, with
+         *   \f$ A = Q H Z \f$ and \f$ B = Q T Z \f$
+         */
+        ComplexMatrixX _Q, _Z, _H, _T;
+
+        /*!
+         *   triangular factor and rotations of the QR factorization of
+         *   \f$ H - \sigma T \f$ for the current shift
+         */
+        ComplexMatrixX _R;
+        std::vector<Eigen::JacobiRotation<Complex>> _G;
+    };
+}
+
+
+#endif // __mast__generalized_eigen_tracker_h__
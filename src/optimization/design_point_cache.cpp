@@ -0,0 +1,155 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <cmath>
+
+// MAST includes
+#include "optimization/design_point_cache.h"
+
+// libMesh includes
+#include "libmesh/parallel.h"
+
+
+MAST::DesignPointCache::DesignPointCache(const libMesh::Parallel::Communicator& comm_in,
+                                         unsigned int max_entries,
+                                         Real         tol):
+libMesh::ParallelObject (comm_in),
+_max_entries            (max_entries),
+_tol                    (tol),
+_n_uses                 (0),
+_n_hits                 (0),
+_n_misses               (0) {
+    
+    libmesh_assert_greater(max_entries, 0);
+    libmesh_assert_greater_equal(tol, 0.);
+}
+
+
+
+MAST::DesignPointCache::~DesignPointCache() {
+    
+}
+
+
+
+MAST::DesignPointCache::Entry*
+MAST::DesignPointCache::find(const std::vector<Real>& x) {
+    
+    Real x_norm = 0.;
+    for (unsigned int i=0; i<x.size(); i++)
+        x_norm = std::max(x_norm, std::fabs(x[i]));
+    this->comm().max(x_norm);
+    
+    const Real
+    tol = _tol * std::max(x_norm, 1.);
+    
+    std::list<std::unique_ptr<Entry> >::iterator
+    it  = _entries.begin(),
+    end = _entries.end();
+    
+    for ( ; it != end; it++)
+        if ((*it)->dvars.size() == x.size() &&
+            _distance((*it)->dvars, x) <= tol) {
+            
+            // move the entry to the front of the list so that the least
+            // recently used entry remains at the back.
+            _entries.splice(_entries.begin(), _entries, it);
+            _entries.front()->last_use = ++_n_uses;
+            _n_hits++;
+            return _entries.front().get();
+        }
+    
+    _n_misses++;
+    return nullptr;
+}
+
+
+
+MAST::DesignPointCache::Entry*
+MAST::DesignPointCache::nearest(const std::vector<Real>& x) {
+    
+    Entry* e     = nullptr;
+    Real   d_min = 0.;
+    
+    std::list<std::unique_ptr<Entry> >::iterator
+    it  = _entries.begin(),
+    end = _entries.end();
+    
+    for ( ; it != end; it++) {
+        
+        if ((*it)->dvars.size() != x.size())
+            continue;
+        
+        const Real d = _distance((*it)->dvars, x);
+        if (!e || d < d_min) {
+            e     = it->get();
+            d_min = d;
+        }
+    }
+    
+    if (e)
+        e->last_use = ++_n_uses;
+    
+    return e;
+}
+
+
+
+MAST::DesignPointCache::Entry&
+MAST::DesignPointCache::insert(std::unique_ptr<Entry> e) {
+    
+    libmesh_assert(e);
+    
+    e->last_use = ++_n_uses;
+    _entries.push_front(std::move(e));
+    
+    while (_entries.size() > _max_entries)
+        _entries.pop_back();
+    
+    return *_entries.front();
+}
+
+
+
+void
+MAST::DesignPointCache::clear() {
+    
+    _entries.clear();
+}
+
+
+
+Real
+MAST::DesignPointCache::_distance(const std::vector<Real>& x1,
+                                  const std::vector<Real>& x2) const {
+    
+    libmesh_assert_equal_to(x1.size(), x2.size());
+    
+    Real d = 0.;
+    for (unsigned int i=0; i<x1.size(); i++)
+        d = std::max(d, std::fabs(x1[i] - x2[i]));
+    
+    // for replicated design vectors all ranks have the same value, and
+    // for distributed vectors this gives the global norm
+    this->comm().max(d);
+    
+    return d;
+}
@@ -0,0 +1,180 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__design_point_cache_h__
+#define __mast__design_point_cache_h__
+
+// C++ includes
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/parallel_object.h"
+#include "libmesh/numeric_vector.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Stores the results of function evaluations at recent design
+     *   points, together with analysis states that can be used to start
+     *   the analysis at a neighboring design point. Each entry is keyed
+     *   by the design variable vector, which is either the replicated
+     *   vector of all design variables or the local entries of a
+     *   distributed vector. Distances between design points use the
+     *   infinity norm, so that the same comparison is obtained on all
+     *   ranks in either case. The least recently used entry is deleted
+     *   when the number of entries exceeds the capacity.
+     */
+    class DesignPointCache:
+    public libMesh::ParallelObject {
+        
+    public:
+        
+        /*!
+         *   data stored for a single design point
+         */
+        struct Entry {
+            
+            Entry(): obj(0.), if_obj_grad(false), last_use(0) { }
+            
+            /*!
+             *   design variables that identify this entry
+             */
+            std::vector<Real>        dvars;
+            
+            Real                     obj;
+            
+            std::vector<Real>        fvals;
+            
+            /*!
+             *   objective and constraint gradients in the replicated
+             *   format of \p MAST::FunctionEvaluation::evaluate(), with
+             *   flags identifying the gradients that were computed.
+             */
+            bool                     if_obj_grad;
+            std::vector<Real>        obj_grad;
+            std::vector<bool>        if_grads;
+            std::vector<Real>        grads;
+            
+            /*!
+             *   gradients for the distributed evaluation
+             */
+            std::unique_ptr<libMesh::NumericVector<Real> >               obj_grad_vec;
+            std::vector<std::unique_ptr<libMesh::NumericVector<Real> > > grad_vecs;
+            
+            /*!
+             *   analysis states, for example converged solutions and
+             *   eigenvectors, stored by name
+             */
+            std::map<std::string, std::unique_ptr<libMesh::NumericVector<Real> > > vectors;
+            
+            /*!
+             *   sensitivity of the named vectors with respect to the
+             *   design variable with the specified index
+             */
+            std::map<std::pair<std::string, unsigned int>,
+            std::unique_ptr<libMesh::NumericVector<Real> > > sensitivities;
+            
+            /*!
+             *   small data, for example eigenvalues and flutter roots,
+             *   stored by name
+             */
+            std::map<std::string, std::vector<Real> > data;
+            
+            unsigned long            last_use;
+        };
+        
+        /*!
+         *   creates a cache for up to \p max_entries design points. Two
+         *   design points are considered identical if their distance is
+         *   less than \p tol times the norm of the design vector.
+         */
+        DesignPointCache(const libMesh::Parallel::Communicator& comm_in,
+                         unsigned int max_entries,
+                         Real         tol);
+        
+        virtual ~DesignPointCache();
+        
+        /*!
+         *   @returns the entry for design point \p x, or \p nullptr if
+         *   \p x has not been stored.
+         */
+        Entry* find(const std::vector<Real>& x);
+        
+        /*!
+         *   @returns the stored entry closest to \p x, or \p nullptr if
+         *   the cache is empty.
+         */
+        Entry* nearest(const std::vector<Real>& x);
+        
+        /*!
+         *   adds \p e to the cache and deletes the least recently used
+         *   entries in excess of the capacity.
+         *   @returns a reference to the stored entry.
+         */
+        Entry& insert(std::unique_ptr<Entry> e);
+        
+        /*!
+         *   deletes all entries
+         */
+        void clear();
+        
+        unsigned int n_entries() const { return (unsigned int)_entries.size(); }
+        
+        /*!
+         *   @returns the number of calls to \p find() that returned an entry
+         */
+        unsigned int n_hits() const { return _n_hits; }
+        
+        /*!
+         *   @returns the number of calls to \p find() that did not return
+         *   an entry
+         */
+        unsigned int n_misses() const { return _n_misses; }
+        
+    protected:
+        
+        /*!
+         *   @returns the infinity norm of \p x1 - \p x2 across all ranks
+         */
+        Real _distance(const std::vector<Real>& x1,
+                       const std::vector<Real>& x2) const;
+        
+        const unsigned int _max_entries;
+        
+        const Real         _tol;
+        
+        unsigned long      _n_uses;
+        
+        unsigned int       _n_hits, _n_misses;
+        
+        std::list<std::unique_ptr<Entry> > _entries;
+    };
+}
+
+
+#endif // __mast__design_point_cache_h__
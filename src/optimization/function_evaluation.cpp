@@ -37,6 +37,105 @@ MAST::FunctionEvaluation::attach_optimization_interface(MAST::OptimizationInterf
 }
 
 
+unsigned int
+MAST::FunctionEvaluation::n_local_vars() const {
+    
+    const unsigned int
+    n_procs = this->comm().size(),
+    rank    = this->comm().rank();
+    
+    return _n_vars/n_procs + (rank < _n_vars%n_procs ? 1 : 0);
+}
+
+
+
+void
+MAST::FunctionEvaluation::init_dvar(libMesh::NumericVector<Real>& x,
+                                    libMesh::NumericVector<Real>& xmin,
+                                    libMesh::NumericVector<Real>& xmax) {
+    
+    std::vector<Real>
+    x_vec    (_n_vars, 0.),
+    xmin_vec (_n_vars, 0.),
+    xmax_vec (_n_vars, 0.);
+    
+    this->_init_dvar_wrapper(x_vec, xmin_vec, xmax_vec);
+    
+    for (libMesh::numeric_index_type i=x.first_local_index(); i<x.last_local_index(); i++) {
+        
+        x.set   (i, x_vec[i]);
+        xmin.set(i, xmin_vec[i]);
+        xmax.set(i, xmax_vec[i]);
+    }
+    
+    x.close();
+    xmin.close();
+    xmax.close();
+}
+
+
+
+void
+MAST::FunctionEvaluation::evaluate(const libMesh::NumericVector<Real>& dvars,
+                                   Real& obj,
+                                   bool eval_obj_grad,
+                                   libMesh::NumericVector<Real>& obj_grad,
+                                   std::vector<Real>& fvals,
+                                   std::vector<bool>& eval_grads,
+                                   std::vector<libMesh::NumericVector<Real>*>& grads) {
+    
+    const unsigned int
+    n_con = _n_eq + _n_ineq;
+    
+    libmesh_assert_equal_to(dvars.size(), _n_vars);
+    libmesh_assert_equal_to(grads.size(), n_con);
+    
+    std::vector<Real>
+    x        (_n_vars, 0.),
+    g0       (_n_vars, 0.),
+    g        (_n_vars*n_con, 0.);
+    
+    dvars.localize(x);
+    
+    this->evaluate(x, obj, eval_obj_grad, g0, fvals, eval_grads, g);
+    
+    const libMesh::numeric_index_type
+    first = dvars.first_local_index(),
+    last  = dvars.last_local_index();
+    
+    if (eval_obj_grad) {
+        
+        for (libMesh::numeric_index_type j=first; j<last; j++)
+            obj_grad.set(j, g0[j]);
+        obj_grad.close();
+    }
+    
+    for (unsigned int i=0; i<n_con; i++)
+        if (eval_grads[i]) {
+            
+            for (libMesh::numeric_index_type j=first; j<last; j++)
+                grads[i]->set(j, g[j*n_con+i]);
+            grads[i]->close();
+        }
+}
+
+
+
+void
+MAST::FunctionEvaluation::output(unsigned int iter,
+                                 const libMesh::NumericVector<Real>& x,
+                                 Real obj,
+                                 const std::vector<Real>& fval,
+                                 bool if_write_to_optim_file) {
+    
+    std::vector<Real> x_vec(_n_vars, 0.);
+    x.localize(x_vec);
+    
+    this->output(iter, x_vec, obj, fval, if_write_to_optim_file);
+}
+
+
+
 void
 MAST::FunctionEvaluation::output(unsigned int iter,
                                  const std::vector<Real> &x,
@@ -455,6 +554,135 @@ MAST::FunctionEvaluation::sanitize_parallel() {
 
 
 
+void
+MAST::FunctionEvaluation::enable_design_point_cache(unsigned int max_entries,
+                                                    Real         tol) {
+    
+    libmesh_assert(this->comm().verify(max_entries));
+    
+    _cache.reset(new MAST::DesignPointCache(this->comm(), max_entries, tol));
+}
+
+
+
+bool
+MAST::FunctionEvaluation::warm_start_vector(const std::string& nm,
+                                            libMesh::NumericVector<Real>& v) const {
+    
+    if (!_warm_start)
+        return false;
+    
+    std::map<std::string, std::unique_ptr<libMesh::NumericVector<Real> > >::const_iterator
+    it = _warm_start->vectors.find(nm);
+    
+    if (it == _warm_start->vectors.end())
+        return false;
+    
+    v = *it->second;
+    
+    // first-order extrapolation from the stored sensitivities
+    if (_current_dvars && _warm_start != _current_entry) {
+        
+        std::map<std::pair<std::string, unsigned int>,
+        std::unique_ptr<libMesh::NumericVector<Real> > >::const_iterator
+        s_it  = _warm_start->sensitivities.lower_bound(std::make_pair(nm, 0u)),
+        s_end = _warm_start->sensitivities.end();
+        
+        for ( ; s_it != s_end && s_it->first.first == nm; s_it++) {
+            
+            const unsigned int i = s_it->first.second;
+            libmesh_assert_less(i, _current_dvars->size());
+            
+            const Real dx = (*_current_dvars)[i] - _warm_start->dvars[i];
+            if (dx != 0.)
+                v.add(dx, *s_it->second);
+        }
+        
+        v.close();
+    }
+    
+    return true;
+}
+
+
+
+bool
+MAST::FunctionEvaluation::warm_start_data(const std::string& nm,
+                                          std::vector<Real>& d) const {
+    
+    if (!_warm_start)
+        return false;
+    
+    std::map<std::string, std::vector<Real> >::const_iterator
+    it = _warm_start->data.find(nm);
+    
+    if (it == _warm_start->data.end())
+        return false;
+    
+    d = it->second;
+    
+    return true;
+}
+
+
+
+void
+MAST::FunctionEvaluation::cache_vector(const std::string& nm,
+                                       const libMesh::NumericVector<Real>& v) {
+    
+    if (!_current_entry)
+        return;
+    
+    _current_entry->vectors[nm].reset(v.clone().release());
+}
+
+
+
+void
+MAST::FunctionEvaluation::cache_vector_sensitivity(const std::string& nm,
+                                                   unsigned int i,
+                                                   const libMesh::NumericVector<Real>& dv) {
+    
+    if (!_current_entry)
+        return;
+    
+    libmesh_assert_less(i, _n_vars);
+    
+    _current_entry->sensitivities[std::make_pair(nm, i)].reset(dv.clone().release());
+}
+
+
+
+void
+MAST::FunctionEvaluation::cache_data(const std::string& nm,
+                                     const std::vector<Real>& d) {
+    
+    if (!_current_entry)
+        return;
+    
+    _current_entry->data[nm] = d;
+}
+
+
+
+bool
+MAST::FunctionEvaluation::_if_cached(const MAST::DesignPointCache::Entry& e,
+                                     bool eval_obj_grad,
+                                     const std::vector<bool>& eval_grads) const {
+    
+    if (eval_obj_grad && !e.if_obj_grad)
+        return false;
+    
+    for (unsigned int i=0; i<eval_grads.size(); i++)
+        if (eval_grads[i] &&
+            (i >= e.if_grads.size() || !e.if_grads[i]))
+            return false;
+    
+    return true;
+}
+
+
+
 void
 MAST::FunctionEvaluation::_init_dvar_wrapper(std::vector<Real>& x,
                                              std::vector<Real>& xmin,
@@ -483,6 +711,47 @@ MAST::FunctionEvaluation::_evaluate_wrapper(const std::vector<Real>& dvars,
     libmesh_assert(this->comm().verify(dvars));
     libmesh_assert(this->comm().verify(eval_obj_grad));
     
+    std::unique_ptr<MAST::DesignPointCache::Entry> new_entry;
+    
+    if (_cache) {
+        
+        MAST::DesignPointCache::Entry
+        *e = _cache->find(dvars);
+        
+        if (e && _if_cached(*e, eval_obj_grad, eval_grads)) {
+            
+            // repeat evaluation at a stored design point
+            const unsigned int
+            n_con = _n_eq + _n_ineq;
+            
+            obj   = e->obj;
+            fvals = e->fvals;
+            
+            if (eval_obj_grad)
+                obj_grad = e->obj_grad;
+            
+            for (unsigned int i=0; i<n_con; i++)
+                if (eval_grads[i])
+                    for (unsigned int j=0; j<_n_vars; j++)
+                        grads[j*n_con+i] = e->grads[j*n_con+i];
+            
+            return;
+        }
+        
+        if (e)
+            _warm_start    = e;
+        else {
+            
+            _warm_start    = _cache->nearest(dvars);
+            new_entry.reset(new MAST::DesignPointCache::Entry);
+            new_entry->dvars = dvars;
+            e              = new_entry.get();
+        }
+        
+        _current_entry = e;
+        _current_dvars = &dvars;
+    }
+    
     this->evaluate(dvars,
                    obj,
                    eval_obj_grad,
@@ -497,6 +766,172 @@ MAST::FunctionEvaluation::_evaluate_wrapper(const std::vector<Real>& dvars,
     libmesh_assert(this->comm().verify(obj_grad));
     libmesh_assert(this->comm().verify(fvals));
     libmesh_assert(this->comm().verify(grads));
+    
+    if (_cache) {
+        
+        MAST::DesignPointCache::Entry
+        &e = *_current_entry;
+        
+        const unsigned int
+        n_con = _n_eq + _n_ineq;
+        
+        e.obj   = obj;
+        e.fvals = fvals;
+        
+        if (eval_obj_grad) {
+            e.if_obj_grad = true;
+            e.obj_grad    = obj_grad;
+        }
+        
+        if (e.if_grads.size() != n_con) {
+            e.if_grads.assign(n_con, false);
+            e.grads.assign(_n_vars*n_con, 0.);
+        }
+        
+        for (unsigned int i=0; i<n_con; i++)
+            if (eval_grads[i]) {
+                e.if_grads[i] = true;
+                for (unsigned int j=0; j<_n_vars; j++)
+                    e.grads[j*n_con+i] = grads[j*n_con+i];
+            }
+        
+        if (new_entry)
+            _cache->insert(std::move(new_entry));
+        
+        _warm_start    = nullptr;
+        _current_entry = nullptr;
+        _current_dvars = nullptr;
+    }
+}
+
+
+
+void
+MAST::FunctionEvaluation::_init_dvar_wrapper(libMesh::NumericVector<Real>& x,
+                                             libMesh::NumericVector<Real>& xmin,
+                                             libMesh::NumericVector<Real>& xmax) {
+    
+    libmesh_assert_equal_to(x.size(),    _n_vars);
+    libmesh_assert_equal_to(xmin.size(), _n_vars);
+    libmesh_assert_equal_to(xmax.size(), _n_vars);
+    
+    this->init_dvar(x, xmin, xmax);
+}
+
+
+
+void
+MAST::FunctionEvaluation::_evaluate_wrapper(const libMesh::NumericVector<Real>& dvars,
+                                            Real& obj,
+                                            bool eval_obj_grad,
+                                            libMesh::NumericVector<Real>& obj_grad,
+                                            std::vector<Real>& fvals,
+                                            std::vector<bool>& eval_grads,
+                                            std::vector<libMesh::NumericVector<Real>*>& grads) {
+    
+    libmesh_assert(this->comm().verify(eval_obj_grad));
+    
+    std::unique_ptr<MAST::DesignPointCache::Entry> new_entry;
+    
+    if (_cache) {
+        
+        // the cache is keyed by the local entries of the design vector
+        std::vector<Real>
+        x(dvars.local_size());
+        
+        for (libMesh::numeric_index_type i=dvars.first_local_index();
+             i<dvars.last_local_index(); i++)
+            x[i-dvars.first_local_index()] = dvars(i);
+        
+        MAST::DesignPointCache::Entry
+        *e = _cache->find(x);
+        
+        if (e && _if_cached(*e, eval_obj_grad, eval_grads)) {
+            
+            obj   = e->obj;
+            fvals = e->fvals;
+            
+            if (eval_obj_grad)
+                obj_grad = *e->obj_grad_vec;
+            
+            for (unsigned int i=0; i<eval_grads.size(); i++)
+                if (eval_grads[i])
+                    *grads[i] = *e->grad_vecs[i];
+            
+            return;
+        }
+        
+        if (e)
+            _warm_start    = e;
+        else {
+            
+            _warm_start    = _cache->nearest(x);
+            new_entry.reset(new MAST::DesignPointCache::Entry);
+            new_entry->dvars.swap(x);
+            e              = new_entry.get();
+        }
+        
+        _current_entry = e;
+    }
+    
+    this->evaluate(dvars,
+                   obj,
+                   eval_obj_grad,
+                   obj_grad,
+                   fvals,
+                   eval_grads,
+                   grads);
+    
+    // the function values are used by all ranks in the optimizer
+    libmesh_assert(this->comm().verify(obj));
+    libmesh_assert(this->comm().verify(fvals));
+    
+    if (_cache) {
+        
+        MAST::DesignPointCache::Entry
+        &e = *_current_entry;
+        
+        e.obj   = obj;
+        e.fvals = fvals;
+        
+        if (eval_obj_grad) {
+            e.if_obj_grad = true;
+            e.obj_grad_vec.reset(obj_grad.clone().release());
+        }
+        
+        if (e.if_grads.size() != eval_grads.size()) {
+            e.if_grads.assign(eval_grads.size(), false);
+            e.grad_vecs.clear();
+            e.grad_vecs.resize(eval_grads.size());
+        }
+        
+        for (unsigned int i=0; i<eval_grads.size(); i++)
+            if (eval_grads[i]) {
+                e.if_grads[i] = true;
+                e.grad_vecs[i].reset(grads[i]->clone().release());
+            }
+        
+        if (new_entry)
+            _cache->insert(std::move(new_entry));
+        
+        _warm_start    = nullptr;
+        _current_entry = nullptr;
+    }
+}
+
+
+
+void
+MAST::FunctionEvaluation::_output_wrapper(unsigned int iter,
+                                          const libMesh::NumericVector<Real>& x,
+                                          Real obj,
+                                          const std::vector<Real>& fval,
+                                          bool if_write_to_optim_file) {
+    
+    libmesh_assert(this->comm().verify(iter));
+    
+    this->output(_iter, x, obj, fval, if_write_to_optim_file);
+    _iter++;
 }
 
 
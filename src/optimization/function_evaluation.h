@@ -31,10 +31,12 @@
 // MAST includes
 #include "base/mast_data_types.h"
 #include "base/mast_config.h"
+#include "optimization/design_point_cache.h"
 
 
 // libMesh includes
 #include "libmesh/parallel_object.h"
+#include "libmesh/numeric_vector.h"
 
 
 namespace MAST {
@@ -57,7 +59,10 @@ namespace MAST {
         _n_rel_change_iters     (5),
         _tol                    (1.0e-6),
         _output                 (nullptr),
-        _optimization_interface (nullptr)
+        _optimization_interface (nullptr),
+        _warm_start             (nullptr),
+        _current_entry          (nullptr),
+        _current_dvars          (nullptr)
         { }
         
         virtual ~FunctionEvaluation() { }
@@ -96,10 +101,31 @@ namespace MAST {
         }
         
         
+        /*!
+         *   @returns the number of design variables stored on this rank
+         *   in the distributed vectors passed to the distributed
+         *   \p init_dvar() and \p evaluate(). The default implementation
+         *   divides the variables evenly among the ranks. Derived classes
+         *   should override this to match the distribution of the
+         *   underlying field, for example the local dofs of a level-set
+         *   system.
+         */
+        virtual unsigned int n_local_vars() const;
+        
+        
         virtual void init_dvar(std::vector<Real>& x,
                                std::vector<Real>& xmin,
                                std::vector<Real>& xmax) = 0;
         
+        /*!
+         *   initializes the distributed design variable vector \p x and its
+         *   bounds. The default implementation calls the replicated
+         *   \p init_dvar() and copies the local entries.
+         */
+        virtual void init_dvar(libMesh::NumericVector<Real>& x,
+                               libMesh::NumericVector<Real>& xmin,
+                               libMesh::NumericVector<Real>& xmax);
+        
         /*!
          *   \p grads(k): Derivative of f_i(x) with respect
          *   to x_j, where k = (j-1)*M + i.
@@ -112,6 +138,62 @@ namespace MAST {
                               std::vector<bool>& eval_grads,
                               std::vector<Real>& grads) = 0;
         
+        /*!
+         *   evaluates the functions for distributed design variables. The
+         *   gradient of constraint \p i is returned in \p grads[i] if
+         *   \p eval_grads[i] is true. The gradient vectors have the same
+         *   distribution as \p dvars. The default implementation localizes
+         *   \p dvars, calls the replicated \p evaluate() and copies the
+         *   local entries of the gradients, so that derived classes need
+         *   to override this method to avoid the replicated storage of
+         *   the gradients.
+         */
+        virtual void evaluate(const libMesh::NumericVector<Real>& dvars,
+                              Real& obj,
+                              bool eval_obj_grad,
+                              libMesh::NumericVector<Real>& obj_grad,
+                              std::vector<Real>& fvals,
+                              std::vector<bool>& eval_grads,
+                              std::vector<libMesh::NumericVector<Real>*>& grads);
+        
+        
+        /*!
+         *   creates a cache of the last \p max_entries function evaluations.
+         *   The wrappers \p _evaluate_wrapper() used by the optimizers
+         *   then return the stored values without calling \p evaluate()
+         *   if the design point and requested gradients were previously
+         *   evaluated, which is frequent in the inner iterations and line
+         *   searches of the optimizers. Two design points are considered
+         *   identical if their distance is less than \p tol times the
+         *   norm of the design vector.
+         *
+         *   During a call to \p evaluate() derived classes can store the
+         *   analysis states with \p cache_vector() and \p cache_data(),
+         *   and initialize the analysis with \p warm_start_vector() and
+         *   \p warm_start_data() from the nearest cached design point. For
+         *   example, a nonlinear analysis can be started as
+         *
+         *   \code
+         *   if (!this->warm_start_vector("sol", *sys.solution))
+         *       sys.solution->zero();
+         *   // ... solve ...
+         *   this->cache_vector("sol", *sys.solution);
+         *   \endcode
+         *
+         *   and eigenvectors and flutter roots can be stored in the
+         *   same manner.
+         */
+        void enable_design_point_cache(unsigned int max_entries = 5,
+                                       Real         tol         = 0.);
+        
+        /*!
+         *   @returns a pointer to the design point cache, or \p nullptr if
+         *   the cache is not enabled.
+         */
+        MAST::DesignPointCache* design_point_cache() {
+            return _cache.get();
+        }
+        
         
         /*!
          *   sets the output file and the function evaluation will 
@@ -142,6 +224,17 @@ namespace MAST {
                             const std::vector<Real>& fval,
                             bool if_write_to_optim_file);
         
+        /*!
+         *   outputs the current iterate for distributed design variables.
+         *   The default implementation localizes \p x and calls the
+         *   replicated \p output().
+         */
+        virtual void output(unsigned int iter,
+                            const libMesh::NumericVector<Real>& x,
+                            Real obj,
+                            const std::vector<Real>& fval,
+                            bool if_write_to_optim_file);
+        
         
         /*!
          *   This reads and initializes the DV vector from a previous
@@ -156,13 +249,41 @@ namespace MAST {
                                             std::vector<Real> &x);
         
         /*!
-         *  verifies the gradients at the specified design point
+         *   @returns true if the derived class implements
+         *   \p evaluate_complex_step().
+         */
+        virtual bool if_complex_step() const {
+            return false;
+        }
+        
+        /*!
+         *   evaluates the complex-step derivatives of the objective and
+         *   constraints with respect to design variable \p i,
+         *   \f$ Im(f(x + i h e_i))/h \f$, in \p obj_deriv and
+         *   \p fvals_deriv. This is used by \p MAST::GradientVerification
+         *   for analyses that can be run in complex arithmetic, and should
+         *   be implemented together with \p if_complex_step().
+         */
+        virtual void evaluate_complex_step(const std::vector<Real>& dvars,
+                                           unsigned int i,
+                                           Real h,
+                                           Real& obj_deriv,
+                                           std::vector<Real>& fvals_deriv) {
+            libmesh_error_msg("Complex-step evaluation not implemented.");
+        }
+        
+        /*!
+         *  verifies the gradients at the specified design point. See
+         *  \p MAST::GradientVerification for the verification with
+         *  concurrent evaluations on groups of ranks.
          */
         virtual bool verify_gradients(const std::vector<Real>& dvars);
 
         /*!
          *  computes a parametric evaluation along a line from \p iter1 to
          *  \p iter2 in file \p nm with \p divs runs between the two.
+         *  See \p MAST::GradientVerification for the concurrent evaluation
+         *  of the points on groups of ranks.
          */
         virtual void
         parametric_line_study(const std::string& nm,
@@ -232,6 +353,13 @@ namespace MAST {
         virtual void _init_dvar_wrapper(std::vector<Real>& x,
                                         std::vector<Real>& xmin,
                                         std::vector<Real>& xmax);
+
+        /*!
+         *  wrapper around the distributed init_dvar()
+         */
+        virtual void _init_dvar_wrapper(libMesh::NumericVector<Real>& x,
+                                        libMesh::NumericVector<Real>& xmin,
+                                        libMesh::NumericVector<Real>& xmax);
         
 
         /*!
@@ -248,6 +376,18 @@ namespace MAST {
                                        std::vector<bool>& eval_grads,
                                        std::vector<Real>& grads);
 
+        /*!
+         *  wrapper around the distributed evaluate(), which makes sure
+         *  that the function values are the same on all processors.
+         */
+        virtual void _evaluate_wrapper(const libMesh::NumericVector<Real>& dvars,
+                                       Real& obj,
+                                       bool eval_obj_grad,
+                                       libMesh::NumericVector<Real>& obj_grad,
+                                       std::vector<Real>& fvals,
+                                       std::vector<bool>& eval_grads,
+                                       std::vector<libMesh::NumericVector<Real>*>& grads);
+
         /*!
          *  This serves as a wrapper around evaluate() and makes sure
          *  that the derived class's implementation is given the same
@@ -259,8 +399,71 @@ namespace MAST {
                                      const std::vector<Real>& fval,
                                      bool if_write_to_optim_file);
 
+        /*!
+         *  wrapper around the distributed output()
+         */
+        virtual void _output_wrapper(unsigned int iter,
+                                     const libMesh::NumericVector<Real>& x,
+                                     Real obj,
+                                     const std::vector<Real>& fval,
+                                     bool if_write_to_optim_file);
+
     protected:
         
+        /*!
+         *   initializes \p v from the vector stored with name \p nm at the
+         *   cached design point nearest to the design point being
+         *   evaluated. If the sensitivities of this vector were stored
+         *   with \p cache_vector_sensitivity(), the first-order
+         *   extrapolation to the current design point is returned. This
+         *   is only available for replicated design vectors.
+         *   @returns false if no cached vector is available, in which case
+         *   \p v is not modified.
+         */
+        bool warm_start_vector(const std::string& nm,
+                               libMesh::NumericVector<Real>& v) const;
+        
+        /*!
+         *   initializes \p d from the data stored with name \p nm at the
+         *   cached design point nearest to the design point being
+         *   evaluated.
+         *   @returns false if no cached data is available.
+         */
+        bool warm_start_data(const std::string& nm,
+                             std::vector<Real>& d) const;
+        
+        /*!
+         *   stores a copy of \p v with name \p nm for the design point
+         *   being evaluated. This does nothing if the cache is not enabled
+         *   or if called outside \p evaluate().
+         */
+        void cache_vector(const std::string& nm,
+                          const libMesh::NumericVector<Real>& v);
+        
+        /*!
+         *   stores a copy of the sensitivity \p dv of vector \p nm with
+         *   respect to design variable \p i, which is used for the
+         *   first-order extrapolation in \p warm_start_vector().
+         */
+        void cache_vector_sensitivity(const std::string& nm,
+                                      unsigned int i,
+                                      const libMesh::NumericVector<Real>& dv);
+        
+        /*!
+         *   stores a copy of \p d with name \p nm for the design point
+         *   being evaluated.
+         */
+        void cache_data(const std::string& nm,
+                        const std::vector<Real>& d);
+        
+        /*!
+         *   @returns true if \p e provides the gradients requested by
+         *   \p eval_obj_grad and \p eval_grads.
+         */
+        bool _if_cached(const MAST::DesignPointCache::Entry& e,
+                        bool eval_obj_grad,
+                        const std::vector<bool>& eval_grads) const;
+        
         unsigned int _iter;
         
         unsigned int _n_vars;
@@ -278,6 +481,24 @@ namespace MAST {
         std::ofstream* _output;
         
         MAST::OptimizationInterface        *_optimization_interface;
+        
+        std::unique_ptr<MAST::DesignPointCache> _cache;
+        
+        /*!
+         *   cached entry nearest to the design point being evaluated
+         */
+        MAST::DesignPointCache::Entry*          _warm_start;
+        
+        /*!
+         *   entry that stores the data of the design point being evaluated
+         */
+        MAST::DesignPointCache::Entry*          _current_entry;
+        
+        /*!
+         *   replicated design point being evaluated, which is \p nullptr
+         *   for the distributed evaluation
+         */
+        const std::vector<Real>*                _current_dvars;
     };
 
 
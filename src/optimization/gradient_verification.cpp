@@ -0,0 +1,459 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <cmath>
+#include <iomanip>
+#include <algorithm>
+
+// MAST includes
+#include "optimization/gradient_verification.h"
+#include "optimization/function_evaluation.h"
+
+
+MAST::GradientVerification::
+GradientVerification(const libMesh::Parallel::Communicator& comm_in,
+                     unsigned int n_groups):
+libMesh::ParallelObject (comm_in),
+step                    (1.e-5),
+n_adaptive_steps        (1),
+step_reduction          (0.1),
+tol                     (1.e-3),
+use_complex_step        (true),
+complex_step            (1.e-20),
+_n_groups               (n_groups),
+_group_id               (0),
+_n_funcs                (0) {
+    
+    libmesh_assert_greater(n_groups, 0);
+    libmesh_assert_less_equal(n_groups, comm_in.size());
+    
+    // contiguous blocks of ranks form a group
+    _group_id = (comm_in.rank() * n_groups) / comm_in.size();
+    comm_in.split(_group_id, comm_in.rank(), _group_comm);
+}
+
+
+
+MAST::GradientVerification::~GradientVerification() {
+    
+}
+
+
+
+template <typename EvalFunc>
+void
+MAST::GradientVerification::_evaluate_units(unsigned int n_units,
+                                            unsigned int n_funcs,
+                                            EvalFunc eval,
+                                            std::vector<Real>& obj,
+                                            std::vector<Real>& fvals) {
+    
+    obj.assign(n_units, 0.);
+    fvals.assign(n_units*n_funcs, 0.);
+    
+    Real
+    o = 0.;
+    
+    std::vector<Real>
+    f(n_funcs, 0.);
+    
+    for (unsigned int u=0; u<n_units; u++) {
+        
+        // group 0 also computes the analytical gradients, so the
+        // assignment starts with the next group
+        if ((u+1) % _n_groups != _group_id)
+            continue;
+        
+        o = 0.;
+        std::fill(f.begin(), f.end(), 0.);
+        
+        eval(u, o, f);
+        
+        // all ranks of a group have the same values, which are
+        // contributed only by the first rank of the group
+        if (_group_comm.rank() == 0) {
+            
+            obj[u] = o;
+            for (unsigned int j=0; j<n_funcs; j++)
+                fvals[u*n_funcs+j] = f[j];
+        }
+    }
+    
+    this->comm().sum(obj);
+    this->comm().sum(fvals);
+}
+
+
+
+bool
+MAST::GradientVerification::verify_gradients(MAST::FunctionEvaluation& feval,
+                                             const std::vector<Real>& dvars) {
+    
+    libmesh_assert_equal_to(feval.comm().size(), _group_comm.size());
+    libmesh_assert_equal_to(dvars.size(), feval.n_vars());
+    libmesh_assert(this->comm().verify(dvars));
+    
+    const unsigned int
+    n_vars  = feval.n_vars(),
+    n_con   = feval.n_eq() + feval.n_ineq(),
+    n_steps = std::max(n_adaptive_steps, 1u);
+    
+    const bool
+    if_cs   = use_complex_step && feval.if_complex_step();
+    
+    _n_funcs = n_con + 1;
+    _analytical.assign(n_vars*_n_funcs, 0.);
+    _numerical.assign (n_vars*_n_funcs, 0.);
+    _rel_error.assign (n_vars*_n_funcs, 0.);
+    _step.assign      (n_vars*_n_funcs, 0.);
+    
+    std::vector<Real>
+    x        (dvars),
+    obj_grad (n_vars,       0.),
+    fvals    (n_con,        0.),
+    grads    (n_vars*n_con, 0.),
+    g        (n_vars*n_con, 0.),
+    obj_u,
+    fvals_u;
+    
+    std::vector<bool>
+    eval_grads (n_con, false);
+    
+    Real
+    obj     = 0.;
+    
+    // analytical gradients
+    if (_group_id == 0) {
+        
+        std::fill(eval_grads.begin(), eval_grads.end(), true);
+        feval._evaluate_wrapper(dvars,
+                                obj,
+                                true,
+                                obj_grad,
+                                fvals,
+                                eval_grads,
+                                grads);
+        std::fill(eval_grads.begin(), eval_grads.end(), false);
+        
+        if (_group_comm.rank() == 0)
+            for (unsigned int i=0; i<n_vars; i++) {
+                
+                _analytical[i*_n_funcs] = obj_grad[i];
+                for (unsigned int j=0; j<n_con; j++)
+                    _analytical[i*_n_funcs+j+1] = grads[i*n_con+j];
+            }
+    }
+    
+    // step for design variable i and step number k
+    std::vector<Real>
+    h (n_vars*n_steps, 0.);
+    
+    for (unsigned int i=0; i<n_vars; i++)
+        for (unsigned int k=0; k<n_steps; k++)
+            h[i*n_steps+k] = step * std::max(1., std::fabs(dvars[i])) *
+            std::pow(step_reduction, (Real)k);
+    
+    if (if_cs) {
+        
+        // one complex-step evaluation per design variable, which directly
+        // returns the derivatives
+        _evaluate_units(n_vars,
+                        n_con,
+                        [&](unsigned int u, Real& o, std::vector<Real>& f) {
+                            feval.evaluate_complex_step(dvars, u, complex_step, o, f);
+                        },
+                        obj_u,
+                        fvals_u);
+        
+        for (unsigned int i=0; i<n_vars; i++) {
+            
+            _numerical[i*_n_funcs] = obj_u[i];
+            _step     [i*_n_funcs] = complex_step;
+            for (unsigned int j=0; j<n_con; j++) {
+                _numerical[i*_n_funcs+j+1] = fvals_u[i*n_con+j];
+                _step     [i*_n_funcs+j+1] = complex_step;
+            }
+        }
+    }
+    else {
+        
+        // evaluation u = 2*(i*n_steps+k)+s is the central difference
+        // point of design variable i with step k, with s = 0 for the
+        // positive and s = 1 for the negative perturbation.
+        _evaluate_units(2*n_vars*n_steps,
+                        n_con,
+                        [&](unsigned int u, Real& o, std::vector<Real>& f) {
+                            
+                            const unsigned int
+                            s  = u%2,
+                            ik = u/2,
+                            i  = ik/n_steps;
+                            
+                            x     = dvars;
+                            x[i] += (s == 0 ? 1. : -1.) * h[ik];
+                            
+                            feval._evaluate_wrapper(x, o, false, obj_grad, f, eval_grads, g);
+                        },
+                        obj_u,
+                        fvals_u);
+        
+        Real
+        d      = 0.,
+        d_prev = 0.,
+        err    = 0.,
+        err_min = 0.;
+        
+        for (unsigned int i=0; i<n_vars; i++)
+            for (unsigned int f=0; f<_n_funcs; f++) {
+                
+                for (unsigned int k=0; k<n_steps; k++) {
+                    
+                    const unsigned int
+                    ik = i*n_steps+k;
+                    
+                    if (f == 0)
+                        d = (obj_u[2*ik] - obj_u[2*ik+1]) / 2. / h[ik];
+                    else
+                        d = (fvals_u[2*ik*n_con+f-1] - fvals_u[(2*ik+1)*n_con+f-1]) / 2. / h[ik];
+                    
+                    // with a single step the estimate is used directly.
+                    // Otherwise, the estimate that differs least from the
+                    // estimate with the previous step is used.
+                    if (k == 0) {
+                        
+                        _numerical[i*_n_funcs+f] = d;
+                        _step     [i*_n_funcs+f] = h[ik];
+                    }
+                    else {
+                        
+                        err = std::fabs(d - d_prev);
+                        if (k == 1 || err < err_min) {
+                            
+                            err_min = err;
+                            _numerical[i*_n_funcs+f] = d;
+                            _step     [i*_n_funcs+f] = h[ik];
+                        }
+                    }
+                    
+                    d_prev = d;
+                }
+            }
+    }
+    
+    this->comm().sum(_analytical);
+    
+    // relative errors, where the magnitude of the largest gradient
+    // component of each function is used to avoid the division by
+    // vanishing gradient components
+    bool
+    accurate_sens = true;
+    
+    for (unsigned int f=0; f<_n_funcs; f++) {
+        
+        Real
+        g_max = 0.;
+        
+        for (unsigned int i=0; i<n_vars; i++)
+            g_max = std::max(g_max, std::fabs(_analytical[i*_n_funcs+f]));
+        
+        for (unsigned int i=0; i<n_vars; i++) {
+            
+            const Real
+            a     = _analytical[i*_n_funcs+f],
+            n     = _numerical [i*_n_funcs+f],
+            scale = std::max(std::max(std::fabs(a), std::fabs(n)), 1.e-6 * g_max);
+            
+            _rel_error[i*_n_funcs+f] = scale > 0. ? std::fabs(a - n)/scale : 0.;
+            
+            if (_rel_error[i*_n_funcs+f] > tol)
+                accurate_sens = false;
+        }
+    }
+    
+    this->print_report(libMesh::out);
+    
+    return accurate_sens;
+}
+
+
+
+void
+MAST::GradientVerification::parametric_line_study(MAST::FunctionEvaluation& feval,
+                                                  const std::vector<Real>& dv1,
+                                                  const std::vector<Real>& dv2,
+                                                  unsigned int divs,
+                                                  std::vector<Real>& obj,
+                                                  std::vector<Real>& fvals) {
+    
+    libmesh_assert_equal_to(feval.comm().size(), _group_comm.size());
+    libmesh_assert_equal_to(dv1.size(), feval.n_vars());
+    libmesh_assert_equal_to(dv2.size(), feval.n_vars());
+    libmesh_assert_greater(divs, 0);
+    
+    const unsigned int
+    n_vars  = feval.n_vars(),
+    n_con   = feval.n_eq() + feval.n_ineq();
+    
+    std::vector<Real>
+    x        (n_vars,       0.),
+    obj_grad (n_vars,       0.),
+    g        (n_vars*n_con, 0.);
+    
+    std::vector<bool>
+    eval_grads (n_con, false);
+    
+    _evaluate_units(divs+1,
+                    n_con,
+                    [&](unsigned int u, Real& o, std::vector<Real>& f) {
+                        
+                        const Real
+                        r = (1.*u)/(1.*divs);
+                        
+                        for (unsigned int j=0; j<n_vars; j++)
+                            x[j] = (1.-r) * dv1[j] + r * dv2[j];
+                        
+                        feval._evaluate_wrapper(x, o, false, obj_grad, f, eval_grads, g);
+                    },
+                    obj,
+                    fvals);
+}
+
+
+
+void
+MAST::GradientVerification::parametric_line_study(MAST::FunctionEvaluation& feval,
+                                                  const std::string& nm,
+                                                  const unsigned int iter1,
+                                                  const unsigned int iter2,
+                                                  unsigned int divs,
+                                                  std::vector<Real>& obj,
+                                                  std::vector<Real>& fvals) {
+    
+    std::vector<Real>
+    dv1(feval.n_vars(), 0.),
+    dv2(feval.n_vars(), 0.);
+    
+    feval.initialize_dv_from_output_file(nm, iter1, dv1);
+    feval.initialize_dv_from_output_file(nm, iter2, dv2);
+    
+    this->parametric_line_study(feval, dv1, dv2, divs, obj, fvals);
+}
+
+
+
+Real
+MAST::GradientVerification::analytical_gradient(unsigned int i,
+                                                unsigned int f) const {
+    
+    libmesh_assert_less(f, _n_funcs);
+    libmesh_assert_less(i*_n_funcs+f, _analytical.size());
+    
+    return _analytical[i*_n_funcs+f];
+}
+
+
+
+Real
+MAST::GradientVerification::numerical_gradient(unsigned int i,
+                                               unsigned int f) const {
+    
+    libmesh_assert_less(f, _n_funcs);
+    libmesh_assert_less(i*_n_funcs+f, _numerical.size());
+    
+    return _numerical[i*_n_funcs+f];
+}
+
+
+
+Real
+MAST::GradientVerification::relative_error(unsigned int i,
+                                           unsigned int f) const {
+    
+    libmesh_assert_less(f, _n_funcs);
+    libmesh_assert_less(i*_n_funcs+f, _rel_error.size());
+    
+    return _rel_error[i*_n_funcs+f];
+}
+
+
+
+Real
+MAST::GradientVerification::step_size(unsigned int i,
+                                      unsigned int f) const {
+    
+    libmesh_assert_less(f, _n_funcs);
+    libmesh_assert_less(i*_n_funcs+f, _step.size());
+    
+    return _step[i*_n_funcs+f];
+}
+
+
+
+void
+MAST::GradientVerification::print_report(std::ostream& o) const {
+    
+    if (!_n_funcs)
+        return;
+    
+    const unsigned int
+    n_vars = (unsigned int)_analytical.size()/_n_funcs;
+    
+    Real
+    max_err = 0.;
+    
+    for (unsigned int f=0; f<_n_funcs; f++) {
+        
+        if (f == 0)
+            o << " *** Objective function gradients: analytical vs numerical" << std::endl;
+        else
+            o << " *** Constraint function gradients: analytical vs numerical"
+            << "  Constraint: " << f-1 << std::endl;
+        
+        o
+        << std::setw(10) << "DV"
+        << std::setw(25) << "Analytical"
+        << std::setw(25) << "Numerical"
+        << std::setw(15) << "Step"
+        << std::setw(15) << "Rel. Error" << std::endl;
+        
+        for (unsigned int i=0; i<n_vars; i++) {
+            
+            const unsigned int k = i*_n_funcs+f;
+            
+            o
+            << std::setw(10) << i
+            << std::setw(25) << _analytical[k]
+            << std::setw(25) << _numerical[k]
+            << std::setw(15) << _step[k]
+            << std::setw(15) << _rel_error[k];
+            if (_rel_error[k] > tol)
+                o << " : Mismatched sensitivity";
+            o << std::endl;
+            
+            max_err = std::max(max_err, _rel_error[k]);
+        }
+    }
+    
+    o
+    << "Verify gradients: maximum relative error: " << max_err
+    << "  with tolerance: " << tol
+    << "  using " << _n_groups << " groups" << std::endl;
+}
@@ -0,0 +1,212 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__gradient_verification_h__
+#define __mast__gradient_verification_h__
+
+// C++ includes
+#include <vector>
+#include <string>
+#include <iostream>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/parallel_object.h"
+#include "libmesh/parallel.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class FunctionEvaluation;
+    
+    /*!
+     *   Verifies the gradients of a \p MAST::FunctionEvaluation with
+     *   finite differences, and evaluates the functions along a line in
+     *   the design space, by distributing the independent evaluations
+     *   among groups of ranks. The communicator is split into \p n_groups
+     *   sub-communicators, and the user should create the analysis and
+     *   the function evaluation on \p group_comm() so that each group
+     *   runs its analyses concurrently with the other groups. All ranks
+     *   of the global communicator must call the methods of this class.
+     *
+     *   The gradients are computed with central differences. If
+     *   \p n_adaptive_steps is greater than one, the differences are
+     *   computed for a sequence of steps reduced by \p step_reduction, and
+     *   for each function the step is chosen where consecutive estimates
+     *   agree best, which balances the truncation and round-off errors.
+     *   If \p use_complex_step is true and the function evaluation
+     *   implements \p evaluate_complex_step(), the complex-step derivative
+     *   is used instead, which requires one evaluation per variable and
+     *   is insensitive to the step size.
+     */
+    class GradientVerification:
+    public libMesh::ParallelObject {
+        
+    public:
+        
+        GradientVerification(const libMesh::Parallel::Communicator& comm_in,
+                             unsigned int n_groups);
+        
+        virtual ~GradientVerification();
+        
+        /*!
+         *   @returns the communicator of the group that this rank belongs
+         *   to, on which the function evaluation should be created.
+         */
+        const libMesh::Parallel::Communicator& group_comm() const {
+            return _group_comm;
+        }
+        
+        unsigned int n_groups() const {
+            return _n_groups;
+        }
+        
+        unsigned int group_id() const {
+            return _group_id;
+        }
+        
+        /*!
+         *   relative step size of the finite differences, which is scaled
+         *   by the magnitude of the design variable if it exceeds one
+         */
+        Real         step;
+        
+        /*!
+         *   number of step sizes used for the adaptive step selection.
+         *   A value of 1 uses \p step for all variables.
+         */
+        unsigned int n_adaptive_steps;
+        
+        /*!
+         *   factor by which successive steps are reduced
+         */
+        Real         step_reduction;
+        
+        /*!
+         *   relative error above which a gradient is reported as mismatched
+         */
+        Real         tol;
+        
+        /*!
+         *   uses the complex-step derivative if it is implemented by the
+         *   function evaluation
+         */
+        bool         use_complex_step;
+        
+        /*!
+         *   step of the complex-step derivative
+         */
+        Real         complex_step;
+        
+        /*!
+         *   compares the gradients of \p feval at \p dvars with the numerical
+         *   gradients and writes the report to \p libMesh::out.
+         *   @returns true if all relative errors are below \p tol.
+         */
+        bool verify_gradients(MAST::FunctionEvaluation& feval,
+                              const std::vector<Real>& dvars);
+        
+        /*!
+         *   evaluates the functions at \p divs+1 points on the line from
+         *   \p dv1 to \p dv2. Upon return, \p obj[p] and
+         *   \p fvals[p*(n_eq+n_ineq)+i] contain the objective and
+         *   constraint \p i at point \p p on all ranks.
+         */
+        void parametric_line_study(MAST::FunctionEvaluation& feval,
+                                   const std::vector<Real>& dv1,
+                                   const std::vector<Real>& dv2,
+                                   unsigned int divs,
+                                   std::vector<Real>& obj,
+                                   std::vector<Real>& fvals);
+        
+        /*!
+         *   evaluates the functions on the line between the design points
+         *   of iterations \p iter1 and \p iter2 in the optimization history
+         *   file \p nm.
+         */
+        void parametric_line_study(MAST::FunctionEvaluation& feval,
+                                   const std::string& nm,
+                                   const unsigned int iter1,
+                                   const unsigned int iter2,
+                                   unsigned int divs,
+                                   std::vector<Real>& obj,
+                                   std::vector<Real>& fvals);
+        
+        /*!
+         *   The following return the results of the last call to
+         *   \p verify_gradients() for design variable \p i and function
+         *   \p f, where \p f = 0 is the objective and \p f = j+1 is
+         *   constraint \p j.
+         */
+        Real analytical_gradient(unsigned int i, unsigned int f) const;
+        
+        Real numerical_gradient(unsigned int i, unsigned int f) const;
+        
+        Real relative_error(unsigned int i, unsigned int f) const;
+        
+        Real step_size(unsigned int i, unsigned int f) const;
+        
+        /*!
+         *   writes the per-variable report of the last call to
+         *   \p verify_gradients() to \p o.
+         */
+        void print_report(std::ostream& o) const;
+        
+    protected:
+        
+        /*!
+         *   calls \p eval(u, obj, fvals) for the \p n_units independent
+         *   evaluations assigned to this group and gathers \p obj and
+         *   \p fvals of all evaluations on all ranks.
+         */
+        template <typename EvalFunc>
+        void _evaluate_units(unsigned int n_units,
+                             unsigned int n_funcs,
+                             EvalFunc eval,
+                             std::vector<Real>& obj,
+                             std::vector<Real>& fvals);
+        
+        const unsigned int              _n_groups;
+        
+        unsigned int                    _group_id;
+        
+        libMesh::Parallel::Communicator _group_comm;
+        
+        /*!
+         *   results of the last verification, with \p n_vars*(1+n_eq+n_ineq)
+         *   entries
+         */
+        unsigned int                    _n_funcs;
+        
+        std::vector<Real>               _analytical;
+        
+        std::vector<Real>               _numerical;
+        
+        std::vector<Real>               _rel_error;
+        
+        std::vector<Real>               _step;
+    };
+}
+
+
+#endif // __mast__gradient_verification_h__
@@ -0,0 +1,687 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <cmath>
+#include <algorithm>
+
+// MAST includes
+#include "optimization/mma_optimization_interface.h"
+#include "optimization/function_evaluation.h"
+
+// libMesh includes
+#include "libmesh/parallel.h"
+
+
+MAST::MMAOptimizationInterface::MMAOptimizationInterface():
+MAST::OptimizationInterface(),
+_constr_penalty       (5.e1),
+_initial_rel_step     (5.e-1),
+_asymptote_reduction  (0.7),
+_asymptote_expansion  (1.2),
+_move_limit           (0.1),
+_dual_tol             (1.e-10),
+_max_inner_iters      (15),
+_max_dual_iters       (100),
+_m                    (0) {
+    
+}
+
+
+
+MAST::MMAOptimizationInterface::~MMAOptimizationInterface() {
+    
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::set_real_parameter(const std::string &nm, Real val) {
+    
+    if (nm == "constraint_penalty") {
+        
+        libmesh_assert_greater(val, 0.);
+        
+        _constr_penalty = val;
+    }
+    else if (nm == "initial_rel_step") {
+        
+        libmesh_assert_greater(val, 0.);
+        
+        _initial_rel_step = val;
+    }
+    else if (nm == "asymptote_reduction") {
+        
+        libmesh_assert_greater(val, 0.);
+        
+        _asymptote_reduction = val;
+    }
+    else if (nm == "asymptote_expansion") {
+        
+        libmesh_assert_greater(val, 0.);
+        
+        _asymptote_expansion = val;
+    }
+    else if (nm == "move_limit") {
+        
+        libmesh_assert_greater(val, 0.);
+        libmesh_assert_less(val, 1.);
+        
+        _move_limit = val;
+    }
+    else if (nm == "dual_tolerance") {
+        
+        libmesh_assert_greater(val, 0.);
+        
+        _dual_tol = val;
+    }
+    else
+        libMesh::out
+        << "Unrecognized real parameter: " << nm << std::endl;
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::set_integer_parameter(const std::string &nm, int val) {
+    
+    if (nm == "max_inner_iters") {
+        
+        libmesh_assert_greater_equal(val, 0);
+        
+        _max_inner_iters = val;
+    }
+    else if (nm == "max_dual_iters") {
+        
+        libmesh_assert_greater(val, 0);
+        
+        _max_dual_iters = val;
+    }
+    else
+        libMesh::out
+        << "Unrecognized integer parameter: " << nm << std::endl;
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::optimize() {
+    
+    libmesh_assert(_feval);
+    
+    // make sure that all processes have the same problem setup
+    _feval->sanitize_parallel();
+    
+    _m = _feval->n_eq() + _feval->n_ineq();
+    
+    const unsigned int
+    n_rel_change_iters = _feval->n_iters_relative_change();
+    
+    const Real
+    geps               = _feval->tolerance();
+    
+    libmesh_assert_greater(_feval->n_vars(), 0);
+    libmesh_assert_greater(n_rel_change_iters, 0);
+    
+    _init_vectors();
+    
+    _feval->_init_dvar_wrapper(*_x, *_xmin, *_xmax);
+    _get_local(*_xmin, _xlb);
+    _get_local(*_xmax, _xub);
+    *_xold1 = *_x;
+    *_xold2 = *_x;
+    
+    // the penalty on the artificial variables is large compared to the
+    // design variables
+    const Real max_x = _x->linfty_norm();
+    _c.assign(_m, std::max(max_x, _constr_penalty));
+    _d.assign(_m, 1.);
+    _lambda.assign(_m, 1.);
+    
+    std::vector<Real>
+    fval     (_m, 0.),
+    fnew     (_m, 0.),
+    fapp     (_m+1, 0.),
+    xmma,
+    f0_iters (n_rel_change_iters, 0.);
+    
+    std::vector<bool>
+    eval_grads(_m, false);
+    
+    std::vector<libMesh::NumericVector<Real>*>
+    grads(_m, nullptr);
+    for (unsigned int i=0; i<_m; i++)
+        grads[i] = _dfdx[i].get();
+    
+    Real
+    f0       = 0.,
+    f0new    = 0.;
+    
+    unsigned int
+    iter     = 0,
+    nl       = (unsigned int)_local_idx.size();
+    
+    while (true) {
+        
+        // function values and gradients at the current design
+        std::fill(eval_grads.begin(), eval_grads.end(), true);
+        _feval->_evaluate_wrapper(*_x, f0, true, *_df0dx, fval, eval_grads, grads);
+        _feval->_output_wrapper(iter, *_x, f0, fval, true);
+        
+        f0_iters[iter%n_rel_change_iters] = f0;
+        
+        if (iter == _feval->max_iters()) {
+            libMesh::out
+            << "MMA: Reached maximum iterations, terminating! "
+            << std::endl;
+            break;
+        }
+        
+        // relative change in objective over the last iterations
+        if (iter+1 >= n_rel_change_iters) {
+            
+            bool rel_change_conv = true;
+            for (unsigned int i=0; i<n_rel_change_iters; i++) {
+                if (f0 > sqrt(geps))
+                    rel_change_conv = (rel_change_conv &&
+                                       fabs(f0_iters[i]-f0)/fabs(f0) < geps);
+                else
+                    rel_change_conv = (rel_change_conv &&
+                                       fabs(f0_iters[i]-f0) < geps);
+            }
+            
+            if (rel_change_conv) {
+                libMesh::out
+                << "MMA: Converged relative change tolerance, terminating! "
+                << std::endl;
+                break;
+            }
+        }
+        
+        iter++;
+        
+        _get_local(*_x, _xval);
+        _get_local(*_df0dx, _g0);
+        _g.resize(_m*nl);
+        for (unsigned int i=0; i<_m; i++) {
+            
+            _get_local(*_dfdx[i], xmma);
+            std::copy(xmma.begin(), xmma.end(), _g.begin()+i*nl);
+        }
+        
+        _update_asymptotes(iter);
+        _init_rho();
+        
+        // the inner iterations increase the conservatism parameters until
+        // the approximations are conservative at the subproblem solution
+        unsigned int inner = 0;
+        
+        while (true) {
+            
+            _init_approximations(f0, fval);
+            _solve_subproblem(xmma, fapp);
+            _set_local(*_xmma, xmma);
+            
+            if (inner == _max_inner_iters) {
+                if (_max_inner_iters)
+                    libMesh::out
+                    << "** Max Inner Iter Reached: Terminating! Inner Iter = "
+                    << inner << std::endl;
+                break;
+            }
+            
+            std::fill(eval_grads.begin(), eval_grads.end(), false);
+            _feval->_evaluate_wrapper(*_xmma, f0new, false, *_df0dx, fnew, eval_grads, grads);
+            
+            bool conservative = (f0new <= fapp[0] + geps);
+            for (unsigned int i=0; i<_m; i++)
+                conservative = conservative && (fnew[i] <= fapp[i+1] + geps);
+            
+            if (conservative) {
+                libMesh::out
+                << "** Conservative Solution: Terminating! Inner Iter = "
+                << inner << std::endl;
+                break;
+            }
+            
+            // increase the conservatism of the approximations that
+            // underestimate the functions
+            const Real dist = std::max(_distance(xmma), 1.e-30);
+            
+            for (unsigned int i=0; i<=_m; i++) {
+                
+                const Real
+                fv    = i ? fnew[i-1] : f0new,
+                delta = (fv - fapp[i]) / dist;
+                
+                if (delta > 0.)
+                    _rho[i] = std::min(1.1 * (_rho[i] + delta), 10. * _rho[i]);
+            }
+            
+            inner++;
+        }
+        
+        *_xold2 = *_xold1;
+        *_xold1 = *_x;
+        *_x     = *_xmma;
+    }
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::_init_vectors() {
+    
+    const libMesh::Parallel::Communicator& comm = _feval->comm();
+    
+    const libMesh::numeric_index_type
+    n   = _feval->n_vars(),
+    n_l = _feval->n_local_vars();
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >*
+    vecs[] = {&_x, &_xold1, &_xold2, &_xmma, &_xmin, &_xmax, &_low, &_upp, &_df0dx};
+    
+    for (unsigned int i=0; i<9; i++) {
+        
+        *vecs[i] = libMesh::NumericVector<Real>::build(comm);
+        (*vecs[i])->init(n, n_l, false, libMesh::PARALLEL);
+    }
+    
+    _dfdx.resize(_m);
+    for (unsigned int i=0; i<_m; i++) {
+        
+        _dfdx[i] = libMesh::NumericVector<Real>::build(comm);
+        _dfdx[i]->init(n, n_l, false, libMesh::PARALLEL);
+    }
+    
+    _local_idx.resize(_x->local_size());
+    for (unsigned int j=0; j<_local_idx.size(); j++)
+        _local_idx[j] = _x->first_local_index() + j;
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::_get_local(const libMesh::NumericVector<Real>& v,
+                                           std::vector<Real>& vals) const {
+    
+    vals.resize(_local_idx.size());
+    if (_local_idx.size())
+        v.get(_local_idx, vals);
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::_set_local(libMesh::NumericVector<Real>& v,
+                                           const std::vector<Real>& vals) const {
+    
+    libmesh_assert_equal_to(vals.size(), _local_idx.size());
+    
+    if (_local_idx.size())
+        v.insert(vals, _local_idx);
+    v.close();
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::_update_asymptotes(unsigned int iter) {
+    
+    const unsigned int
+    nl = (unsigned int)_local_idx.size();
+    
+    std::vector<Real>
+    xold1,
+    xold2;
+    
+    _get_local(*_xold1, xold1);
+    _get_local(*_xold2, xold2);
+    if (iter > 2) {
+        _get_local(*_low, _xl);
+        _get_local(*_upp, _xu);
+    }
+    else {
+        _xl.resize(nl);
+        _xu.resize(nl);
+    }
+    
+    _alpha.resize(nl);
+    _beta.resize(nl);
+    
+    for (unsigned int j=0; j<nl; j++) {
+        
+        const Real
+        x     = _xval[j],
+        range = std::max(_xub[j] - _xlb[j], 1.e-9);
+        
+        if (iter <= 2) {
+            
+            _xl[j] = x - _initial_rel_step * range;
+            _xu[j] = x + _initial_rel_step * range;
+        }
+        else {
+            
+            // asymptotes move closer to the design for oscillating
+            // variables, and away from it for monotonic changes
+            const Real
+            osc   = (x - xold1[j]) * (xold1[j] - xold2[j]),
+            gamma = osc < 0. ? _asymptote_reduction :
+                   (osc > 0. ? _asymptote_expansion : 1.);
+            
+            _xl[j] = x - gamma * (xold1[j] - _xl[j]);
+            _xu[j] = x + gamma * (_xu[j] - xold1[j]);
+            
+            _xl[j] = std::min(std::max(_xl[j], x - 10. * range), x - 0.01 * range);
+            _xu[j] = std::max(std::min(_xu[j], x + 10. * range), x + 0.01 * range);
+        }
+        
+        _alpha[j] = std::max(_xlb[j], _xl[j] + _move_limit * (x - _xl[j]));
+        _beta[j]  = std::min(_xub[j], _xu[j] - _move_limit * (_xu[j] - x));
+    }
+    
+    _set_local(*_low, _xl);
+    _set_local(*_upp, _xu);
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::_init_rho() {
+    
+    const unsigned int
+    nl = (unsigned int)_local_idx.size();
+    
+    _rho.assign(_m+1, 0.);
+    
+    for (unsigned int j=0; j<nl; j++) {
+        
+        const Real range = _xub[j] - _xlb[j];
+        
+        _rho[0] += std::fabs(_g0[j]) * range;
+        for (unsigned int i=0; i<_m; i++)
+            _rho[i+1] += std::fabs(_g[i*nl+j]) * range;
+    }
+    
+    _feval->comm().sum(_rho);
+    
+    for (unsigned int i=0; i<=_m; i++)
+        _rho[i] = std::max(0.1 * _rho[i] / _feval->n_vars(), 1.e-6);
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::_init_approximations(Real f0,
+                                                     const std::vector<Real>& fvals) {
+    
+    const unsigned int
+    nl = (unsigned int)_local_idx.size();
+    
+    _p0.resize(nl);
+    _q0.resize(nl);
+    _p.resize(_m*nl);
+    _q.resize(_m*nl);
+    _r.assign(_m+1, 0.);
+    
+    for (unsigned int j=0; j<nl; j++) {
+        
+        const Real
+        ux  = _xu[j] - _xval[j],
+        xl  = _xval[j] - _xl[j],
+        ir  = 1. / std::max(_xub[j] - _xlb[j], 1.e-9);
+        
+        for (unsigned int i=0; i<=_m; i++) {
+            
+            const Real
+            df  = i ? _g[(i-1)*nl+j] : _g0[j],
+            dfp = std::max(df, 0.),
+            dfm = std::max(-df, 0.),
+            p   = ux * ux * (1.001 * dfp + 0.001 * dfm + _rho[i] * ir),
+            q   = xl * xl * (0.001 * dfp + 1.001 * dfm + _rho[i] * ir);
+            
+            if (i) {
+                _p[(i-1)*nl+j] = p;
+                _q[(i-1)*nl+j] = q;
+            }
+            else {
+                _p0[j] = p;
+                _q0[j] = q;
+            }
+            
+            _r[i] += p / ux + q / xl;
+        }
+    }
+    
+    _feval->comm().sum(_r);
+    
+    // the approximations match the function values at the current design
+    _r[0] = f0 - _r[0];
+    for (unsigned int i=0; i<_m; i++)
+        _r[i+1] = fvals[i] - _r[i+1];
+}
+
+
+
+Real
+MAST::MMAOptimizationInterface::_dual(const std::vector<Real>& lambda,
+                                      std::vector<Real>&       x,
+                                      std::vector<Real>&       fapp,
+                                      std::vector<Real>*       grad,
+                                      RealMatrixX*             hess) const {
+    
+    const unsigned int
+    nl = (unsigned int)_local_idx.size();
+    
+    // the sums over the local variables of the objective and constraint
+    // approximations, followed by the Hessian of the dual if requested,
+    // are reduced in a single call
+    std::vector<Real>
+    sums (1 + _m + (hess ? _m*_m : 0), 0.),
+    dg   (_m, 0.);
+    
+    x.resize(nl);
+    
+    for (unsigned int j=0; j<nl; j++) {
+        
+        Real
+        P = _p0[j],
+        Q = _q0[j];
+        
+        for (unsigned int i=0; i<_m; i++) {
+            P += lambda[i] * _p[i*nl+j];
+            Q += lambda[i] * _q[i*nl+j];
+        }
+        
+        // minimizer of P/(u-x) + Q/(x-l) within the move limits
+        const Real
+        sp = std::sqrt(P),
+        sq = std::sqrt(Q);
+        
+        x[j] = (sp * _xl[j] + sq * _xu[j]) / (sp + sq);
+        x[j] = std::min(std::max(x[j], _alpha[j]), _beta[j]);
+        
+        const Real
+        ux = _xu[j] - x[j],
+        xl = x[j] - _xl[j];
+        
+        sums[0] += _p0[j] / ux + _q0[j] / xl;
+        for (unsigned int i=0; i<_m; i++)
+            sums[1+i] += _p[i*nl+j] / ux + _q[i*nl+j] / xl;
+        
+        if (hess && x[j] > _alpha[j] && x[j] < _beta[j]) {
+            
+            const Real
+            h = 2. * P / (ux * ux * ux) + 2. * Q / (xl * xl * xl);
+            
+            for (unsigned int i=0; i<_m; i++)
+                dg[i] = _p[i*nl+j] / (ux * ux) - _q[i*nl+j] / (xl * xl);
+            
+            for (unsigned int i=0; i<_m; i++)
+                for (unsigned int k=0; k<_m; k++)
+                    sums[1+_m+i*_m+k] -= dg[i] * dg[k] / h;
+        }
+    }
+    
+    _feval->comm().sum(sums);
+    
+    fapp.resize(_m+1);
+    for (unsigned int i=0; i<=_m; i++)
+        fapp[i] = sums[i] + _r[i];
+    
+    if (grad) grad->resize(_m);
+    if (hess) hess->setZero(_m, _m);
+    
+    Real
+    w = fapp[0];
+    
+    for (unsigned int i=0; i<_m; i++) {
+        
+        // artificial variable that minimizes the Lagrangian
+        const Real
+        y = std::max(0., (lambda[i] - _c[i]) / _d[i]);
+        
+        w += lambda[i] * (fapp[i+1] - y) + _c[i] * y + 0.5 * _d[i] * y * y;
+        
+        if (grad) (*grad)[i] = fapp[i+1] - y;
+        
+        if (hess) {
+            
+            for (unsigned int k=0; k<_m; k++)
+                (*hess)(i, k) = sums[1+_m+i*_m+k];
+            
+            if (y > 0.)
+                (*hess)(i, i) -= 1. / _d[i];
+        }
+    }
+    
+    return w;
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::_solve_subproblem(std::vector<Real>& x,
+                                                  std::vector<Real>& fapp) {
+    
+    std::vector<Real>
+    lambda (_lambda),
+    lt     (_m, 0.),
+    xt,
+    ft,
+    grad;
+    
+    RealMatrixX
+    hess;
+    
+    Real
+    w      = _dual(lambda, x, fapp, &grad, &hess);
+    
+    // without constraints the primal solution is explicit
+    if (!_m)
+        return;
+    
+    const Real
+    max_step = 10. * (1. + *std::max_element(_c.begin(), _c.end()));
+    
+    for (unsigned int it=0; it<_max_dual_iters; it++) {
+        
+        // variables at the bound with a descent direction remain fixed
+        std::vector<unsigned int> free;
+        Real pg = 0.;
+        
+        for (unsigned int i=0; i<_m; i++) {
+            
+            pg = std::max(pg, std::fabs(std::max(0., lambda[i] + grad[i]) - lambda[i]));
+            if (lambda[i] > 0. || grad[i] > 0.)
+                free.push_back(i);
+        }
+        
+        if (pg <= _dual_tol * (1. + std::fabs(w)) || free.empty())
+            break;
+        
+        // Newton direction in the free variables. The dual function is
+        // concave, and a small shift keeps the system positive definite
+        // when all primal variables are at their move limits.
+        const unsigned int nf = (unsigned int)free.size();
+        RealMatrixX H(nf, nf);
+        RealVectorX g(nf), s;
+        
+        for (unsigned int i=0; i<nf; i++) {
+            g(i) = grad[free[i]];
+            for (unsigned int k=0; k<nf; k++)
+                H(i, k) = -hess(free[i], free[k]);
+        }
+        
+        const Real
+        shift = 1.e-8 * (1. + H.diagonal().cwiseAbs().maxCoeff());
+        H.diagonal().array() += shift;
+        s = H.ldlt().solve(g);
+        
+        if (s.cwiseAbs().maxCoeff() > max_step)
+            s *= max_step / s.cwiseAbs().maxCoeff();
+        
+        // projected backtracking line search
+        Real t = 1., wt = 0., inc = 0.;
+        bool accepted = false;
+        
+        for (unsigned int ls=0; ls<50 && !accepted; ls++, t *= 0.5) {
+            
+            lt = lambda;
+            for (unsigned int i=0; i<nf; i++)
+                lt[free[i]] = std::max(0., lambda[free[i]] + t * s(i));
+            
+            inc = 0.;
+            for (unsigned int i=0; i<_m; i++)
+                inc += grad[i] * (lt[i] - lambda[i]);
+            
+            wt = _dual(lt, xt, ft, nullptr, nullptr);
+            accepted = (wt >= w + 1.e-4 * inc);
+        }
+        
+        if (!accepted)
+            break;
+        
+        lambda = lt;
+        w      = _dual(lambda, x, fapp, &grad, &hess);
+    }
+    
+    _lambda = lambda;
+}
+
+
+
+Real
+MAST::MMAOptimizationInterface::_distance(const std::vector<Real>& x) const {
+    
+    Real d = 0.;
+    
+    for (unsigned int j=0; j<_local_idx.size(); j++) {
+        
+        const Real dx = x[j] - _xval[j];
+        
+        d += (_xu[j] - _xl[j]) * dx * dx /
+        ((_xu[j] - x[j]) * (x[j] - _xl[j]) * std::max(_xub[j] - _xlb[j], 1.e-9));
+    }
+    
+    _feval->comm().sum(d);
+    
+    return d;
+}
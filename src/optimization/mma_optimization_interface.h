@@ -0,0 +1,217 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __MAST_mma_optimization_interface_h__
+#define __MAST_mma_optimization_interface_h__
+
+// C++ includes
+#include <vector>
+#include <memory>
+
+// MAST includes
+#include "optimization/optimization_interface.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Native implementation of the globally convergent method of moving
+     *   asymptotes (GCMMA) of Svanberg, "MMA and GCMMA - two methods for
+     *   nonlinear optimization", 2007. Unlike
+     *   \p MAST::GCMMAOptimizationInterface, the design variables,
+     *   bounds, asymptotes and gradients are stored in distributed
+     *   \p libMesh::NumericVector objects, with the local entries on each
+     *   rank specified by \p MAST::FunctionEvaluation::n_local_vars(), and
+     *   the function evaluation is called through its distributed
+     *   \p evaluate() interface. No array of size \p n_vars x \p n_constraints
+     *   is created on any rank.
+     *
+     *   The MMA subproblem is solved through its dual, which has one
+     *   variable per constraint. For given dual variables the primal
+     *   variables are computed independently on each rank, and the dual
+     *   function, its gradient and its Hessian need a single reduction of
+     *   \p 1+m+m^2 values, where \p m is the number of constraints. The
+     *   dual is maximized with a projected Newton method.
+     *
+     *   The equality constraints of the function evaluation are treated as
+     *   inequality constraints, as in \p MAST::GCMMAOptimizationInterface.
+     *   Setting the integer parameter \p max_inner_iters to zero gives the
+     *   original MMA without the conservative inner iterations.
+     */
+    class MMAOptimizationInterface: public MAST::OptimizationInterface {
+        
+    public:
+        
+        MMAOptimizationInterface();
+        
+        virtual ~MMAOptimizationInterface();
+        
+        /*!
+         *   sets the real parameters: \p constraint_penalty,
+         *   \p initial_rel_step, \p asymptote_reduction,
+         *   \p asymptote_expansion, \p move_limit and \p dual_tolerance.
+         */
+        virtual void
+        set_real_parameter(const std::string& nm, Real val);
+        
+        /*!
+         *   sets the integer parameters: \p max_inner_iters and
+         *   \p max_dual_iters.
+         */
+        virtual void
+        set_integer_parameter(const std::string& nm, int val);
+        
+        virtual void optimize();
+        
+    protected:
+        
+        /*!
+         *   creates the distributed vectors for the current function
+         *   evaluation object
+         */
+        void _init_vectors();
+        
+        /*!
+         *   copies the local entries of \p v to \p vals
+         */
+        void _get_local(const libMesh::NumericVector<Real>& v,
+                        std::vector<Real>& vals) const;
+        
+        /*!
+         *   sets the local entries of \p v from \p vals and closes \p v
+         */
+        void _set_local(libMesh::NumericVector<Real>& v,
+                        const std::vector<Real>& vals) const;
+        
+        /*!
+         *   updates the asymptotes and the move limits for outer
+         *   iteration \p iter
+         */
+        void _update_asymptotes(unsigned int iter);
+        
+        /*!
+         *   computes the initial values of \p _rho for the current
+         *   gradients
+         */
+        void _init_rho();
+        
+        /*!
+         *   computes the coefficients of the approximations for the
+         *   current values of \p _rho
+         */
+        void _init_approximations(Real f0,
+                                  const std::vector<Real>& fvals);
+        
+        /*!
+         *   computes the primal variables for dual variables \p lambda,
+         *   and the approximations of the objective and constraints at
+         *   these variables in \p fapp. If \p hess is not \p nullptr, the
+         *   gradient of the dual function with respect to \p lambda is
+         *   returned in \p grad and its Hessian in \p hess.
+         *   @returns the value of the dual function.
+         */
+        Real _dual(const std::vector<Real>& lambda,
+                   std::vector<Real>&       x,
+                   std::vector<Real>&       fapp,
+                   std::vector<Real>*       grad,
+                   RealMatrixX*             hess) const;
+        
+        /*!
+         *   solves the dual subproblem and returns the primal solution in
+         *   \p x and the approximations at \p x in \p fapp.
+         */
+        void _solve_subproblem(std::vector<Real>& x,
+                               std::vector<Real>& fapp);
+        
+        /*!
+         *   @returns the scaled distance between \p x and \p _xval used in
+         *   the update of \p _rho
+         */
+        Real _distance(const std::vector<Real>& x) const;
+        
+        Real           _constr_penalty;
+        Real           _initial_rel_step;
+        Real           _asymptote_reduction;
+        Real           _asymptote_expansion;
+        Real           _move_limit;
+        Real           _dual_tol;
+        unsigned int   _max_inner_iters;
+        unsigned int   _max_dual_iters;
+        
+        /*!
+         *   number of constraints
+         */
+        unsigned int   _m;
+        
+        /*!
+         *   distributed design variables, bounds, asymptotes and gradients
+         */
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        _x, _xold1, _xold2, _xmma, _xmin, _xmax, _low, _upp, _df0dx;
+        
+        std::vector<std::unique_ptr<libMesh::NumericVector<Real> > > _dfdx;
+        
+        /*!
+         *   global indices of the local design variables
+         */
+        std::vector<libMesh::numeric_index_type> _local_idx;
+        
+        /*!
+         *   local entries of the design variables, the move limits and the
+         *   asymptotes for the current outer iteration
+         */
+        std::vector<Real> _xval, _xlb, _xub, _alpha, _beta, _xl, _xu;
+        
+        /*!
+         *   local entries of the objective and constraint gradients. The
+         *   gradient of constraint \p i is stored at \p i*n_local+j.
+         */
+        std::vector<Real> _g0, _g;
+        
+        /*!
+         *   local coefficients of the approximations. The coefficients
+         *   of constraint \p i are stored at \p i*n_local+j.
+         */
+        std::vector<Real> _p0, _q0, _p, _q;
+        
+        /*!
+         *   constant terms of the approximations, and the penalty
+         *   and quadratic coefficients of the artificial variables
+         */
+        std::vector<Real> _r, _c, _d;
+        
+        /*!
+         *   conservatism parameters of the objective, at index zero, and
+         *   the constraints
+         */
+        std::vector<Real> _rho;
+        
+        /*!
+         *   dual variables, which are used to start the next subproblem
+         */
+        std::vector<Real> _lambda;
+    };
+}
+
+
+#endif // __MAST_mma_optimization_interface_h__
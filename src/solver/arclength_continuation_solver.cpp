@@ -23,6 +23,7 @@
 #include "base/assembly_base.h"
 #include "base/nonlinear_system.h"
 #include "base/parameter.h"
+#include "utility/hdf5_restart_file.h"
 
 // libMesh includes
 #include "libmesh/linear_solver.h"
@@ -74,6 +75,26 @@ MAST::ArclengthContinuationSolver::initialize(Real dp) {
 }
 
 
+void
+MAST::ArclengthContinuationSolver::write_restart(MAST::HDF5RestartFile& file) const {
+    
+    MAST::ContinuationSolverBase::write_restart(file);
+    
+    file.write_scalar("continuation/dpds_sign", _dpds_sign);
+}
+
+
+
+void
+MAST::ArclengthContinuationSolver::read_restart(MAST::HDF5RestartFile& file) {
+    
+    MAST::ContinuationSolverBase::read_restart(file);
+    
+    _dpds_sign = file.read_scalar("continuation/dpds_sign");
+}
+
+
+
 void
 MAST::ArclengthContinuationSolver::
 _solve_NR_iterate(libMesh::NumericVector<Real>       &X,
@@ -84,8 +105,6 @@ _solve_NR_iterate(libMesh::NumericVector<Real>       &X,
     std::unique_ptr<libMesh::NumericVector<Real>>
     f(X.zero_clone().release()),
     dgdX(X.zero_clone().release()),
-    dfdp(X.zero_clone().release()),
-    dXdp(X.zero_clone().release()),
     dX(X.zero_clone().release());
     
     libMesh::SparseMatrix<Real>
@@ -96,23 +115,31 @@ _solve_NR_iterate(libMesh::NumericVector<Real>       &X,
     dgdp = 0.,
     dp   = 0.;
     
-    _g(X, p, *dfdp, *dXdp, g, dgdp, dgdX.get());
+    // this computes df/dp and dX/dp with the Jacobian at X, unless
+    // they were computed for the residual norm at X
+    _g(X, p, g, dgdp, dgdX.get());
     
+    // dX/dp is current, so the block elimination only needs the
+    // solution for the residual, which reuses the preconditioner
     if (!schur_factorization)
         _solve(X, p,
                *f,                           true,  // update f
-               *dfdp,                        false, // update dfdp
+               *_dfdp_X,                     false, // do not update dfdp
                *dgdX, dgdp, g,
                *dX, dp);
     else
         _solve_schur_factorization(X, p,
-                                   jac,                          true,  // update jac
+                                   jac,                          !_jac_current,
                                    *f,                           true,  // update f
-                                   *dfdp,                        false, // update dfdp
-                                   *dXdp,                        false, // update dXdp
+                                   *_dfdp_X,                     false, // do not update dfdp
+                                   *_dXdp_X,                     false, // do not update dXdp
                                    *dgdX, dgdp, g,
                                    *dX, dp);
 
+    // the Jacobian and tangent are recomputed at the new iterate
+    _jac_current     = false;
+    _tangent_current = false;
+    
     // update the solution and load parameter
     p() += dp;
     X.add(1., *dX);
@@ -136,35 +163,24 @@ _dXdp(const libMesh::NumericVector<Real> &X,
 
     _assembly->set_elem_operation_object(*_elem_ops);
 
+    // the Jacobian at X is also used by the corrector from X
+    system.set_operation(MAST::NonlinearSystem::NONLINEAR_SOLVE);
+    
+    _assembly->residual_and_jacobian(X, nullptr, system.matrix, system);
+    _jac_current = true;
+    _pc_current  = false;
+    
     system.set_operation(MAST::NonlinearSystem::FORWARD_SENSITIVITY_SOLVE);
 
     _assembly->sensitivity_assemble(*system.solution, true, p, dfdp);
 
-    libMesh::SparseMatrix<Real>
-    *pc  = system.request_matrix("Preconditioner");
-
-    std::pair<unsigned int, Real>
-    solver_params = system.get_linear_solve_parameters(),
-    rval;
-
     dXdp.zero();
     
-    rval = system.linear_solver->solve (*system.matrix, pc,
-                                        dXdp,
-                                        dfdp,
-                                        solver_params.second,
-                                        solver_params.first);
+    _linear_solve(*system.matrix, dfdp, dXdp);
     
     dXdp.scale(-1.);
     dXdp.close();
     
-    // The linear solver may not have fit our constraints exactly
-#ifdef LIBMESH_ENABLE_CONSTRAINTS
-    system.get_dof_map().enforce_constraints_exactly (system,
-                                                      &dXdp,
-                                                      /* homogeneous = */ true);
-#endif
-    
     _assembly->clear_elem_operation_object();
     system.set_operation(MAST::NonlinearSystem::NONE);
 }
@@ -176,15 +192,11 @@ Real
 MAST::ArclengthContinuationSolver::_g(const libMesh::NumericVector<Real> &X,
                                       const MAST::Parameter              &p) {
     
-    std::unique_ptr<libMesh::NumericVector<Real>>
-    dfdp(X.zero_clone().release()),
-    dXdp(X.zero_clone().release());
-    
     Real
     g    = 0.,
     dgdp = 0.;
     
-    _g(X, p, *dfdp, *dXdp, g, dgdp, nullptr);
+    _g(X, p, g, dgdp, nullptr);
     
     return g;
 }
@@ -193,16 +205,23 @@ MAST::ArclengthContinuationSolver::_g(const libMesh::NumericVector<Real> &X,
 void
 MAST::ArclengthContinuationSolver::_g(const libMesh::NumericVector<Real> &X,
                                       const MAST::Parameter              &p,
-                                      libMesh::NumericVector<Real>       &dfdp,
-                                      libMesh::NumericVector<Real>       &dXdp,
                                       Real                               &g,
                                       Real                               &dgdp,
                                       libMesh::NumericVector<Real>       *dgdX) {
 
     libmesh_assert(_initialized);
 
-    // update the constraint data
-    _dXdp(X, p, dfdp, dXdp);
+    // update the constraint data, unless it was computed at X
+    if (!_tangent_current) {
+        
+        _dfdp_X.reset(X.zero_clone().release());
+        _dXdp_X.reset(X.zero_clone().release());
+        _dXdp(X, p, *_dfdp_X, *_dXdp_X);
+        _tangent_current = true;
+    }
+    
+    const libMesh::NumericVector<Real>
+    &dXdp = *_dXdp_X;
     
     // this includes scaling of X and p
     Real
@@ -47,12 +47,23 @@ namespace MAST {
          */
         virtual void initialize(Real dp);
 
+        /*!
+         *   also writes the direction of the load parameter along the path
+         */
+        virtual void write_restart(MAST::HDF5RestartFile& file) const;
+        
+        virtual void read_restart(MAST::HDF5RestartFile& file);
+
     protected:
         
         virtual void
         _solve_NR_iterate(libMesh::NumericVector<Real>       &X,
                           MAST::Parameter                    &p);
         
+        /*!
+         *   assembles the Jacobian at \p X in the system matrix and
+         *   computes \p dXdp from it
+         */
         virtual void
         _dXdp(const libMesh::NumericVector<Real> &X,
               const MAST::Parameter              &p,
@@ -78,12 +89,14 @@ namespace MAST {
          *    dg/dp       & = & p_{scale} * (dp/ds)_{scaled} \\
          *    dg/dX       & = & X_{scale} * (dX/ds)_{scaled}
          * \f}
+         *   where the tangent \f$ dX/ds \f$ is computed at \p X. The
+         *   tangent and the Jacobian at \p X are stored and reused by the
+         *   corrector from \p X, so that both solutions with the Jacobian
+         *   share its preconditioner.
          */
         void
         _g(const libMesh::NumericVector<Real> &X,
            const MAST::Parameter              &p,
-           libMesh::NumericVector<Real>       &dfdp,
-           libMesh::NumericVector<Real>       &dXdp,
            Real                               &g,
            Real                               &dgdp,
            libMesh::NumericVector<Real>       *dgdX);
@@ -95,13 +108,20 @@ namespace MAST {
         virtual void _save_iteration_data() {}
 
         /*!
-         *   method resets any data if a soltion step is restarted. Nothing to
-         *   be done here. 
+         *   method resets any data if a soltion step is restarted. The
+         *   tangent is recomputed at the restored solution.
          */
-        virtual void _reset_iterations() {}
+        virtual void _reset_iterations() { _tangent_current = false; }
 
         Real
         _dpds_sign;
+        
+        /*!
+         *   df/dp and dX/dp at the current iterate
+         */
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        _dfdp_X,
+        _dXdp_X;
     };
 }
 
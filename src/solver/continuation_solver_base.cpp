@@ -23,6 +23,7 @@
 #include "base/assembly_base.h"
 #include "base/assembly_elem_operation.h"
 #include "base/parameter.h"
+#include "utility/hdf5_restart_file.h"
 
 // libMesh includes
 #include "libmesh/linear_solver.h"
@@ -44,7 +45,14 @@ max_step                  (20.),
 step_size_change_exponent (0.5),
 step_desired_iters        (5),
 schur_factorization       (true),
+bordering_refinement_tol  (1.e-8),
+max_bordering_refinements (2),
 _initialized              (false),
+_tangent_current          (false),
+_jac_current              (false),
+_pc_current               (false),
+_n_linear_solves          (0),
+_n_iterations             (0),
 _elem_ops                 (nullptr),
 _assembly                 (nullptr),
 _p                        (nullptr),
@@ -89,6 +97,35 @@ MAST::ContinuationSolverBase::clear_assembly_and_load_parameters() {
 
 
 
+void
+MAST::ContinuationSolverBase::write_restart(MAST::HDF5RestartFile& file) const {
+    
+    libmesh_assert(_initialized);
+    libmesh_assert(_p);
+    
+    file.write_scalar("continuation/parameters/" + _p->name(), (*_p)());
+    file.write_scalar("continuation/arc_length", arc_length);
+    file.write_scalar("continuation/X_scale", _X_scale);
+    file.write_scalar("continuation/p_scale", _p_scale);
+}
+
+
+
+void
+MAST::ContinuationSolverBase::read_restart(MAST::HDF5RestartFile& file) {
+    
+    libmesh_assert(_p);
+    
+    (*_p)()     = file.read_scalar("continuation/parameters/" + _p->name());
+    arc_length  = file.read_scalar("continuation/arc_length");
+    _X_scale    = file.read_scalar("continuation/X_scale");
+    _p_scale    = file.read_scalar("continuation/p_scale");
+    
+    _initialized = true;
+}
+
+
+
 void
 MAST::ContinuationSolverBase::solve()  {
     
@@ -103,6 +140,14 @@ MAST::ContinuationSolverBase::solve()  {
     _p0     = (*_p)();
     _X0.reset(X.clone().release());
     
+    // the tangent is computed at the beginning of the step, and the
+    // matrix may have been modified since the last call
+    _tangent_current = false;
+    _jac_current     = false;
+    _pc_current      = false;
+    _n_linear_solves = 0;
+    _n_iterations    = 0;
+    
 
     // save data for possible reuse if the iterations are restarted.
     _save_iteration_data();
@@ -127,6 +172,7 @@ MAST::ContinuationSolverBase::solve()  {
         _solve_NR_iterate(X, *_p);
         norm = _res_norm(X, *_p);
         iter++;
+        _n_iterations++;
         
         if (norm < abs_tol)       cont = false;
         if (norm/norm0 < rel_tol) cont = false;
@@ -144,6 +190,7 @@ MAST::ContinuationSolverBase::solve()  {
                 X.add(1., *_X0);
                 X.close();
                 *_p = _p0;
+                _jac_current = false;
                 _reset_iterations();
                 cont = true;
             }
@@ -388,6 +435,7 @@ MAST::ContinuationSolverBase::_solve(const libMesh::NumericVector<Real>  &X,
     
     // now solve
     ierr = KSPSolve(ksp, res_vec, sol_vec);
+    _n_linear_solves++;
 
     // copy the solution back to the system
     dX.zero();
@@ -449,7 +497,7 @@ _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
     //     [df/dX    df/dp]  { dX } = { -f}
     //     [dg/dX    dg/dp]  { dp } = { -g}
     //
-    //   Schur factorization:
+    //   Block elimination:
     //     df/dX  dX =    -f - df/dp dp
     //
     //   Substitute in second equation
@@ -459,23 +507,22 @@ _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
     //
     //   1.  solve   r1        =  inv(df/dX) f
     //   2.  solve   dXdp      = -inv(df/dX) df/dp
-    //   3.  solve   a         = dg/dp + dg/dX dXdp
-    //   4.  solve   a  dp     = -g + dg/dX r1
-    //   5.  solve   df/dX  dX =    -f - df/dp dp
+    //   3.  compute a         = dg/dp + dg/dX dXdp
+    //   4.  compute dp        = (-g + dg/dX r1)/a
+    //   5.  compute dX        = -r1 + dXdp dp
+    //
+    //   Only the first two steps require a solution with df/dX, and the
+    //   second solution reuses the preconditioner of the first. If dXdp
+    //   is not updated, the one computed by the caller with the same
+    //   df/dX is used. Near limit points df/dX is nearly singular and
+    //   the cancellation in step 5 loses accuracy, which is recovered
+    //   by refining the solution with the residual of the bordered
+    //   system using the same elimination.
     //
-    
-    
-    std::pair<unsigned int, Real>
-    solver_params = system.get_linear_solve_parameters(),
-    rval;
-    
     
     std::unique_ptr<libMesh::NumericVector<Real>>
     r1(X.zero_clone().release());
     
-    libMesh::SparseMatrix<Real>
-    *pc  = system.request_matrix("Preconditioner");
-    
     Real
     a    = 0.;
     
@@ -490,17 +537,18 @@ _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
                                          update_f?     &f:nullptr,
                                          update_jac? &jac:nullptr,
                                          system);
-    rval = system.linear_solver->solve (jac, pc,
-                                        *r1,
-                                        f,
-                                        solver_params.second,
-                                        solver_params.first);
-
-#ifdef LIBMESH_ENABLE_CONSTRAINTS
-    system.get_dof_map().enforce_constraints_exactly (system,
-                                                      r1.get(),
-                                                      /* homogeneous = */ true);
-#endif
+    
+    // the preconditioner of the previous call is reused if the Jacobian
+    // was not updated
+    if (update_jac) {
+        _pc_current  = false;
+        _jac_current = true;
+    }
+    
+    // the search direction of the pseudo-arclength method is computed
+    // with a zero residual, in which case r1 vanishes
+    if (update_f || f.linfty_norm() > 0.)
+        _linear_solve(jac, f, *r1);
 
 
     //////////////////////////////////////////////////////////
@@ -510,23 +558,11 @@ _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
     if (update_dfdp)
         _assembly->sensitivity_assemble(*system.solution, true, p, dfdp);
 
-    if (update_dfdp || update_dXdp) {
-        
-        rval = system.linear_solver->solve (jac, pc,
-                                            dXdp,
-                                            dfdp,
-                                            solver_params.second,
-                                            solver_params.first);
+    if (update_dXdp) {
         
+        _linear_solve(jac, dfdp, dXdp);
         dXdp.scale(-1.);
         dXdp.close();
-        
-        // The linear solver may not have fit our constraints exactly
-#ifdef LIBMESH_ENABLE_CONSTRAINTS
-        system.get_dof_map().enforce_constraints_exactly (system,
-                                                          &dXdp,
-                                                          /* homogeneous = */ true);
-#endif
     }
 
     //////////////////////////////////////////////////////////
@@ -540,20 +576,58 @@ _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
     dp  = 1./a * (- g + dgdX.dot(*r1));
     
     //////////////////////////////////////////////////////////
-    //         STEP 5:  df/dX  dX =    -f - df/dp dp
+    //         STEP 5:  dX =  -r1 + dXdp dp
     //////////////////////////////////////////////////////////
-    r1->zero();
-    r1->add(1., f);
-    r1->add(dp, dfdp);
-    r1->scale(-1.);
-    r1->close();
-    rval = system.linear_solver->solve (jac, pc,
-                                        dX,
-                                        *r1,
-                                        solver_params.second,
-                                        solver_params.first);
-    
+    dX.zero();
+    dX.add(-1., *r1);
+    dX.add(dp, dXdp);
+    dX.close();
     
+    //////////////////////////////////////////////////////////
+    //         Refinement with the bordered residual
+    //////////////////////////////////////////////////////////
+    if (max_bordering_refinements) {
+        
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        res(X.zero_clone().release());
+        
+        Real
+        res_g     = 0.,
+        rhs_norm  = std::sqrt(std::pow(f.l2_norm(), 2) + g*g),
+        res_norm  = 0.;
+        
+        for (unsigned int i=0; i<max_bordering_refinements; i++) {
+            
+            //  res_f  = -f - df/dX dX - df/dp dp
+            //  res_g  = -g - dg/dX dX - dg/dp dp
+            jac.vector_mult(*res, dX);
+            res->add(1., f);
+            res->add(dp, dfdp);
+            res->scale(-1.);
+            res->close();
+            
+            res_g    = -g - dgdX.dot(dX) - dgdp * dp;
+            res_norm = std::sqrt(std::pow(res->l2_norm(), 2) + res_g*res_g);
+            
+            if (res_norm <= bordering_refinement_tol * rhs_norm)
+                break;
+            
+            // the correction is the solution of the bordered system with
+            // the right-hand side { res_f, res_g }, so that r1 = -inv(df/dX) res_f
+            _linear_solve(jac, *res, *r1);
+            r1->scale(-1.);
+            r1->close();
+            
+            const Real
+            ddp = 1./a * (res_g + dgdX.dot(*r1));
+            
+            dX.add(-1., *r1);
+            dX.add(ddp, dXdp);
+            dX.close();
+            dp += ddp;
+        }
+    }
+
     // The linear solver may not have fit our constraints exactly
 #ifdef LIBMESH_ENABLE_CONSTRAINTS
     system.get_dof_map().enforce_constraints_exactly (system,
@@ -566,6 +640,51 @@ _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
 }
 
 
+
+void
+MAST::ContinuationSolverBase::
+_linear_solve(libMesh::SparseMatrix<Real>         &jac,
+              libMesh::NumericVector<Real>        &rhs,
+              libMesh::NumericVector<Real>        &sol) {
+    
+    MAST::NonlinearSystem
+    &system    = _assembly->system();
+    
+    std::pair<unsigned int, Real>
+    solver_params = system.get_linear_solve_parameters();
+    
+    libMesh::SparseMatrix<Real>
+    *pc  = system.request_matrix("Preconditioner");
+    
+    // the preconditioner, or the factorization for direct solvers, is
+    // rebuilt at each solve unless the solver is asked to reuse it for
+    // an unchanged operator.
+    const bool
+    reuse_pc = system.linear_solver->get_same_preconditioner();
+    
+    system.linear_solver->reuse_preconditioner(_pc_current);
+    
+    system.linear_solver->solve(jac, pc,
+                                sol,
+                                rhs,
+                                solver_params.second,
+                                solver_params.first);
+    
+    system.linear_solver->reuse_preconditioner(reuse_pc);
+    
+    _pc_current = true;
+    _n_linear_solves++;
+    
+    // The linear solver may not have fit our constraints exactly
+#ifdef LIBMESH_ENABLE_CONSTRAINTS
+    system.get_dof_map().enforce_constraints_exactly (system,
+                                                      &sol,
+                                                      /* homogeneous = */ true);
+#endif
+}
+
+
+
 Real
 MAST::ContinuationSolverBase::
 _res_norm(const libMesh::NumericVector<Real>                  &X,
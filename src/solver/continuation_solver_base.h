@@ -33,6 +33,7 @@ namespace MAST {
     class AssemblyElemOperations;
     class AssemblyBase;
     class Parameter;
+    class HDF5RestartFile;
     
     /*!
      *    the equation set is:
@@ -83,6 +84,21 @@ namespace MAST {
          */
         virtual void solve();
         
+        /*!
+         *   writes the load parameter, step size and the state of the
+         *   continuation to the restart file \p file. The solution is
+         *   written by \p MAST::NonlinearSystem::write_restart().
+         */
+        virtual void write_restart(MAST::HDF5RestartFile& file) const;
+        
+        /*!
+         *   reads the data written by \p write_restart(), after which
+         *   \p solve() can be called without \p initialize(). The
+         *   assembly and load parameter must be attached before this is
+         *   called.
+         */
+        virtual void read_restart(MAST::HDF5RestartFile& file);
+        
         /*!
          *  Maximum number of Newton-Raphson iterations for the solver.
          *  Default is 20.
@@ -140,6 +156,41 @@ namespace MAST {
          */
         bool schur_factorization;
         
+        /*!
+         *   relative residual of the bordered system below which the
+         *   block-elimination solution is not refined. Default is 1.e-8.
+         */
+        Real bordering_refinement_tol;
+        
+        /*!
+         *   maximum number of refinements of the block-elimination
+         *   solution, each of which requires one linear solve with the
+         *   reused preconditioner. Refinements are only performed if the
+         *   residual of the bordered system exceeds
+         *   \p bordering_refinement_tol, which happens near limit points
+         *   where \f$ df/dX \f$ is nearly singular. Default is 2.
+         */
+        unsigned int max_bordering_refinements;
+        
+        /*!
+         *   @returns the number of linear solves in the last call to
+         *   \p solve(). Without refinements, this is one solve for the
+         *   tangent at the initial solution and two per Newton-Raphson
+         *   iterate, which share the preconditioner.
+         */
+        unsigned int n_linear_solves() const {
+            return _n_linear_solves;
+        }
+        
+        /*!
+         *   @returns the number of Newton-Raphson iterates in the last
+         *   call to \p solve(), including those of the attempts with
+         *   larger step sizes.
+         */
+        unsigned int n_iterations() const {
+            return _n_iterations;
+        }
+        
     protected:
 
         virtual void
@@ -178,7 +229,14 @@ namespace MAST {
          *          \left\{ \begin{array}{c} dx \\ dp \end{array} \right\}  =
          *          - \left\{ \begin{array}{c} f \\ g \end{array} \right\}
          *    \f]
-         *   \p dX and \p dp are returned from the solution
+         *   \p dX and \p dp are returned from the solution. The bordered
+         *   system is solved by block elimination with two solutions with
+         *   \p jac, which share the preconditioner, and \p dX is recovered
+         *   without a third solution. If \p update_dXdp is false, the
+         *   given \p dXdp is used and only one solution is needed. If
+         *   \p update_jac is false, the preconditioner of the previous
+         *   call is reused. The solution is refined with the residual of
+         *   the bordered system up to \p max_bordering_refinements times.
          */
         void
         _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
@@ -197,6 +255,15 @@ namespace MAST {
                                    libMesh::NumericVector<Real>        &dX,
                                    Real                                &dp);
 
+        /*!
+         *   solves \p jac \p sol = \p rhs with the linear solver of the
+         *   system. The preconditioner is reused if it was computed for
+         *   the current \p jac by a previous call.
+         */
+        void _linear_solve(libMesh::SparseMatrix<Real>         &jac,
+                           libMesh::NumericVector<Real>        &rhs,
+                           libMesh::NumericVector<Real>        &sol);
+        
         /*!
          *   @return the norm of residual at given solution and
          *   load parameter.
@@ -220,6 +287,28 @@ namespace MAST {
         
         bool                           _initialized;
         
+        /*!
+         *   true if the tangent used by the corrector has been computed
+         *   for the current step
+         */
+        bool                           _tangent_current;
+        
+        /*!
+         *   true if the system matrix holds the Jacobian at the current
+         *   iterate
+         */
+        bool                           _jac_current;
+        
+        /*!
+         *   true if the preconditioner of the linear solver was computed
+         *   for the current system Jacobian
+         */
+        bool                           _pc_current;
+        
+        unsigned int                   _n_linear_solves;
+        
+        unsigned int                   _n_iterations;
+        
         MAST::AssemblyElemOperations   *_elem_ops;
         MAST::AssemblyBase             *_assembly;
         MAST::Parameter                *_p;
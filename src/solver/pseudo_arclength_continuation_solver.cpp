@@ -23,6 +23,7 @@
 #include "base/assembly_base.h"
 #include "base/nonlinear_system.h"
 #include "base/parameter.h"
+#include "utility/hdf5_restart_file.h"
 
 // libMesh includes
 #include "libmesh/linear_solver.h"
@@ -81,6 +82,38 @@ MAST::PseudoArclengthContinuationSolver::initialize(Real dp) {
 }
 
 
+void
+MAST::PseudoArclengthContinuationSolver::write_restart(MAST::HDF5RestartFile& file) const {
+    
+    MAST::ContinuationSolverBase::write_restart(file);
+    
+    file.write_vector("continuation/t0_X", *_t0_X);
+    file.write_scalar("continuation/t0_p", _t0_p);
+}
+
+
+
+void
+MAST::PseudoArclengthContinuationSolver::read_restart(MAST::HDF5RestartFile& file) {
+    
+    libmesh_assert(_assembly);
+    
+    MAST::ContinuationSolverBase::read_restart(file);
+    
+    MAST::NonlinearSystem&
+    system = _assembly->system();
+    
+    _t0_X.reset(system.solution->zero_clone().release());
+    _t0_X_orig.reset(system.solution->zero_clone().release());
+    
+    file.read_vector("continuation/t0_X", *_t0_X);
+    _t0_p = file.read_scalar("continuation/t0_p");
+    
+    _save_iteration_data();
+}
+
+
+
 void
 MAST::PseudoArclengthContinuationSolver::
 _solve_NR_iterate(libMesh::NumericVector<Real>       &X,
@@ -99,22 +132,13 @@ _solve_NR_iterate(libMesh::NumericVector<Real>       &X,
     &jac = *_assembly->system().matrix;
     
     Real
-    t1_p = 0.,
-    g    = 0.,
+    g    = _g(X, p),
+    t1_p = _p_scale * _t0_p,
     dp   = 0.;
     
-    _update_search_direction(X, p,
-                             jac,
-                             *t1_X,
-                             t1_p);
-    
-    
-    _g(X, p, *t1_X, t1_p, g);
-    
     // scale the values so that they are in the scaled coordinates
-    t1_X->scale(_X_scale);
+    t1_X->add(_X_scale, *_t0_X);
     t1_X->close();
-    t1_p *= _p_scale;
     
     if (!schur_factorization)
         _solve(X, p,
@@ -123,14 +147,18 @@ _solve_NR_iterate(libMesh::NumericVector<Real>       &X,
                *t1_X, t1_p, g,           // dgdX = X_scale * t1^X, dgdp = p_scale *t1^p
                *dX, dp);
     else
+        // the two solutions with the Jacobian at X share its
+        // preconditioner
         _solve_schur_factorization(X, p,
-                                   jac,                          false, // do not update jac
+                                   jac,                          !_jac_current,
                                    *f,                           true,  // update f
                                    *dfdp,                        true,  // update dfdp
                                    *dXdp,                        true,  // update dXdp
                                    *t1_X, t1_p, g,           // dgdX = X_scale * t1^X, dgdp = p_scale *t1^p
                                    *dX, dp);
     
+    _jac_current = false;
+    
     // update the solution and load parameter
     p() += dp;
     X.add(1., *dX);
@@ -205,20 +233,27 @@ Real
 MAST::PseudoArclengthContinuationSolver::_g(const libMesh::NumericVector<Real> &X,
                                             const MAST::Parameter              &p) {
     
-    std::unique_ptr<libMesh::NumericVector<Real>>
-    f(X.zero_clone().release()),
-    t1_X(X.zero_clone().release());
-    
     Real
-    g       = 0.,
-    t1_p    = 0.;
-
-    _update_search_direction(X, p,
-                             *_assembly->system().matrix,
-                             *t1_X,
-                             t1_p);
+    g       = 0.;
+
+    // the search direction is computed at the first evaluation in the
+    // step, which is at X0, and stored in _t0_X and _t0_p
+    if (!_tangent_current) {
+        
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        t1_X(X.zero_clone().release());
+        
+        Real
+        t1_p    = 0.;
+        
+        _update_search_direction(X, p,
+                                 *_assembly->system().matrix,
+                                 *t1_X,
+                                 t1_p);
+        _tangent_current = true;
+    }
     
-    _g(X, p, *t1_X, t1_p, g);
+    _g(X, p, *_t0_X, _t0_p, g);
     
     return g;
 }
@@ -264,4 +299,7 @@ MAST::PseudoArclengthContinuationSolver::_reset_iterations() {
     _t0_X->add(1., *_t0_X_orig);
     _t0_X->close();
     _t0_p = _t0_p_orig;
+    
+    // the search direction is recomputed from the restored one
+    _tangent_current = false;
 }
@@ -61,6 +61,13 @@ namespace MAST {
          */
         virtual void initialize(Real dp);
         
+        /*!
+         *   also writes the search direction
+         */
+        virtual void write_restart(MAST::HDF5RestartFile& file) const;
+        
+        virtual void read_restart(MAST::HDF5RestartFile& file);
+        
         
     protected:
         
@@ -76,8 +83,6 @@ namespace MAST {
         _update_search_direction(const libMesh::NumericVector<Real> &X,
                                  const MAST::Parameter              &p,
                                  libMesh::SparseMatrix<Real>        &jac,
-                                 /*libMesh::NumericVector<Real>       &dfdp,
-                                 libMesh::NumericVector<Real>       &dXdp,*/
                                  libMesh::NumericVector<Real>       &t1_X,
                                  Real                               &t1_p);
         
@@ -89,7 +94,8 @@ namespace MAST {
          * \f]
          *  where,
          *  \f$ t_1^{X} = (dX/ds)_{scaled} \f$ and
-         *  \f$ t_1^{p} = (dp/ds)_{scaled} \f$.
+         *  \f$ t_1^{p} = (dp/ds)_{scaled} \f$ is the search direction,
+         *  which is computed at X0 once per step.
          */
         virtual Real
         _g(const libMesh::NumericVector<Real> &X,
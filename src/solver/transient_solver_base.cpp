@@ -24,6 +24,7 @@
 #include "base/transient_assembly.h"
 #include "base/nonlinear_system.h"
 #include "base/system_initialization.h"
+#include "utility/hdf5_restart_file.h"
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
@@ -796,6 +797,30 @@ MAST::TransientSolverBase::advance_time_step_with_sensitivity() {
 
 
 
+void
+MAST::TransientSolverBase::write_restart(MAST::HDF5RestartFile& file) const {
+    
+    file.write_scalar("transient/dt", dt);
+    file.write_scalar("transient/n_iters_stored", _n_iters_to_store);
+    file.write_scalar("transient/first_step", _first_step);
+    file.write_scalar("transient/first_sensitivity_step", _first_sensitivity_step);
+}
+
+
+
+void
+MAST::TransientSolverBase::read_restart(MAST::HDF5RestartFile& file) {
+    
+    libmesh_assert_equal_to(file.read_scalar("transient/n_iters_stored"),
+                            _n_iters_to_store);
+    
+    dt                      = file.read_scalar("transient/dt");
+    _first_step             = file.read_scalar("transient/first_step") != 0.;
+    _first_sensitivity_step = file.read_scalar("transient/first_sensitivity_step") != 0.;
+}
+
+
+
 void
 MAST::TransientSolverBase::set_elem_data(unsigned int dim,
                                          const libMesh::Elem& ref_elem,
@@ -35,6 +35,7 @@ namespace MAST {
     class TransientAssemblyElemOperations;
     class ElementBase;
     class NonlinearSystem;
+    class HDF5RestartFile;
     
     
     class TransientSolverBase:
@@ -223,6 +224,20 @@ namespace MAST {
          *   primary solution.
          */
         virtual void advance_time_step_with_sensitivity();
+        
+        /*!
+         *   writes the time-step size and the state of the solver to the
+         *   restart file \p file. The solution history is stored in vectors
+         *   of the system, and is written by
+         *   \p MAST::NonlinearSystem::write_restart().
+         */
+        virtual void write_restart(MAST::HDF5RestartFile& file) const;
+        
+        /*!
+         *   reads the data written by \p write_restart(). The solver should
+         *   be attached to the system before this is called.
+         */
+        virtual void read_restart(MAST::HDF5RestartFile& file);
 
         
         /*!
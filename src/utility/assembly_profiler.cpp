@@ -0,0 +1,385 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+// MAST includes
+#include "utility/assembly_profiler.h"
+
+// libMesh includes
+#include "libmesh/string_to_enum.h"
+
+
+bool
+MAST::AssemblyProfiler::_enabled = false;
+
+bool
+MAST::AssemblyProfiler::_trace = false;
+
+std::size_t
+MAST::AssemblyProfiler::_max_trace_events = 0;
+
+std::size_t
+MAST::AssemblyProfiler::_n_dropped_events = 0;
+
+MAST::AssemblyProfiler::AllocationCounter
+MAST::AssemblyProfiler::_alloc_counter = nullptr;
+
+MAST::AssemblyProfiler::Scope*
+MAST::AssemblyProfiler::_current = nullptr;
+
+MAST::AssemblyProfiler::ClockType::time_point
+MAST::AssemblyProfiler::_start = MAST::AssemblyProfiler::ClockType::now();
+
+MAST::AssemblyProfiler::Stats
+MAST::AssemblyProfiler::_phase_stats[MAST::AssemblyProfiler::N_PHASES];
+
+std::uint64_t
+MAST::AssemblyProfiler::_counters[MAST::AssemblyProfiler::N_COUNTERS] = {0};
+
+std::map<const char*, MAST::AssemblyProfiler::Stats>
+MAST::AssemblyProfiler::_region_stats;
+
+std::map<libMesh::ElemType, MAST::AssemblyProfiler::ElemStats>
+MAST::AssemblyProfiler::_elem_stats;
+
+std::vector<MAST::AssemblyProfiler::TraceEvent>
+MAST::AssemblyProfiler::_events;
+
+
+
+void
+MAST::AssemblyProfiler::enable(bool trace,
+                               std::size_t max_trace_events) {
+    
+    // scopes that are open when the profiler is enabled are not recorded
+    // and should not become parents of new scopes.
+    libmesh_assert(!_current);
+    
+    _enabled          = true;
+    _trace            = trace;
+    _max_trace_events = max_trace_events;
+    
+    if (_trace)
+        _events.reserve(std::min(_max_trace_events, (std::size_t)100000));
+}
+
+
+
+void
+MAST::AssemblyProfiler::disable() {
+    
+    // the open scopes complete their recording after this call
+    _enabled = false;
+}
+
+
+
+void
+MAST::AssemblyProfiler::clear() {
+    
+    libmesh_assert(!_current);
+
+    for (unsigned int i=0; i<N_PHASES; i++)
+        _phase_stats[i] = Stats();
+    for (unsigned int i=0; i<N_COUNTERS; i++)
+        _counters[i] = 0;
+    
+    _region_stats.clear();
+    _elem_stats.clear();
+    _events.clear();
+    _n_dropped_events = 0;
+    _start            = ClockType::now();
+}
+
+
+
+void
+MAST::AssemblyProfiler::set_allocation_counter(AllocationCounter c) {
+    
+    _alloc_counter = c;
+}
+
+
+
+const char*
+MAST::AssemblyProfiler::phase_name(Phase p) {
+    
+    switch (p) {
+        case ELEM_INIT:           return "elem_init";
+        case PROPERTY_EVALUATION: return "property_evaluation";
+        case ELEM_KERNEL:         return "elem_kernel";
+        case CONSTRAINTS:         return "constraints";
+        case SCATTER:             return "scatter";
+        case LOCALIZATION:        return "localization";
+        default:
+            libmesh_error_msg("Invalid assembly phase: " << p);
+    }
+}
+
+
+
+const char*
+MAST::AssemblyProfiler::counter_name(Counter c) {
+    
+    switch (c) {
+        case VECTOR_ENTRIES_ADDED: return "vector_entries_added";
+        case MATRIX_ENTRIES_ADDED: return "matrix_entries_added";
+        case LOCALIZED_VECTORS:    return "localized_vectors";
+        case LOCALIZED_ENTRIES:    return "localized_entries";
+        default:
+            libmesh_error_msg("Invalid assembly counter: " << c);
+    }
+}
+
+
+
+void
+MAST::AssemblyProfiler::Scope::_begin() {
+    
+    _parent        = AssemblyProfiler::_current;
+    _child_seconds = 0.;
+    _n_allocs      = 0;
+    _n_bytes       = 0;
+    AssemblyProfiler::_current = this;
+    
+    if (AssemblyProfiler::_alloc_counter)
+        AssemblyProfiler::_alloc_counter(_n_allocs, _n_bytes);
+    
+    // the clock is read last so that the bookkeeping is not timed
+    _t0 = ClockType::now();
+}
+
+
+
+void
+MAST::AssemblyProfiler::Scope::_end() {
+    
+    const ClockType::time_point
+    t1 = ClockType::now();
+    
+    const Real
+    dt = std::chrono::duration<Real>(t1 - _t0).count();
+    
+    Stats&
+    s  = (_phase < N_PHASES)?
+    AssemblyProfiler::_phase_stats[_phase]:
+    AssemblyProfiler::_region_stats[_name];
+    
+    s.n_calls++;
+    s.inclusive += dt;
+    s.exclusive += dt - _child_seconds;
+    
+    if (AssemblyProfiler::_alloc_counter) {
+        
+        std::uint64_t
+        n_allocs = 0,
+        n_bytes  = 0;
+        AssemblyProfiler::_alloc_counter(n_allocs, n_bytes);
+        s.n_allocs += n_allocs - _n_allocs;
+        s.n_bytes  += n_bytes  - _n_bytes;
+    }
+    
+    if (_parent)
+        _parent->_child_seconds += dt;
+    AssemblyProfiler::_current = _parent;
+    
+    // property evaluations happen at each quadrature point and are too
+    // fine-grained for the trace.
+    if (AssemblyProfiler::_trace && _phase != PROPERTY_EVALUATION) {
+        
+        if (AssemblyProfiler::_events.size() < AssemblyProfiler::_max_trace_events) {
+            
+            TraceEvent e;
+            e.name     = (_phase < N_PHASES)? phase_name(_phase) : _name;
+            e.begin    = std::chrono::duration<Real, std::micro>
+            (_t0 - AssemblyProfiler::_start).count();
+            e.duration = dt * 1.e6;
+            AssemblyProfiler::_events.push_back(e);
+        }
+        else
+            AssemblyProfiler::_n_dropped_events++;
+    }
+}
+
+
+
+void
+MAST::AssemblyProfiler::_add_elem(libMesh::ElemType t,
+                                  const ClockType::time_point& t0) {
+    
+    ElemStats& s = _elem_stats[t];
+    s.n_elems++;
+    s.seconds += std::chrono::duration<Real>(ClockType::now() - t0).count();
+}
+
+
+
+void
+MAST::AssemblyProfiler::_write_stats(std::ostream& o,
+                                     const std::string& nm,
+                                     const Stats& s) {
+    
+    o << "    {\"name\": \"" << nm << "\""
+    << ", \"calls\": "           << s.n_calls
+    << ", \"inclusive_s\": "     << s.inclusive
+    << ", \"exclusive_s\": "     << s.exclusive;
+    if (_alloc_counter)
+        o << ", \"allocations\": "     << s.n_allocs
+        << ", \"allocated_bytes\": " << s.n_bytes;
+    o << "}";
+}
+
+
+
+void
+MAST::AssemblyProfiler::write_json(const libMesh::Parallel::Communicator& comm,
+                                   std::ostream& o) {
+    
+    const std::ios::fmtflags f = o.flags();
+    o << std::setprecision(9);
+    
+    o << "{\n"
+    << "  \"rank\": "     << comm.rank() << ",\n"
+    << "  \"n_ranks\": "  << comm.size() << ",\n"
+    << "  \"phases\": [\n";
+    
+    for (unsigned int i=0; i<N_PHASES; i++) {
+        _write_stats(o, phase_name(Phase(i)), _phase_stats[i]);
+        o << (i+1 < N_PHASES? ",\n" : "\n");
+    }
+    
+    o << "  ],\n  \"regions\": [\n";
+    
+    {
+        // the same name can be used in different translation units, which
+        // may not share the address of the string literal
+        std::map<std::string, Stats>
+        regions;
+        
+        for (std::map<const char*, Stats>::const_iterator
+             it = _region_stats.begin(); it != _region_stats.end(); it++) {
+            
+            Stats& s = regions[it->first];
+            s.n_calls   += it->second.n_calls;
+            s.inclusive += it->second.inclusive;
+            s.exclusive += it->second.exclusive;
+            s.n_allocs  += it->second.n_allocs;
+            s.n_bytes   += it->second.n_bytes;
+        }
+        
+        std::map<std::string, Stats>::const_iterator
+        it  = regions.begin(),
+        end = regions.end();
+        
+        for ( ; it != end; ) {
+            _write_stats(o, it->first, it->second);
+            o << (++it != end? ",\n" : "\n");
+        }
+    }
+    
+    o << "  ],\n  \"elem_types\": [\n";
+    
+    {
+        std::map<libMesh::ElemType, ElemStats>::const_iterator
+        it  = _elem_stats.begin(),
+        end = _elem_stats.end();
+        
+        for ( ; it != end; ) {
+            
+            const ElemStats& s = it->second;
+            o << "    {\"type\": \""
+            << libMesh::Utility::enum_to_string<libMesh::ElemType>(it->first) << "\""
+            << ", \"elements\": "          << s.n_elems
+            << ", \"seconds\": "           << s.seconds
+            << ", \"elements_per_second\": "
+            << (s.seconds > 0.? s.n_elems/s.seconds : 0.) << "}";
+            o << (++it != end? ",\n" : "\n");
+        }
+    }
+    
+    o << "  ],\n  \"counters\": {\n";
+    
+    for (unsigned int i=0; i<N_COUNTERS; i++)
+        o << "    \"" << counter_name(Counter(i)) << "\": " << _counters[i]
+        << (i+1 < N_COUNTERS? ",\n" : "\n");
+    
+    o << "  },\n"
+    << "  \"trace_events\": " << _events.size() << ",\n"
+    << "  \"dropped_trace_events\": " << _n_dropped_events << "\n"
+    << "}\n";
+    
+    o.flags(f);
+}
+
+
+
+void
+MAST::AssemblyProfiler::write_chrome_trace(const libMesh::Parallel::Communicator& comm,
+                                           std::ostream& o) {
+    
+    const std::ios::fmtflags f = o.flags();
+    o << std::fixed << std::setprecision(3);
+    
+    o << "{\"traceEvents\": [\n"
+    << "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << comm.rank()
+    << ", \"args\": {\"name\": \"rank " << comm.rank() << "\"}}";
+    
+    for (std::size_t i=0; i<_events.size(); i++) {
+        
+        const TraceEvent& e = _events[i];
+        o << ",\n  {\"name\": \"" << e.name << "\", \"ph\": \"X\""
+        << ", \"pid\": " << comm.rank() << ", \"tid\": 0"
+        << ", \"ts\": "  << e.begin
+        << ", \"dur\": " << e.duration << "}";
+    }
+    
+    o << "\n],\n\"displayTimeUnit\": \"ms\"}\n";
+    
+    o.flags(f);
+}
+
+
+
+void
+MAST::AssemblyProfiler::write(const libMesh::Parallel::Communicator& comm,
+                              const std::string& prefix) {
+    
+    std::ostringstream nm;
+    nm << prefix << "." << comm.rank();
+    
+    {
+        std::ofstream o(nm.str() + ".json");
+        if (!o.good())
+            libmesh_error_msg("Unable to open file: " << nm.str() << ".json");
+        write_json(comm, o);
+    }
+    
+    if (_trace) {
+        
+        std::ofstream o(nm.str() + ".trace.json");
+        if (!o.good())
+            libmesh_error_msg("Unable to open file: " << nm.str() << ".trace.json");
+        write_chrome_trace(comm, o);
+    }
+}
@@ -0,0 +1,285 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_assembly_profiler_h__
+#define __mast_assembly_profiler_h__
+
+// C++ includes
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <iostream>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/elem.h"
+#include "libmesh/parallel.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Collects per-rank timings and counters for the phases of the
+     *   assembly routines. The assembly code marks the phases with
+     *   \p AssemblyProfiler::Scope objects, and the element loops mark
+     *   each element with an \p AssemblyProfiler::ElemScope, which
+     *   provides the throughput for each element type.
+     *
+     *   The profiler is disabled by default, in which case each scope
+     *   costs a single test of a static flag. Once enabled with
+     *   \p enable(), each scope records its inclusive time and the time
+     *   exclusive of the nested scopes. If requested, the begin and end
+     *   of each scope, except the property evaluations at quadrature
+     *   points, is also recorded for a Chrome trace (viewable in
+     *   chrome://tracing or Perfetto).
+     *
+     *   Heap allocations are not counted by the library. Applications that
+     *   replace the global \p operator \p new can provide their counters
+     *   through \p set_allocation_counter(), in which case the allocations
+     *   in each scope are reported along with the times.
+     *
+     *   The data is process-wide and is not protected against concurrent
+     *   updates, so scopes should only be used from the thread that
+     *   performs the assembly.
+     */
+    class AssemblyProfiler {
+        
+    public:
+        
+        /*!
+         *   phases of the assembly that are timed separately
+         */
+        enum Phase {
+            ELEM_INIT = 0,        // GeomElem, FE and element initialization
+            PROPERTY_EVALUATION,  // property functions at quadrature points
+            ELEM_KERNEL,          // element residual, Jacobian and outputs
+            CONSTRAINTS,          // constraint application to element quantities
+            SCATTER,              // addition to, and closing of, global objects
+            LOCALIZATION,         // ghosted copies of global vectors
+            N_PHASES
+        };
+        
+        /*!
+         *   counters that are incremented by the assembly
+         */
+        enum Counter {
+            VECTOR_ENTRIES_ADDED = 0,
+            MATRIX_ENTRIES_ADDED,
+            LOCALIZED_VECTORS,
+            LOCALIZED_ENTRIES,
+            N_COUNTERS
+        };
+        
+        /*!
+         *   function that returns the number of allocations and the
+         *   allocated bytes since the start of the program
+         */
+        typedef void (*AllocationCounter)(std::uint64_t& n_allocations,
+                                          std::uint64_t& n_bytes);
+        
+        /*!
+         *   @returns true if the profiler is collecting data
+         */
+        static bool enabled() { return _enabled; }
+        
+        /*!
+         *   starts collecting data. If \p trace is true, up to
+         *   \p max_trace_events scopes are also recorded for the Chrome
+         *   trace. Data from previous calls is retained until \p clear().
+         */
+        static void enable(bool trace = false,
+                           std::size_t max_trace_events = 1000000);
+        
+        /*!
+         *   stops collecting data
+         */
+        static void disable();
+        
+        /*!
+         *   clears all data collected so far
+         */
+        static void clear();
+        
+        /*!
+         *   sets the function used to count heap allocations in each scope.
+         *   A \p nullptr disables counting of allocations.
+         */
+        static void set_allocation_counter(AllocationCounter c);
+        
+        /*!
+         *   increments counter \p c by \p n
+         */
+        static void count(Counter c, std::uint64_t n = 1) {
+            if (_enabled) _counters[c] += n;
+        }
+        
+        static const char* phase_name(Phase p);
+        
+        static const char* counter_name(Counter c);
+        
+        /*!
+         *   writes the summary of this rank in JSON format to \p o
+         */
+        static void write_json(const libMesh::Parallel::Communicator& comm,
+                               std::ostream& o);
+        
+        /*!
+         *   writes the recorded scopes of this rank in the Chrome trace
+         *   event format to \p o. The rank is used as the process id.
+         */
+        static void write_chrome_trace(const libMesh::Parallel::Communicator& comm,
+                                       std::ostream& o);
+        
+        /*!
+         *   writes \p <prefix>.<rank>.json and, if tracing was enabled,
+         *   \p <prefix>.<rank>.trace.json on each rank of \p comm.
+         */
+        static void write(const libMesh::Parallel::Communicator& comm,
+                          const std::string& prefix);
+        
+        
+        typedef std::chrono::steady_clock ClockType;
+
+        /*!
+         *   Times the enclosing block as one of the assembly phases or as
+         *   a named region. Region names must remain valid until the
+         *   data is written, which is satisfied by string literals. The
+         *   regions are identified by the address of the name while the
+         *   data is collected, and regions with the same name are merged
+         *   when the data is written.
+         */
+        class Scope {
+            
+        public:
+            
+            explicit Scope(Phase p):
+            _active   (AssemblyProfiler::_enabled),
+            _phase    (p),
+            _name     (nullptr) {
+                if (_active) _begin();
+            }
+            
+            explicit Scope(const char* region):
+            _active   (AssemblyProfiler::_enabled),
+            _phase    (N_PHASES),
+            _name     (region) {
+                if (_active) _begin();
+            }
+            
+            ~Scope() {
+                if (_active) _end();
+            }
+            
+        private:
+            
+            friend class AssemblyProfiler;
+            
+            void _begin();
+            
+            void _end();
+            
+            const bool                _active;
+            const Phase               _phase;
+            const char*               _name;
+            Scope*                    _parent;
+            Real                      _child_seconds;
+            std::uint64_t             _n_allocs;
+            std::uint64_t             _n_bytes;
+            ClockType::time_point     _t0;
+        };
+        
+        
+        /*!
+         *   Times the processing of one element, including all phases,
+         *   for the throughput of each element type.
+         */
+        class ElemScope {
+            
+        public:
+            
+            explicit ElemScope(const libMesh::Elem& e):
+            _active   (AssemblyProfiler::_enabled),
+            _type     (e.type()) {
+                if (_active) _t0 = ClockType::now();
+            }
+            
+            ~ElemScope() {
+                if (_active) AssemblyProfiler::_add_elem(_type, _t0);
+            }
+            
+        private:
+            
+            const bool                _active;
+            const libMesh::ElemType   _type;
+            ClockType::time_point     _t0;
+        };
+        
+    protected:
+        
+        struct Stats {
+            Stats(): n_calls(0), inclusive(0.), exclusive(0.),
+            n_allocs(0), n_bytes(0) { }
+            std::uint64_t  n_calls;
+            Real           inclusive;
+            Real           exclusive;
+            std::uint64_t  n_allocs;
+            std::uint64_t  n_bytes;
+        };
+        
+        struct ElemStats {
+            ElemStats(): n_elems(0), seconds(0.) { }
+            std::uint64_t  n_elems;
+            Real           seconds;
+        };
+        
+        struct TraceEvent {
+            const char*    name;
+            Real           begin;    // microseconds since the start
+            Real           duration; // microseconds
+        };
+        
+        static void _add_elem(libMesh::ElemType t,
+                              const ClockType::time_point& t0);
+        
+        static void _write_stats(std::ostream& o,
+                                 const std::string& nm,
+                                 const Stats& s);
+        
+        static bool                                _enabled;
+        static bool                                _trace;
+        static std::size_t                         _max_trace_events;
+        static std::size_t                         _n_dropped_events;
+        static AllocationCounter                   _alloc_counter;
+        static Scope*                              _current;
+        static ClockType::time_point               _start;
+        static Stats                               _phase_stats[N_PHASES];
+        static std::uint64_t                       _counters[N_COUNTERS];
+        static std::map<const char*, Stats>        _region_stats;
+        static std::map<libMesh::ElemType, ElemStats> _elem_stats;
+        static std::vector<TraceEvent>             _events;
+    };
+}
+
+
+#endif // __mast_assembly_profiler_h__
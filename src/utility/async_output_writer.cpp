@@ -0,0 +1,322 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "utility/async_output_writer.h"
+
+
+std::size_t
+MAST::AsyncOutputWriter::Snapshot::bytes() const {
+    
+    std::size_t n = 0;
+    for (unsigned int i=0; i<data.size(); i++)
+        n += data[i].size() * sizeof(Real);
+    
+    return n;
+}
+
+
+
+MAST::AsyncOutputWriter::AsyncOutputWriter(const libMesh::Parallel::Communicator& comm,
+                                           const std::string& nm,
+                                           const unsigned int n_buffers,
+                                           const std::size_t max_buffer_bytes):
+_comm           (comm),
+_n_buffers      (n_buffers),
+_max_bytes      (max_buffer_bytes),
+_if_async       (n_buffers > 0),
+_if_collective  (false),
+_file           (-1),
+_staged_bytes   (0),
+_n_staged       (0),
+_stop           (false) {
+    
+    std::lock_guard<std::mutex> hdf5_lock(hdf5_mutex());
+    
+    hid_t
+    fapl = H5Pcreate(H5P_FILE_ACCESS),
+    fcpl = H5Pcreate(H5P_FILE_CREATE);
+    
+    // the snapshot groups can be iterated in the order of the writes
+    H5Pset_link_creation_order(fcpl, H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED);
+    
+#ifdef H5_HAVE_PARALLEL
+    // the background thread holds the HDF5 mutex while it writes, so it
+    // does not make collective calls that wait for the other ranks.
+    if (!_if_async) {
+        
+        _if_collective = true;
+        H5Pset_fapl_mpio(fapl, comm.get(), MPI_INFO_NULL);
+    }
+#endif
+    
+    std::string
+    file_nm = nm;
+    if (!_if_collective && comm.size() > 1)
+        file_nm += "." + std::to_string(comm.rank());
+    
+    _file = H5Fcreate(file_nm.c_str(), H5F_ACC_TRUNC, fcpl, fapl);
+    H5Pclose(fcpl);
+    H5Pclose(fapl);
+    
+    if (_file < 0)
+        libmesh_error_msg("Error creating HDF5 file: " << file_nm);
+    
+    if (_if_async)
+        _thread = std::thread(&MAST::AsyncOutputWriter::_worker, this);
+}
+
+
+
+MAST::AsyncOutputWriter::~AsyncOutputWriter() {
+    
+    if (_if_async) {
+        
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cv_queue.notify_all();
+        _thread.join();
+    }
+    
+    std::lock_guard<std::mutex> hdf5_lock(hdf5_mutex());
+    H5Fclose(_file);
+}
+
+
+
+void
+MAST::AsyncOutputWriter::write(const std::string& group,
+                               const Real time,
+                               const std::vector<std::string>& names,
+                               const std::vector<const libMesh::NumericVector<Real>*>& vecs) {
+    
+    libmesh_assert_equal_to(names.size(), vecs.size());
+    
+    std::size_t
+    bytes = 0;
+    for (unsigned int i=0; i<vecs.size(); i++)
+        bytes += vecs[i]->local_size() * sizeof(Real);
+    
+    std::unique_ptr<Snapshot> s;
+    
+    if (_if_async) {
+        
+        // wait for space in the staging area. A snapshot is always
+        // accepted if nothing else is staged.
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv_done.wait(lock, [&] {
+            return _n_staged == 0 ||
+            (_n_staged < _n_buffers && _staged_bytes + bytes <= _max_bytes);
+        });
+        
+        _n_staged++;
+        _staged_bytes += bytes;
+        
+        // reuse the buffers of a previously written snapshot
+        if (!_free.empty()) {
+            s = std::move(_free.back());
+            _free.pop_back();
+        }
+    }
+    
+    if (!s)
+        s.reset(new Snapshot);
+    
+    s->group = group;
+    s->time  = time;
+    s->names = names;
+    s->first_index.resize(vecs.size());
+    s->global_size.resize(vecs.size());
+    s->data.resize(vecs.size());
+    
+    for (unsigned int i=0; i<vecs.size(); i++) {
+        
+        const libMesh::NumericVector<Real>& v = *vecs[i];
+        
+        const libMesh::dof_id_type
+        first = v.first_local_index(),
+        n     = v.local_size();
+        
+        s->first_index[i] = first;
+        s->global_size[i] = v.size();
+        s->data[i].resize(n);
+        
+        for (libMesh::dof_id_type j=0; j<n; j++)
+            s->data[i][j] = v(first+j);
+    }
+    
+    if (_if_async) {
+        
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back(std::move(s));
+        }
+        _cv_queue.notify_one();
+    }
+    else
+        _write_snapshot(*s);
+}
+
+
+
+void
+MAST::AsyncOutputWriter::flush() {
+    
+    if (_if_async) {
+        
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv_done.wait(lock, [&] { return _n_staged == 0; });
+    }
+    
+    // the background thread is idle at this point
+    std::lock_guard<std::mutex> hdf5_lock(hdf5_mutex());
+    H5Fflush(_file, H5F_SCOPE_LOCAL);
+}
+
+
+
+std::mutex&
+MAST::AsyncOutputWriter::hdf5_mutex() {
+    
+    static std::mutex m;
+    return m;
+}
+
+
+
+void
+MAST::AsyncOutputWriter::_worker() {
+    
+    while (true) {
+        
+        std::unique_ptr<Snapshot> s;
+        
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv_queue.wait(lock, [&] { return _stop || !_queue.empty(); });
+            
+            // pending snapshots are written before the thread exits
+            if (_queue.empty())
+                break;
+            
+            s = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        
+        _write_snapshot(*s);
+        
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            
+            _n_staged--;
+            _staged_bytes -= s->bytes();
+            
+            if (_free.size() < _n_buffers)
+                _free.push_back(std::move(s));
+        }
+        _cv_done.notify_all();
+    }
+}
+
+
+
+void
+MAST::AsyncOutputWriter::_write_snapshot(const Snapshot& s) {
+    
+    std::lock_guard<std::mutex> hdf5_lock(hdf5_mutex());
+    
+    herr_t
+    ierr  = 0;
+    
+    hid_t
+    grp   = H5Gcreate2(_file, s.group.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
+    scalar = H5Screate(H5S_SCALAR),
+    attr  = H5Acreate2(grp, "time", H5T_NATIVE_DOUBLE, scalar, H5P_DEFAULT, H5P_DEFAULT);
+    
+    libmesh_assert_greater_equal(grp, 0);
+    
+    ierr = H5Awrite(attr, H5T_NATIVE_DOUBLE, &s.time);
+    libmesh_assert_greater_equal(ierr, 0);
+    H5Aclose(attr);
+    
+    hid_t
+    dxpl  = H5Pcreate(H5P_DATASET_XFER);
+#ifdef H5_HAVE_PARALLEL
+    if (_if_collective)
+        H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+#endif
+    
+    for (unsigned int i=0; i<s.names.size(); i++) {
+        
+        hsize_t
+        n_local  = s.data[i].size(),
+        first    = s.first_index[i],
+        n_file   = _if_collective? s.global_size[i]: n_local;
+        
+        hid_t
+        fspace   = H5Screate_simple(1, &n_file, nullptr),
+        mspace   = H5Screate_simple(1, &n_local, nullptr),
+        dset     = H5Dcreate2(grp, s.names[i].c_str(), H5T_NATIVE_DOUBLE, fspace,
+                              H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        
+        libmesh_assert_greater_equal(dset, 0);
+        
+        if (_if_collective) {
+            
+            // each rank writes its local entries to the global dataset
+            if (n_local)
+                H5Sselect_hyperslab(fspace, H5S_SELECT_SET, &first, nullptr, &n_local, nullptr);
+            else {
+                H5Sselect_none(fspace);
+                H5Sselect_none(mspace);
+            }
+        }
+        else {
+            
+            // the global position of the local entries is stored with
+            // the dataset in the file of each rank
+            hsize_t
+            vals[2] = {s.first_index[i], s.global_size[i]};
+            const char*
+            attr_nm[2] = {"first_index", "global_size"};
+            
+            for (unsigned int j=0; j<2; j++) {
+                attr  = H5Acreate2(dset, attr_nm[j], H5T_NATIVE_HSIZE, scalar, H5P_DEFAULT, H5P_DEFAULT);
+                ierr  = H5Awrite(attr, H5T_NATIVE_HSIZE, &vals[j]);
+                libmesh_assert_greater_equal(ierr, 0);
+                H5Aclose(attr);
+            }
+        }
+        
+        ierr = H5Dwrite(dset, H5T_NATIVE_DOUBLE, mspace, fspace, dxpl,
+                        n_local? &s.data[i][0]: nullptr);
+        libmesh_assert_greater_equal(ierr, 0);
+        
+        H5Dclose(dset);
+        H5Sclose(mspace);
+        H5Sclose(fspace);
+    }
+    
+    H5Pclose(dxpl);
+    H5Sclose(scalar);
+    H5Gclose(grp);
+}
@@ -0,0 +1,207 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast_async_output_writer_h__
+#define __mast_async_output_writer_h__
+
+// C++ includes
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+#include "libmesh/parallel.h"
+
+// HDF5 includes
+#include "hdf5.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Writes snapshots of distributed vectors to an HDF5 file from a
+     *   background thread, so that the analysis can proceed with the next
+     *   time-step or iteration while the previous one is being written.
+     *   A call to \p write() copies the local entries of the vectors to a
+     *   staging buffer and returns. The number of staged snapshots and the
+     *   memory used by them are capped, and \p write() blocks only if the
+     *   writer falls behind by more than this amount.
+     *
+     *   Each snapshot is written to a group in the file with one dataset
+     *   per vector and the \p time attribute. The groups are written in
+     *   the order of the calls to \p write(), and the file tracks the
+     *   creation order so that the snapshots can be iterated in this
+     *   order. If HDF5 is built with MPI support and the snapshots are
+     *   written by \p write(), all ranks write collectively to the same
+     *   file. Otherwise, each rank writes its local entries to a separate
+     *   file, \p <name>.<rank>, with the global index of the first entry
+     *   stored in the \p first_index attribute of each dataset.
+     *
+     *   HDF5 is not thread-safe unless it is built with that option, so
+     *   all calls to the library from the writers and from
+     *   \p HDF5RestartFile hold \p hdf5_mutex(). The background thread
+     *   only writes to the per-rank files, since a collective write would
+     *   wait for the other ranks while holding the mutex, and could
+     *   deadlock with a collective HDF5 call on the main thread of
+     *   another rank. Other libraries that use HDF5, such as a NetCDF-4
+     *   backend of the Exodus writer, do not take this mutex and should
+     *   not write while a snapshot is pending, unless HDF5 is
+     *   thread-safe.
+     *
+     *   The vectors are not otherwise accessed by the writer, so they can
+     *   be modified as soon as \p write() returns.
+     */
+    class AsyncOutputWriter {
+        
+    public:
+        
+        /*!
+         *   creates the file \p nm. Up to \p n_buffers snapshots, with a
+         *   total of \p max_buffer_bytes, are staged for writing. At least
+         *   one snapshot is always accepted, irrespective of its size. With
+         *   \p n_buffers = 0 no thread is created and each snapshot is
+         *   written before \p write() returns.
+         */
+        AsyncOutputWriter(const libMesh::Parallel::Communicator& comm,
+                          const std::string& nm,
+                          const unsigned int n_buffers      = 2,
+                          const std::size_t max_buffer_bytes = 512*1024*1024);
+        
+        /*!
+         *   completes the pending writes and closes the file.
+         */
+        virtual ~AsyncOutputWriter();
+        
+        /*!
+         *   @returns true if the snapshots are written from a background
+         *   thread, and false if they are written by \p write().
+         */
+        bool if_asynchronous() const { return _if_async; }
+        
+        /*!
+         *   @returns true if all ranks write to the same file
+         */
+        bool if_collective() const { return _if_collective; }
+        
+        /*!
+         *   stages the vectors \p vecs, identified by the names in \p names,
+         *   for writing to group \p group with attribute \p time. This must
+         *   be called on all ranks with the same group and vector names.
+         */
+        void write(const std::string& group,
+                   const Real time,
+                   const std::vector<std::string>& names,
+                   const std::vector<const libMesh::NumericVector<Real>*>& vecs);
+        
+        /*!
+         *   blocks until all staged snapshots have been written and flushed
+         *   to the file.
+         */
+        void flush();
+        
+        /*!
+         *   @returns the mutex that serializes the calls to the HDF5
+         *   library in this process. It must be held by any code in MAST
+         *   that calls HDF5 while a writer may be active.
+         */
+        static std::mutex& hdf5_mutex();
+        
+    protected:
+        
+        /*!
+         *   local entries of the vectors of one snapshot
+         */
+        struct Snapshot {
+            
+            std::string                        group;
+            Real                               time;
+            std::vector<std::string>           names;
+            std::vector<libMesh::dof_id_type>  first_index;
+            std::vector<libMesh::dof_id_type>  global_size;
+            std::vector<std::vector<Real>>     data;
+            
+            std::size_t bytes() const;
+        };
+        
+        /*!
+         *   loop for the background thread
+         */
+        void _worker();
+        
+        /*!
+         *   writes the snapshot to the file
+         */
+        void _write_snapshot(const Snapshot& s);
+        
+        const libMesh::Parallel::Communicator& _comm;
+        
+        const unsigned int _n_buffers;
+        
+        const std::size_t _max_bytes;
+        
+        bool _if_async;
+        
+        bool _if_collective;
+        
+        /*!
+         *   HDF5 file identifier
+         */
+        hid_t _file;
+        
+        /*!
+         *   snapshots staged for writing, in order
+         */
+        std::deque<std::unique_ptr<Snapshot>> _queue;
+        
+        /*!
+         *   snapshots that have been written, whose buffers are reused
+         */
+        std::vector<std::unique_ptr<Snapshot>> _free;
+        
+        /*!
+         *   number of bytes in staged snapshots, including the one being
+         *   written
+         */
+        std::size_t _staged_bytes;
+        
+        /*!
+         *   number of snapshots staged, including the one being written
+         */
+        unsigned int _n_staged;
+        
+        bool _stop;
+        
+        std::mutex _mutex;
+        
+        std::condition_variable _cv_queue, _cv_done;
+        
+        std::thread _thread;
+    };
+}
+
+
+#endif // __mast_async_output_writer_h__
@@ -0,0 +1,827 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+// MAST includes
+#include "utility/hdf5_restart_file.h"
+#include "utility/async_output_writer.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+#include "libmesh/mesh_base.h"
+#include "libmesh/node.h"
+#include "libmesh/elem.h"
+#include "libmesh/parallel_sync.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   number of entries in a chunk of the compressed datasets
+     */
+    static const hsize_t restart_chunk_size       = 1 << 16;
+
+    
+    /*!
+     *   @returns the key of component \p c of variable \p v on the node or
+     *   element with unique id \p id.
+     */
+    inline uint64_t
+    restart_dof_key(bool if_elem,
+                    uint64_t id,
+                    unsigned int v,
+                    unsigned int c) {
+        
+        libmesh_assert_less(v, 256);
+        libmesh_assert_less(c, 256);
+        libmesh_assert_less(id, (uint64_t)1 << 47);
+        
+        return
+        ((uint64_t)if_elem << 63) | (id << 16) | ((uint64_t)v << 8) | (uint64_t)c;
+    }
+    
+    
+    /*!
+     *   @returns the id of the node or element used in the dof keys, which
+     *   is the unique id if libMesh supports it.
+     */
+    inline uint64_t
+    restart_object_id(const libMesh::DofObject& obj) {
+        
+#ifdef LIBMESH_ENABLE_UNIQUE_ID
+        libmesh_assert(obj.valid_unique_id());
+        return obj.unique_id();
+#else
+        return obj.id();
+#endif
+    }
+    
+    
+    /*!
+     *   @returns the link creation property list that creates the
+     *   intermediate groups in a path
+     */
+    inline hid_t
+    restart_link_plist() {
+        
+        hid_t lcpl = H5Pcreate(H5P_LINK_CREATE);
+        H5Pset_create_intermediate_group(lcpl, 1);
+        return lcpl;
+    }
+}
+
+
+
+MAST::HDF5RestartFile::HDF5RestartFile(const libMesh::System& sys,
+                                       const std::string& nm,
+                                       MAST::HDF5RestartFile::AccessMode mode):
+_sys             (sys),
+_nm              (nm),
+_mode            (mode),
+_if_collective   (false),
+_file            (-1),
+_first_dof       (sys.get_dof_map().first_dof()),
+_redistribution_initialized (false),
+_n_files         (0),
+_same_partition  (-1) {
+    
+    // the HDF5 calls are serialized with those of the output writers
+    std::lock_guard<std::mutex> hdf5_lock(MAST::AsyncOutputWriter::hdf5_mutex());
+    
+    const libMesh::Parallel::Communicator& comm = sys.comm();
+    
+    hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+#ifdef H5_HAVE_PARALLEL
+    _if_collective = true;
+    H5Pset_fapl_mpio(fapl, comm.get(), MPI_INFO_NULL);
+#endif
+    
+    _init_keys();
+    
+    if (_mode == MAST::HDF5RestartFile::WRITE) {
+        
+        std::string
+        file_nm = nm;
+        if (!_if_collective)
+            file_nm += "." + std::to_string(comm.rank());
+        
+        _file    = H5Fcreate(file_nm.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+        if (_file < 0)
+            libmesh_error_msg("Error creating HDF5 file: " << file_nm);
+        
+        _n_files = _if_collective? 1: comm.size();
+        
+        unsigned int
+        n_ranks  = comm.size();
+        
+        hid_t
+        scalar   = H5Screate(H5S_SCALAR),
+        attr     = H5Acreate2(_file, "n_files", H5T_NATIVE_UINT, scalar, H5P_DEFAULT, H5P_DEFAULT);
+        H5Awrite(attr, H5T_NATIVE_UINT, &_n_files);
+        H5Aclose(attr);
+        attr     = H5Acreate2(_file, "n_ranks", H5T_NATIVE_UINT, scalar, H5P_DEFAULT, H5P_DEFAULT);
+        H5Awrite(attr, H5T_NATIVE_UINT, &n_ranks);
+        H5Aclose(attr);
+        H5Sclose(scalar);
+        
+        _write_keys();
+    }
+    else {
+        
+        // in the per-rank mode, the file of the first rank provides the
+        // scalar values, and the other files are opened as needed.
+        if (_if_collective)
+            _file = H5Fopen(nm.c_str(), H5F_ACC_RDONLY, fapl);
+        else
+            _file = _rank_file(0);
+        
+        if (_file < 0)
+            libmesh_error_msg("Error opening HDF5 file: " << nm);
+        
+        hid_t
+        attr     = H5Aopen(_file, "n_files", H5P_DEFAULT);
+        H5Aread(attr, H5T_NATIVE_UINT, &_n_files);
+        H5Aclose(attr);
+        
+        if (_if_collective && _n_files != 1)
+            libmesh_error_msg("HDF5 file " << nm << " was written in per-rank mode");
+    }
+    
+    H5Pclose(fapl);
+}
+
+
+
+MAST::HDF5RestartFile::~HDF5RestartFile() {
+    
+    std::lock_guard<std::mutex> hdf5_lock(MAST::AsyncOutputWriter::hdf5_mutex());
+    
+    for (unsigned int i=0; i<_rank_files.size(); i++)
+        if (_rank_files[i] >= 0 && _rank_files[i] != _file)
+            H5Fclose(_rank_files[i]);
+    
+    H5Fclose(_file);
+}
+
+
+
+bool
+MAST::HDF5RestartFile::contains(const std::string& nm) const {
+    
+    std::lock_guard<std::mutex> hdf5_lock(MAST::AsyncOutputWriter::hdf5_mutex());
+    
+    // each component of the path is checked, since H5Lexists fails for
+    // a path with missing intermediate groups
+    std::string::size_type
+    pos  = 0;
+    
+    while (true) {
+        
+        pos = nm.find('/', pos+1);
+        
+        if (H5Lexists(_file, nm.substr(0, pos).c_str(), H5P_DEFAULT) <= 0)
+            return false;
+        
+        if (pos == std::string::npos)
+            return true;
+    }
+}
+
+
+
+void
+MAST::HDF5RestartFile::write_vector(const std::string& nm,
+                                    const libMesh::NumericVector<Real>& vec) {
+    
+    libmesh_assert_equal_to(_mode, MAST::HDF5RestartFile::WRITE);
+    libmesh_assert_equal_to(vec.first_local_index(), _first_dof);
+    libmesh_assert_equal_to(vec.local_size(), _keys.size());
+    
+    const libMesh::dof_id_type
+    n     = _keys.size();
+    
+    std::vector<Real>
+    vals(n);
+    
+    for (libMesh::dof_id_type i=0; i<n; i++)
+        vals[i] = vec(_first_dof+i);
+    
+    std::lock_guard<std::mutex> hdf5_lock(MAST::AsyncOutputWriter::hdf5_mutex());
+    
+    _write_dataset(_file, nm, H5T_NATIVE_DOUBLE, _first_dof, n, vec.size(),
+                   n? &vals[0]: nullptr);
+}
+
+
+
+void
+MAST::HDF5RestartFile::read_vector(const std::string& nm,
+                                   libMesh::NumericVector<Real>& vec) {
+    
+    libmesh_assert_equal_to(_mode, MAST::HDF5RestartFile::READ);
+    libmesh_assert_equal_to(vec.first_local_index(), _first_dof);
+    libmesh_assert_equal_to(vec.local_size(), _keys.size());
+    
+    // the lock is also held during the redistribution, in which the
+    // other ranks only wait for the output writers to complete their
+    // local writes
+    std::lock_guard<std::mutex> hdf5_lock(MAST::AsyncOutputWriter::hdf5_mutex());
+    
+    const libMesh::Parallel::Communicator& comm = _sys.comm();
+    
+    const libMesh::dof_id_type
+    n     = _keys.size();
+    
+    std::vector<Real>
+    vals;
+    
+    if (_if_same_partition()) {
+        
+        // each rank reads its own range
+        vals.resize(n);
+        
+        if (_if_collective)
+            _read_dataset(_file, nm, H5T_NATIVE_DOUBLE, _first_dof, n, n? &vals[0]: nullptr);
+        else
+            _read_dataset(_rank_file(comm.rank()), nm, H5T_NATIVE_DOUBLE, 0, n, n? &vals[0]: nullptr);
+        
+        for (libMesh::dof_id_type i=0; i<n; i++)
+            vec.set(_first_dof+i, vals[i]);
+    }
+    else {
+        
+        // each rank reads its share of the stored entries and sends them
+        // to the ranks that own the matching dofs
+        if (!_redistribution_initialized)
+            _init_redistribution();
+        
+        vals.resize(_read_owner.size());
+        _read_share(nm, H5T_NATIVE_DOUBLE, vals.empty()? nullptr: &vals[0]);
+        
+        std::map<libMesh::processor_id_type, std::vector<Real>>
+        send_vals;
+        
+        for (std::size_t i=0; i<vals.size(); i++)
+            if (_read_owner[i] != libMesh::DofObject::invalid_processor_id)
+                send_vals[_read_owner[i]].push_back(vals[i]);
+        
+        auto set_vals =
+        [&](libMesh::processor_id_type pid, const std::vector<Real>& d) {
+            
+            const std::vector<libMesh::dof_id_type>& idx = _recv_index[pid];
+            libmesh_assert_equal_to(idx.size(), d.size());
+            
+            for (std::size_t i=0; i<d.size(); i++)
+                vec.set(_first_dof+idx[i], d[i]);
+        };
+        
+        libMesh::Parallel::push_parallel_vector_data(comm, send_vals, set_vals);
+    }
+    
+    vec.close();
+}
+
+
+
+void
+MAST::HDF5RestartFile::write_scalar(const std::string& nm, const Real v) {
+    
+    libmesh_assert_equal_to(_mode, MAST::HDF5RestartFile::WRITE);
+    
+    // in collective mode, the value is written by the first rank
+    const hsize_t
+    n    = (!_if_collective || _sys.comm().rank() == 0)? 1: 0;
+    
+    std::lock_guard<std::mutex> hdf5_lock(MAST::AsyncOutputWriter::hdf5_mutex());
+    
+    _write_dataset(_file, nm, H5T_NATIVE_DOUBLE, 0, n, 1, &v);
+}
+
+
+
+Real
+MAST::HDF5RestartFile::read_scalar(const std::string& nm) {
+    
+    libmesh_assert_equal_to(_mode, MAST::HDF5RestartFile::READ);
+    
+    std::lock_guard<std::mutex> hdf5_lock(MAST::AsyncOutputWriter::hdf5_mutex());
+    
+    Real v = 0.;
+    _read_dataset(_file, nm, H5T_NATIVE_DOUBLE, 0, 1, &v);
+    
+    return v;
+}
+
+
+
+void
+MAST::HDF5RestartFile::_init_keys() {
+    
+    const libMesh::DofMap&
+    dof_map  = _sys.get_dof_map();
+    
+    const libMesh::MeshBase&
+    mesh     = _sys.get_mesh();
+    
+    const unsigned int
+    sys_num  = _sys.number(),
+    n_vars   = _sys.n_vars();
+    
+    const libMesh::dof_id_type
+    n        = dof_map.n_local_dofs();
+    
+    _keys.assign(n, std::numeric_limits<uint64_t>::max());
+    
+    // dofs are owned by the processor that owns the node or element
+    libMesh::MeshBase::const_node_iterator
+    n_it     = mesh.local_nodes_begin(),
+    n_end    = mesh.local_nodes_end();
+    
+    for ( ; n_it != n_end; n_it++) {
+        
+        const libMesh::Node& node = **n_it;
+        
+        for (unsigned int v=0; v<n_vars; v++)
+            for (unsigned int c=0; c<node.n_comp(sys_num, v); c++) {
+                
+                const libMesh::dof_id_type
+                dof = node.dof_number(sys_num, v, c);
+                
+                libmesh_assert(dof >= _first_dof && dof < _first_dof+n);
+                _keys[dof-_first_dof] = MAST::restart_dof_key(false, MAST::restart_object_id(node), v, c);
+            }
+    }
+    
+    libMesh::MeshBase::const_element_iterator
+    e_it     = mesh.active_local_elements_begin(),
+    e_end    = mesh.active_local_elements_end();
+    
+    for ( ; e_it != e_end; e_it++) {
+        
+        const libMesh::Elem& elem = **e_it;
+        
+        for (unsigned int v=0; v<n_vars; v++)
+            for (unsigned int c=0; c<elem.n_comp(sys_num, v); c++) {
+                
+                const libMesh::dof_id_type
+                dof = elem.dof_number(sys_num, v, c);
+                
+                libmesh_assert(dof >= _first_dof && dof < _first_dof+n);
+                _keys[dof-_first_dof] = MAST::restart_dof_key(true, MAST::restart_object_id(elem), v, c);
+            }
+    }
+    
+    // SCALAR variables are not associated with a node or element
+    libmesh_assert(std::find(_keys.begin(), _keys.end(),
+                             std::numeric_limits<uint64_t>::max()) == _keys.end());
+}
+
+
+
+void
+MAST::HDF5RestartFile::_write_keys() {
+    
+    const libMesh::dof_id_type
+    n  = _keys.size();
+    
+    _write_dataset(_file, "dof_keys", H5T_NATIVE_UINT64, _first_dof, n,
+                   _sys.get_dof_map().n_dofs(), n? &_keys[0]: nullptr);
+    
+    if (!_if_collective) {
+        
+        // the number of entries in all files is stored in each file, so
+        // that a reader can divide the entries without opening all files
+        const libMesh::Parallel::Communicator& comm = _sys.comm();
+        
+        std::vector<libMesh::dof_id_type>
+        counts;
+        comm.allgather(n, counts);
+        
+        std::vector<hsize_t>
+        file_counts(counts.begin(), counts.end());
+        
+        _write_dataset(_file, "file_dof_counts", H5T_NATIVE_HSIZE, 0,
+                       file_counts.size(), file_counts.size(), &file_counts[0]);
+        
+        hsize_t
+        first   = _first_dof;
+        
+        hid_t
+        scalar  = H5Screate(H5S_SCALAR),
+        attr    = H5Acreate2(_file, "first_dof", H5T_NATIVE_HSIZE, scalar, H5P_DEFAULT, H5P_DEFAULT);
+        H5Awrite(attr, H5T_NATIVE_HSIZE, &first);
+        H5Aclose(attr);
+        H5Sclose(scalar);
+    }
+}
+
+
+
+bool
+MAST::HDF5RestartFile::_if_same_partition() {
+    
+    if (_same_partition >= 0)
+        return _same_partition;
+    
+    const libMesh::Parallel::Communicator& comm = _sys.comm();
+    
+    const libMesh::dof_id_type
+    n     = _keys.size();
+    
+    bool
+    same  = true;
+    
+    if (_if_collective)
+        same = _dataset_size(_file, "dof_keys") == _sys.get_dof_map().n_dofs();
+    else {
+        
+        same = _n_files == comm.size();
+        
+        if (same) {
+            
+            hsize_t
+            first = 0;
+            
+            hid_t
+            attr  = H5Aopen(_rank_file(comm.rank()), "first_dof", H5P_DEFAULT);
+            H5Aread(attr, H5T_NATIVE_HSIZE, &first);
+            H5Aclose(attr);
+            
+            same = first == _first_dof &&
+            _dataset_size(_rank_file(comm.rank()), "dof_keys") == n;
+        }
+    }
+    
+    if (same) {
+        
+        std::vector<uint64_t>
+        keys(n);
+        
+        if (_if_collective)
+            _read_dataset(_file, "dof_keys", H5T_NATIVE_UINT64, _first_dof, n, n? &keys[0]: nullptr);
+        else
+            _read_dataset(_rank_file(comm.rank()), "dof_keys", H5T_NATIVE_UINT64, 0, n, n? &keys[0]: nullptr);
+        
+        same = keys == _keys;
+    }
+    
+    comm.min(same);
+    _same_partition = same;
+    
+    return same;
+}
+
+
+
+void
+MAST::HDF5RestartFile::_init_redistribution() {
+    
+    libmesh_assert(!_redistribution_initialized);
+    
+    const libMesh::Parallel::Communicator& comm = _sys.comm();
+    
+    const libMesh::processor_id_type
+    n_procs  = comm.size(),
+    rank     = comm.rank();
+    
+    // number of entries stored in each file
+    std::vector<hsize_t>
+    n_stored(_n_files, 0);
+    
+    if (_if_collective)
+        n_stored[0] = _dataset_size(_file, "dof_keys");
+    else
+        _read_dataset(_file, "file_dof_counts", H5T_NATIVE_HSIZE, 0, _n_files, &n_stored[0]);
+    
+    hsize_t
+    n_total  = 0;
+    for (unsigned int f=0; f<_n_files; f++)
+        n_total += n_stored[f];
+    
+    // each rank reads a contiguous share of the entries, which can span
+    // the files of several ranks. In collective mode, all ranks take part
+    // in the read, even with an empty share.
+    const hsize_t
+    lo       = (n_total * rank)/n_procs,
+    hi       = (n_total * (rank+1))/n_procs;
+    
+    hsize_t
+    offset   = 0;
+    
+    for (unsigned int f=0; f<_n_files; f++) {
+        
+        const hsize_t
+        first    = std::max(lo, offset),
+        last     = std::min(hi, offset+n_stored[f]);
+        
+        if (_if_collective || first < last) {
+            
+            _read_files.push_back(f);
+            _read_first.push_back(first < last? first-offset: 0);
+            _read_n.push_back(first < last? last-first: 0);
+        }
+        
+        offset += n_stored[f];
+    }
+    
+    const hsize_t
+    n_read   = hi - lo;
+    
+    std::vector<uint64_t>
+    keys(n_read);
+    _read_share("dof_keys", H5T_NATIVE_UINT64, n_read? &keys[0]: nullptr);
+    
+    // the keys are matched on the directory rank key % n_procs. The
+    // owners send pairs of key and local index, and the readers send
+    // pairs of key and position in their share.
+    std::map<libMesh::processor_id_type, std::vector<uint64_t>>
+    owned_keys,
+    read_keys,
+    matches,
+    recv_index;
+    
+    for (libMesh::dof_id_type i=0; i<_keys.size(); i++) {
+        
+        std::vector<uint64_t>& d = owned_keys[_keys[i] % n_procs];
+        d.push_back(_keys[i]);
+        d.push_back(i);
+    }
+    
+    std::unordered_map<uint64_t, std::pair<libMesh::processor_id_type, uint64_t>>
+    directory;
+    
+    auto collect_owned_keys =
+    [&](libMesh::processor_id_type pid, const std::vector<uint64_t>& d) {
+        
+        for (std::size_t i=0; i<d.size(); i+=2)
+            directory[d[i]] = std::make_pair(pid, d[i+1]);
+    };
+    
+    libMesh::Parallel::push_parallel_vector_data(comm, owned_keys, collect_owned_keys);
+    
+    for (hsize_t i=0; i<n_read; i++) {
+        
+        std::vector<uint64_t>& d = read_keys[keys[i] % n_procs];
+        d.push_back(keys[i]);
+        d.push_back(i);
+    }
+    
+    // the directory returns the owner and local index for each read
+    // entry. Stored entries without a dof in the system are ignored.
+    auto match_read_keys =
+    [&](libMesh::processor_id_type pid, const std::vector<uint64_t>& d) {
+        
+        for (std::size_t i=0; i<d.size(); i+=2) {
+            
+            auto it = directory.find(d[i]);
+            
+            if (it != directory.end()) {
+                
+                std::vector<uint64_t>& m = matches[pid];
+                m.push_back(d[i+1]);
+                m.push_back(it->second.first);
+                m.push_back(it->second.second);
+            }
+        }
+    };
+    
+    libMesh::Parallel::push_parallel_vector_data(comm, read_keys, match_read_keys);
+    
+    std::vector<uint64_t>
+    owner_index(n_read, 0);
+    _read_owner.assign(n_read, libMesh::DofObject::invalid_processor_id);
+    
+    auto collect_matches =
+    [&](libMesh::processor_id_type pid, const std::vector<uint64_t>& d) {
+        
+        for (std::size_t i=0; i<d.size(); i+=3) {
+            
+            _read_owner[d[i]] = d[i+1];
+            owner_index[d[i]] = d[i+2];
+        }
+    };
+    
+    libMesh::Parallel::push_parallel_vector_data(comm, matches, collect_matches);
+    
+    // the owners receive the values in the order of the read entries
+    for (hsize_t i=0; i<n_read; i++)
+        if (_read_owner[i] != libMesh::DofObject::invalid_processor_id)
+            recv_index[_read_owner[i]].push_back(owner_index[i]);
+    
+    libMesh::dof_id_type
+    n_found  = 0;
+    
+    auto collect_index =
+    [&](libMesh::processor_id_type pid, const std::vector<uint64_t>& d) {
+        
+        _recv_index[pid].assign(d.begin(), d.end());
+        n_found += d.size();
+    };
+    
+    libMesh::Parallel::push_parallel_vector_data(comm, recv_index, collect_index);
+    
+    bool
+    found    = n_found == _keys.size();
+    comm.min(found);
+    
+    if (!found)
+        libmesh_error_msg
+        ("Restart file " << _nm << " does not match the dofs of system " << _sys.name());
+    
+    _redistribution_initialized = true;
+}
+
+
+
+void
+MAST::HDF5RestartFile::_read_share(const std::string& nm,
+                                   hid_t type,
+                                   void* data) {
+    
+    char
+    *p       = static_cast<char*>(data);
+    
+    const std::size_t
+    size     = H5Tget_size(type);
+    
+    for (unsigned int i=0; i<_read_files.size(); i++) {
+        
+        hid_t
+        fid      = _if_collective? _file: _rank_file(_read_files[i]);
+        
+        _read_dataset(fid, nm, type, _read_first[i], _read_n[i], p);
+        
+        if (_read_n[i])
+            p   += _read_n[i] * size;
+    }
+}
+
+
+
+void
+MAST::HDF5RestartFile::_write_dataset(hid_t fid,
+                                      const std::string& nm,
+                                      hid_t type,
+                                      hsize_t first,
+                                      hsize_t n,
+                                      hsize_t n_global,
+                                      const void* data) {
+    
+    hsize_t
+    n_file   = _if_collective? n_global: n,
+    chunk    = std::min(n_file, MAST::restart_chunk_size);
+    
+    hid_t
+    fspace   = H5Screate_simple(1, &n_file, nullptr),
+    mspace   = H5Screate_simple(1, &n, nullptr),
+    lcpl     = MAST::restart_link_plist(),
+    dcpl     = H5Pcreate(H5P_DATASET_CREATE),
+    dxpl     = H5Pcreate(H5P_DATASET_XFER);
+    
+    // small datasets, like the scalar values, are stored contiguously
+    if (n_file > 1) {
+        
+        H5Pset_chunk(dcpl, 1, &chunk);
+        H5Pset_shuffle(dcpl);
+        H5Pset_deflate(dcpl, 4);
+    }
+    
+    hid_t
+    dset     = H5Dcreate2(fid, nm.c_str(), type, fspace, lcpl, dcpl, H5P_DEFAULT);
+    
+    if (dset < 0)
+        libmesh_error_msg("Error creating HDF5 dataset: " << nm);
+    
+    if (_if_collective) {
+        
+#ifdef H5_HAVE_PARALLEL
+        // filtered datasets require collective writes
+        H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+#endif
+        if (n)
+            H5Sselect_hyperslab(fspace, H5S_SELECT_SET, &first, nullptr, &n, nullptr);
+        else {
+            H5Sselect_none(fspace);
+            H5Sselect_none(mspace);
+        }
+    }
+    
+    herr_t
+    ierr     = H5Dwrite(dset, type, mspace, fspace, dxpl, data);
+    
+    if (ierr < 0)
+        libmesh_error_msg("Error writing HDF5 dataset: " << nm);
+    
+    H5Dclose(dset);
+    H5Pclose(dxpl);
+    H5Pclose(dcpl);
+    H5Pclose(lcpl);
+    H5Sclose(mspace);
+    H5Sclose(fspace);
+}
+
+
+
+void
+MAST::HDF5RestartFile::_read_dataset(hid_t fid,
+                                     const std::string& nm,
+                                     hid_t type,
+                                     hsize_t first,
+                                     hsize_t n,
+                                     void* data) const {
+    
+    hid_t
+    dset     = H5Dopen2(fid, nm.c_str(), H5P_DEFAULT);
+    
+    if (dset < 0)
+        libmesh_error_msg("Error opening HDF5 dataset: " << nm);
+    
+    hid_t
+    fspace   = H5Dget_space(dset),
+    mspace   = H5Screate_simple(1, &n, nullptr);
+    
+    if (n)
+        H5Sselect_hyperslab(fspace, H5S_SELECT_SET, &first, nullptr, &n, nullptr);
+    else {
+        H5Sselect_none(fspace);
+        H5Sselect_none(mspace);
+    }
+    
+    herr_t
+    ierr     = H5Dread(dset, type, mspace, fspace, H5P_DEFAULT, data);
+    
+    if (ierr < 0)
+        libmesh_error_msg("Error reading HDF5 dataset: " << nm);
+    
+    H5Sclose(mspace);
+    H5Sclose(fspace);
+    H5Dclose(dset);
+}
+
+
+
+hsize_t
+MAST::HDF5RestartFile::_dataset_size(hid_t fid, const std::string& nm) const {
+    
+    hid_t
+    dset     = H5Dopen2(fid, nm.c_str(), H5P_DEFAULT);
+    
+    if (dset < 0)
+        libmesh_error_msg("Error opening HDF5 dataset: " << nm);
+    
+    hid_t
+    fspace   = H5Dget_space(dset);
+    
+    hsize_t
+    n        = H5Sget_simple_extent_npoints(fspace);
+    
+    H5Sclose(fspace);
+    H5Dclose(dset);
+    
+    return n;
+}
+
+
+
+hid_t
+MAST::HDF5RestartFile::_rank_file(unsigned int i) {
+    
+    libmesh_assert(!_if_collective);
+    
+    if (_rank_files.size() <= i)
+        _rank_files.resize(i+1, -1);
+    
+    if (_rank_files[i] < 0) {
+        
+        const std::string
+        file_nm  = _nm + "." + std::to_string(i);
+        
+        _rank_files[i] = H5Fopen(file_nm.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        
+        if (_rank_files[i] < 0)
+            libmesh_error_msg("Error opening HDF5 file: " << file_nm);
+    }
+    
+    return _rank_files[i];
+}
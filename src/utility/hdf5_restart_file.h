@@ -0,0 +1,262 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_hdf5_restart_file_h__
+#define __mast_hdf5_restart_file_h__
+
+// C++ includes
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <map>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+#include "libmesh/system.h"
+
+// HDF5 includes
+#include "hdf5.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   HDF5 container for the solution vectors and the scalar state of
+     *   an analysis, used to restart long transient, continuation and
+     *   optimization runs.
+     *
+     *   Vectors are stored in chunked datasets with shuffle and deflate
+     *   filters. Each rank writes its owned dof range. If HDF5 is built
+     *   with MPI support, all ranks write to a single file; otherwise each
+     *   rank writes \p <name>.<rank>. The dof numbering depends on the
+     *   partitioning, so the file also stores a key for each dof composed
+     *   of the unique id of the node or element, the variable and the
+     *   component. Unique ids are not changed when a distributed mesh
+     *   renumbers its nodes and elements, so a file can be read on a
+     *   different number of ranks or after the mesh was renumbered. If
+     *   libMesh is configured without unique ids, the ids of the nodes
+     *   and elements are used instead, which requires the same mesh
+     *   numbering.
+     *
+     *   If the dof numbering is unchanged, each rank reads only its own
+     *   range. Otherwise, each rank reads an equal share of the stored
+     *   entries, and the entries are sent to the ranks that own the dofs
+     *   with matching keys. The keys are matched on a rank chosen by the
+     *   key, so that no rank reads or stores all entries.
+     *
+     *   Names may include \p '/' to organize the data in groups. The
+     *   calls to HDF5 hold \p AsyncOutputWriter::hdf5_mutex(), so the
+     *   file can be used while an output writer is active.
+     */
+    class HDF5RestartFile {
+        
+    public:
+        
+        enum AccessMode {
+            WRITE,
+            READ
+        };
+        
+        /*!
+         *   opens the file \p nm for dofs of system \p sys. This is
+         *   collective on the communicator of \p sys.
+         */
+        HDF5RestartFile(const libMesh::System& sys,
+                        const std::string& nm,
+                        MAST::HDF5RestartFile::AccessMode mode);
+        
+        /*!
+         *   closes the file
+         */
+        virtual ~HDF5RestartFile();
+        
+        /*!
+         *   @returns true if all ranks use the same file
+         */
+        bool if_collective() const { return _if_collective; }
+        
+        /*!
+         *   @returns true if the file contains an entry with name \p nm
+         */
+        bool contains(const std::string& nm) const;
+        
+        /*!
+         *   writes the vector \p vec, which must have the layout of the
+         *   system dofs.
+         */
+        void write_vector(const std::string& nm,
+                          const libMesh::NumericVector<Real>& vec);
+        
+        /*!
+         *   reads the vector \p nm into \p vec, which must have the layout
+         *   of the system dofs. The vector is closed before returning.
+         */
+        void read_vector(const std::string& nm,
+                         libMesh::NumericVector<Real>& vec);
+        
+        /*!
+         *   writes the value \p v, which must be the same on all ranks.
+         */
+        void write_scalar(const std::string& nm, const Real v);
+        
+        /*!
+         *   @returns the value \p nm
+         */
+        Real read_scalar(const std::string& nm);
+        
+    protected:
+        
+        /*!
+         *   computes the partition independent key of the local dofs
+         */
+        void _init_keys();
+        
+        /*!
+         *   writes the keys of the local dofs to the file
+         */
+        void _write_keys();
+        
+        /*!
+         *   @returns true if all ranks have the same dof range and keys as
+         *   the ranks that wrote the file
+         */
+        bool _if_same_partition();
+        
+        /*!
+         *   divides the stored entries among the ranks and matches the
+         *   entries read by each rank to the ranks that own the dofs.
+         *   This is used if the partitioning has changed.
+         */
+        void _init_redistribution();
+        
+        /*!
+         *   reads the entries of dataset \p nm in the share of this rank
+         *   computed by \p _init_redistribution().
+         */
+        void _read_share(const std::string& nm,
+                         hid_t type,
+                         void* data);
+        
+        /*!
+         *   creates and writes a one-dimensional dataset \p nm in file
+         *   \p fid. In collective mode, the local \p n entries are written
+         *   at offset \p first of a dataset of size \p n_global.
+         */
+        void _write_dataset(hid_t fid,
+                            const std::string& nm,
+                            hid_t type,
+                            hsize_t first,
+                            hsize_t n,
+                            hsize_t n_global,
+                            const void* data);
+        
+        /*!
+         *   reads \p n entries of dataset \p nm starting at \p first.
+         */
+        void _read_dataset(hid_t fid,
+                           const std::string& nm,
+                           hid_t type,
+                           hsize_t first,
+                           hsize_t n,
+                           void* data) const;
+        
+        /*!
+         *   @returns the number of entries in dataset \p nm
+         */
+        hsize_t _dataset_size(hid_t fid, const std::string& nm) const;
+        
+        /*!
+         *   @returns the file written by rank \p i, which is opened on the
+         *   first call.
+         */
+        hid_t _rank_file(unsigned int i);
+        
+        const libMesh::System& _sys;
+        
+        const std::string _nm;
+        
+        const MAST::HDF5RestartFile::AccessMode _mode;
+        
+        bool _if_collective;
+        
+        /*!
+         *   file of this rank. In collective mode, this is the shared file.
+         */
+        hid_t _file;
+        
+        /*!
+         *   files written by all ranks, which are opened for reading only
+         *   if the partitioning has changed.
+         */
+        std::vector<hid_t> _rank_files;
+        
+        /*!
+         *   first local dof
+         */
+        libMesh::dof_id_type _first_dof;
+        
+        /*!
+         *   keys of the local dofs
+         */
+        std::vector<uint64_t> _keys;
+        
+        /*!
+         *   files, offsets and number of entries read by this rank if the
+         *   partitioning has changed
+         */
+        std::vector<unsigned int> _read_files;
+        std::vector<hsize_t>      _read_first;
+        std::vector<hsize_t>      _read_n;
+        
+        /*!
+         *   rank that owns the dof of each entry read by this rank, or
+         *   \p invalid_processor_id if the system has no such dof.
+         */
+        std::vector<libMesh::processor_id_type> _read_owner;
+        
+        /*!
+         *   local indices of the dofs for the entries received from each
+         *   rank, in the order in which they are sent
+         */
+        std::map<libMesh::processor_id_type, std::vector<libMesh::dof_id_type>> _recv_index;
+        
+        /*!
+         *   flag if \p _init_redistribution() has been called
+         */
+        bool _redistribution_initialized;
+        
+        /*!
+         *   number of files the data was written to
+         */
+        unsigned int _n_files;
+        
+        /*!
+         *   flag if the file was written on the same partitioning. This is
+         *   evaluated on the first read.
+         */
+        int _same_partition;
+    };
+}
+
+
+#endif // __mast_hdf5_restart_file_h__
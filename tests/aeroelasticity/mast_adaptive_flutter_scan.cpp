@@ -0,0 +1,193 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// C++ includes
+#include <map>
+#include <vector>
+
+// Catch2 includes
+#include "catch.hpp"
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "aeroelasticity/flutter_solver_base.h"
+#include "aeroelasticity/flutter_solution_base.h"
+#include "aeroelasticity/flutter_root_base.h"
+
+
+namespace TEST {
+
+    /*!
+     *   flutter solution with prescribed damping of each root
+     */
+    class ScanSolution:
+    public MAST::FlutterSolutionBase {
+
+    public:
+
+        ScanSolution(const Real v, const std::vector<Real>& g):
+        MAST::FlutterSolutionBase() {
+
+            _ref_val = v;
+            for (unsigned int i=0; i<g.size(); i++) {
+
+                MAST::FlutterRootBase* r = new MAST::FlutterRootBase;
+                r->V   = v;
+                r->g   = g[i];
+                r->modal_participation = RealVectorX::Unit(g.size(), i);
+                _roots.push_back(r);
+            }
+        }
+
+        virtual void sort(const MAST::FlutterSolutionBase& sol) { }
+
+        virtual void print(std::ostream& output) { }
+    };
+
+
+    /*!
+     *   solver that scans a velocity grid for analytical damping curves
+     *   and counts the number of solutions
+     */
+    class ScanSolver:
+    public MAST::FlutterSolverBase {
+
+    public:
+
+        ScanSolver(): MAST::FlutterSolverBase(), n_evals(0) { }
+
+        virtual ~ScanSolver() {
+
+            std::map<Real, MAST::FlutterSolutionBase*>::iterator
+            it = sols.begin();
+            for ( ; it != sols.end(); it++)
+                delete it->second;
+        }
+
+        void scan(const std::vector<Real>& vals) {
+            _adaptive_scan(vals, sols);
+        }
+
+        /*!
+         *   @returns the interval of the first damping sign change of
+         *   \p root in the scan
+         */
+        std::pair<Real, Real> crossing(unsigned int root) const {
+
+            std::map<Real, MAST::FlutterSolutionBase*>::const_iterator
+            it  = sols.begin(),
+            nxt = sols.begin();
+
+            for (nxt++; nxt != sols.end(); it++, nxt++)
+                if ((it->second->get_root(root).g <= 0.) !=
+                    (nxt->second->get_root(root).g <= 0.))
+                    return std::make_pair(it->first, nxt->first);
+
+            return std::make_pair(0., 0.);
+        }
+
+        virtual void print_sorted_roots() { }
+
+        virtual void print_crossover_points() { }
+
+        std::map<Real, MAST::FlutterSolutionBase*> sols;
+
+        unsigned int n_evals;
+
+    protected:
+
+        virtual void _analyze_scan_point(const Real v) {
+
+            // root 0 goes unstable at V = 0.637, root 1 is always stable
+            std::vector<Real> g(2);
+            g[0] = 0.2 * (v - 0.637);
+            g[1] = -0.05 - 0.01 * v;
+
+            sols[v] = new TEST::ScanSolution(v, g);
+            n_evals++;
+        }
+    };
+}
+
+
+TEST_CASE("adaptive_flutter_scan",
+          "[aeroelasticity],[flutter]")
+{
+    const unsigned int n_divs = 64;
+
+    std::vector<Real> vals(n_divs+1);
+    for (unsigned int i=0; i<=n_divs; i++)
+        vals[i] = (1.*i)/n_divs;
+
+    // a scan without coarsening levels evaluates the full uniform grid
+    TEST::ScanSolver dense;
+    dense.set_adaptive_scan(true, 0);
+    dense.scan(vals);
+
+    REQUIRE( dense.n_evals == n_divs+1 );
+
+    const std::pair<Real, Real>
+    bracket = dense.crossing(0);
+    REQUIRE( bracket.first  <  0.637 );
+    REQUIRE( bracket.second >= 0.637 );
+
+    SECTION("adaptive scan brackets the crossing with fewer evaluations")
+    {
+        TEST::ScanSolver adaptive;
+        adaptive.set_adaptive_scan(true, 3);
+        adaptive.scan(vals);
+
+        // the coarse grid has 9 points, and the crossing interval is
+        // bisected three times
+        REQUIRE( adaptive.n_evals == 12 );
+        REQUIRE( adaptive.n_evals < dense.n_evals );
+
+        const std::pair<Real, Real>
+        adaptive_bracket = adaptive.crossing(0);
+        REQUIRE( adaptive_bracket.first  == bracket.first );
+        REQUIRE( adaptive_bracket.second == bracket.second );
+
+        // the stable root does not cross
+        REQUIRE( adaptive.crossing(1).first  == 0. );
+        REQUIRE( adaptive.crossing(1).second == 0. );
+    }
+
+    SECTION("scan points are taken from the uniform grid in either direction")
+    {
+        // the scan may march from the upper to the lower limit, as in the
+        // UG solver
+        std::vector<Real> rvals(vals.rbegin(), vals.rend());
+
+        TEST::ScanSolver adaptive;
+        adaptive.set_adaptive_scan(true, 3);
+        adaptive.scan(rvals);
+
+        REQUIRE( adaptive.n_evals == 12 );
+
+        std::map<Real, MAST::FlutterSolutionBase*>::const_iterator
+        it = adaptive.sols.begin();
+        for ( ; it != adaptive.sols.end(); it++)
+            REQUIRE( dense.sols.count(it->first) == 1 );
+
+        const std::pair<Real, Real>
+        adaptive_bracket = adaptive.crossing(0);
+        REQUIRE( adaptive_bracket.first  == bracket.first );
+        REQUIRE( adaptive_bracket.second == bracket.second );
+    }
+}
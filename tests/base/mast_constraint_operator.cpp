@@ -0,0 +1,209 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <map>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/system.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/dense_matrix.h"
+#include "libmesh/dense_vector.h"
+#include "libmesh/elem.h"
+
+// MAST includes
+#include "base/constraint_operator.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+
+TEST_CASE("constraint_operator",
+          "[base][constraints]")
+{
+    libMesh::ReplicatedMesh mesh(p_global_init->comm());
+    libMesh::MeshTools::Generation::build_square(mesh, 4, 4,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+    
+    libMesh::EquationSystems eq_sys(mesh);
+    libMesh::System& sys = eq_sys.add_system<libMesh::System>("sys");
+    sys.add_variable("u", libMesh::FIRST, libMesh::LAGRANGE);
+    eq_sys.init();
+    
+    libMesh::DofMap& dof_map = sys.get_dof_map();
+    REQUIRE(sys.n_dofs() == 25);
+    
+    // a tie of dof 7 to two masters, a Dirichlet constraint on dof 3, and
+    // a tie of dof 20 to the constrained dof 7, which the operator
+    // resolves to the masters of dof 7.
+    libMesh::DofConstraintRow row_7, row_3, row_20;
+    row_7[1]   =  0.25;
+    row_7[12]  =  0.75;
+    row_20[7]  =  2.0;
+    row_20[5]  = -1.0;
+    dof_map.add_constraint_row( 7, row_7,  0., true);
+    dof_map.add_constraint_row( 3, row_3,  0., true);
+    dof_map.add_constraint_row(20, row_20, 0., true);
+    
+    MAST::ConstraintOperator constraints;
+    constraints.init(dof_map);
+    
+    REQUIRE(constraints.initialized());
+    REQUIRE(constraints.n_constrained_dofs() == 3);
+    REQUIRE(constraints.if_constrained_dof(20));
+    REQUIRE_FALSE(constraints.if_constrained_dof(12));
+    
+    SECTION("resolved constraint rows")
+    {
+        std::vector<libMesh::dof_id_type> dofs(1, 20);
+        MAST::ConstraintOperator::ElemOperator op;
+        constraints.init_elem_operator(dofs, op);
+        
+        REQUIRE(op.rows.size() == 1);
+        REQUIRE(op.dof_indices.size() == 4);
+        
+        std::map<libMesh::dof_id_type, Real> row;
+        for (unsigned int k=op.row_begin[0]; k<op.row_begin[1]; k++)
+            row[op.dof_indices[op.entries[k].first]] += op.entries[k].second;
+        
+        REQUIRE(row.size() == 3);
+        REQUIRE(row[1]  == Approx( 0.5));
+        REQUIRE(row[12] == Approx( 1.5));
+        REQUIRE(row[5]  == Approx(-1.0));
+    }
+    
+    SECTION("element operator matches libMesh constraint application")
+    {
+        libMesh::MeshBase::const_element_iterator
+        e_it   = mesh.active_local_elements_begin(),
+        e_end  = mesh.active_local_elements_end();
+        
+        unsigned int
+        n_constrained_elems = 0;
+        
+        for ( ; e_it != e_end; e_it++) {
+            
+            std::vector<libMesh::dof_id_type> dofs, dofs_ref;
+            dof_map.dof_indices(*e_it, dofs);
+            
+            const unsigned int n = (unsigned int)dofs.size();
+            
+            RealMatrixX m = RealMatrixX::Zero(n, n), m_c;
+            RealVectorX v = RealVectorX::Zero(n),    v_c;
+            
+            libMesh::DenseMatrix<Real> m_ref;
+            libMesh::DenseVector<Real> v_ref;
+            m_ref.resize(n, n);
+            v_ref.resize(n);
+            
+            for (unsigned int i=0; i<n; i++) {
+                v(i)     = 1. + i;
+                v_ref(i) = v(i);
+                for (unsigned int j=0; j<n; j++) {
+                    m(i, j)     = 1./(1. + i + j) + (i == j ? n : 0.);
+                    m_ref(i, j) = m(i, j);
+                }
+            }
+            
+            MAST::ConstraintOperator::ElemOperator op;
+            constraints.init_elem_operator(dofs, op);
+            
+            bool
+            if_constrained = false;
+            for (unsigned int i=0; i<n; i++)
+                if (dof_map.is_constrained_dof(dofs[i]))
+                    if_constrained = true;
+            
+            REQUIRE(op.empty() == !if_constrained);
+            if (!if_constrained) continue;
+            
+            n_constrained_elems++;
+            
+            op.constrain_matrix(m, m_c);
+            op.constrain_vector(v, v_c);
+            
+            dofs_ref = dofs;
+            dof_map.constrain_element_matrix_and_vector(m_ref, v_ref, dofs_ref);
+            
+            // the constrained quantities are compared by global dof, since
+            // the masters can be added in a different order. Chains of
+            // constraints are resolved by the operator, so the rows of
+            // constrained dofs are only compared with the resolved
+            // constraint equations.
+            std::map<std::pair<libMesh::dof_id_type, libMesh::dof_id_type>, Real>
+            mat_vals, mat_ref_vals;
+            std::map<libMesh::dof_id_type, Real>
+            vec_vals, vec_ref_vals;
+            
+            for (unsigned int i=0; i<op.dof_indices.size(); i++) {
+                vec_vals[op.dof_indices[i]] += v_c(i);
+                if (!dof_map.is_constrained_dof(op.dof_indices[i]))
+                    for (unsigned int j=0; j<op.dof_indices.size(); j++)
+                        mat_vals[std::make_pair(op.dof_indices[i], op.dof_indices[j])] += m_c(i, j);
+            }
+            
+            for (unsigned int i=0; i<dofs_ref.size(); i++) {
+                vec_ref_vals[dofs_ref[i]] += v_ref(i);
+                if (!dof_map.is_constrained_dof(dofs_ref[i]))
+                    for (unsigned int j=0; j<dofs_ref.size(); j++)
+                        mat_ref_vals[std::make_pair(dofs_ref[i], dofs_ref[j])] += m_ref(i, j);
+            }
+            
+            for (std::map<libMesh::dof_id_type, Real>::const_iterator
+                 it = vec_ref_vals.begin(); it != vec_ref_vals.end(); it++)
+                CHECK(vec_vals[it->first] == Approx(it->second).margin(1.e-12));
+            
+            for (std::map<std::pair<libMesh::dof_id_type, libMesh::dof_id_type>, Real>::const_iterator
+                 it = mat_ref_vals.begin(); it != mat_ref_vals.end(); it++)
+                CHECK(mat_vals[it->first] == Approx(it->second).margin(1.e-12));
+            
+            for (std::map<std::pair<libMesh::dof_id_type, libMesh::dof_id_type>, Real>::const_iterator
+                 it = mat_vals.begin(); it != mat_vals.end(); it++)
+                CHECK(mat_ref_vals[it->first] == Approx(it->second).margin(1.e-12));
+            
+            // rows of the constrained dofs contain the constraint equations
+            for (unsigned int r=0; r<op.rows.size(); r++) {
+                
+                const unsigned int s = op.rows[r];
+                
+                RealVectorX row = RealVectorX::Zero(op.dof_indices.size());
+                row(s) = 1.;
+                for (unsigned int k=op.row_begin[r]; k<op.row_begin[r+1]; k++)
+                    row(op.entries[k].first) -= op.entries[k].second;
+                
+                CHECK((m_c.row(s).transpose() - row).norm() == Approx(0.).margin(1.e-12));
+                CHECK(v_c(s) == 0.);
+            }
+        }
+        
+        // the constrained dofs are on the elements of the local partition
+        // on at least one processor
+        mesh.comm().sum(n_constrained_elems);
+        REQUIRE(n_constrained_elems > 0);
+    }
+}
@@ -0,0 +1,333 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <cmath>
+#include <vector>
+#include <memory>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/elem.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/sparse_matrix.h"
+#include "libmesh/petsc_matrix.h"
+#include "libmesh/dense_matrix.h"
+#include "libmesh/dense_vector.h"
+#include "libmesh/mesh_refinement.h"
+
+// MAST includes
+#include "base/element_scatter.h"
+#include "numerics/utility.h"
+
+// Test includes
+#include "catch.hpp"
+#include "base/mast_structural_plate_system.h"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   deterministic, nonsymmetric element vector and matrix of \p elem
+     */
+    inline void element_scatter_quantities(const libMesh::Elem& elem,
+                                           unsigned int n,
+                                           RealVectorX& vec,
+                                           RealMatrixX& mat) {
+
+        vec.setZero(n);
+        mat.setZero(n, n);
+
+        for (unsigned int i=0; i<n; i++) {
+            vec(i) = std::cos(1. + i + 0.3*elem.id());
+            for (unsigned int j=0; j<n; j++)
+                mat(i, j) = std::sin(1. + i + 2.*j + 0.7*elem.id()) + (i == j? 10.: 0.);
+        }
+    }
+
+    /*!
+     *   adds the element quantities of all local elements to \p R and \p J
+     *   through libMesh dense types and
+     *   \p DofMap::constrain_element_matrix_and_vector()
+     */
+    inline void assemble_reference(const libMesh::System& sys,
+                                   libMesh::NumericVector<Real>& R,
+                                   libMesh::SparseMatrix<Real>& J) {
+
+        const libMesh::DofMap& dof_map = sys.get_dof_map();
+
+        std::vector<libMesh::dof_id_type> dofs;
+        RealVectorX vec;
+        RealMatrixX mat;
+        DenseRealVector v;
+        DenseRealMatrix m;
+
+        for (const auto& elem: sys.get_mesh().active_local_element_ptr_range()) {
+
+            dof_map.dof_indices(elem, dofs);
+            element_scatter_quantities(*elem, dofs.size(), vec, mat);
+
+            MAST::copy(v, vec);
+            MAST::copy(m, mat);
+            dof_map.constrain_element_matrix_and_vector(m, v, dofs);
+
+            R.add_vector(v, dofs);
+            J.add_matrix(m, dofs);
+        }
+
+        R.close();
+        J.close();
+    }
+
+    /*!
+     *   adds the element quantities of all local elements to \p R and \p J
+     *   with \p scatter
+     */
+    inline void assemble_scatter(const libMesh::System& sys,
+                                 MAST::ElementScatter& scatter,
+                                 libMesh::NumericVector<Real>& R,
+                                 libMesh::SparseMatrix<Real>& J) {
+
+        const libMesh::DofMap& dof_map = sys.get_dof_map();
+
+        std::vector<libMesh::dof_id_type> dofs;
+        RealVectorX vec;
+        RealMatrixX mat;
+
+        scatter.init(dof_map, &R, &J);
+
+        for (const auto& elem: sys.get_mesh().active_local_element_ptr_range()) {
+
+            dof_map.dof_indices(elem, dofs);
+            element_scatter_quantities(*elem, dofs.size(), vec, mat);
+            scatter.add(*elem, dofs, vec, mat);
+        }
+
+        R.close();
+        J.close();
+    }
+
+    /*!
+     *   @returns the infinity norm of \p A - \p B
+     */
+    inline Real matrix_difference(libMesh::PetscMatrix<Real>& A,
+                                  libMesh::PetscMatrix<Real>& B) {
+
+        Mat D;
+        PetscReal nrm = 0.;
+
+        MatDuplicate(A.mat(), MAT_COPY_VALUES, &D);
+        MatAXPY(D, -1., B.mat(), DIFFERENT_NONZERO_PATTERN);
+        MatNorm(D, NORM_INFINITY, &nrm);
+        MatDestroy(&D);
+
+        return nrm;
+    }
+
+    /*!
+     *   @returns the infinity norm of \p a - \p b
+     */
+    inline Real vector_difference(const libMesh::NumericVector<Real>& a,
+                                  const libMesh::NumericVector<Real>& b) {
+
+        std::unique_ptr<libMesh::NumericVector<Real>> d = a.clone();
+        d->add(-1., b);
+        return d->linfty_norm();
+    }
+
+    /*!
+     *   vector and matrix with the layout and sparsity of \p sys
+     */
+    class ScatterTarget {
+    public:
+        std::unique_ptr<libMesh::NumericVector<Real>> R;
+        std::unique_ptr<libMesh::SparseMatrix<Real>>  J;
+
+        ScatterTarget(libMesh::System& sys):
+        R(sys.solution->zero_clone()),
+        J(libMesh::SparseMatrix<Real>::build(sys.comm())) {
+
+            J->attach_dof_map(sys.get_dof_map());
+            J->init();
+            J->zero();
+        }
+
+        libMesh::PetscMatrix<Real>& petsc_J() {
+            return dynamic_cast<libMesh::PetscMatrix<Real>&>(*J);
+        }
+    };
+}
+
+
+
+TEST_CASE("element_scatter",
+          "[base][element_scatter]")
+{
+    TEST::TestStructuralPlateSystem plate(4);
+    MAST::NonlinearSystem& sys = plate.system;
+
+    // refining one element creates hanging node constraints, which couple
+    // dofs, in addition to the Dirichlet constraints on the edges.
+    bool
+    if_hanging_nodes = GENERATE(false, true);
+
+    if (if_hanging_nodes) {
+
+        libMesh::MeshRefinement refinement(plate.mesh);
+        libMesh::Elem* elem = plate.mesh.query_elem_ptr(5);
+        if (elem && elem->active())
+            elem->set_refinement_flag(libMesh::Elem::REFINE);
+        refinement.refine_elements();
+        plate.equation_systems.reinit();
+    }
+
+    const libMesh::DofMap& dof_map = sys.get_dof_map();
+    REQUIRE(dof_map.n_constrained_dofs() > 0);
+
+    TEST::ScatterTarget ref(sys);
+    TEST::assemble_reference(sys, *ref.R, *ref.J);
+
+    const Real
+    tol = 1.e-12 * ref.petsc_J().linfty_norm();
+
+    SECTION("Direct and constrained elements match the libMesh constraint application")
+    {
+        const bool
+        static_constraints = GENERATE(true, false);
+
+        MAST::ElementScatter scatter;
+        scatter.set_static_constraints(static_constraints);
+
+        TEST::ScatterTarget s(sys);
+        TEST::assemble_scatter(sys, scatter, *s.R, *s.J);
+
+        // the free interior elements skip the constraint application
+        unsigned int
+        n_constrained = scatter.n_constrained_elems(),
+        n_direct      = scatter.n_direct_elems();
+        sys.comm().sum(n_constrained);
+        sys.comm().sum(n_direct);
+        REQUIRE(n_constrained > 0);
+        REQUIRE(n_direct > 0);
+
+        REQUIRE(TEST::matrix_difference(s.petsc_J(), ref.petsc_J()) <= tol);
+        REQUIRE(TEST::vector_difference(*s.R, *ref.R) <= tol);
+
+        // a second assembly reuses the stored element status and
+        // constraint operators
+        s.R->zero();
+        s.J->zero();
+        TEST::assemble_scatter(sys, scatter, *s.R, *s.J);
+
+        REQUIRE(TEST::matrix_difference(s.petsc_J(), ref.petsc_J()) <= tol);
+        REQUIRE(TEST::vector_difference(*s.R, *ref.R) <= tol);
+    }
+
+    SECTION("Static constraints follow changes of the constraint coefficients")
+    {
+        MAST::ElementScatter scatter;
+
+        TEST::ScatterTarget s(sys);
+        TEST::assemble_scatter(sys, scatter, *s.R, *s.J);
+
+        REQUIRE(TEST::matrix_difference(s.petsc_J(), ref.petsc_J()) <= tol);
+
+        // the coefficients of the hanging node constraints are changed
+        // without a change in the number of dofs or of constrained dofs.
+        // The masters are not changed, so the sparsity is retained.
+        libMesh::DofMap& dm = sys.get_dof_map();
+
+        const libMesh::dof_id_type
+        n_constrained = dm.n_constrained_dofs();
+
+        std::vector<std::pair<libMesh::dof_id_type, libMesh::DofConstraintRow>> rows;
+
+        for (libMesh::DofConstraints::const_iterator it = dm.constraint_rows_begin();
+             it != dm.constraint_rows_end(); it++)
+            if (!it->second.empty()) {
+
+                rows.push_back(*it);
+                for (auto& m: rows.back().second)
+                    m.second *= 0.5;
+            }
+
+        unsigned int
+        n_rows = (unsigned int)rows.size();
+        sys.comm().sum(n_rows);
+        REQUIRE((n_rows > 0) == if_hanging_nodes);
+
+        for (unsigned int i=0; i<rows.size(); i++)
+            dm.add_constraint_row(rows[i].first, rows[i].second, 0., false);
+
+        REQUIRE(dm.n_constrained_dofs() == n_constrained);
+
+        TEST::ScatterTarget ref_new(sys);
+        TEST::assemble_reference(sys, *ref_new.R, *ref_new.J);
+
+        if (if_hanging_nodes)
+            REQUIRE(TEST::matrix_difference(ref_new.petsc_J(), ref.petsc_J()) > tol);
+
+        // the stored operators are discarded and the assembly uses the
+        // new coefficients
+        s.R->zero();
+        s.J->zero();
+        TEST::assemble_scatter(sys, scatter, *s.R, *s.J);
+
+        REQUIRE(TEST::matrix_difference(s.petsc_J(), ref_new.petsc_J()) <= tol);
+        REQUIRE(TEST::vector_difference(*s.R, *ref_new.R) <= tol);
+    }
+
+    SECTION("MatSetValuesBlocked with node blocks matches the scalar insertion")
+    {
+        // matrix with the block size of the six structural variables, for
+        // which the element matrix is permuted from the libMesh ordering
+        // of dofs by variable to the ordering by node blocks.
+        const PetscInt
+        bs       = 6,
+        n_local  = dof_map.n_local_dofs(),
+        n_global = dof_map.n_dofs();
+
+        REQUIRE(n_local % bs == 0);
+        REQUIRE(dof_map.first_dof() % bs == 0);
+
+        Mat mat;
+        MatCreate(sys.comm().get(), &mat);
+        MatSetSizes(mat, n_local, n_local, n_global, n_global);
+        MatSetType(mat, MATAIJ);
+        MatSetBlockSize(mat, bs);
+        MatSetUp(mat);
+        MatSetOption(mat, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+
+        {
+            libMesh::PetscMatrix<Real> J(mat, sys.comm());
+            std::unique_ptr<libMesh::NumericVector<Real>> R = sys.solution->zero_clone();
+
+            MAST::ElementScatter scatter;
+            TEST::assemble_scatter(sys, scatter, *R, J);
+
+            REQUIRE(TEST::matrix_difference(J, ref.petsc_J()) <= tol);
+            REQUIRE(TEST::vector_difference(*R, *ref.R) <= tol);
+        }
+
+        MatDestroy(&mat);
+    }
+}
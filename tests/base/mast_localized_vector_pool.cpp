@@ -0,0 +1,207 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <vector>
+#include <memory>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/mesh_refinement.h"
+
+// MAST includes
+#include "base/localized_vector_pool.h"
+
+// Test includes
+#include "catch.hpp"
+#include "base/mast_structural_plate_system.h"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   sets the solution of \p sys to a value that depends on the dof and
+     *   updates the current local solution
+     */
+    inline void set_pool_test_solution(libMesh::System& sys, Real scale) {
+
+        libMesh::NumericVector<Real>& sol = *sys.solution;
+
+        for (libMesh::dof_id_type i=sol.first_local_index(); i<sol.last_local_index(); i++)
+            sol.set(i, scale*(1. + 0.5*i));
+        sol.close();
+        sys.update();
+    }
+
+    /*!
+     *   checks that \p v has the values of the current local solution of
+     *   \p sys for the local dofs and the send list
+     */
+    inline void check_localized_values(const libMesh::System& sys,
+                                       const libMesh::NumericVector<Real>& v) {
+
+        const libMesh::NumericVector<Real>& sol = *sys.current_local_solution;
+
+        for (libMesh::dof_id_type i=sol.first_local_index(); i<sol.last_local_index(); i++)
+            REQUIRE(v(i) == sol(i));
+
+        for (const auto& i: sys.get_dof_map().get_send_list())
+            REQUIRE(v(i) == sol(i));
+    }
+}
+
+
+
+TEST_CASE("localized_vector_pool",
+          "[base][localized_vector_pool]")
+{
+    TEST::TestStructuralPlateSystem plate(4);
+    MAST::NonlinearSystem& sys = plate.system;
+
+    TEST::set_pool_test_solution(sys, 1.);
+
+    MAST::LocalizedVectorPool pool;
+
+    SECTION("Vectors are reused for the same system and role")
+    {
+        const libMesh::NumericVector<Real>&
+        v1 = pool.localize(sys, *sys.solution, "solution");
+
+        REQUIRE(&v1 != sys.solution.get());
+        REQUIRE(v1.type() == libMesh::GHOSTED);
+        TEST::check_localized_values(sys, v1);
+
+        // new values are copied into the same vector
+        TEST::set_pool_test_solution(sys, 2.);
+
+        const libMesh::NumericVector<Real>&
+        v2 = pool.localize(sys, *sys.solution, "solution");
+
+        REQUIRE(&v2 == &v1);
+        REQUIRE(pool.n_allocations() == 1);
+        TEST::check_localized_values(sys, v2);
+
+        // a different role uses a different vector
+        const libMesh::NumericVector<Real>&
+        v3 = pool.localize(sys, *sys.solution, "solution_sensitivity");
+
+        REQUIRE(&v3 != &v1);
+        REQUIRE(pool.n_vectors() == 2);
+        REQUIRE(pool.n_allocations() == 2);
+
+        // a serial copy is a different type and is reallocated
+        const libMesh::NumericVector<Real>&
+        v4 = pool.localize(sys, *sys.solution, "solution", libMesh::SERIAL);
+
+        REQUIRE(v4.type() == libMesh::SERIAL);
+        REQUIRE(pool.n_allocations() == 3);
+        for (libMesh::dof_id_type i=0; i<sys.n_dofs(); i++)
+            REQUIRE(v4(i) == Approx(2.*(1. + 0.5*i)));
+
+        // a released vector is deleted, and is reallocated if needed again
+        pool.release(sys, "solution_sensitivity");
+        REQUIRE(pool.n_vectors() == 1);
+        pool.localize(sys, *sys.solution, "solution_sensitivity");
+        REQUIRE(pool.n_vectors() == 2);
+        REQUIRE(pool.n_allocations() == 4);
+
+        pool.clear();
+        REQUIRE(pool.n_vectors() == 0);
+    }
+
+    SECTION("Vectors are reallocated when the dof distribution changes")
+    {
+        const libMesh::NumericVector<Real>&
+        v1 = pool.localize(sys, *sys.solution, "solution");
+        const libMesh::dof_id_type
+        n_dofs = v1.size();
+
+        REQUIRE(pool.n_allocations() == 1);
+
+        libMesh::MeshRefinement refinement(plate.mesh);
+        refinement.uniformly_refine(1);
+        plate.equation_systems.reinit();
+        REQUIRE(sys.n_dofs() > n_dofs);
+
+        TEST::set_pool_test_solution(sys, 3.);
+
+        const libMesh::NumericVector<Real>&
+        v2 = pool.localize(sys, *sys.solution, "solution");
+
+        REQUIRE(pool.n_allocations() == 2);
+        REQUIRE(v2.size() == sys.n_dofs());
+        TEST::check_localized_values(sys, v2);
+    }
+
+    SECTION("Ghosted vectors of the system are returned as views")
+    {
+        const libMesh::NumericVector<Real>&
+        v1 = pool.localize(sys, *sys.current_local_solution, "solution");
+
+        REQUIRE(&v1 == sys.current_local_solution.get());
+        REQUIRE(pool.n_views() == 1);
+        REQUIRE(pool.n_allocations() == 0);
+
+        // a ghosted vector added to the system uses the send list
+        libMesh::NumericVector<Real>&
+        ghosted = sys.add_vector("pool_test_ghosted", false, libMesh::GHOSTED);
+        ghosted = *sys.current_local_solution;
+        ghosted.close();
+
+        const libMesh::NumericVector<Real>&
+        v2 = pool.localize(sys, ghosted, "solution");
+
+        REQUIRE(&v2 == &ghosted);
+        REQUIRE(pool.n_views() == 2);
+
+        // views can be disabled
+        const libMesh::NumericVector<Real>&
+        v3 = pool.localize(sys, ghosted, "solution", libMesh::GHOSTED, false);
+
+        REQUIRE(&v3 != &ghosted);
+        REQUIRE(pool.n_views() == 2);
+        TEST::check_localized_values(sys, v3);
+
+        sys.remove_vector("pool_test_ghosted");
+    }
+
+    SECTION("Ghosted vectors with another ghost set are copied")
+    {
+        // same dof distribution as the system, but without ghosts
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        other = libMesh::NumericVector<Real>::build(sys.comm());
+
+        std::vector<libMesh::dof_id_type> no_ghosts;
+        other->init(sys.n_dofs(), sys.n_local_dofs(), no_ghosts, false, libMesh::GHOSTED);
+        *other = *sys.solution;
+        other->close();
+
+        const libMesh::NumericVector<Real>&
+        v1 = pool.localize(sys, *other, "solution");
+
+        REQUIRE(&v1 != other.get());
+        REQUIRE(pool.n_views() == 0);
+        REQUIRE(pool.n_allocations() == 1);
+        TEST::check_localized_values(sys, v1);
+    }
+}
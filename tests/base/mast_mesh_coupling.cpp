@@ -0,0 +1,123 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <set>
+#include <vector>
+#include <memory>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/elem.h"
+#include "libmesh/point_locator_tree.h"
+
+// MAST includes
+#include "mesh/mesh_coupling_base.h"
+
+// Test includes
+#include "catch.hpp"
+#include "base/mast_structural_plate_system.h"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   provides access to the master element search of
+     *   \p MAST::MeshCouplingBase
+     */
+    class MeshCouplingSearch: public MAST::MeshCouplingBase {
+    public:
+        MeshCouplingSearch(MAST::SystemInitialization& sys_init):
+        MAST::MeshCouplingBase(sys_init) { }
+
+        using MAST::MeshCouplingBase::_get_local_boundary_nodes;
+        using MAST::MeshCouplingBase::_find_master_elems;
+    };
+}
+
+
+
+TEST_CASE("mesh_coupling_master_search",
+          "[base][mesh_coupling]")
+{
+    TEST::TestStructuralPlateSystem plate(6);
+    libMesh::MeshBase& mesh = plate.mesh;
+
+    TEST::MeshCouplingSearch search(plate.structural_system);
+
+    // the search radius of the kd-tree is checked with tolerances below
+    // and above the element size of 1/6
+    const Real
+    tol = GENERATE(1.e-8, 0.05, 0.3);
+
+    // the master elements are the elements in the left half of the plate
+    std::vector<const libMesh::Elem*> master_elems;
+    std::set<const libMesh::Elem*>    master_set;
+
+    for (const auto& elem: mesh.active_element_ptr_range())
+        if (elem->centroid()(0) < 0.5) {
+
+            master_elems.push_back(elem);
+            master_set.insert(elem);
+        }
+
+    // the slave nodes are on the bottom and right edges of the plate,
+    // some of which are outside the master elements
+    std::vector<const libMesh::Node*> slave_nodes, nodes;
+    search._get_local_boundary_nodes(mesh, 0, slave_nodes);
+    search._get_local_boundary_nodes(mesh, 1, nodes);
+    slave_nodes.insert(slave_nodes.end(), nodes.begin(), nodes.end());
+
+    std::vector<std::vector<const libMesh::Elem*>> elems;
+    search._find_master_elems(master_elems, slave_nodes, tol, elems);
+
+    REQUIRE(elems.size() == slave_nodes.size());
+
+    // reference search over all elements, restricted to the masters
+    std::unique_ptr<libMesh::PointLocatorBase>
+    pt_locator(mesh.sub_point_locator());
+    libMesh::PointLocatorTree
+    &locator_tree = dynamic_cast<libMesh::PointLocatorTree&>(*pt_locator);
+
+    unsigned int
+    n_found = 0;
+
+    for (unsigned int i=0; i<slave_nodes.size(); i++) {
+
+        std::set<const libMesh::Elem*>
+        ref = locator_tree.perform_fuzzy_linear_search(*slave_nodes[i], nullptr, tol),
+        ref_masters,
+        found(elems[i].begin(), elems[i].end());
+
+        for (const libMesh::Elem* e: ref)
+            if (master_set.count(e))
+                ref_masters.insert(e);
+
+        // each element is reported once
+        CHECK(found.size() == elems[i].size());
+        CHECK(found == ref_masters);
+
+        n_found += (unsigned int)found.size();
+    }
+
+    mesh.comm().sum(n_found);
+    CHECK(n_found > 0);
+}
@@ -0,0 +1,98 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <vector>
+#include <memory>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/linear_solver.h"
+
+// MAST includes
+#include "base/nonlinear_system.h"
+#include "base/output_assembly_elem_operations.h"
+#include "elasticity/compliance_output.h"
+#include "elasticity/stress_output_base.h"
+
+// Test includes
+#include "catch.hpp"
+#include "base/mast_structural_plate_system.h"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+TEST_CASE("nonlinear_system_batched_adjoint",
+          "[nonlinear_system][adjoint]")
+{
+    TEST::TestStructuralPlateSystem plate(4);
+    MAST::NonlinearSystem& sys = plate.system;
+
+    sys.solve(plate.elem_ops, plate.assembly);
+
+    MAST::ComplianceOutput        compliance;
+    MAST::StressStrainOutputBase  stress;
+
+    compliance.set_participating_elements_to_all();
+    compliance.set_discipline_and_system(plate.discipline, plate.structural_system);
+    stress.set_participating_elements_to_all();
+    stress.set_aggregation_coefficients(2., 1., 2., 2.e8);
+    stress.set_discipline_and_system(plate.discipline, plate.structural_system);
+
+    std::vector<MAST::OutputAssemblyElemOperations*>
+    outputs = {&compliance, &stress};
+
+    const bool
+    reuse_pc = GENERATE(false, true);
+
+    sys.linear_solver->reuse_preconditioner(reuse_pc);
+
+    // adjoints of both outputs with one Jacobian and preconditioner
+    sys.adjoint_solve(*sys.solution, false, plate.elem_ops, outputs, plate.assembly);
+
+    // the preconditioner setting of the caller is restored
+    REQUIRE(sys.linear_solver->get_same_preconditioner() == reuse_pc);
+
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real>>> batched;
+    for (unsigned int i=0; i<outputs.size(); i++)
+        batched.push_back(std::unique_ptr<libMesh::NumericVector<Real>>
+                          (sys.get_adjoint_solution(i).clone().release()));
+
+    // adjoint of each output solved on its own
+    for (unsigned int i=0; i<outputs.size(); i++) {
+
+        sys.linear_solver->reuse_preconditioner(false);
+        sys.adjoint_solve(*sys.solution, false, plate.elem_ops, *outputs[i], plate.assembly);
+
+        libMesh::NumericVector<Real>& single = sys.get_adjoint_solution(0);
+
+        REQUIRE(single.linfty_norm() > 0.);
+
+        std::unique_ptr<libMesh::NumericVector<Real>> diff(single.clone().release());
+        diff->add(-1., *batched[i]);
+        diff->close();
+
+        CHECK(diff->linfty_norm() <= 1.e-6 * single.linfty_norm());
+    }
+
+    sys.linear_solver->reuse_preconditioner(false);
+    compliance.clear_discipline_and_system();
+    stress.clear_discipline_and_system();
+}
@@ -0,0 +1,111 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <vector>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/elem.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/petsc_matrix.h"
+#include "libmesh/petsc_nonlinear_solver.h"
+
+// MAST includes
+#include "base/nonlinear_system.h"
+#include "elasticity/structural_near_null_vector_space.h"
+
+// Test includes
+#include "catch.hpp"
+#include "base/mast_structural_plate_system.h"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+TEST_CASE("nonlinear_system_matrix_block_size",
+          "[nonlinear_system][block_size]")
+{
+    TEST::TestStructuralPlateSystem plate(4);
+    MAST::NonlinearSystem& sys = plate.system;
+    const libMesh::DofMap& dof_map = sys.get_dof_map();
+
+    SECTION("Structural system matrices use 6x6 node blocks")
+    {
+        REQUIRE(sys.matrix_block_size() == 6);
+
+        PetscInt bs = 0;
+        MatGetBlockSize(dynamic_cast<libMesh::PetscMatrix<Real>&>(*sys.matrix).mat(), &bs);
+        REQUIRE(bs == 6);
+
+        MatGetBlockSize(dynamic_cast<libMesh::PetscMatrix<Real>&>(*sys.matrix_A).mat(), &bs);
+        REQUIRE(bs == 6);
+
+        // dofs of each node are numbered contiguously, which libMesh
+        // returns in variable-major order for the element
+        std::vector<libMesh::dof_id_type> dofs;
+
+        for (const auto& elem: plate.mesh.active_local_element_ptr_range()) {
+
+            dof_map.dof_indices(elem, dofs);
+
+            const unsigned int n_nodes = (unsigned int)dofs.size() / 6;
+            REQUIRE(n_nodes == elem->n_nodes());
+
+            for (unsigned int k=0; k<n_nodes; k++) {
+
+                REQUIRE(dofs[k] % 6 == 0);
+                for (unsigned int v=1; v<6; v++)
+                    REQUIRE(dofs[v*n_nodes+k] == dofs[k] + v);
+            }
+        }
+    }
+
+    SECTION("Blocked matrices are reinitialized with the system")
+    {
+        plate.equation_systems.reinit();
+        REQUIRE(sys.matrix_block_size() == 6);
+
+        sys.solve(plate.elem_ops, plate.assembly);
+        REQUIRE(dynamic_cast<libMesh::PetscNonlinearSolver<Real>&>
+                (*sys.nonlinear_solver).get_converged_reason() > 0);
+    }
+
+    SECTION("Sensitivity solves attach the near-null space to the blocked matrix")
+    {
+        MAST::StructuralNearNullVectorSpace nsp;
+        sys.nonlinear_solver->nearnullspace_object = &nsp;
+
+        sys.solve(plate.elem_ops, plate.assembly);
+        sys.sensitivity_solve(*sys.solution, false,
+                              plate.elem_ops, plate.assembly, plate.thickness);
+
+        MatNullSpace msp = nullptr;
+        MatGetNearNullSpace(dynamic_cast<libMesh::PetscMatrix<Real>&>(*sys.matrix).mat(), &msp);
+        REQUIRE(msp);
+
+        PetscBool       has_const = PETSC_TRUE;
+        PetscInt        n_vecs    = 0;
+        const Vec*      vecs      = nullptr;
+        MatNullSpaceGetVecs(msp, &has_const, &n_vecs, &vecs);
+        REQUIRE(n_vecs == 6);
+
+        sys.nonlinear_solver->nearnullspace_object = nullptr;
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <memory>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/petsc_nonlinear_solver.h"
+
+// MAST includes
+#include "base/nonlinear_system.h"
+
+// Test includes
+#include "catch.hpp"
+#include "test_helpers.h"
+#include "base/mast_structural_plate_system.h"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+TEST_CASE("nonlinear_system_jacobian_free_newton_krylov",
+          "[nonlinear_system][jfnk]")
+{
+    // von Karman strain with a pressure that gives a deflection of the
+    // order of the plate thickness, so that Newton needs several iterations.
+    TEST::TestStructuralPlateSystem plate(6, MAST::NONLINEAR_STRAIN);
+    MAST::NonlinearSystem& sys = plate.system;
+
+    sys.nonlinear_solver->relative_residual_tolerance = 1.e-10;
+    sys.nonlinear_solver->absolute_residual_tolerance = 1.e-12;
+    sys.nonlinear_solver->max_nonlinear_iterations    = 50;
+
+    libMesh::PetscNonlinearSolver<Real>& petsc_solver =
+    dynamic_cast<libMesh::PetscNonlinearSolver<Real>&>(*sys.nonlinear_solver);
+
+    // Newton with the assembled Jacobian
+    sys.solution->zero();
+    sys.solve(plate.elem_ops, plate.assembly);
+    REQUIRE(petsc_solver.get_converged_reason() > 0);
+
+    std::unique_ptr<libMesh::NumericVector<Real>>
+    sol_newton = sys.solution->clone();
+    REQUIRE(sol_newton->linfty_norm() > 0.5 * plate.thickness());
+
+    SECTION("JFNK with the assembled Jacobian as preconditioner converges to the Newton solution")
+    {
+        const unsigned int pc_lag = GENERATE(1, 3);
+
+        sys.set_jacobian_free_newton_krylov(true, pc_lag);
+        sys.solution->zero();
+        sys.solve(plate.elem_ops, plate.assembly);
+        sys.set_jacobian_free_newton_krylov(false);
+
+        REQUIRE(petsc_solver.get_converged_reason() > 0);
+
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        dsol = sys.solution->clone();
+        dsol->add(-1., *sol_newton);
+
+        REQUIRE(dsol->linfty_norm() <= 1.e-6 * sol_newton->linfty_norm());
+    }
+
+    SECTION("The assembled Newton solve is unchanged after a JFNK solve")
+    {
+        sys.set_jacobian_free_newton_krylov(true, 2);
+        sys.solution->zero();
+        sys.solve(plate.elem_ops, plate.assembly);
+        sys.set_jacobian_free_newton_krylov(false);
+
+        sys.solution->zero();
+        sys.solve(plate.elem_ops, plate.assembly);
+        REQUIRE(petsc_solver.get_converged_reason() > 0);
+
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        dsol = sys.solution->clone();
+        dsol->add(-1., *sol_newton);
+
+        REQUIRE(dsol->linfty_norm() <= 1.e-8 * sol_newton->linfty_norm());
+    }
+}
@@ -0,0 +1,173 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef __test__mast_structural_plate_system__
+#define __test__mast_structural_plate_system__
+
+// C++ includes
+#include <vector>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/numeric_vector.h"
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/parameter.h"
+#include "base/constant_field_function.h"
+#include "base/physics_discipline_base.h"
+#include "base/nonlinear_system.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "boundary_condition/dirichlet_boundary_condition.h"
+#include "property_cards/isotropic_material_property_card.h"
+#include "property_cards/solid_2d_section_element_property_card.h"
+#include "elasticity/structural_system_initialization.h"
+#include "elasticity/structural_nonlinear_assembly.h"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+namespace TEST {
+
+    /**
+     * Storage class for a unit square mesh of QUAD4 elements with the
+     * boundary ids 0 to 3 created by the libMesh mesh generation.
+     */
+    class TestMeshUnitSquare {
+    public:
+        libMesh::ReplicatedMesh mesh;
+
+        TestMeshUnitSquare(unsigned int n_divs):
+        mesh(p_global_init->comm()) {
+            libMesh::MeshTools::Generation::build_square(mesh, n_divs, n_divs,
+                                                         0., 1., 0., 1.,
+                                                         libMesh::QUAD4);
+        }
+    };
+
+
+    /**
+     * Square plate of QUAD4 elements clamped on all four edges and loaded by a
+     * uniform surface pressure. This is used by tests that need a complete
+     * structural system with assembly, boundary conditions and a well-posed
+     * solve, as opposed to the single element tests.
+     */
+    class TestStructuralPlateSystem: public TEST::TestMeshUnitSquare {
+    public:
+        // Material, section and load parameters.
+        MAST::Parameter E;
+        MAST::Parameter nu;
+        MAST::Parameter rho;
+        MAST::Parameter thickness;
+        MAST::Parameter offset;
+        MAST::Parameter kappa;
+        MAST::Parameter pressure;
+        // Field functions to distribute parameters throughout model.
+        MAST::ConstantFieldFunction E_f;
+        MAST::ConstantFieldFunction nu_f;
+        MAST::ConstantFieldFunction rho_f;
+        MAST::ConstantFieldFunction thickness_f;
+        MAST::ConstantFieldFunction offset_f;
+        MAST::ConstantFieldFunction kappa_f;
+        MAST::ConstantFieldFunction pressure_f;
+        // Material and property cards.
+        MAST::IsotropicMaterialPropertyCard material;
+        MAST::Solid2DSectionElementPropertyCard section;
+        // Loads and boundary conditions.
+        MAST::BoundaryConditionBase surface_pressure;
+        MAST::DirichletBoundaryCondition clamped_edges[4];
+        // Data associated with finite element system/assembly and discipline.
+        libMesh::EquationSystems equation_systems;
+        MAST::NonlinearSystem& system;
+        libMesh::FEType fetype;
+        MAST::StructuralSystemInitialization structural_system;
+        MAST::PhysicsDisciplineBase discipline;
+        MAST::NonlinearImplicitAssembly assembly;
+        MAST::StructuralNonlinearAssemblyElemOperations elem_ops;
+
+        /**
+         * @param n_divs  number of elements along each edge of the unit plate
+         * @param strain  strain type used by the section property card
+         */
+        TestStructuralPlateSystem(unsigned int n_divs,
+                                  MAST::StrainType strain = MAST::LINEAR_STRAIN):
+        TestMeshUnitSquare(n_divs),
+        E("E_param", 72.0e9),
+        nu("nu_param", 0.33),
+        rho("rho_param", 2700.),
+        thickness("th_param", 0.01),
+        offset("off_param", 0.),
+        kappa("kappa_param", 5.0/6.0),
+        pressure("p_param", 5.e4),
+        E_f("E", E),
+        nu_f("nu", nu),
+        rho_f("rho", rho),
+        thickness_f("h", thickness),
+        offset_f("off", offset),
+        kappa_f("kappa", kappa),
+        pressure_f("pressure", pressure),
+        surface_pressure(MAST::SURFACE_PRESSURE),
+        equation_systems(mesh),
+        system(equation_systems.add_system<MAST::NonlinearSystem>("structural")),
+        fetype(libMesh::FIRST, libMesh::LAGRANGE),
+        structural_system(system, system.name(), fetype),
+        discipline(equation_systems)
+        {
+            // Configure material and section property cards.
+            material.add(E_f);
+            material.add(nu_f);
+            material.add(rho_f);
+
+            section.add(thickness_f);
+            section.add(offset_f);
+            section.add(kappa_f);
+            section.set_strain(strain);
+            section.set_material(material);
+            discipline.set_property_for_subdomain(0, section);
+
+            // Uniform pressure on the plate surface.
+            surface_pressure.add(pressure_f);
+            discipline.add_volume_load(0, surface_pressure);
+
+            // Clamp all displacements and rotations on the four edges.
+            std::vector<unsigned int> vars = {0, 1, 2, 3, 4, 5};
+            for (unsigned int i=0; i<4; i++) {
+                clamped_edges[i].init(i, vars);
+                discipline.add_dirichlet_bc(i, clamped_edges[i]);
+            }
+            discipline.init_system_dirichlet_bc(system);
+
+            // Setup finite element system and assembly.
+            equation_systems.init();
+            assembly.set_discipline_and_system(discipline, structural_system);
+            elem_ops.set_discipline_and_system(discipline, structural_system);
+
+            system.solution->zero();
+        }
+
+        ~TestStructuralPlateSystem() {
+            elem_ops.clear_discipline_and_system();
+            assembly.clear_discipline_and_system();
+        }
+    };
+} // TEST namespace
+
+#endif // __test__mast_structural_plate_system__
@@ -0,0 +1,188 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <vector>
+#include <memory>
+
+// Catch2 includes
+#include "catch.hpp"
+
+// MAST includes
+#include "base/parameter.h"
+#include "base/constant_field_function.h"
+#include "elasticity/piston_theory_boundary_condition.h"
+
+
+namespace TEST {
+
+    /*!
+     *   field function  v = a + b x  used for a flow property that varies
+     *   over the element
+     */
+    class LinearFieldFunction:
+    public MAST::FieldFunction<Real> {
+    public:
+        LinearFieldFunction(const std::string& nm, Real a, Real b):
+        MAST::FieldFunction<Real>(nm), _a(a), _b(b) { }
+
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 Real& v) const {
+            v = _a + _b * p(0);
+        }
+
+    protected:
+        Real _a, _b;
+    };
+
+
+    /*!
+     *   compares \p MAST::PistonTheoryBoundaryCondition::pressure() at the
+     *   points \p pts with the pointwise pressure function, and its
+     *   derivatives with central differences.
+     */
+    inline void
+    check_piston_theory_pressure(const MAST::PistonTheoryBoundaryCondition& bc,
+                                 const std::vector<libMesh::Point>& pts) {
+
+        const unsigned int
+        n = (unsigned int)pts.size();
+
+        RealVectorX
+        dwdx = RealVectorX::LinSpaced(n, -0.05, 0.08),
+        dwdt = RealVectorX::LinSpaced(n, 0.3, -0.2),
+        p,
+        dp_dx,
+        dp_dxdot,
+        p_p,
+        p_m;
+
+        bc.pressure(pts, 0., dwdx, dwdt, p, &dp_dx, &dp_dxdot);
+
+        REQUIRE(p.size()        == n);
+        REQUIRE(dp_dx.size()    == n);
+        REQUIRE(dp_dxdot.size() == n);
+
+        // pointwise pressure with the same slope and velocity
+        for (unsigned int i=0; i<n; i++) {
+
+            MAST::Parameter
+            dwdx_p("dwdx", dwdx(i)),
+            dwdt_p("dwdt", dwdt(i));
+
+            MAST::ConstantFieldFunction
+            dwdx_f("dwdx", dwdx_p),
+            dwdt_f("dwdt", dwdt_p);
+
+            std::unique_ptr<MAST::FieldFunction<Real>>
+            p_f(bc.get_pressure_function(dwdx_f, dwdt_f));
+
+            Real
+            v = 0.;
+            (*p_f)(pts[i], 0., v);
+
+            REQUIRE(p(i) == Approx(v).epsilon(1.e-12));
+        }
+
+        // the pressure at each point depends only on the slope and
+        // velocity at that point, so that all points are perturbed together
+        const Real
+        h = 1.e-6;
+
+        const RealVectorX
+        dh = RealVectorX::Constant(n, h);
+
+        bc.pressure(pts, 0., dwdx + dh, dwdt, p_p);
+        bc.pressure(pts, 0., dwdx - dh, dwdt, p_m);
+
+        for (unsigned int i=0; i<n; i++)
+            REQUIRE(dp_dx(i) == Approx((p_p(i) - p_m(i))/(2.*h)).epsilon(1.e-6));
+
+        bc.pressure(pts, 0., dwdx, dwdt + dh, p_p);
+        bc.pressure(pts, 0., dwdx, dwdt - dh, p_m);
+
+        for (unsigned int i=0; i<n; i++)
+            REQUIRE(dp_dxdot(i) == Approx((p_p(i) - p_m(i))/(2.*h)).epsilon(1.e-6));
+    }
+}
+
+
+TEST_CASE("piston_theory_pressure",
+          "[piston_theory],[load]")
+{
+    MAST::Parameter
+    V    ("V",     600.),
+    mach ("mach",    3.),
+    rho  ("rho",   1.05),
+    gamma("gamma",  1.4);
+
+    MAST::ConstantFieldFunction
+    V_f    ("V",     V),
+    mach_f ("mach",  mach),
+    rho_f  ("rho",   rho),
+    gamma_f("gamma", gamma);
+
+    TEST::LinearFieldFunction
+    V_var_f("V", 600., 50.);
+
+    std::vector<libMesh::Point> pts;
+    for (unsigned int i=0; i<5; i++)
+        pts.push_back(libMesh::Point(0.1*i, 0.05*i, 0.));
+
+    const RealVectorX
+    vel = RealVectorX::Unit(3, 0);
+
+    for (unsigned int order=1; order<=3; order++) {
+
+        SECTION("constant flow, order " + std::to_string(order))
+        {
+            MAST::PistonTheoryBoundaryCondition bc(order, vel);
+            bc.add(V_f);
+            bc.add(mach_f);
+            bc.add(rho_f);
+            bc.add(gamma_f);
+
+            REQUIRE(bc.if_constant_flow());
+            TEST::check_piston_theory_pressure(bc, pts);
+
+            // an element without quadrature points on the surface
+            RealVectorX p, dp_dx, dp_dxdot;
+            bc.pressure(std::vector<libMesh::Point>(), 0.,
+                        RealVectorX(), RealVectorX(),
+                        p, &dp_dx, &dp_dxdot);
+
+            REQUIRE(p.size()        == 0);
+            REQUIRE(dp_dx.size()    == 0);
+            REQUIRE(dp_dxdot.size() == 0);
+        }
+
+        SECTION("variable flow, order " + std::to_string(order))
+        {
+            MAST::PistonTheoryBoundaryCondition bc(order, vel);
+            bc.add(V_var_f);
+            bc.add(mach_f);
+            bc.add(rho_f);
+            bc.add(gamma_f);
+
+            REQUIRE_FALSE(bc.if_constant_flow());
+            TEST::check_piston_theory_pressure(bc, pts);
+        }
+    }
+}
@@ -0,0 +1,151 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <cmath>
+#include <map>
+#include <memory>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/elem.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/numeric_vector.h"
+
+// MAST includes
+#include "base/parameter.h"
+#include "base/constant_field_function.h"
+#include "property_cards/isotropic_material_property_card.h"
+#include "property_cards/solid_2d_section_element_property_card.h"
+#include "elasticity/structural_element_2d.h"
+#include "elasticity/structural_system_initialization.h"
+#include "elasticity/structural_fluid_interaction_assembly.h"
+#include "elasticity/fluid_structure_assembly_elem_operations.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "base/nonlinear_system.h"
+#include "mesh/geom_elem.h"
+
+// Test includes
+#include "catch.hpp"
+#include "test_helpers.h"
+#include "element/structural/2D/mast_structural_element_2d.h"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   deterministic value of the \p j-th basis vector at global dof \p i
+     */
+    inline Real reduced_basis_value(libMesh::dof_id_type i, unsigned int j) {
+        return std::sin(1.3*(i+1)*(j+1)) + 0.1*(j+1);
+    }
+}
+
+
+TEST_CASE("structural_fluid_interaction_reduced_quantities",
+          "[2D],[structural],[fsi]")
+{
+    RealMatrixX coords = RealMatrixX::Zero(3,4);
+    coords << -1.0,  1.0, 1.0, -1.0,
+              -1.0, -1.0, 1.0,  1.0,
+               0.0,  0.0, 0.0,  0.0;
+    TEST::TestStructuralSingleElement2D test_elem(libMesh::QUAD4, coords);
+
+    test_elem.section.set_strain(MAST::LINEAR_STRAIN);
+    test_elem.section.set_bending_model(MAST::MINDLIN);
+    test_elem.section.set_diagonal_mass_matrix(false);
+
+    MAST::NonlinearSystem& sys = test_elem.system;
+    const unsigned int n_basis = 3;
+
+    // create the basis vectors, each processor setting its own rows
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real>>> basis_ptrs(n_basis);
+    std::vector<libMesh::NumericVector<Real>*> basis(n_basis);
+    for (unsigned int j=0; j<n_basis; j++) {
+
+        basis_ptrs[j] = sys.solution->zero_clone();
+        basis[j] = basis_ptrs[j].get();
+        for (libMesh::dof_id_type i=basis[j]->first_local_index();
+             i<basis[j]->last_local_index(); i++)
+            basis[j]->set(i, TEST::reduced_basis_value(i, j));
+        basis[j]->close();
+    }
+
+    MAST::FluidStructureAssemblyElemOperations elem_ops;
+    MAST::StructuralFluidInteractionAssembly fsi_assembly;
+    fsi_assembly.set_discipline_and_system(test_elem.discipline, test_elem.structural_system);
+    fsi_assembly.set_elem_operation_object(elem_ops);
+
+    RealMatrixX
+    m_elem  = RealMatrixX::Zero(n_basis, n_basis),
+    k_elem  = RealMatrixX::Zero(n_basis, n_basis),
+    m_proj  = RealMatrixX::Zero(n_basis, n_basis),
+    k_proj  = RealMatrixX::Zero(n_basis, n_basis);
+
+    std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
+
+    // opt-out: element matrices projected one at a time
+    qty_map[MAST::MASS]      = &m_elem;
+    qty_map[MAST::STIFFNESS] = &k_elem;
+    fsi_assembly.set_project_assembled_quantities(false);
+    fsi_assembly.assemble_reduced_order_quantity(basis, qty_map);
+
+    // default: global matrices assembled and projected
+    qty_map[MAST::MASS]      = &m_proj;
+    qty_map[MAST::STIFFNESS] = &k_proj;
+    fsi_assembly.set_project_assembled_quantities(true);
+    fsi_assembly.assemble_reduced_order_quantity(basis, qty_map);
+
+    fsi_assembly.clear_elem_operation_object();
+    fsi_assembly.clear_discipline_and_system();
+
+    SECTION("Element path matches the basis projection of the element matrices")
+    {
+        RealMatrixX phi = RealMatrixX::Zero(test_elem.n_dofs, n_basis);
+        for (uint i=0; i<test_elem.n_dofs; i++)
+            for (uint j=0; j<n_basis; j++)
+                phi(i,j) = TEST::reduced_basis_value(test_elem.dof_indices[i], j);
+
+        test_elem.update_residual_and_jacobian0();
+        test_elem.update_inertial_residual_and_jacobian0();
+
+        const RealMatrixX
+        k_ref = phi.transpose() * test_elem.jacobian0 * phi,
+        m_ref = phi.transpose() * test_elem.jacobian_xddot0 * phi;
+
+        REQUIRE_THAT(TEST::eigen_matrix_to_std_vector(k_elem),
+                     Catch::Approx<double>(TEST::eigen_matrix_to_std_vector(k_ref)));
+        REQUIRE_THAT(TEST::eigen_matrix_to_std_vector(m_elem),
+                     Catch::Approx<double>(TEST::eigen_matrix_to_std_vector(m_ref)));
+    }
+
+    SECTION("Projected and unprojected reduced matrices are identical")
+    {
+        const Real
+        k_margin = k_elem.array().abs().maxCoeff() * 1.e-10,
+        m_margin = m_elem.array().abs().maxCoeff() * 1.e-10;
+
+        REQUIRE_THAT(TEST::eigen_matrix_to_std_vector(k_proj),
+                     Catch::Approx<double>(TEST::eigen_matrix_to_std_vector(k_elem)).margin(k_margin));
+        REQUIRE_THAT(TEST::eigen_matrix_to_std_vector(m_proj),
+                     Catch::Approx<double>(TEST::eigen_matrix_to_std_vector(m_elem)).margin(m_margin));
+    }
+}
@@ -0,0 +1,196 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// Catch2 includes
+#include "catch.hpp"
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "fluid/gas_property.h"
+#include "fluid/primitive_fluid_solution.h"
+#include "fluid/fluid_flux_kernels.h"
+
+// Custom includes
+#include "test_helpers.h"
+
+
+/**
+ * Euler advection flux in direction \p d for conservative variables \p U.
+ */
+RealVectorX euler_flux(const unsigned int d,
+                       const RealVectorX& U,
+                       const MAST::GasProperty& gas) {
+    
+    const unsigned int
+    n1   = (unsigned int)U.size(),
+    dim  = n1-2;
+    
+    MAST::PrimitiveSolution sol;
+    sol.init(dim, U, gas.cp, gas.cv, false);
+    
+    const Real
+    u[3] = {sol.u1, sol.u2, sol.u3};
+    
+    RealVectorX F = RealVectorX::Zero(n1);
+    
+    F(0)      = sol.rho * u[d];
+    for (unsigned int j=0; j<dim; j++)
+        F(j+1) = sol.rho * u[j] * u[d];
+    F(d+1)   += sol.p;
+    F(n1-1)   = (sol.rho * sol.e_tot + sol.p) * u[d];
+    
+    return F;
+}
+
+
+/**
+ * Conservative variables for a state with density 1.2, velocity
+ * components (137, 174, 211) and temperature 300.
+ */
+RealVectorX conservative_state(const unsigned int dim,
+                               const MAST::GasProperty& gas) {
+    
+    const Real
+    rho   = 1.2,
+    T     = 300.,
+    u[3]  = {137., 174., 211.};
+    
+    RealVectorX U = RealVectorX::Zero(dim+2);
+    
+    Real k = 0.;
+    U(0) = rho;
+    for (unsigned int j=0; j<dim; j++) {
+        U(j+1) = rho * u[j];
+        k     += 0.5 * u[j] * u[j];
+    }
+    U(dim+1) = rho * (gas.cv * T + k);
+    
+    return U;
+}
+
+
+TEST_CASE("fluid_flux_kernels",
+          "[fluid],[kernel]")
+{
+    const unsigned int dim = GENERATE(1, 2, 3);
+    const unsigned int n1  = dim+2;
+    
+    MAST::GasProperty gas;
+    gas.cp    = 1003.6;
+    gas.cv    = 716.9;
+    gas.R     = gas.cp - gas.cv;
+    gas.gamma = gas.cp / gas.cv;
+    
+    std::unique_ptr<MAST::FluidFluxKernelBase>
+    kernel(MAST::build_fluid_flux_kernel(dim, gas));
+    
+    REQUIRE( kernel->dim() == dim );
+    
+    const RealVectorX U = conservative_state(dim, gas);
+    
+    MAST::PrimitiveSolution sol;
+    sol.init(dim, U, gas.cp, gas.cv, false);
+    
+    RealMatrixX A;
+    
+    SECTION("flux Jacobian satisfies the homogeneity of the Euler flux")
+    {
+        for (unsigned int d=0; d<dim; d++) {
+            
+            kernel->advection_flux_jacobian(d, sol, A);
+            
+            REQUIRE( A.rows() == n1 );
+            REQUIRE( A.cols() == n1 );
+            
+            std::vector<double> test =
+            TEST::eigen_matrix_to_std_vector(A * U);
+            std::vector<double> truth =
+            TEST::eigen_matrix_to_std_vector(euler_flux(d, U, gas));
+            
+            REQUIRE_THAT( test, Catch::Approx<double>(truth) );
+        }
+    }
+    
+    SECTION("flux Jacobian matches finite difference of the flux")
+    {
+        RealMatrixX A_fd = RealMatrixX::Zero(n1, n1);
+        
+        for (unsigned int d=0; d<dim; d++) {
+            
+            kernel->advection_flux_jacobian(d, sol, A);
+            
+            for (unsigned int c=0; c<n1; c++) {
+                
+                const Real h = 1.e-6 * std::fabs(U(c));
+                RealVectorX Up = U, Um = U;
+                Up(c) += h;
+                Um(c) -= h;
+                A_fd.col(c) = (euler_flux(d, Up, gas) - euler_flux(d, Um, gas))/(2.*h);
+            }
+            
+            REQUIRE( (A - A_fd).norm() <= 1.e-6 * A.norm() );
+        }
+    }
+    
+    SECTION("flux Jacobian sensitivity matches finite difference of the Jacobian")
+    {
+        std::vector<RealMatrixX> jac(n1);
+        
+        RealMatrixX Ap, Am;
+        MAST::PrimitiveSolution sol_p, sol_m;
+        
+        for (unsigned int d=0; d<dim; d++) {
+            
+            kernel->advection_flux_jacobian_sensitivity_for_conservative_variable
+            (d, sol, jac);
+            
+            for (unsigned int c=0; c<n1; c++) {
+                
+                const Real h = 1.e-6 * std::fabs(U(c));
+                RealVectorX Up = U, Um = U;
+                Up(c) += h;
+                Um(c) -= h;
+                sol_p.init(dim, Up, gas.cp, gas.cv, false);
+                sol_m.init(dim, Um, gas.cp, gas.cv, false);
+                kernel->advection_flux_jacobian(d, sol_p, Ap);
+                kernel->advection_flux_jacobian(d, sol_m, Am);
+                
+                const RealMatrixX dA_fd = (Ap - Am)/(2.*h);
+                
+                REQUIRE( jac[c].rows() == n1 );
+                REQUIRE( (jac[c] - dA_fd).norm() <= 1.e-5 * (dA_fd.norm() + 1.) );
+            }
+        }
+    }
+    
+    SECTION("conservative and primitive variable Jacobians are inverses")
+    {
+        RealMatrixX dcons_dprim, dprim_dcons;
+        
+        kernel->conservative_variable_jacobian(sol, dcons_dprim, dprim_dcons);
+        
+        std::vector<double> test =
+        TEST::eigen_matrix_to_std_vector(dcons_dprim * dprim_dcons);
+        std::vector<double> truth =
+        TEST::eigen_matrix_to_std_vector(RealMatrixX::Identity(n1, n1));
+        
+        REQUIRE_THAT( test, Catch::Approx<double>(truth).margin(1.e-10) );
+    }
+}
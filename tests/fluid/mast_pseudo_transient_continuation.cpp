@@ -0,0 +1,79 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// Catch2 includes
+#include "catch.hpp"
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "fluid/conservative_fluid_transient_assembly.h"
+
+
+TEST_CASE("pseudo_transient_continuation_cfl",
+          "[fluid],[transient]")
+{
+    MAST::ConservativeFluidTransientAssemblyElemOperations elem_ops;
+    
+    // initial, maximum and minimum CFL numbers
+    elem_ops.set_pseudo_transient_continuation(true, 10., 1.e3, 0.5);
+    REQUIRE( elem_ops.cfl() == Approx(10.) );
+    
+    SECTION("CFL grows with the residual reduction up to the maximum")
+    {
+        // the first residual only initializes the controller
+        REQUIRE( elem_ops.update_cfl(1.) );
+        REQUIRE( elem_ops.cfl() == Approx(10.) );
+        
+        REQUIRE( elem_ops.update_cfl(0.5) );
+        REQUIRE( elem_ops.cfl() == Approx(20.) );
+        
+        REQUIRE( elem_ops.update_cfl(0.005) );
+        REQUIRE( elem_ops.cfl() == Approx(1.e3) );
+    }
+    
+    SECTION("failed steps are rejected and reduce the CFL below its initial value")
+    {
+        REQUIRE( elem_ops.update_cfl(1.) );
+        
+        // a failed Newton solve
+        REQUIRE_FALSE( elem_ops.update_cfl(0.9, false) );
+        REQUIRE( elem_ops.cfl() == Approx(1.) );
+        
+        // a large growth in the residual
+        REQUIRE_FALSE( elem_ops.update_cfl(20.) );
+        REQUIRE( elem_ops.cfl() == Approx(0.5) );
+        
+        // at the minimum CFL the step is accepted, since the CFL cannot
+        // be reduced any further
+        REQUIRE( elem_ops.update_cfl(20.) );
+        REQUIRE( elem_ops.cfl() == Approx(0.5) );
+    }
+    
+    SECTION("rejected steps do not change the reference residual")
+    {
+        REQUIRE( elem_ops.update_cfl(1.) );
+        REQUIRE_FALSE( elem_ops.update_cfl(100.) );
+        REQUIRE( elem_ops.cfl() == Approx(1.) );
+        
+        // the repeated step is compared to the last accepted residual
+        REQUIRE( elem_ops.update_cfl(0.5) );
+        REQUIRE( elem_ops.cfl() == Approx(2.) );
+    }
+}
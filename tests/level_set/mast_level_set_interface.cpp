@@ -0,0 +1,169 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <cmath>
+#include <vector>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/point.h"
+
+// MAST includes
+#include "level_set/level_set_interface.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   distance from \p p to the segment between \p a and \p b
+     */
+    inline Real
+    segment_distance(const libMesh::Point& p,
+                     const libMesh::Point& a,
+                     const libMesh::Point& b) {
+
+        const libMesh::Point d = b - a;
+        Real t = ((p - a) * d) / d.norm_sq();
+        t = std::max(0., std::min(1., t));
+        return (p - (a + t * d)).norm();
+    }
+}
+
+
+TEST_CASE("level_set_interface",
+          "[level_set]")
+{
+    const Real
+    pi  = std::acos(-1.);
+
+    const unsigned int
+    n_seg  = 400;
+
+    // probe points distributed inside and outside of the interface
+    std::vector<libMesh::Point> probes;
+    for (unsigned int i=0; i<50; i++) {
+        const Real
+        r  = 0.1 + 2. * i / 50.,
+        th = 0.37 * i * i + 0.11;
+        probes.push_back(libMesh::Point(r*std::cos(th), r*std::sin(th), 0.));
+    }
+
+    SECTION("closest points on a polygonal circle")
+    {
+        MAST::LevelSetInterface interface(p_global_init->comm(), 2);
+
+        libMesh::Point x[2];
+        std::vector<libMesh::Point> verts(n_seg);
+        for (unsigned int i=0; i<n_seg; i++)
+            verts[i] = libMesh::Point(std::cos(2.*pi*i/n_seg),
+                                      std::sin(2.*pi*i/n_seg),
+                                      0.);
+
+        for (unsigned int i=0; i<n_seg; i++) {
+            x[0] = verts[i];
+            x[1] = verts[(i+1)%n_seg];
+            interface.add_facet(x);
+        }
+        interface.build_tree();
+
+        REQUIRE(interface.n_facets() == n_seg);
+
+        std::vector<libMesh::Point> pts;
+        REQUIRE(interface.closest_points(probes, pts));
+        REQUIRE(pts.size() == probes.size());
+
+        libMesh::Point pt;
+        for (unsigned int i=0; i<probes.size(); i++) {
+
+            // brute-force search over all segments
+            Real d = 1.e12;
+            for (unsigned int j=0; j<n_seg; j++)
+                d = std::min(d, TEST::segment_distance(probes[i],
+                                                       verts[j],
+                                                       verts[(j+1)%n_seg]));
+
+            REQUIRE(interface.closest_point(probes[i], pt));
+            CHECK((probes[i] - pt).norm()      == Approx(d).epsilon(1.e-10));
+            CHECK((probes[i] - pts[i]).norm()  == Approx(d).epsilon(1.e-10));
+            CHECK(pt.norm() == Approx(1.).epsilon(1.e-3));
+        }
+    }
+
+    SECTION("closest points on a triangulated plane")
+    {
+        MAST::LevelSetInterface interface(p_global_init->comm(), 3);
+
+        // unit square at z = 0 split into 2 x n x n triangles
+        const unsigned int n = 8;
+        const Real         h = 1./n;
+        libMesh::Point x[3];
+        for (unsigned int i=0; i<n; i++)
+            for (unsigned int j=0; j<n; j++) {
+                x[0] = libMesh::Point(i*h,     j*h,     0.);
+                x[1] = libMesh::Point((i+1)*h, j*h,     0.);
+                x[2] = libMesh::Point((i+1)*h, (j+1)*h, 0.);
+                interface.add_facet(x);
+                x[1] = libMesh::Point(i*h,     (j+1)*h, 0.);
+                interface.add_facet(x);
+            }
+        interface.build_tree();
+
+        REQUIRE(interface.n_facets() == 2*n*n);
+
+        libMesh::Point pt;
+        for (unsigned int i=0; i<probes.size(); i++) {
+
+            libMesh::Point p(0.5 + 0.3*probes[i](0),
+                             0.5 + 0.3*probes[i](1),
+                             probes[i](0) - probes[i](1));
+
+            // the closest point on the square is the clamped projection
+            libMesh::Point exact(std::max(0., std::min(1., p(0))),
+                                 std::max(0., std::min(1., p(1))),
+                                 0.);
+
+            REQUIRE(interface.closest_point(p, pt));
+            CHECK(pt(0) == Approx(exact(0)).margin(1.e-12));
+            CHECK(pt(1) == Approx(exact(1)).margin(1.e-12));
+            CHECK(pt(2) == Approx(0.).margin(1.e-12));
+        }
+    }
+
+    SECTION("empty interface reports that no closest point exists")
+    {
+        MAST::LevelSetInterface interface(p_global_init->comm(), 2);
+        interface.build_tree();
+
+        libMesh::Point pt;
+        REQUIRE_FALSE(interface.closest_point(probes[0], pt));
+        CHECK((pt - probes[0]).norm() == Approx(0.).margin(1.e-14));
+
+        std::vector<libMesh::Point> pts;
+        REQUIRE_FALSE(interface.closest_points(probes, pts));
+        REQUIRE(pts.size() == probes.size());
+    }
+}
@@ -0,0 +1,300 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <cmath>
+#include <memory>
+#include <array>
+#include <map>
+#include <set>
+#include <vector>
+#include <algorithm>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/elem.h"
+
+// MAST includes
+#include "base/field_function_base.h"
+#include "level_set/level_set_intersection.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   planar level set   phi = a0 x + a1 y + a2 z - c
+     */
+    class PlaneLevelSet:
+    public MAST::FieldFunction<Real> {
+    public:
+        PlaneLevelSet(Real a0, Real a1, Real a2, Real c):
+        MAST::FieldFunction<Real>("phi"),
+        _a0(a0), _a1(a1), _a2(a2), _c(c)
+        { }
+
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 Real& v) const {
+            v = _a0 * p(0) + _a1 * p(1) + _a2 * p(2) - _c;
+        }
+
+    protected:
+        Real _a0, _a1, _a2, _c;
+    };
+
+
+    /*!
+     *   intersects all elements of \p mesh with \p phi and returns the
+     *   volume on positive phi and the interface area. Also checks that
+     *   all sub-elements have a positive volume and fill the element.
+     */
+    inline void
+    intersect_mesh(const libMesh::MeshBase& mesh,
+                   const MAST::FieldFunction<Real>& phi,
+                   Real& volume,
+                   Real& area) {
+
+        volume = 0.;
+        area   = 0.;
+
+        for (const auto& elem : mesh.active_local_element_ptr_range()) {
+
+            MAST::LevelSetIntersection intersection;
+            intersection.init(phi, *elem, 0., mesh.max_elem_id(), mesh.max_node_id());
+
+            const std::vector<const libMesh::Elem*>
+            &pos = intersection.get_sub_elems_positive_phi(),
+            &neg = intersection.get_sub_elems_negative_phi();
+
+            Real
+            v_pos = 0.,
+            v_neg = 0.;
+
+            for (unsigned int i=0; i<pos.size(); i++) {
+                REQUIRE(pos[i]->volume() > 0.);
+                v_pos += pos[i]->volume();
+            }
+
+            for (unsigned int i=0; i<neg.size(); i++) {
+                REQUIRE(neg[i]->volume() > 0.);
+                v_neg += neg[i]->volume();
+            }
+
+            // the sub-elements on either side fill the element
+            CHECK(v_pos + v_neg == Approx(elem->volume()).epsilon(1.e-10));
+
+            volume += v_pos;
+
+            // the interface is counted from the sides of the sub-elements
+            // on positive phi, so that an interface on the side shared by
+            // two elements is counted once
+            for (unsigned int i=0; i<pos.size(); i++)
+                if (intersection.has_side_on_interface(*pos[i])) {
+
+                    std::unique_ptr<const libMesh::Elem>
+                    s(pos[i]->side_ptr(intersection.get_side_on_interface(*pos[i])).release());
+                    area += s->volume();
+                }
+        }
+
+        mesh.comm().sum(volume);
+        mesh.comm().sum(area);
+    }
+}
+
+
+
+TEST_CASE("level_set_intersection_3d",
+          "[level_set]")
+{
+    const libMesh::ElemType
+    types[2] = {libMesh::HEX8, libMesh::TET4};
+
+    for (unsigned int i=0; i<2; i++) {
+
+        libMesh::ReplicatedMesh mesh(p_global_init->comm());
+        libMesh::MeshTools::Generation::build_cube(mesh, 4, 4, 4,
+                                                   0., 1., 0., 1., 0., 1.,
+                                                   types[i]);
+
+        Real
+        volume = 0.,
+        area   = 0.;
+
+        SECTION("inclined plane through the element interiors")
+        {
+            // x = 0.65 - 0.3 y is inside the cube for all y
+            TEST::PlaneLevelSet phi(1., 0.3, 0., 0.65);
+            TEST::intersect_mesh(mesh, phi, volume, area);
+
+            CHECK(volume == Approx(0.5).epsilon(1.e-10));
+            CHECK(area   == Approx(std::sqrt(1.09)).epsilon(1.e-10));
+        }
+
+        SECTION("plane on the element faces")
+        {
+            TEST::PlaneLevelSet phi(1., 0., 0., 0.5);
+            TEST::intersect_mesh(mesh, phi, volume, area);
+
+            CHECK(volume == Approx(0.5).epsilon(1.e-10));
+            CHECK(area   == Approx(1.).epsilon(1.e-10));
+        }
+
+        SECTION("plane through the element nodes and diagonals")
+        {
+            TEST::PlaneLevelSet phi(1., 1., 0., 1.);
+            TEST::intersect_mesh(mesh, phi, volume, area);
+
+            CHECK(volume == Approx(0.5).epsilon(1.e-10));
+            CHECK(area   == Approx(std::sqrt(2.)).epsilon(1.e-10));
+        }
+
+        SECTION("oblique plane through all three directions")
+        {
+            // volume of the corner x + y + z < 0.9 is 0.9^3/6, and the
+            // interface is an equilateral triangle with side 0.9 sqrt(2)
+            TEST::PlaneLevelSet phi(1., 1., 1., 0.9);
+            TEST::intersect_mesh(mesh, phi, volume, area);
+
+            CHECK(volume == Approx(1. - std::pow(0.9, 3)/6.).epsilon(1.e-10));
+            CHECK(area   == Approx(std::sqrt(3.)/4. * 2. * 0.81).epsilon(1.e-10));
+        }
+    }
+}
+
+
+
+TEST_CASE("level_set_intersection_3d_conforming",
+          "[level_set]")
+{
+    // every other element is rotated about its z-axis, so that
+    // neighboring elements do not have the same orientation
+    libMesh::ReplicatedMesh mesh(p_global_init->comm());
+    libMesh::MeshTools::Generation::build_cube(mesh, 3, 3, 3,
+                                               0., 1., 0., 1., 0., 1.,
+                                               libMesh::HEX8);
+
+    const unsigned int
+    rotation[8] = {1, 2, 3, 0, 5, 6, 7, 4};
+
+    for (auto& elem : mesh.active_element_ptr_range())
+        if (elem->id() % 2) {
+
+            libMesh::Node* nodes[8];
+            for (unsigned int i=0; i<8; i++)
+                nodes[i] = elem->node_ptr(rotation[i]);
+            for (unsigned int i=0; i<8; i++)
+                elem->set_node(i) = nodes[i];
+        }
+    mesh.find_neighbors();
+
+    TEST::PlaneLevelSet phi(1., 0.7, 0.4, 1.15);
+
+    // triangles of the sub-elements on each side of the intersected
+    // elements, identified by the coordinates of their nodes
+    typedef std::array<long long, 9> Triangle;
+    std::map<std::vector<libMesh::dof_id_type>, std::vector<std::set<Triangle>>>
+    side_triangles;
+
+    for (const auto& elem : mesh.active_element_ptr_range()) {
+
+        MAST::LevelSetIntersection intersection;
+        intersection.init(phi, *elem, 0., mesh.max_elem_id(), mesh.max_node_id());
+
+        if (intersection.get_intersection_mode() != MAST::SUB_TETRAHEDRA)
+            continue;
+
+        std::vector<const libMesh::Elem*>
+        sub_elems = intersection.get_sub_elems_positive_phi();
+        sub_elems.insert(sub_elems.end(),
+                         intersection.get_sub_elems_negative_phi().begin(),
+                         intersection.get_sub_elems_negative_phi().end());
+
+        for (unsigned int s=0; s<elem->n_sides(); s++) {
+
+            std::unique_ptr<const libMesh::Elem>
+            side(elem->side_ptr(s).release());
+
+            // the sides of the mesh are normal to a coordinate direction
+            unsigned int
+            d = 0;
+            for (unsigned int i=0; i<3; i++)
+                if (std::fabs(side->point(0)(i) - side->point(2)(i)) < 1.e-12)
+                    d = i;
+
+            std::vector<libMesh::dof_id_type> key(4);
+            for (unsigned int i=0; i<4; i++)
+                key[i] = side->node_id(i);
+            std::sort(key.begin(), key.end());
+
+            std::set<Triangle> triangles;
+
+            for (unsigned int i=0; i<sub_elems.size(); i++)
+                for (unsigned int j=0; j<4; j++) {
+
+                    // face of the tetrahedron opposite to node j
+                    std::vector<std::array<long long, 3>> pts;
+                    for (unsigned int k=0; k<4; k++)
+                        if (k != j) {
+
+                            const libMesh::Point& p = sub_elems[i]->point(k);
+                            if (std::fabs(p(d) - side->point(0)(d)) < 1.e-10)
+                                pts.push_back({{std::llround(p(0)*1.e6),
+                                                std::llround(p(1)*1.e6),
+                                                std::llround(p(2)*1.e6)}});
+                        }
+
+                    if (pts.size() == 3) {
+
+                        std::sort(pts.begin(), pts.end());
+                        Triangle t;
+                        for (unsigned int k=0; k<3; k++)
+                            for (unsigned int l=0; l<3; l++)
+                                t[3*k+l] = pts[k][l];
+                        triangles.insert(t);
+                    }
+                }
+
+            side_triangles[key].push_back(triangles);
+        }
+    }
+
+    // the sub-elements of two intersected elements sharing a side have
+    // the same triangles on the side
+    unsigned int
+    n_shared = 0;
+
+    for (const auto& s : side_triangles)
+        if (s.second.size() == 2) {
+
+            CHECK(s.second[0] == s.second[1]);
+            n_shared++;
+        }
+
+    REQUIRE(n_shared > 0);
+}
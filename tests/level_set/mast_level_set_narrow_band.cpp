@@ -0,0 +1,287 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/system.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/elem.h"
+#include "libmesh/dof_map.h"
+
+// MAST includes
+#include "base/field_function_base.h"
+#include "base/nonlinear_system.h"
+#include "base/parameter.h"
+#include "base/constant_field_function.h"
+#include "base/physics_discipline_base.h"
+#include "base/boundary_condition_base.h"
+#include "base/transient_assembly.h"
+#include "property_cards/isotropic_material_property_card.h"
+#include "property_cards/solid_1d_section_element_property_card.h"
+#include "heat_conduction/heat_conduction_system_initialization.h"
+#include "heat_conduction/heat_conduction_transient_assembly.h"
+#include "solver/first_order_newmark_transient_solver.h"
+#include "level_set/level_set_narrow_band.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   level set   phi = a (x - c), which is not a distance function
+     *   for a != 1
+     */
+    class ScaledLineLevelSet:
+    public MAST::FieldFunction<Real> {
+    public:
+        ScaledLineLevelSet(Real a, Real c):
+        MAST::FieldFunction<Real>("phi"),
+        _a(a), _c(c)
+        { }
+
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 Real& v) const {
+            v = _a * (p(0) - _c);
+        }
+
+    protected:
+        Real _a, _c;
+    };
+}
+
+
+
+TEST_CASE("level_set_narrow_band",
+          "[level_set]")
+{
+    const unsigned int
+    n_divs   = 10;
+
+    const Real
+    a        = 3.,
+    c        = 0.45;
+
+    libMesh::ReplicatedMesh mesh(p_global_init->comm());
+    libMesh::MeshTools::Generation::build_square(mesh, n_divs, n_divs,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+
+    libMesh::EquationSystems eq_sys(mesh);
+    libMesh::System& sys = eq_sys.add_system<libMesh::System>("level_set");
+    sys.add_variable("phi", libMesh::FIRST, libMesh::LAGRANGE);
+    eq_sys.init();
+
+    TEST::ScaledLineLevelSet phi(a, c);
+
+    libMesh::MeshBase::const_node_iterator
+    n_it    = mesh.local_nodes_begin(),
+    n_end   = mesh.local_nodes_end();
+
+    for ( ; n_it != n_end; n_it++) {
+
+        Real v = 0.;
+        phi(**n_it, 0., v);
+        sys.solution->set((*n_it)->dof_number(sys.number(), 0, 0), v);
+    }
+    sys.solution->close();
+
+    // the interface is in the column of elements 0.4 <= x <= 0.5, and one
+    // layer of elements is added on either side
+    MAST::LevelSetNarrowBand band(sys, 1);
+    band.init(*sys.solution);
+
+    REQUIRE(band.initialized());
+    CHECK(band.n_elems() == 3 * n_divs);
+
+    for (unsigned int i=0; i<band.local_elems().size(); i++) {
+
+        const libMesh::Elem* e = band.local_elems()[i];
+        CHECK(e->centroid()(0) > 0.3);
+        CHECK(e->centroid()(0) < 0.6);
+    }
+
+    // nodes with x < 0.3 or x > 0.6 are outside the band
+    unsigned int
+    n_fixed = (unsigned int)band.local_fixed_dofs().size();
+    mesh.comm().sum(n_fixed);
+    CHECK(n_fixed == (n_divs+1) * (n_divs+1 - 4));
+
+    // outside the band the level set is replaced by the signed distance
+    band.reinitialize_outside_band(phi, *sys.solution);
+
+    n_it    = mesh.local_nodes_begin();
+    n_end   = mesh.local_nodes_end();
+
+    for ( ; n_it != n_end; n_it++) {
+
+        const libMesh::Node& n = **n_it;
+
+        Real
+        x = n(0),
+        v = (*sys.solution)(n.dof_number(sys.number(), 0, 0));
+
+        if (x < 0.3 - 1.e-8 || x > 0.6 + 1.e-8)
+            CHECK(v == Approx(x - c));
+        else
+            CHECK(v == Approx(a * (x - c)));
+    }
+}
+
+
+
+TEST_CASE("level_set_narrow_band_transient",
+          "[level_set]")
+{
+    const unsigned int
+    n_divs   = 10;
+
+    // transient heat conduction in a bar with a flux on the right end,
+    // restricted to a band around x = 0.85
+    libMesh::ReplicatedMesh mesh(p_global_init->comm());
+    libMesh::MeshTools::Generation::build_line(mesh, n_divs, 0., 1.);
+
+    libMesh::EquationSystems eq_sys(mesh);
+    MAST::NonlinearSystem& sys = eq_sys.add_system<MAST::NonlinearSystem>("conduction");
+
+    libMesh::FEType fetype(libMesh::FIRST, libMesh::LAGRANGE);
+    MAST::HeatConductionSystemInitialization sys_init(sys, sys.name(), fetype);
+    MAST::PhysicsDisciplineBase discipline(eq_sys);
+    eq_sys.init();
+
+    MAST::Parameter
+    zero     ("zero",     0.),
+    kappa_yy ("kappa_yy", 5./6.),
+    kappa_zz ("kappa_zz", 5./6.),
+    thy      ("thy",      0.06),
+    thz      ("thz",      0.02),
+    k        ("k",        190.),
+    rho      ("rho",      2700.),
+    cp       ("cp",       864.),
+    q        ("flux",     -2.e3);
+
+    MAST::ConstantFieldFunction
+    thy_f      ("hy",        thy),
+    thz_f      ("hz",        thz),
+    hyoff_f    ("hy_off",    zero),
+    hzoff_f    ("hz_off",    zero),
+    k_f        ("k_th",      k),
+    rho_f      ("rho",       rho),
+    cp_f       ("cp",        cp),
+    q_f        ("heat_flux", q),
+    kappa_yy_f ("Kappayy",   kappa_yy),
+    kappa_zz_f ("Kappazz",   kappa_zz);
+
+    MAST::BoundaryConditionBase flux(MAST::HEAT_FLUX);
+    flux.add(q_f);
+    discipline.add_side_load(1, flux);
+
+    MAST::IsotropicMaterialPropertyCard material;
+    material.add(k_f);
+    material.add(rho_f);
+    material.add(cp_f);
+
+    MAST::Solid1DSectionElementPropertyCard section;
+    section.add(thy_f);
+    section.add(thz_f);
+    section.add(hyoff_f);
+    section.add(hzoff_f);
+    section.add(kappa_yy_f);
+    section.add(kappa_zz_f);
+
+    RealVectorX orientation = RealVectorX::Zero(3);
+    orientation(1) = 1.;
+    section.y_vector() = orientation;
+    section.set_material(material);
+    section.init();
+    discipline.set_property_for_subdomain(0, section);
+
+    // the band contains the interface element 0.8 <= x <= 0.9 and one
+    // layer on either side
+    TEST::ScaledLineLevelSet phi(1., 0.85);
+
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    phi_vec(sys.solution->zero_clone().release());
+
+    libMesh::MeshBase::const_node_iterator
+    n_it    = mesh.local_nodes_begin(),
+    n_end   = mesh.local_nodes_end();
+
+    for ( ; n_it != n_end; n_it++) {
+
+        Real v = 0.;
+        phi(**n_it, 0., v);
+        phi_vec->set((*n_it)->dof_number(sys.number(), 0, 0), v);
+    }
+    phi_vec->close();
+
+    MAST::LevelSetNarrowBand band(sys, 1);
+    band.init(*phi_vec);
+
+    // nodes with x < 0.7 are outside the band
+    unsigned int
+    n_fixed = (unsigned int)band.local_fixed_dofs().size();
+    mesh.comm().sum(n_fixed);
+    REQUIRE(n_fixed == n_divs+1 - 4);
+
+    MAST::TransientAssembly                                  assembly;
+    MAST::HeatConductionTransientAssemblyElemOperations      elem_ops;
+    MAST::FirstOrderNewmarkTransientSolver                   solver;
+
+    assembly.set_discipline_and_system(discipline, sys_init);
+    elem_ops.set_discipline_and_system(discipline, sys_init);
+    solver.set_discipline_and_system(discipline, sys_init);
+    solver.set_elem_operation_object(elem_ops);
+    assembly.set_narrow_band(band);
+
+    sys.solution->zero();
+    sys.update();
+
+    solver.dt    = 1.e+3;
+    solver.beta  = 1.;
+
+    for (unsigned int i=0; i<3; i++) {
+
+        solver.solve(assembly);
+        solver.advance_time_step();
+    }
+
+    // the flux changes the temperature in the band, but the fixed dofs
+    // retain their initial value
+    CHECK(sys.solution->linfty_norm() > 0.);
+
+    const std::vector<libMesh::dof_id_type>
+    &dofs = band.local_fixed_dofs();
+
+    for (unsigned int i=0; i<dofs.size(); i++)
+        CHECK((*sys.solution)(dofs[i]) == Approx(0.).margin(1.e-12));
+
+    assembly.clear_narrow_band();
+    assembly.clear_discipline_and_system();
+    elem_ops.clear_discipline_and_system();
+    solver.clear_discipline_and_system();
+}
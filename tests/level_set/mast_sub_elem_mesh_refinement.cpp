@@ -0,0 +1,261 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <memory>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/system.h"
+#include "libmesh/elem.h"
+
+// MAST includes
+#include "base/field_function_base.h"
+#include "level_set/sub_elem_mesh_refinement.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   level set   phi = x - c
+     */
+    class VerticalLineLevelSet:
+    public MAST::FieldFunction<Real> {
+    public:
+        VerticalLineLevelSet(Real c):
+        MAST::FieldFunction<Real>("phi"),
+        _c(c)
+        { }
+
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 Real& v) const {
+            v = p(0) - _c;
+        }
+
+    protected:
+        Real _c;
+    };
+
+
+    /*!
+     *   @returns the number of active elements and the area of active
+     *   elements on the positive level set
+     */
+    inline void
+    positive_area(const libMesh::MeshBase& mesh,
+                  unsigned int negative_offset,
+                  unsigned int& n_elems,
+                  Real& area) {
+
+        n_elems = 0;
+        area    = 0.;
+
+        for (const auto& elem : mesh.active_element_ptr_range()) {
+
+            n_elems++;
+            if (elem->subdomain_id() < negative_offset)
+                area += elem->volume();
+        }
+    }
+}
+
+
+
+TEST_CASE("sub_elem_mesh_refinement",
+          "[level_set]")
+{
+    const unsigned int
+    n_divs          = 8,
+    negative_offset = 100,
+    inactive_offset = 200,
+    boundary_id     = 10;
+
+    libMesh::ReplicatedMesh
+    mesh(p_global_init->comm()),
+    mesh_ref(p_global_init->comm());
+
+    libMesh::MeshTools::Generation::build_square(mesh, n_divs, n_divs,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+    libMesh::MeshTools::Generation::build_square(mesh_ref, n_divs, n_divs,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+
+    libMesh::EquationSystems
+    eq_sys(mesh),
+    eq_sys_ref(mesh_ref);
+
+    libMesh::System
+    &sys     = eq_sys.add_system<libMesh::System>("sys"),
+    &sys_ref = eq_sys_ref.add_system<libMesh::System>("sys");
+
+    MAST::SubElemMeshRefinement
+    refine(mesh, sys),
+    refine_ref(mesh_ref, sys_ref);
+
+    TEST::VerticalLineLevelSet
+    phi1(0.43),
+    phi2(0.47),
+    phi3(0.6);
+
+    unsigned int
+    n1     = 0,
+    n2     = 0;
+
+    Real
+    a1     = 0.,
+    a2     = 0.;
+
+    // the first update processes all intersected and negative elements
+    CHECK(refine.process_mesh(phi1, false, 0., negative_offset,
+                              inactive_offset, boundary_id));
+    CHECK(refine.get_changed_elems().size() == 4 * n_divs);
+    CHECK(refine.if_subdomains_changed());
+
+    TEST::positive_area(mesh, negative_offset, n1, a1);
+    CHECK(a1 == Approx(0.57));
+
+    // no change in the level set
+    CHECK(!refine.update_mesh(phi1, 0.));
+    CHECK(refine.get_changed_elems().empty());
+    CHECK(!refine.if_subdomains_changed());
+
+    TEST::positive_area(mesh, negative_offset, n2, a2);
+    CHECK(n2 == n1);
+    CHECK(a2 == Approx(a1));
+
+    SECTION("interface moves within intersected elements") {
+
+        // only the intersected column of elements is updated
+        CHECK(refine.update_mesh(phi2, 0.));
+        CHECK(refine.get_changed_elems().size() == n_divs);
+        CHECK(refine.if_subdomains_changed());
+
+        refine_ref.process_mesh(phi2, false, 0., negative_offset,
+                                inactive_offset, boundary_id);
+
+        TEST::positive_area(mesh, negative_offset, n1, a1);
+        TEST::positive_area(mesh_ref, negative_offset, n2, a2);
+        CHECK(n1 == n2);
+        CHECK(mesh.n_nodes() == mesh_ref.n_nodes());
+        CHECK(a1 == Approx(0.53));
+        CHECK(a1 == Approx(a2));
+    }
+
+    SECTION("interface moves across elements") {
+
+        // the previously intersected column becomes negative and
+        // a new column is intersected
+        CHECK(refine.update_mesh(phi3, 0.));
+        CHECK(refine.get_changed_elems().size() == 2 * n_divs);
+        CHECK(refine.if_subdomains_changed());
+
+        refine_ref.process_mesh(phi3, false, 0., negative_offset,
+                                inactive_offset, boundary_id);
+
+        TEST::positive_area(mesh, negative_offset, n1, a1);
+        TEST::positive_area(mesh_ref, negative_offset, n2, a2);
+        CHECK(n1 == n2);
+        CHECK(mesh.n_nodes() == mesh_ref.n_nodes());
+        CHECK(a1 == Approx(0.4));
+        CHECK(a1 == Approx(a2));
+
+        // clearing the mesh restores the original mesh
+        refine.clear_mesh();
+        CHECK(refine.if_subdomains_changed());
+        TEST::positive_area(mesh, negative_offset, n1, a1);
+        CHECK(n1 == n_divs * n_divs);
+        CHECK(mesh.n_nodes() == (n_divs+1) * (n_divs+1));
+        CHECK(a1 == Approx(1.));
+    }
+}
+
+
+
+TEST_CASE("sub_elem_mesh_refinement_subdomains",
+          "[level_set]")
+{
+    const unsigned int
+    n_divs          = 8,
+    negative_offset = 100,
+    inactive_offset = 200,
+    boundary_id     = 10;
+
+    libMesh::ReplicatedMesh
+    mesh(p_global_init->comm());
+
+    libMesh::MeshTools::Generation::build_square(mesh, n_divs, n_divs,
+                                                 0., 1., 0., 1.,
+                                                 libMesh::QUAD4);
+
+    libMesh::EquationSystems
+    eq_sys(mesh);
+
+    libMesh::System
+    &sys     = eq_sys.add_system<libMesh::System>("sys");
+
+    MAST::SubElemMeshRefinement
+    refine(mesh, sys);
+
+    // the interface lies on the element edges, so that the elements on
+    // the negative side of the edge only change their subdomain id with
+    // a weak discontinuity
+    TEST::VerticalLineLevelSet
+    phi1(0.5),
+    phi2(0.625);
+
+    unsigned int
+    n1     = 0;
+
+    Real
+    a1     = 0.;
+
+    CHECK(!refine.process_mesh(phi1, false, 0., negative_offset,
+                               inactive_offset, boundary_id));
+    CHECK(refine.if_subdomains_changed());
+
+    TEST::positive_area(mesh, negative_offset, n1, a1);
+    CHECK(n1 == n_divs * n_divs);
+    CHECK(a1 == Approx(0.5));
+
+    // a column of elements moves to the negative level set. No element
+    // or node is added, but the subdomains change.
+    CHECK(!refine.update_mesh(phi2, 0.));
+    CHECK(refine.get_changed_elems().size() >= n_divs);
+    CHECK(refine.if_subdomains_changed());
+
+    TEST::positive_area(mesh, negative_offset, n1, a1);
+    CHECK(n1 == n_divs * n_divs);
+    CHECK(a1 == Approx(0.375));
+
+    // no change in the level set
+    CHECK(!refine.update_mesh(phi2, 0.));
+    CHECK(refine.get_changed_elems().empty());
+    CHECK(!refine.if_subdomains_changed());
+}
@@ -0,0 +1,164 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// Catch2 includes
+#include "catch.hpp"
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "numerics/fem_operator_matrix.h"
+#include "numerics/fixed_size_kernels.h"
+
+// Custom includes
+#include "test_helpers.h"
+
+
+namespace TEST {
+    
+    /**
+     * Initializes a plane-stress strain operator with six dofs per node, as
+     * done in MAST::StructuralElement2D.
+     */
+    void init_plane_stress_operator(const unsigned int n_phi,
+                                    MAST::FEMOperatorMatrix& B) {
+        
+        RealVectorX
+        dphi_dx = RealVectorX::Random(n_phi),
+        dphi_dy = RealVectorX::Random(n_phi);
+        
+        B.reinit(3, 6, n_phi);
+        B.set_shape_function(0, 0, dphi_dx); //  epsilon_xx = du/dx
+        B.set_shape_function(2, 1, dphi_dx); //  gamma_xy = dv/dx + ...
+        B.set_shape_function(1, 1, dphi_dy); //  epsilon_yy = dv/dy
+        B.set_shape_function(2, 0, dphi_dy); //  gamma_xy = du/dy + ...
+    }
+}
+
+
+TEST_CASE("fixed_size_strain_operator_kernels",
+          "[numerics],[kernel]")
+{
+    const Real JxW = 0.37;
+    
+    // 3 nodes (TRI3) and 4 nodes (QUAD4) use compile-time sized kernels,
+    // while 9 nodes (QUAD9) uses the dynamically sized fallback.
+    const unsigned int n_phi = GENERATE(3, 4, 9);
+    const unsigned int
+    n1 = 3,
+    n2 = 6*n_phi;
+    
+    MAST::FEMOperatorMatrix B_l, B_r;
+    TEST::init_plane_stress_operator(n_phi, B_l);
+    TEST::init_plane_stress_operator(n_phi, B_r);
+    
+    RealMatrixX
+    D         = RealMatrixX::Random(n1, n1),
+    mat_n1n2  = RealMatrixX::Zero(n1, n2),
+    mat_n2n2  = RealMatrixX::Zero(n2, n2),
+    jac_ref   = RealMatrixX::Zero(n2, n2),
+    jac       = RealMatrixX::Zero(n2, n2);
+    
+    RealVectorX
+    v         = RealVectorX::Random(n1),
+    vec_n2    = RealVectorX::Zero(n2),
+    f         = RealVectorX::Zero(n2),
+    sigma;
+    
+    std::unique_ptr<MAST::StrainOperatorKernelBase>
+    kernel(MAST::build_strain_operator_kernel(n1, n2));
+    
+    REQUIRE( kernel->n_strain() == n1 );
+    REQUIRE( kernel->n_dofs()   == n2 );
+    REQUIRE( kernel->if_fixed_size() == (n_phi != 9) );
+    
+    SECTION("stress matches the dynamically sized product")
+    {
+        kernel->stress(D, v, sigma);
+        
+        std::vector<double> test =
+        TEST::eigen_matrix_to_std_vector(sigma);
+        std::vector<double> truth =
+        TEST::eigen_matrix_to_std_vector(D * v);
+        
+        REQUIRE_THAT( test, Catch::Approx<double>(truth) );
+    }
+    
+    SECTION("B^T v matches FEMOperatorMatrix::vector_mult_transpose")
+    {
+        B_l.vector_mult_transpose(vec_n2, v);
+        kernel->add_Bt_vec(JxW, B_l, v, f);
+        
+        std::vector<double> test =
+        TEST::eigen_matrix_to_std_vector(f);
+        std::vector<double> truth =
+        TEST::eigen_matrix_to_std_vector(JxW * vec_n2);
+        
+        REQUIRE_THAT( test, Catch::Approx<double>(truth) );
+    }
+    
+    SECTION("B_l^T D B_r matches the FEMOperatorMatrix products")
+    {
+        B_r.left_multiply(mat_n1n2, D);
+        B_l.right_multiply_transpose(mat_n2n2, mat_n1n2);
+        jac_ref = JxW * mat_n2n2;
+        
+        kernel->add_Bt_D_B(JxW, B_l, D, B_r, jac);
+        
+        std::vector<double> test =
+        TEST::eigen_matrix_to_std_vector(jac);
+        std::vector<double> truth =
+        TEST::eigen_matrix_to_std_vector(jac_ref);
+        
+        REQUIRE_THAT( test, Catch::Approx<double>(truth) );
+    }
+    
+    SECTION("repeated products with the work buffers of the kernel")
+    {
+        B_r.left_multiply(mat_n1n2, D);
+        B_l.right_multiply_transpose(mat_n2n2, mat_n1n2);
+        jac_ref = 2. * JxW * mat_n2n2;
+        
+        kernel->add_Bt_D_B(JxW, B_l, D, B_r, jac);
+        kernel->add_Bt_vec(JxW, B_r, v, f);
+        kernel->add_Bt_D_B(JxW, B_l, D, B_r, jac);
+        
+        std::vector<double> test =
+        TEST::eigen_matrix_to_std_vector(jac);
+        std::vector<double> truth =
+        TEST::eigen_matrix_to_std_vector(jac_ref);
+        
+        REQUIRE_THAT( test, Catch::Approx<double>(truth) );
+    }
+    
+    SECTION("B^T D B with the same operator on both sides")
+    {
+        B_l.left_multiply(mat_n1n2, D);
+        B_l.right_multiply_transpose(mat_n2n2, mat_n1n2);
+        jac_ref = JxW * mat_n2n2;
+        
+        kernel->add_Bt_D_B(JxW, B_l, D, B_l, jac);
+        
+        std::vector<double> test =
+        TEST::eigen_matrix_to_std_vector(jac);
+        std::vector<double> truth =
+        TEST::eigen_matrix_to_std_vector(jac_ref);
+        
+        REQUIRE_THAT( test, Catch::Approx<double>(truth) );
+    }
+}
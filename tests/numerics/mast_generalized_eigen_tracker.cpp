@@ -0,0 +1,128 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// Catch2 includes
+#include "catch.hpp"
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "numerics/lapack_zggev_interface.h"
+#include "numerics/generalized_eigen_tracker.h"
+
+
+TEST_CASE("generalized_eigen_tracker",
+          "[numerics],[flutter]")
+{
+    const unsigned int n = 6;
+    
+    // pencil with well separated eigenvalues: A(t) = A0 + t A1, B = I + t B1
+    RealVectorX
+    d       = RealVectorX::LinSpaced(n, 1., 6.);
+    
+    ComplexMatrixX
+    A0      = d.cast<Complex>().asDiagonal(),
+    A1      = ComplexMatrixX::Random(n, n),
+    B1      = ComplexMatrixX::Random(n, n),
+    I       = ComplexMatrixX::Identity(n, n),
+    A,
+    B;
+    
+    const Real t0 = 0.01;
+    
+    MAST::LAPACK_ZGGEV ges;
+    ges.compute(A0 + t0 * A1, I + t0 * B1);
+    
+    ComplexVectorX
+    eig0    = ges.alphas().cwiseQuotient(ges.betas());
+    
+    SECTION("tracked eigenpairs satisfy the pencil in the same order")
+    {
+        const Real t = 0.02;
+        A = A0 + t * A1;
+        B = I  + t * B1;
+        
+        MAST::GeneralizedEigenTracker tracker;
+        REQUIRE( tracker.track(A, B, eig0,
+                               ges.right_eigenvectors(),
+                               &ges.left_eigenvectors()) );
+        
+        const ComplexVectorX
+        &eig    = tracker.alphas();
+        const ComplexMatrixX
+        &VR     = tracker.right_eigenvectors(),
+        &VL     = tracker.left_eigenvectors();
+        
+        for (unsigned int i=0; i<n; i++) {
+            
+            // the tracked root is the continuation of root i
+            unsigned int closest = 0;
+            (eig0.array() - eig(i)).abs().minCoeff(&closest);
+            REQUIRE( closest == i );
+            
+            REQUIRE( (A*VR.col(i) - eig(i)*B*VR.col(i)).norm() <
+                    1.e-8 * VR.col(i).norm() );
+            REQUIRE( (VL.col(i).adjoint()*A -
+                      eig(i)*VL.col(i).adjoint()*B).norm() <
+                    1.e-6 * VL.col(i).norm() );
+        }
+        
+        // the eigenvalues match the full QZ solution
+        MAST::LAPACK_ZGGEV ges_ref;
+        ges_ref.compute(A, B);
+        ComplexVectorX
+        eig_ref = ges_ref.alphas().cwiseQuotient(ges_ref.betas());
+        
+        for (unsigned int i=0; i<n; i++)
+            REQUIRE( (eig_ref.array() - eig(i)).abs().minCoeff() < 1.e-8 );
+    }
+    
+    SECTION("each root reuses one factorization for its inverse iterations")
+    {
+        const Real t = 0.0101;
+        A = A0 + t * A1;
+        B = I  + t * B1;
+        
+        MAST::GeneralizedEigenTracker tracker;
+        REQUIRE( tracker.track(A, B, eig0,
+                               ges.right_eigenvectors(),
+                               &ges.left_eigenvectors()) );
+        
+        // a small step in the pencil is tracked without updating the
+        // shift, so that the number of factorizations is the number of
+        // roots, while each root takes several iterations
+        REQUIRE( tracker.n_factorizations() == n );
+        REQUIRE( tracker.n_iterations() > n );
+        
+        const ComplexVectorX &eig = tracker.alphas();
+        const ComplexMatrixX &VR  = tracker.right_eigenvectors();
+        for (unsigned int i=0; i<n; i++)
+            REQUIRE( (A*VR.col(i) - eig(i)*B*VR.col(i)).norm() <
+                    1.e-8 * VR.col(i).norm() );
+    }
+    
+    SECTION("tracking fails when two starting vectors are identical")
+    {
+        ComplexMatrixX VR0 = ges.right_eigenvectors();
+        VR0.col(1) = VR0.col(0);
+        eig0(1)    = eig0(0);
+        
+        MAST::GeneralizedEigenTracker tracker;
+        REQUIRE_FALSE( tracker.track(A0 + t0 * A1, I + t0 * B1, eig0, VR0) );
+    }
+}
@@ -0,0 +1,201 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/parallel.h"
+
+// MAST includes
+#include "optimization/function_evaluation.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   min sum x_j^2 subject to sum x_j >= 1, where the "analysis" state
+     *   s_j = x_j^2 and its sensitivities are stored in the design point
+     *   cache so that the warm start can be verified.
+     */
+    class CachedProblem: public MAST::FunctionEvaluation {
+    public:
+        CachedProblem(const libMesh::Parallel::Communicator& comm):
+        MAST::FunctionEvaluation(comm),
+        n_evals         (0),
+        if_warm_started (false)
+        {
+            _n_vars    = 3;
+            _n_eq      = 0;
+            _n_ineq    = 1;
+
+            state = libMesh::NumericVector<Real>::build(comm);
+            state->init(_n_vars, _n_vars, false, libMesh::SERIAL);
+
+            ds    = libMesh::NumericVector<Real>::build(comm);
+            ds->init(_n_vars, _n_vars, false, libMesh::SERIAL);
+        }
+
+        virtual void init_dvar(std::vector<Real>& x,
+                               std::vector<Real>& xmin,
+                               std::vector<Real>& xmax)
+        {
+            x.assign(_n_vars, 1.);
+            xmin.assign(_n_vars, 0.);
+            xmax.assign(_n_vars, 2.);
+        }
+
+        virtual void evaluate(const std::vector<Real>& x,
+                              Real& obj,
+                              bool eval_obj_grad,
+                              std::vector<Real>& obj_grad,
+                              std::vector<Real>& fvals,
+                              std::vector<bool>& eval_grads,
+                              std::vector<Real>& grads)
+        {
+            n_evals++;
+
+            // initial guess for the analysis
+            state->zero();
+            if_warm_started = this->warm_start_vector("state", *state);
+            warm_start.resize(_n_vars);
+            for (unsigned int j=0; j<_n_vars; j++)
+                warm_start[j] = (*state)(j);
+
+            obj      = 0.;
+            fvals[0] = 1.;
+            for (unsigned int j=0; j<_n_vars; j++) {
+
+                state->set(j, x[j]*x[j]);
+                obj      += x[j]*x[j];
+                fvals[0] -= x[j];
+
+                if (eval_obj_grad) obj_grad[j] = 2.*x[j];
+                if (eval_grads[0]) grads[j]    = -1.;
+            }
+            state->close();
+
+            this->cache_vector("state", *state);
+            this->cache_data("obj", std::vector<Real>(1, obj));
+
+            for (unsigned int j=0; j<_n_vars; j++) {
+
+                ds->zero();
+                ds->set(j, 2.*x[j]);
+                ds->close();
+                this->cache_vector_sensitivity("state", j, *ds);
+            }
+        }
+
+        unsigned int                                  n_evals;
+        bool                                          if_warm_started;
+        std::vector<Real>                             warm_start;
+        std::unique_ptr<libMesh::NumericVector<Real> > state, ds;
+    };
+}
+
+
+TEST_CASE("design_point_cache",
+          "[optimization]")
+{
+    TEST::CachedProblem feval(p_global_init->comm());
+    feval.enable_design_point_cache(2);
+
+    Real
+    obj = 0.;
+
+    std::vector<Real>
+    x        {1., 2., 3.},
+    obj_grad (3, 0.),
+    fvals    (1, 0.),
+    grads    (3, 0.);
+
+    std::vector<bool>
+    eval_grads (1, false);
+
+    SECTION("repeat evaluations return the stored values")
+    {
+        feval._evaluate_wrapper(x, obj, false, obj_grad, fvals, eval_grads, grads);
+        REQUIRE(feval.n_evals == 1);
+        REQUIRE_FALSE(feval.if_warm_started);
+        REQUIRE(obj == Approx(14.));
+
+        // the gradients were not computed in the first evaluation
+        eval_grads[0] = true;
+        feval._evaluate_wrapper(x, obj, true, obj_grad, fvals, eval_grads, grads);
+        REQUIRE(feval.n_evals == 2);
+
+        obj = 0.;
+        std::fill(obj_grad.begin(), obj_grad.end(), 0.);
+        std::fill(grads.begin(), grads.end(), 0.);
+        feval._evaluate_wrapper(x, obj, true, obj_grad, fvals, eval_grads, grads);
+        REQUIRE(feval.n_evals == 2);
+        REQUIRE(obj         == Approx(14.));
+        REQUIRE(fvals[0]    == Approx(-5.));
+        REQUIRE(obj_grad[2] == Approx(6.));
+        REQUIRE(grads[1]    == Approx(-1.));
+        REQUIRE(feval.design_point_cache()->n_entries() == 1);
+    }
+
+    SECTION("new design points are warm started by extrapolation")
+    {
+        feval._evaluate_wrapper(x, obj, false, obj_grad, fvals, eval_grads, grads);
+
+        std::vector<Real>
+        x1 {1.5, 2., 2.5};
+        feval._evaluate_wrapper(x1, obj, false, obj_grad, fvals, eval_grads, grads);
+        REQUIRE(feval.n_evals == 2);
+        REQUIRE(feval.if_warm_started);
+
+        // s(x) + ds/dx (x1 - x)
+        REQUIRE(feval.warm_start[0] == Approx(1. + 2.*0.5));
+        REQUIRE(feval.warm_start[1] == Approx(4.));
+        REQUIRE(feval.warm_start[2] == Approx(9. - 6.*0.5));
+    }
+
+    SECTION("least recently used design points are removed")
+    {
+        std::vector<Real>
+        x1 {2., 2., 2.},
+        x2 {3., 3., 3.};
+
+        feval._evaluate_wrapper(x,  obj, false, obj_grad, fvals, eval_grads, grads);
+        feval._evaluate_wrapper(x1, obj, false, obj_grad, fvals, eval_grads, grads);
+        feval._evaluate_wrapper(x,  obj, false, obj_grad, fvals, eval_grads, grads);
+        REQUIRE(feval.n_evals == 2);
+
+        // x1 is removed to make room for x2
+        feval._evaluate_wrapper(x2, obj, false, obj_grad, fvals, eval_grads, grads);
+        feval._evaluate_wrapper(x,  obj, false, obj_grad, fvals, eval_grads, grads);
+        REQUIRE(feval.n_evals == 3);
+        feval._evaluate_wrapper(x1, obj, false, obj_grad, fvals, eval_grads, grads);
+        REQUIRE(feval.n_evals == 4);
+        REQUIRE(feval.design_point_cache()->n_entries() == 2);
+    }
+}
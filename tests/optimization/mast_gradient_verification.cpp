@@ -0,0 +1,203 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <complex>
+#include <vector>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/parallel.h"
+
+// MAST includes
+#include "optimization/function_evaluation.h"
+#include "optimization/gradient_verification.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   f0 = sum exp(x_j) x_j^2, f1 = prod x_j with analytical and
+     *   complex-step gradients. If \p error_dv is less than n_vars, the
+     *   objective gradient of this variable is perturbed.
+     */
+    class GradientProblem: public MAST::FunctionEvaluation {
+    public:
+        GradientProblem(const libMesh::Parallel::Communicator& comm,
+                        bool cs):
+        MAST::FunctionEvaluation(comm),
+        error_dv (10),
+        _cs      (cs)
+        {
+            _n_vars    = 4;
+            _n_eq      = 0;
+            _n_ineq    = 1;
+        }
+
+        virtual void init_dvar(std::vector<Real>& x,
+                               std::vector<Real>& xmin,
+                               std::vector<Real>& xmax)
+        {
+            x    = {0.5, 1., 1.5, 2.};
+            xmin.assign(_n_vars, 0.);
+            xmax.assign(_n_vars, 3.);
+        }
+
+        template <typename ValType>
+        void functions(const std::vector<ValType>& x,
+                       ValType& obj,
+                       ValType& f)
+        {
+            obj = 0.;
+            f   = 1.;
+            for (unsigned int j=0; j<_n_vars; j++) {
+                obj += std::exp(x[j]) * x[j] * x[j];
+                f   *= x[j];
+            }
+        }
+
+        virtual void evaluate(const std::vector<Real>& x,
+                              Real& obj,
+                              bool eval_obj_grad,
+                              std::vector<Real>& obj_grad,
+                              std::vector<Real>& fvals,
+                              std::vector<bool>& eval_grads,
+                              std::vector<Real>& grads)
+        {
+            this->functions(x, obj, fvals[0]);
+
+            for (unsigned int j=0; j<_n_vars; j++) {
+
+                if (eval_obj_grad)
+                    obj_grad[j] = std::exp(x[j]) * x[j] * (x[j] + 2.) +
+                    (j == error_dv ? 1. : 0.);
+                if (eval_grads[0])
+                    grads[j]    = fvals[0]/x[j];
+            }
+        }
+
+        virtual bool if_complex_step() const { return _cs; }
+
+        virtual void evaluate_complex_step(const std::vector<Real>& dvars,
+                                           unsigned int i,
+                                           Real h,
+                                           Real& obj_deriv,
+                                           std::vector<Real>& fvals_deriv)
+        {
+            std::vector<Complex>
+            x(dvars.begin(), dvars.end());
+            x[i] += Complex(0., h);
+
+            Complex
+            obj = 0.,
+            f   = 0.;
+
+            this->functions(x, obj, f);
+            obj_deriv      = std::imag(obj)/h;
+            fvals_deriv[0] = std::imag(f)/h;
+        }
+
+        unsigned int error_dv;
+
+    protected:
+
+        bool _cs;
+    };
+}
+
+
+TEST_CASE("gradient_verification",
+          "[optimization]")
+{
+    const libMesh::Parallel::Communicator&
+    comm = p_global_init->comm();
+
+    // one group per rank, so that the perturbed designs are evaluated
+    // concurrently in the MPI runs
+    MAST::GradientVerification gv(comm, comm.size());
+
+    REQUIRE(gv.group_comm().size() == 1);
+
+    std::vector<Real>
+    x, xmin, xmax;
+
+    SECTION("central differences with adaptive steps")
+    {
+        TEST::GradientProblem feval(gv.group_comm(), false);
+        feval.init_dvar(x, xmin, xmax);
+
+        gv.n_adaptive_steps = 4;
+        gv.step             = 1.e-3;
+
+        REQUIRE(gv.verify_gradients(feval, x));
+
+        for (unsigned int i=0; i<4; i++) {
+            REQUIRE(gv.relative_error(i, 0) < 1.e-6);
+            REQUIRE(gv.relative_error(i, 1) < 1.e-6);
+            REQUIRE(gv.step_size(i, 0) < 1.e-3 * std::max(1., x[i]));
+        }
+
+        // a wrong gradient is identified
+        feval.error_dv = 2;
+        REQUIRE_FALSE(gv.verify_gradients(feval, x));
+        REQUIRE(gv.relative_error(2, 0) > gv.tol);
+        REQUIRE(gv.relative_error(1, 0) < gv.tol);
+    }
+
+    SECTION("complex-step derivatives")
+    {
+        TEST::GradientProblem feval(gv.group_comm(), true);
+        feval.init_dvar(x, xmin, xmax);
+
+        REQUIRE(gv.verify_gradients(feval, x));
+
+        for (unsigned int i=0; i<4; i++) {
+            REQUIRE(gv.relative_error(i, 0) < 1.e-12);
+            REQUIRE(gv.numerical_gradient(i, 1) == Approx(1.5/x[i]));
+        }
+    }
+
+    SECTION("line study")
+    {
+        TEST::GradientProblem feval(gv.group_comm(), false);
+
+        std::vector<Real>
+        dv1 (4, 1.),
+        dv2 (4, 2.),
+        obj,
+        fvals;
+
+        gv.parametric_line_study(feval, dv1, dv2, 4, obj, fvals);
+
+        REQUIRE(obj.size()   == 5);
+        REQUIRE(fvals.size() == 5);
+        for (unsigned int p=0; p<5; p++) {
+
+            const Real r = 1. + 0.25*p;
+            REQUIRE(obj[p]   == Approx(4.*std::exp(r)*r*r));
+            REQUIRE(fvals[p] == Approx(r*r*r*r));
+        }
+    }
+}
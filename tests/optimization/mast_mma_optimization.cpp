@@ -0,0 +1,232 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <vector>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/parallel.h"
+
+// MAST includes
+#include "optimization/function_evaluation.h"
+#include "optimization/mma_optimization_interface.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   Svanberg's three-variable test problem:
+     *   min x1^2 + x2^2 + x3^2, subject to two spherical constraints.
+     */
+    class MMAToyProblem: public MAST::FunctionEvaluation {
+    public:
+        MMAToyProblem(const libMesh::Parallel::Communicator& comm):
+        MAST::FunctionEvaluation(comm)
+        {
+            _n_vars    = 3;
+            _n_eq      = 0;
+            _n_ineq    = 2;
+            _max_iters = 100;
+            _tol       = 1.e-8;
+        }
+
+        virtual void init_dvar(std::vector<Real>& x,
+                               std::vector<Real>& xmin,
+                               std::vector<Real>& xmax)
+        {
+            x    = {4., 3., 2.};
+            xmin = {0., 0., 0.};
+            xmax = {5., 5., 5.};
+        }
+
+        virtual void evaluate(const std::vector<Real>& x,
+                              Real& obj,
+                              bool eval_obj_grad,
+                              std::vector<Real>& obj_grad,
+                              std::vector<Real>& fvals,
+                              std::vector<bool>& eval_grads,
+                              std::vector<Real>& grads)
+        {
+            const Real
+            c0[3] = {5., 2., 1.},
+            c1[3] = {3., 4., 3.};
+
+            obj      = 0.;
+            fvals[0] = -9.;
+            fvals[1] = -9.;
+            for (unsigned int j=0; j<3; j++)
+            {
+                obj      += x[j]*x[j];
+                fvals[0] += (x[j]-c0[j])*(x[j]-c0[j]);
+                fvals[1] += (x[j]-c1[j])*(x[j]-c1[j]);
+
+                if (eval_obj_grad) obj_grad[j]  = 2.*x[j];
+                if (eval_grads[0]) grads[j*2]   = 2.*(x[j]-c0[j]);
+                if (eval_grads[1]) grads[j*2+1] = 2.*(x[j]-c1[j]);
+            }
+        }
+
+        virtual void output(unsigned int iter,
+                            const std::vector<Real>& x,
+                            Real obj,
+                            const std::vector<Real>& fval,
+                            bool if_write_to_optim_file)
+        {
+            x_opt   = x;
+            obj_opt = obj;
+        }
+
+        std::vector<Real> x_opt;
+        Real obj_opt = 0.;
+    };
+
+
+    /*!
+     *   min sum (x_j - 1)^2 subject to sum x_j <= n/2 and 0 <= x_j <= 1,
+     *   evaluated on the distributed design variable vectors. The
+     *   solution is x_j = 1/2.
+     */
+    class MMADistributedProblem: public MAST::FunctionEvaluation {
+    public:
+        MMADistributedProblem(const libMesh::Parallel::Communicator& comm):
+        MAST::FunctionEvaluation(comm)
+        {
+            _n_vars    = 100;
+            _n_eq      = 0;
+            _n_ineq    = 1;
+            _max_iters = 100;
+            _tol       = 1.e-8;
+        }
+
+        virtual void init_dvar(std::vector<Real>& x,
+                               std::vector<Real>& xmin,
+                               std::vector<Real>& xmax)
+        {
+            x.assign(_n_vars, 0.2);
+            xmin.assign(_n_vars, 0.);
+            xmax.assign(_n_vars, 1.);
+        }
+
+        virtual void evaluate(const std::vector<Real>& x,
+                              Real& obj,
+                              bool eval_obj_grad,
+                              std::vector<Real>& obj_grad,
+                              std::vector<Real>& fvals,
+                              std::vector<bool>& eval_grads,
+                              std::vector<Real>& grads)
+        {
+            // only the distributed interface should be used
+            libmesh_error();
+        }
+
+        virtual void evaluate(const libMesh::NumericVector<Real>& x,
+                              Real& obj,
+                              bool eval_obj_grad,
+                              libMesh::NumericVector<Real>& obj_grad,
+                              std::vector<Real>& fvals,
+                              std::vector<bool>& eval_grads,
+                              std::vector<libMesh::NumericVector<Real>*>& grads)
+        {
+            obj      = 0.;
+            fvals[0] = 0.;
+
+            for (libMesh::numeric_index_type j=x.first_local_index(); j<x.last_local_index(); j++)
+            {
+                const Real xj = x(j);
+                obj      += (xj-1.)*(xj-1.);
+                fvals[0] += xj;
+
+                if (eval_obj_grad) obj_grad.set(j, 2.*(xj-1.));
+                if (eval_grads[0]) grads[0]->set(j, 1.);
+            }
+
+            this->comm().sum(obj);
+            this->comm().sum(fvals);
+            fvals[0] -= 0.5*_n_vars;
+
+            if (eval_obj_grad) obj_grad.close();
+            if (eval_grads[0]) grads[0]->close();
+        }
+
+        virtual void output(unsigned int iter,
+                            const libMesh::NumericVector<Real>& x,
+                            Real obj,
+                            const std::vector<Real>& fval,
+                            bool if_write_to_optim_file)
+        {
+            x_max   = x.max();
+            x_min   = x.min();
+            obj_opt = obj;
+        }
+
+        Real x_max = 0., x_min = 0., obj_opt = 0.;
+    };
+}
+
+
+TEST_CASE("mma_optimization",
+          "[optimization]")
+{
+    const libMesh::Parallel::Communicator& comm = p_global_init->comm();
+
+    SECTION("GCMMA converges to the solution of the toy problem")
+    {
+        TEST::MMAToyProblem feval(comm);
+        MAST::MMAOptimizationInterface optimizer;
+        optimizer.attach_function_evaluation_object(feval);
+        optimizer.optimize();
+
+        REQUIRE(feval.x_opt[0] == Approx(2.0175).epsilon(1.e-3));
+        REQUIRE(feval.x_opt[1] == Approx(1.7800).epsilon(1.e-3));
+        REQUIRE(feval.x_opt[2] == Approx(1.2375).epsilon(1.e-3));
+    }
+
+    SECTION("MMA without inner iterations converges to the same solution")
+    {
+        TEST::MMAToyProblem feval(comm);
+        MAST::MMAOptimizationInterface optimizer;
+        optimizer.set_integer_parameter("max_inner_iters", 0);
+        optimizer.attach_function_evaluation_object(feval);
+        optimizer.optimize();
+
+        REQUIRE(feval.x_opt[0] == Approx(2.0175).epsilon(1.e-3));
+        REQUIRE(feval.x_opt[1] == Approx(1.7800).epsilon(1.e-3));
+        REQUIRE(feval.x_opt[2] == Approx(1.2375).epsilon(1.e-3));
+    }
+
+    SECTION("Distributed evaluation converges with distributed vectors")
+    {
+        TEST::MMADistributedProblem feval(comm);
+        MAST::MMAOptimizationInterface optimizer;
+        optimizer.attach_function_evaluation_object(feval);
+        optimizer.optimize();
+
+        REQUIRE(feval.x_max   == Approx(0.5).epsilon(1.e-4));
+        REQUIRE(feval.x_min   == Approx(0.5).epsilon(1.e-4));
+        REQUIRE(feval.obj_opt == Approx(25.).epsilon(1.e-4));
+    }
+}
@@ -0,0 +1,297 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <memory>
+#include <limits>
+#include <algorithm>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/sparse_matrix.h"
+#include "libmesh/dof_map.h"
+
+// MAST includes
+#include "solver/arclength_continuation_solver.h"
+#include "solver/pseudo_arclength_continuation_solver.h"
+
+// Test includes
+#include "catch.hpp"
+#include "base/mast_structural_plate_system.h"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   assembles \f$ f_k = u^3 - 3u - p \f$ for the unknown
+     *   \f$ u = X_k \f$, and \f$ f_i = X_i \f$ for all other dofs. The
+     *   solution path has limit points at \f$ (u,p) = (-1, 2) \f$ and
+     *   \f$ (1, -2) \f$, where the Jacobian is singular.
+     */
+    class FoldAssembly: public MAST::NonlinearImplicitAssembly {
+    public:
+
+        FoldAssembly(MAST::Parameter& p): _p(p), _k(0) { }
+
+        /*!
+         *   sets the dof of the unknown \p u to the first unconstrained dof
+         */
+        void init() {
+
+            const libMesh::DofMap
+            &dof_map = this->system().get_dof_map();
+
+            libMesh::dof_id_type
+            k = std::numeric_limits<libMesh::dof_id_type>::max();
+
+            for (libMesh::dof_id_type i=dof_map.first_dof(); i<dof_map.end_dof(); i++)
+                if (!dof_map.is_constrained_dof(i)) {
+                    k = i;
+                    break;
+                }
+
+            dof_map.comm().min(k);
+            _k = k;
+        }
+
+        Real u(const libMesh::NumericVector<Real>& X) const {
+
+            Real
+            v = (_k >= X.first_local_index() && _k < X.last_local_index())? X(_k): 0.;
+            X.comm().sum(v);
+            return v;
+        }
+
+        virtual void
+        residual_and_jacobian (const libMesh::NumericVector<Real>& X,
+                               libMesh::NumericVector<Real>* R,
+                               libMesh::SparseMatrix<Real>*  J,
+                               libMesh::NonlinearImplicitSystem& S) {
+
+            const Real
+            v = this->u(X);
+
+            if (R) R->zero();
+            if (J) J->zero();
+
+            for (libMesh::dof_id_type i=X.first_local_index(); i<X.last_local_index(); i++) {
+
+                if (i == _k) {
+                    if (R) R->set(i, v*v*v - 3.*v - _p());
+                    if (J) J->set(i, i, 3.*v*v - 3.);
+                }
+                else {
+                    if (R) R->set(i, X(i));
+                    if (J) J->set(i, i, 1.);
+                }
+            }
+
+            if (R) R->close();
+            if (J) J->close();
+        }
+
+        virtual bool
+        sensitivity_assemble (const libMesh::NumericVector<Real>& X,
+                              bool if_localize_sol,
+                              const MAST::FunctionBase& f,
+                              libMesh::NumericVector<Real>& sensitivity_rhs,
+                              bool close_vector = true) {
+
+            sensitivity_rhs.zero();
+            if (&f == &_p &&
+                _k >= sensitivity_rhs.first_local_index() &&
+                _k <  sensitivity_rhs.last_local_index())
+                sensitivity_rhs.set(_k, -1.);
+
+            if (close_vector) sensitivity_rhs.close();
+            return true;
+        }
+
+    protected:
+
+        MAST::Parameter&     _p;
+        libMesh::dof_id_type _k;
+    };
+
+
+    /*!
+     *   solution and solver statistics of a continuation step
+     */
+    struct ContinuationStep {
+        std::unique_ptr<libMesh::NumericVector<Real>> X;
+        Real         p;
+        unsigned int n_linear_solves;
+        unsigned int n_iterations;
+    };
+
+    /*!
+     *   takes one continuation step on the pressure of a von Karman plate
+     *   and @returns the converged point and the solver statistics.
+     */
+    template <typename SolverType>
+    inline ContinuationStep
+    continuation_step(bool schur, unsigned int n_refinements) {
+
+        TEST::TestStructuralPlateSystem plate(4, MAST::NONLINEAR_STRAIN);
+        plate.pressure() = 0.;
+
+        SolverType solver;
+        solver.schur_factorization       = schur;
+        solver.max_bordering_refinements = n_refinements;
+        solver.max_it                    = 50;
+        solver.abs_tol                   = 0.;
+        solver.rel_tol                   = 1.e-10;
+
+        solver.set_assembly_and_load_parameter(plate.elem_ops, plate.assembly, plate.pressure);
+        solver.initialize(2.e4);
+        solver.solve();
+        solver.clear_assembly_and_load_parameters();
+
+        ContinuationStep step;
+        step.X               = plate.system.solution->clone();
+        step.p               = plate.pressure();
+        step.n_linear_solves = solver.n_linear_solves();
+        step.n_iterations    = solver.n_iterations();
+
+        return step;
+    }
+
+    /*!
+     *   compares the block elimination to the monolithic solution of the
+     *   bordered system. \p n_monolithic_solves is the number of linear
+     *   solves per iterate of the monolithic corrector.
+     */
+    template <typename SolverType>
+    inline void check_continuation_corrector(unsigned int n_monolithic_solves) {
+
+        TEST::ContinuationStep
+        monolithic = continuation_step<SolverType>(false, 0);
+
+        // solves for each iterate, and one for the tangent at the
+        // initial solution
+        REQUIRE(monolithic.n_iterations > 0);
+        REQUIRE(monolithic.n_linear_solves ==
+                n_monolithic_solves * monolithic.n_iterations + 1);
+
+        for (unsigned int n_refinements: {0, 2}) {
+
+            TEST::ContinuationStep
+            schur = continuation_step<SolverType>(true, n_refinements);
+
+            // without refinements, the elimination needs two solves per
+            // iterate, which share the preconditioner
+            REQUIRE(schur.n_iterations > 0);
+            if (n_refinements == 0)
+                REQUIRE(schur.n_linear_solves == 2 * schur.n_iterations + 1);
+            else
+                REQUIRE(schur.n_linear_solves <=
+                        (n_refinements+2) * schur.n_iterations + n_refinements + 1);
+
+            // the block elimination converges to the same point on the path
+            REQUIRE(schur.p == Approx(monolithic.p).epsilon(1.e-6));
+
+            std::unique_ptr<libMesh::NumericVector<Real>> dX = schur.X->clone();
+            dX->add(-1., *monolithic.X);
+            REQUIRE(dX->l2_norm() <= 1.e-6 * monolithic.X->l2_norm());
+        }
+    }
+}
+
+
+TEST_CASE("continuation_solver",
+          "[solver][continuation]")
+{
+    SECTION("Arclength corrector")
+    {
+        // the tangent is recomputed at each iterate
+        TEST::check_continuation_corrector<MAST::ArclengthContinuationSolver>(2);
+    }
+
+    SECTION("Pseudo-arclength corrector")
+    {
+        TEST::check_continuation_corrector<MAST::PseudoArclengthContinuationSolver>(1);
+    }
+}
+
+
+TEST_CASE("continuation_solver_fold",
+          "[solver][continuation]")
+{
+    TEST::TestStructuralPlateSystem plate(2);
+    plate.pressure() = 0.;
+
+    TEST::FoldAssembly assembly(plate.pressure);
+    assembly.set_discipline_and_system(plate.discipline, plate.structural_system);
+    assembly.init();
+
+    MAST::PseudoArclengthContinuationSolver solver;
+    solver.min_step = 0.5;
+    solver.max_step = 2.;
+    solver.max_it   = 20;
+
+    solver.set_assembly_and_load_parameter(plate.elem_ops, assembly, plate.pressure);
+    solver.initialize(0.2);
+
+    libMesh::NumericVector<Real>
+    &X = *plate.system.solution;
+
+    Real
+    u     = assembly.u(X),
+    p_max = plate.pressure();
+
+    bool
+    passed_fold = false;
+
+    for (unsigned int i=0; i<100 && !(passed_fold && plate.pressure() < 0.); i++) {
+
+        const Real
+        p0 = plate.pressure(),
+        u0 = u;
+
+        solver.solve();
+        u = assembly.u(X);
+
+        // each converged point is on the solution path
+        REQUIRE(u*u*u - 3.*u - plate.pressure() == Approx(0.).margin(1.e-6));
+
+        // the continuation proceeds along the path through the fold
+        REQUIRE(u < u0);
+
+        if (plate.pressure() < p0)
+            passed_fold = true;
+        else
+            REQUIRE(!passed_fold);
+
+        p_max = std::max(p_max, plate.pressure());
+    }
+
+    solver.clear_assembly_and_load_parameters();
+    assembly.clear_discipline_and_system();
+
+    // the load increases to the limit point at (u, p) = (-1, 2), after
+    // which the path continues with decreasing load
+    REQUIRE(passed_fold);
+    REQUIRE(p_max == Approx(2.).epsilon(1.e-2));
+    REQUIRE(p_max <= 2. + 1.e-6);
+    REQUIRE(u < -1.);
+    REQUIRE(plate.pressure() < 0.);
+}
@@ -0,0 +1,461 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <cctype>
+#include <cstdlib>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+
+// MAST includes
+#include "utility/assembly_profiler.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   JSON value produced by \p parse_json
+     */
+    struct JSONValue {
+
+        enum Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+        JSONValue(): type(NUL), number(0.) { }
+
+        Type                                            type;
+        Real                                            number;
+        std::string                                     string;
+        std::vector<std::unique_ptr<JSONValue>>         array;
+        std::map<std::string, std::unique_ptr<JSONValue>> object;
+
+        const JSONValue& operator[] (const std::string& k) const {
+            REQUIRE(type == OBJECT);
+            REQUIRE(object.count(k));
+            return *object.at(k);
+        }
+
+        const JSONValue& operator[] (unsigned int i) const {
+            REQUIRE(type == ARRAY);
+            REQUIRE(i < array.size());
+            return *array[i];
+        }
+    };
+
+
+    /*!
+     *   Recursive-descent parser for the subset of JSON written by the
+     *   profiler. Parsing stops with a test failure at the first
+     *   character that does not form valid JSON.
+     */
+    class JSONParser {
+
+    public:
+
+        JSONParser(const std::string& s): _s(s), _i(0) { }
+
+        std::unique_ptr<JSONValue> parse() {
+
+            std::unique_ptr<JSONValue> v = _value();
+            _ws();
+            _check(_i == _s.size(), "trailing characters");
+            return v;
+        }
+
+    private:
+
+        void _check(bool ok, const char* msg) const {
+            if (!ok) FAIL(msg << " at character " << _i << " of:\n" << _s);
+        }
+
+        void _ws() {
+            while (_i < _s.size() && std::isspace(_s[_i])) _i++;
+        }
+
+        void _expect(char c) {
+            _check(_next_is(c), "unexpected character");
+            _i++;
+        }
+
+        bool _next_is(char c) {
+            _ws();
+            return _i < _s.size() && _s[_i] == c;
+        }
+
+        std::string _string() {
+
+            _expect('"');
+            std::string r;
+            while (_i < _s.size() && _s[_i] != '"') {
+                // the profiler does not write escaped characters
+                _check(_s[_i] != '\\' && !std::iscntrl(_s[_i]),
+                       "unexpected character in string");
+                r += _s[_i++];
+            }
+            _expect('"');
+            return r;
+        }
+
+        std::unique_ptr<JSONValue> _value() {
+
+            std::unique_ptr<JSONValue> v(new JSONValue);
+            _ws();
+            _check(_i < _s.size(), "unexpected end of input");
+
+            if (_s[_i] == '{') {
+
+                v->type = JSONValue::OBJECT;
+                _i++;
+                // a trailing comma is followed by another member
+                for (bool more = !_next_is('}'); more; ) {
+                    const std::string k = _string();
+                    _expect(':');
+                    _check(!v->object.count(k), "duplicate key");
+                    v->object[k] = _value();
+                    more = _next_is(',');
+                    if (more) _i++;
+                }
+                _expect('}');
+            }
+            else if (_s[_i] == '[') {
+
+                v->type = JSONValue::ARRAY;
+                _i++;
+                for (bool more = !_next_is(']'); more; ) {
+                    v->array.push_back(_value());
+                    more = _next_is(',');
+                    if (more) _i++;
+                }
+                _expect(']');
+            }
+            else if (_s[_i] == '"') {
+
+                v->type   = JSONValue::STRING;
+                v->string = _string();
+            }
+            else if (!_s.compare(_i, 4, "true") || !_s.compare(_i, 5, "false")) {
+
+                v->type = JSONValue::BOOLEAN;
+                _i += (_s[_i] == 't')? 4 : 5;
+            }
+            else if (!_s.compare(_i, 4, "null")) {
+
+                _i += 4;
+            }
+            else {
+
+                // strtod accepts more than JSON numbers, so the
+                // first character is also checked
+                _check(_s[_i] == '-' || std::isdigit(_s[_i]), "invalid value");
+                const char* b = _s.c_str() + _i;
+                char*       e = nullptr;
+                v->type   = JSONValue::NUMBER;
+                v->number = std::strtod(b, &e);
+                _check(e != b, "invalid number");
+                _i += e - b;
+            }
+
+            return v;
+        }
+
+        const std::string& _s;
+        std::size_t        _i;
+    };
+
+
+    inline std::unique_ptr<JSONValue> parse_json(const std::string& s) {
+
+        return JSONParser(s).parse();
+    }
+
+
+    /*!
+     *   @returns the entry of the array \p a with \p name
+     */
+    inline const JSONValue& named_entry(const JSONValue& a, const std::string& name) {
+
+        REQUIRE(a.type == JSONValue::ARRAY);
+        for (unsigned int i=0; i<a.array.size(); i++)
+            if (a[i]["name"].string == name)
+                return a[i];
+
+        FAIL("no entry named " << name);
+        return a;
+    }
+
+
+    inline void sleep_ms(unsigned int ms) {
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+
+
+    /*!
+     *   allocation counter that reports one allocation of 16 bytes
+     *   on each call
+     */
+    inline void test_allocation_counter(std::uint64_t& n_allocs,
+                                        std::uint64_t& n_bytes) {
+
+        static std::uint64_t n = 0;
+        n++;
+        n_allocs = n;
+        n_bytes  = 16*n;
+    }
+}
+
+
+
+TEST_CASE("assembly_profiler",
+          "[utility][profiler]")
+{
+    typedef MAST::AssemblyProfiler Profiler;
+
+    const libMesh::Parallel::Communicator& comm = p_global_init->comm();
+
+    const unsigned int
+    n_iters     = 3,
+    outer_ms    = 2,
+    kernel_ms   = 5;
+
+    Profiler::disable();
+    Profiler::clear();
+
+    SECTION("Disabled profiler records nothing")
+    {
+        {
+            Profiler::Scope outer("assembly_profiler_test");
+            Profiler::Scope inner(Profiler::ELEM_KERNEL);
+            Profiler::count(Profiler::VECTOR_ENTRIES_ADDED, 10);
+        }
+
+        std::ostringstream o;
+        Profiler::write_json(comm, o);
+        std::unique_ptr<TEST::JSONValue> j = TEST::parse_json(o.str());
+
+        const TEST::JSONValue& phases = (*j)["phases"];
+        REQUIRE(phases.array.size() == Profiler::N_PHASES);
+        for (unsigned int i=0; i<phases.array.size(); i++)
+            REQUIRE(phases[i]["calls"].number == 0.);
+
+        REQUIRE((*j)["regions"].array.empty());
+        REQUIRE((*j)["counters"]["vector_entries_added"].number == 0.);
+        REQUIRE((*j)["trace_events"].number == 0.);
+    }
+
+    SECTION("Nested scopes report inclusive and exclusive times")
+    {
+        Profiler::enable();
+
+        for (unsigned int i=0; i<n_iters; i++) {
+
+            Profiler::Scope outer("assembly_profiler_test");
+            TEST::sleep_ms(outer_ms);
+            {
+                Profiler::Scope inner(Profiler::ELEM_KERNEL);
+                TEST::sleep_ms(kernel_ms);
+            }
+        }
+
+        Profiler::disable();
+
+        std::ostringstream o;
+        Profiler::write_json(comm, o);
+        std::unique_ptr<TEST::JSONValue> j = TEST::parse_json(o.str());
+
+        REQUIRE((*j)["rank"].number    == comm.rank());
+        REQUIRE((*j)["n_ranks"].number == comm.size());
+
+        const TEST::JSONValue
+        &outer  = TEST::named_entry((*j)["regions"], "assembly_profiler_test"),
+        &kernel = TEST::named_entry((*j)["phases"],
+                                    Profiler::phase_name(Profiler::ELEM_KERNEL)),
+        &scatter = TEST::named_entry((*j)["phases"],
+                                     Profiler::phase_name(Profiler::SCATTER));
+
+        REQUIRE(outer["calls"].number   == n_iters);
+        REQUIRE(kernel["calls"].number  == n_iters);
+        REQUIRE(scatter["calls"].number == 0.);
+
+        // the kernel has no nested scopes
+        CHECK(kernel["exclusive_s"].number ==
+              Approx(kernel["inclusive_s"].number).margin(1.e-8));
+        CHECK(kernel["inclusive_s"].number >= n_iters*kernel_ms*1.e-3);
+
+        // the time of the nested kernel is excluded from the outer scope
+        CHECK(outer["exclusive_s"].number ==
+              Approx(outer["inclusive_s"].number -
+                     kernel["inclusive_s"].number).margin(1.e-8));
+        CHECK(outer["exclusive_s"].number >= n_iters*outer_ms*1.e-3);
+        CHECK(outer["inclusive_s"].number >=
+              n_iters*(outer_ms+kernel_ms)*1.e-3);
+
+        // allocations are only reported with an allocation counter
+        REQUIRE_FALSE(outer.object.count("allocations"));
+    }
+
+    SECTION("Allocations are reported by the allocation counter")
+    {
+        Profiler::set_allocation_counter(TEST::test_allocation_counter);
+        Profiler::enable();
+
+        for (unsigned int i=0; i<n_iters; i++) {
+            Profiler::Scope outer("assembly_profiler_test");
+        }
+
+        Profiler::disable();
+
+        std::ostringstream o;
+        Profiler::write_json(comm, o);
+        Profiler::set_allocation_counter(nullptr);
+
+        std::unique_ptr<TEST::JSONValue> j = TEST::parse_json(o.str());
+        const TEST::JSONValue
+        &outer = TEST::named_entry((*j)["regions"], "assembly_profiler_test");
+
+        // the counter is called once at the beginning and once at the
+        // end of each scope
+        REQUIRE(outer["allocations"].number     == n_iters);
+        REQUIRE(outer["allocated_bytes"].number == 16*n_iters);
+    }
+
+    SECTION("Counters are incremented only while enabled")
+    {
+        Profiler::count(Profiler::LOCALIZED_VECTORS, 5);
+
+        Profiler::enable();
+        for (unsigned int i=0; i<n_iters; i++)
+            Profiler::count(Profiler::VECTOR_ENTRIES_ADDED, 8);
+        Profiler::count(Profiler::MATRIX_ENTRIES_ADDED);
+        Profiler::disable();
+
+        Profiler::count(Profiler::MATRIX_ENTRIES_ADDED, 100);
+
+        std::ostringstream o;
+        Profiler::write_json(comm, o);
+        std::unique_ptr<TEST::JSONValue> j = TEST::parse_json(o.str());
+        const TEST::JSONValue& c = (*j)["counters"];
+
+        REQUIRE(c.object.size() == Profiler::N_COUNTERS);
+        REQUIRE(c["vector_entries_added"].number == 8*n_iters);
+        REQUIRE(c["matrix_entries_added"].number == 1.);
+        REQUIRE(c["localized_vectors"].number    == 0.);
+        REQUIRE(c["localized_entries"].number    == 0.);
+
+        // the counters are reset by clear
+        Profiler::clear();
+        std::ostringstream o2;
+        Profiler::write_json(comm, o2);
+        j = TEST::parse_json(o2.str());
+        REQUIRE((*j)["counters"]["vector_entries_added"].number == 0.);
+    }
+
+    SECTION("Trace events are capped and the excess is counted")
+    {
+        // each iteration records the outer scope and the kernel, while
+        // the property evaluation is not traced
+        const unsigned int
+        max_events = 4,
+        n_events   = 2*n_iters;
+
+        Profiler::enable(true, max_events);
+
+        for (unsigned int i=0; i<n_iters; i++) {
+
+            Profiler::Scope outer("assembly_profiler_test");
+            {
+                Profiler::Scope inner(Profiler::ELEM_KERNEL);
+                Profiler::Scope prop(Profiler::PROPERTY_EVALUATION);
+            }
+        }
+
+        Profiler::disable();
+
+        std::ostringstream o;
+        Profiler::write_json(comm, o);
+        std::unique_ptr<TEST::JSONValue> j = TEST::parse_json(o.str());
+
+        REQUIRE((*j)["trace_events"].number         == max_events);
+        REQUIRE((*j)["dropped_trace_events"].number == n_events - max_events);
+
+        // the capping does not affect the statistics
+        REQUIRE(TEST::named_entry((*j)["phases"],
+                                  Profiler::phase_name(Profiler::PROPERTY_EVALUATION))
+                ["calls"].number == n_iters);
+
+        std::ostringstream t;
+        Profiler::write_chrome_trace(comm, t);
+        std::unique_ptr<TEST::JSONValue> trace = TEST::parse_json(t.str());
+
+        REQUIRE((*trace)["displayTimeUnit"].string == "ms");
+
+        const TEST::JSONValue& events = (*trace)["traceEvents"];
+
+        // the process name is followed by the recorded scopes
+        REQUIRE(events.array.size() == max_events + 1);
+        REQUIRE(events[0]["ph"].string           == "M");
+        REQUIRE(events[0]["pid"].number          == comm.rank());
+        REQUIRE(events[0]["args"]["name"].string ==
+                "rank " + std::to_string(comm.rank()));
+
+        Real
+        prev_end = 0.;
+
+        for (unsigned int i=1; i<events.array.size(); i++) {
+
+            const TEST::JSONValue& e = events[i];
+
+            REQUIRE(e["ph"].string   == "X");
+            REQUIRE(e["pid"].number  == comm.rank());
+            REQUIRE(e["tid"].number  == 0.);
+            REQUIRE(e["ts"].number   >= 0.);
+            REQUIRE(e["dur"].number  >= 0.);
+            REQUIRE(e["name"].string != Profiler::phase_name(Profiler::PROPERTY_EVALUATION));
+
+            // events are recorded at the end of each scope, so the
+            // kernel precedes the enclosing scope
+            REQUIRE(e["name"].string == ((i%2)?
+                                         Profiler::phase_name(Profiler::ELEM_KERNEL):
+                                         "assembly_profiler_test"));
+            if (i%2)
+                prev_end = e["ts"].number + e["dur"].number;
+            else {
+                // the outer scope encloses the kernel, up to the
+                // rounding of the written times
+                CHECK(e["ts"].number <= events[i-1]["ts"].number + 1.e-3);
+                CHECK(e["ts"].number + e["dur"].number >= prev_end - 2.e-3);
+            }
+        }
+    }
+
+    Profiler::disable();
+    Profiler::clear();
+}
@@ -0,0 +1,268 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <string>
+#include <vector>
+#include <memory>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/numeric_vector.h"
+
+// MAST includes
+#include "utility/async_output_writer.h"
+
+// HDF5 includes
+#include "hdf5.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   value of entry \p i of vector \p v at snapshot \p step
+     */
+    inline Real snapshot_value(unsigned int step, unsigned int v, libMesh::dof_id_type i) {
+        return 1000.*step + 100.*v + i;
+    }
+
+    /*!
+     *   sets the vectors to the values of snapshot \p step
+     */
+    inline void set_snapshot_values(unsigned int step,
+                                    std::vector<std::unique_ptr<libMesh::NumericVector<Real>>>& vecs) {
+
+        for (unsigned int v=0; v<vecs.size(); v++) {
+            for (libMesh::dof_id_type i=vecs[v]->first_local_index(); i<vecs[v]->last_local_index(); i++)
+                vecs[v]->set(i, snapshot_value(step, v, i));
+            vecs[v]->close();
+        }
+    }
+
+    /*!
+     *   reads the \p time attribute of \p group and the entries of the
+     *   local range of vector \p nm written to file \p file_nm by a
+     *   collective or per-rank writer.
+     */
+    inline void read_snapshot(bool if_collective,
+                              const std::string& file_nm,
+                              const std::string& group,
+                              const std::string& nm,
+                              const libMesh::NumericVector<Real>& v,
+                              Real& time,
+                              std::vector<Real>& vals) {
+
+        const libMesh::Parallel::Communicator& comm = v.comm();
+
+        std::string
+        f_nm = file_nm;
+        if (!if_collective && comm.size() > 1)
+            f_nm += "." + std::to_string(comm.rank());
+
+        hid_t
+        file = H5Fopen(f_nm.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        REQUIRE(file >= 0);
+
+        hid_t
+        grp  = H5Gopen2(file, group.c_str(), H5P_DEFAULT),
+        attr = H5Aopen(grp, "time", H5P_DEFAULT),
+        dset = H5Dopen2(grp, nm.c_str(), H5P_DEFAULT),
+        fspace = H5Dget_space(dset);
+        REQUIRE(grp >= 0);
+        REQUIRE(dset >= 0);
+
+        REQUIRE(H5Aread(attr, H5T_NATIVE_DOUBLE, &time) >= 0);
+
+        hsize_t
+        n = 0;
+        H5Sget_simple_extent_dims(fspace, &n, nullptr);
+
+        std::vector<Real> all(n);
+        if (n)
+            REQUIRE(H5Dread(dset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &all[0]) >= 0);
+
+        // collective files store the global vector, and the rank files
+        // store only the local entries
+        if (if_collective) {
+            REQUIRE(n == v.size());
+            vals.assign(all.begin() + v.first_local_index(),
+                        all.begin() + v.last_local_index());
+        }
+        else {
+            REQUIRE(n == v.local_size());
+            vals = all;
+        }
+
+        H5Sclose(fspace);
+        H5Dclose(dset);
+        H5Aclose(attr);
+        H5Gclose(grp);
+        H5Fclose(file);
+    }
+
+
+    /*!
+     *   checks that the file has one group per snapshot, created in the
+     *   order of the snapshots, with the values that the vectors had when
+     *   the snapshot was written.
+     */
+    inline void check_snapshots(bool if_collective,
+                                const std::string& file_nm,
+                                unsigned int n_steps,
+                                const std::vector<std::string>& names,
+                                std::vector<std::unique_ptr<libMesh::NumericVector<Real>>>& vecs) {
+
+        const libMesh::Parallel::Communicator& comm = vecs[0]->comm();
+
+        std::string
+        f_nm = file_nm;
+        if (!if_collective && comm.size() > 1)
+            f_nm += "." + std::to_string(comm.rank());
+
+        hid_t
+        file = H5Fopen(f_nm.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        REQUIRE(file >= 0);
+
+        H5G_info_t
+        info;
+        REQUIRE(H5Gget_info(file, &info) >= 0);
+        REQUIRE(info.nlinks == n_steps);
+
+        char nm[64];
+        for (unsigned int step=0; step<n_steps; step++) {
+
+            REQUIRE(H5Lget_name_by_idx(file, ".", H5_INDEX_CRT_ORDER, H5_ITER_INC,
+                                       step, nm, sizeof(nm), H5P_DEFAULT) > 0);
+            REQUIRE(std::string(nm) == "t_"+std::to_string(step));
+        }
+        H5Fclose(file);
+
+        Real time;
+        std::vector<Real> vals;
+
+        for (unsigned int step=0; step<n_steps; step++)
+            for (unsigned int v=0; v<vecs.size(); v++) {
+
+                read_snapshot(if_collective, file_nm, "t_"+std::to_string(step), names[v], *vecs[v], time, vals);
+
+                REQUIRE(time == Approx(0.1*step));
+                REQUIRE(vals.size() == vecs[v]->local_size());
+
+                for (libMesh::dof_id_type i=0; i<vals.size(); i++)
+                    REQUIRE(vals[i] == snapshot_value(step, v, vecs[v]->first_local_index()+i));
+            }
+    }
+}
+
+
+
+TEST_CASE("async_output_writer",
+          "[utility][hdf5]")
+{
+    const libMesh::Parallel::Communicator& comm = p_global_init->comm();
+
+    // two vectors of different sizes, as for solution and velocity
+    // of systems with different numbers of variables
+    const libMesh::dof_id_type
+    n_global[2] = {37, 11};
+
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real>>> vecs(2);
+    std::vector<const libMesh::NumericVector<Real>*> vec_ptrs(2);
+    std::vector<std::string> names = {"solution", "velocity"};
+
+    for (unsigned int v=0; v<2; v++) {
+
+        const libMesh::dof_id_type
+        n_local = n_global[v]/comm.size() + (comm.rank() < n_global[v]%comm.size()? 1: 0);
+
+        vecs[v] = libMesh::NumericVector<Real>::build(comm);
+        vecs[v]->init(n_global[v], n_local, false, libMesh::PARALLEL);
+        vec_ptrs[v] = vecs[v].get();
+    }
+
+    const unsigned int
+    n_steps    = 12,
+    n_buffers  = GENERATE(0, 1, 3);
+
+    const std::string
+    file_nm = ("async_output_writer_np" + std::to_string(comm.size()) +
+               "_" + std::to_string(n_buffers) + ".h5");
+
+    SECTION("Snapshots hold the values at the time of write() and are written in order")
+    {
+        MAST::AsyncOutputWriter writer(comm, file_nm, n_buffers);
+        REQUIRE(writer.if_asynchronous() == (n_buffers > 0));
+
+        // the vectors are modified as soon as write() returns, as they
+        // would be by the next time-step
+        for (unsigned int step=0; step<n_steps; step++) {
+            TEST::set_snapshot_values(step, vecs);
+            writer.write("t_"+std::to_string(step), 0.1*step, names, vec_ptrs);
+        }
+        TEST::set_snapshot_values(n_steps+100, vecs);
+
+        // all staged snapshots are readable after flush()
+        writer.flush();
+        TEST::check_snapshots(writer.if_collective(), file_nm, n_steps, names, vecs);
+
+        // the writer stays usable after a flush
+        TEST::set_snapshot_values(n_steps, vecs);
+        writer.write("t_"+std::to_string(n_steps), 0.1*n_steps, names, vec_ptrs);
+        writer.flush();
+        TEST::check_snapshots(writer.if_collective(), file_nm, n_steps+1, names, vecs);
+    }
+
+    SECTION("A small staging area blocks write() until the writer catches up")
+    {
+        // the byte limit admits only one snapshot at a time
+        MAST::AsyncOutputWriter writer(comm, file_nm, n_buffers, sizeof(Real));
+
+        for (unsigned int step=0; step<n_steps; step++) {
+            TEST::set_snapshot_values(step, vecs);
+            writer.write("t_"+std::to_string(step), 0.1*step, names, vec_ptrs);
+        }
+
+        writer.flush();
+        TEST::check_snapshots(writer.if_collective(), file_nm, n_steps, names, vecs);
+    }
+
+    SECTION("Pending snapshots are written when the writer is destroyed")
+    {
+        bool
+        if_collective = false;
+
+        {
+            MAST::AsyncOutputWriter writer(comm, file_nm, n_buffers);
+            if_collective = writer.if_collective();
+
+            for (unsigned int step=0; step<n_steps; step++) {
+                TEST::set_snapshot_values(step, vecs);
+                writer.write("t_"+std::to_string(step), 0.1*step, names, vec_ptrs);
+            }
+            // no flush before the destructor
+        }
+
+        TEST::check_snapshots(if_collective, file_nm, n_steps, names, vecs);
+    }
+}
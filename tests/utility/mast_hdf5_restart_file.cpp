@@ -0,0 +1,219 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2020  Manav Bhatia and MAST authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// C++ includes
+#include <string>
+#include <memory>
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/explicit_system.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/node.h"
+#include "libmesh/elem.h"
+
+// MAST includes
+#include "utility/hdf5_restart_file.h"
+
+// Test includes
+#include "catch.hpp"
+
+extern libMesh::LibMeshInit* p_global_init;
+
+
+namespace TEST {
+
+    /*!
+     *   value of variable \p v at point \p p, which identifies the dof
+     *   independent of the mesh numbering and partitioning
+     */
+    inline Real restart_value(const libMesh::Point& p, unsigned int v) {
+        return 1. + p(0) + 10.*p(1) + 100.*v;
+    }
+
+    /*!
+     *   sets the local entries of \p vec to \p restart_value of the nodes
+     *   for the nodal variable and of the element centroids for the
+     *   element variable of \p sys.
+     */
+    inline void set_restart_values(const libMesh::System& sys,
+                                   libMesh::NumericVector<Real>& vec) {
+
+        const unsigned int
+        sn = sys.number();
+
+        for (const auto& node: sys.get_mesh().local_node_ptr_range())
+            vec.set(node->dof_number(sn, 0, 0), restart_value(*node, 0));
+
+        for (const auto& elem: sys.get_mesh().active_local_element_ptr_range())
+            vec.set(elem->dof_number(sn, 1, 0), restart_value(elem->centroid(), 1));
+
+        vec.close();
+    }
+
+    /*!
+     *   checks that the local entries of \p vec have the values set by
+     *   \p set_restart_values.
+     */
+    inline void check_restart_values(const libMesh::System& sys,
+                                     const libMesh::NumericVector<Real>& vec) {
+
+        const unsigned int
+        sn = sys.number();
+
+        for (const auto& node: sys.get_mesh().local_node_ptr_range())
+            REQUIRE(vec(node->dof_number(sn, 0, 0)) == Approx(restart_value(*node, 0)));
+
+        for (const auto& elem: sys.get_mesh().active_local_element_ptr_range())
+            REQUIRE(vec(elem->dof_number(sn, 1, 0)) == Approx(restart_value(elem->centroid(), 1)));
+    }
+
+    /*!
+     *   system with a nodal and an element variable on \p mesh
+     */
+    class TestRestartSystem {
+    public:
+        libMesh::EquationSystems equation_systems;
+        libMesh::ExplicitSystem& system;
+
+        TestRestartSystem(libMesh::MeshBase& mesh):
+        equation_systems(mesh),
+        system(equation_systems.add_system<libMesh::ExplicitSystem>("restart")) {
+
+            system.add_variable("u", libMesh::FIRST, libMesh::LAGRANGE);
+            system.add_variable("c", libMesh::CONSTANT, libMesh::MONOMIAL);
+            equation_systems.init();
+        }
+    };
+}
+
+
+
+TEST_CASE("hdf5_restart_file",
+          "[utility][hdf5][restart]")
+{
+    const libMesh::Parallel::Communicator& comm = p_global_init->comm();
+
+    const std::string
+    file_nm = "hdf5_restart_file_np" + std::to_string(comm.size()) + ".h5";
+
+    libMesh::ReplicatedMesh mesh(comm);
+    libMesh::MeshTools::Generation::build_square(mesh, 7, 5, 0., 1., 0., 1., libMesh::QUAD4);
+
+    TEST::TestRestartSystem written(mesh);
+    TEST::set_restart_values(written.system, *written.system.solution);
+
+    {
+        MAST::HDF5RestartFile file(written.system, file_nm, MAST::HDF5RestartFile::WRITE);
+        file.write_vector("system/restart/solution", *written.system.solution);
+        file.write_scalar("transient/dt", 0.125);
+    }
+
+    SECTION("Vectors and scalars are read back on the same mesh")
+    {
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        vec = written.system.solution->zero_clone();
+
+        MAST::HDF5RestartFile file(written.system, file_nm, MAST::HDF5RestartFile::READ);
+
+        REQUIRE(file.contains("system/restart/solution"));
+        REQUIRE(file.contains("transient/dt"));
+        REQUIRE_FALSE(file.contains("system/restart/velocity"));
+        REQUIRE_FALSE(file.contains("system/other/solution"));
+
+        file.read_vector("system/restart/solution", *vec);
+        REQUIRE(file.read_scalar("transient/dt") == 0.125);
+
+        TEST::check_restart_values(written.system, *vec);
+    }
+
+#ifdef LIBMESH_ENABLE_UNIQUE_ID
+    SECTION("Vectors are read back after the nodes and elements are renumbered")
+    {
+        // copy of the mesh with the ids of the nodes and elements in
+        // reverse order and the same unique ids, as after the renumbering
+        // of a distributed mesh. This changes the dof numbering and the
+        // partitioning.
+        libMesh::ReplicatedMesh renumbered(comm);
+        renumbered.set_mesh_dimension(mesh.mesh_dimension());
+        renumbered.allow_renumbering(false);
+
+        const libMesh::dof_id_type
+        n_nodes = mesh.max_node_id(),
+        n_elems = mesh.max_elem_id();
+
+        for (const auto& node: mesh.node_ptr_range()) {
+
+            libMesh::Node*
+            nd = renumbered.add_point(*node, n_nodes-1-node->id());
+            nd->set_unique_id() = node->unique_id();
+        }
+
+        for (const auto& elem: mesh.element_ptr_range()) {
+
+            libMesh::Elem*
+            e = libMesh::Elem::build(elem->type()).release();
+            e->set_id(n_elems-1-elem->id());
+            e->set_unique_id() = elem->unique_id();
+
+            for (unsigned int i=0; i<elem->n_nodes(); i++)
+                e->set_node(i) = renumbered.node_ptr(n_nodes-1-elem->node_id(i));
+
+            renumbered.add_elem(e);
+        }
+
+        renumbered.prepare_for_use();
+
+        TEST::TestRestartSystem read(renumbered);
+
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        vec = read.system.solution->zero_clone();
+
+        MAST::HDF5RestartFile file(read.system, file_nm, MAST::HDF5RestartFile::READ);
+        file.read_vector("system/restart/solution", *vec);
+        REQUIRE(file.read_scalar("transient/dt") == 0.125);
+
+        TEST::check_restart_values(read.system, *vec);
+
+        // the second read reuses the matching of the stored entries
+        vec->zero();
+        vec->close();
+        file.read_vector("system/restart/solution", *vec);
+        TEST::check_restart_values(read.system, *vec);
+    }
+#endif
+
+    SECTION("Reading fails if the file has no entries for some dofs")
+    {
+        // a finer mesh has dofs that are not in the file
+        libMesh::ReplicatedMesh finer(comm);
+        libMesh::MeshTools::Generation::build_square(finer, 8, 5, 0., 1., 0., 1., libMesh::QUAD4);
+
+        TEST::TestRestartSystem read(finer);
+
+        std::unique_ptr<libMesh::NumericVector<Real>>
+        vec = read.system.solution->zero_clone();
+
+        MAST::HDF5RestartFile file(read.system, file_nm, MAST::HDF5RestartFile::READ);
+        REQUIRE_THROWS(file.read_vector("system/restart/solution", *vec));
+    }
+}